@@ -41,6 +41,7 @@
 #include "TAppDecCfg.h"
 #include "TAppCommon/program_options_lite.h"
 #include "TLibCommon/TComChromaFormat.h"
+#include "TLibVideoIO/TVideoIOStdio.h"
 #ifdef WIN32
 #define strdup _strdup
 #endif
@@ -70,8 +71,8 @@ Bool TAppDecCfg::parseCfg( Int argc, TChar* argv[] )
 
 
   ("help",                      do_help,                               false,      "this help text")
-  ("BitstreamFile,b",           m_bitstreamFileName,                   string(""), "bitstream input file name")
-  ("ReconFile,o",               m_reconFileName,                       string(""), "reconstructed YUV output file name\n"
+  ("BitstreamFile,b",           m_bitstreamFileName,                   string(""), "bitstream input file name (- for the standard input)")
+  ("ReconFile,o",               m_reconFileName,                       string(""), "reconstructed YUV output file name (- for the standard output, extension .y4m for Y4M)\n"
                                                                                    "YUV writing is skipped if omitted")
   ("WarnUnknowParameter,w",     warnUnknowParameter,                                  0, "warn for unknown configuration parameters instead of failing")
   ("SkipFrames,s",              m_iSkipFrame,                          0,          "number of frames to skip before random access")
@@ -91,6 +92,14 @@ Bool TAppDecCfg::parseCfg( Int argc, TChar* argv[] )
 #endif
   ("OutputDecodedSEIMessagesFilename",  m_outputDecodedSEIMessagesFilename,    string(""), "When non empty, output decoded SEI messages to the indicated file. If file is '-', then output to stdout\n")
   ("ClipOutputVideoToRec709Range",      m_bClipOutputVideoToRec709Range,  false, "If true then clip output video to the Rec. 709 Range on saving")
+  ("Threads",                   m_numThreads,                          1,          "Number of worker threads used by the decoder (1: single-threaded)")
+  ("FramePipeline",             m_framePipeline,                       false,      "Reconstruct and filter each picture on a worker thread while the next pictures are parsed (requires Threads > 1)")
+  ("NalIndexFile",              m_nalIndexFileName,                    string(""), "NAL unit index of the bitstream, as written by the nalIndex tool; built and written if the file does not exist.\n"
+                                                                                   "Required by StartIRAP and Segment")
+  ("StartIRAP",                 m_startIRAP,                           -1,         "Random access point of the NAL unit index to start decoding at (-1: decode the segment)")
+  ("Segment",                   m_segment,                             0U,         "Segment of the bitstream to decode")
+  ("NumSegments",               m_numSegments,                         1U,         "Number of segments the bitstream is split into at random access points, to be decoded independently")
+  ("WriteBehindFrames",         m_writeBehindFrames,                   0,          "Number of decoded pictures, or field pairs, queued for writing on an output thread (0: write them synchronously)")
   ;
 
   po::setDefaults(opts);
@@ -117,6 +126,12 @@ Bool TAppDecCfg::parseCfg( Int argc, TChar* argv[] )
     }
   }
 
+  // when pictures go to the standard output, move the messages to stderr before any of them is flushed
+  if (TVideoIOStdio::isStdio(m_reconFileName))
+  {
+    TVideoIOStdio::getOutput();
+  }
+
   m_outputColourSpaceConvert = stringToInputColourSpaceConvert(outputColourSpaceConvert, false);
   if (m_outputColourSpaceConvert>=NUMBER_INPUT_COLOUR_SPACE_CONVERSIONS)
   {
@@ -130,6 +145,48 @@ Bool TAppDecCfg::parseCfg( Int argc, TChar* argv[] )
     return false;
   }
 
+  if (m_numThreads < 1)
+  {
+    fprintf(stderr, "Threads must be at least 1, aborting\n");
+    return false;
+  }
+
+  if (m_framePipeline && m_numThreads < 2)
+  {
+    fprintf(stderr, "FramePipeline requires Threads > 1, aborting\n");
+    return false;
+  }
+
+  if (m_writeBehindFrames < 0)
+  {
+    fprintf(stderr, "WriteBehindFrames cannot be negative, aborting\n");
+    return false;
+  }
+
+  if (m_numSegments < 1 || m_segment >= m_numSegments)
+  {
+    fprintf(stderr, "Segment must be less than NumSegments, aborting\n");
+    return false;
+  }
+
+  if ((m_startIRAP >= 0 || m_numSegments > 1) && m_nalIndexFileName.empty())
+  {
+    fprintf(stderr, "StartIRAP and NumSegments require a NalIndexFile, aborting\n");
+    return false;
+  }
+
+  if (m_startIRAP >= 0 && m_numSegments > 1)
+  {
+    fprintf(stderr, "StartIRAP and NumSegments cannot be used together, aborting\n");
+    return false;
+  }
+
+  if (!m_nalIndexFileName.empty() && TVideoIOStdio::isStdio(m_bitstreamFileName))
+  {
+    fprintf(stderr, "NalIndexFile cannot be used with a bitstream from the standard input, aborting\n");
+    return false;
+  }
+
   if ( !cfg_TargetDecLayerIdSetFile.empty() )
   {
     FILE* targetDecLayerIdSetFile = fopen ( cfg_TargetDecLayerIdSetFile.c_str(), "r" );
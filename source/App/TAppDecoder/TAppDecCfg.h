@@ -73,6 +73,13 @@ protected:
 #endif
   std::string   m_outputDecodedSEIMessagesFilename;   ///< filename to output decoded SEI messages to. If '-', then use stdout. If empty, do not output details.
   Bool          m_bClipOutputVideoToRec709Range;      ///< If true, clip the output video to the Rec 709 range on saving.
+  Int           m_numThreads;                         ///< number of worker threads
+  Bool          m_framePipeline;                      ///< overlap the parsing of a picture with the reconstruction and filtering of the previous ones
+  std::string   m_nalIndexFileName;                   ///< NAL unit index of the bitstream, for random access. If empty, the bitstream is decoded from its start
+  Int           m_startIRAP;                          ///< random access point of the NAL unit index to start decoding at, -1 to use the segments
+  UInt          m_segment;                            ///< segment of the bitstream to decode
+  UInt          m_numSegments;                        ///< number of segments the bitstream is split into
+  Int           m_writeBehindFrames;                  ///< number of decoded pictures queued for the output thread, 0 to write them synchronously
 
 public:
   TAppDecCfg()
@@ -92,6 +99,13 @@ public:
 #endif
   , m_outputDecodedSEIMessagesFilename()
   , m_bClipOutputVideoToRec709Range(false)
+  , m_numThreads(1)
+  , m_framePipeline(false)
+  , m_nalIndexFileName()
+  , m_startIRAP(-1)
+  , m_segment(0)
+  , m_numSegments(1)
+  , m_writeBehindFrames(0)
   {
     for (UInt channelTypeIndex = 0; channelTypeIndex < MAX_NUM_CHANNEL_TYPE; channelTypeIndex++)
     {
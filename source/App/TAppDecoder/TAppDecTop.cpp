@@ -36,6 +36,7 @@
 */
 
 #include <list>
+#include <limits>
 #include <vector>
 #include <stdio.h>
 #include <fcntl.h>
@@ -43,7 +44,9 @@
 
 #include "TAppDecTop.h"
 #include "TLibDecoder/AnnexBread.h"
+#include "TLibDecoder/NALindex.h"
 #include "TLibDecoder/NALread.h"
+#include "TLibVideoIO/TVideoIOStdio.h"
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
 #include "TLibCommon/TComCodingStatistics.h"
 #endif
@@ -58,6 +61,7 @@
 TAppDecTop::TAppDecTop()
 : m_iPOCLastDisplay(-MAX_INT)
  ,m_pcSeiColourRemappingInfoPrevious(NULL)
+ ,m_numOutputQueued(0)
 {
 }
 
@@ -88,14 +92,20 @@ Void TAppDecTop::decode()
   Int                 poc;
   TComList<TComPic*>* pcListPic = NULL;
 
-  ifstream bitstreamFile(m_bitstreamFileName.c_str(), ifstream::in | ifstream::binary);
-  if (!bitstreamFile)
+  const Bool bStdinBitstream = TVideoIOStdio::isStdio(m_bitstreamFileName);
+  ifstream bitstreamFile;
+  if (!bStdinBitstream)
+  {
+    bitstreamFile.open(m_bitstreamFileName.c_str(), ifstream::in | ifstream::binary);
+  }
+  std::istream& bitstreamIn = bStdinBitstream ? TVideoIOStdio::getInput() : static_cast<std::istream&>(bitstreamFile);
+  if (!bitstreamIn)
   {
     fprintf(stderr, "\nfailed to open bitstream file `%s' for reading\n", m_bitstreamFileName.c_str());
     exit(EXIT_FAILURE);
   }
 
-  InputByteStream bytestream(bitstreamFile);
+  InputByteStream bytestream(bitstreamIn);
 
   if (!m_outputDecodedSEIMessagesFilename.empty() && m_outputDecodedSEIMessagesFilename!="-")
   {
@@ -127,37 +137,58 @@ Void TAppDecTop::decode()
   Bool openedReconFile = false; // reconstruction file not yet opened. (must be performed after SPS is seen)
   Bool loopFiltered = false;
 
-  while (!!bitstreamFile)
+  // byte offsets of the next NAL unit to read and of the end of the NAL units to decode
+  UInt64 bitstreamPos = 0;
+  UInt64 bitstreamEnd = std::numeric_limits<UInt64>::max();
+  if (!m_nalIndexFileName.empty())
+  {
+    xSeekBitstream(bitstreamIn, bytestream, bitstreamPos, bitstreamEnd);
+  }
+
+  Bool bBitstreamEnded = bitstreamPos >= bitstreamEnd;
+
+  while (!bBitstreamEnded || m_cTDecTop.hasPendingNalUnit())
   {
-    /* location serves to work around a design fault in the decoder, whereby
-     * the process of reading a new slice that is the first slice of a new frame
-     * requires the TDecTop::decode() method to be called again with the same
-     * nal unit. */
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-    TComCodingStatistics::TComCodingStatisticsData backupStats(TComCodingStatistics::GetStatistics());
-    streampos location = bitstreamFile.tellg() - streampos(bytestream.GetNumBufferedBytes());
-#else
-    streampos location = bitstreamFile.tellg();
-#endif
     AnnexBStats stats = AnnexBStats();
 
+    /* the first slice of a new picture is only decoded once the previous
+     * picture is finished, so TDecTop::decode() keeps it and gives it back
+     * here, unescaped, instead of it being read again */
     InputNALUnit nalu;
-    byteStreamNALUnit(bytestream, nalu.getBitstream().getFifo(), stats);
+    Bool bNalUnitRead = m_cTDecTop.takePendingNalUnit(nalu);
+    if (!bNalUnitRead)
+    {
+      const uint8_t* nalUnitBytes = NULL; // the payload is unescaped from here into nalu
+      std::size_t numNalUnitBytes = 0;
+      bBitstreamEnded = byteStreamNALUnit(bytestream, nalUnitBytes, numNalUnitBytes, stats);
+      bitstreamPos += stats.getNumBytes();
+      if (bitstreamPos >= bitstreamEnd)
+      {
+        bBitstreamEnded = true; // the end of the segment
+      }
+      if (numNalUnitBytes == 0)
+      {
+        /* this can happen if the following occur:
+         *  - empty input file
+         *  - two back-to-back start_code_prefixes
+         *  - start_code_prefix immediately followed by EOF
+         */
+        fprintf(stderr, "Warning: Attempt to decode an empty NAL unit\n");
+      }
+      else
+      {
+        read(nalu, nalUnitBytes, numNalUnitBytes);
+        bNalUnitRead = true;
+      }
+    }
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+    TComCodingStatistics::TComCodingStatisticsData backupStats(TComCodingStatistics::GetStatistics());
+#endif
 
     // call actual decoding function
     Bool bNewPicture = false;
-    if (nalu.getBitstream().getFifo().empty())
-    {
-      /* this can happen if the following occur:
-       *  - empty input file
-       *  - two back-to-back start_code_prefixes
-       *  - start_code_prefix immediately followed by EOF
-       */
-      fprintf(stderr, "Warning: Attempt to decode an empty NAL unit\n");
-    }
-    else
+    if (bNalUnitRead)
     {
-      read(nalu);
       if( (m_iMaxTemporalLayer >= 0 && nalu.m_temporalId > m_iMaxTemporalLayer) || !isNaluWithinTargetDecLayerIdSet(&nalu)  )
       {
         bNewPicture = false;
@@ -165,29 +196,21 @@ Void TAppDecTop::decode()
       else
       {
         bNewPicture = m_cTDecTop.decode(nalu, m_iSkipFrame, m_iPOCLastDisplay);
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
         if (bNewPicture)
         {
-          bitstreamFile.clear();
-          /* location points to the current nalunit payload[1] due to the
-           * need for the annexB parser to read three extra bytes.
-           * [1] except for the first NAL unit in the file
-           *     (but bNewPicture doesn't happen then) */
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-          bitstreamFile.seekg(location);
-          bytestream.reset();
+          // the statistics are gathered when the slice is decoded again
           TComCodingStatistics::SetStatistics(backupStats);
-#else
-          bitstreamFile.seekg(location-streamoff(3));
-          bytestream.reset();
-#endif
         }
+#endif
       }
     }
 
-    if ( (bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS) &&
+    const Bool bMoreNalUnits = !bBitstreamEnded || m_cTDecTop.hasPendingNalUnit();
+    if ( (bNewPicture || !bMoreNalUnits || nalu.m_nalUnitType == NAL_UNIT_EOS) &&
         !m_cTDecTop.getFirstSliceInSequence () )
     {
-      if (!loopFiltered || bitstreamFile)
+      if (!loopFiltered || bMoreNalUnits)
       {
         m_cTDecTop.executeLoopFilters(poc, pcListPic);
       }
@@ -197,7 +220,7 @@ Void TAppDecTop::decode()
         m_cTDecTop.setFirstSliceInSequence(true);
       }
     }
-    else if ( (bNewPicture || !bitstreamFile || nalu.m_nalUnitType == NAL_UNIT_EOS ) &&
+    else if ( (bNewPicture || !bMoreNalUnits || nalu.m_nalUnitType == NAL_UNIT_EOS ) &&
               m_cTDecTop.getFirstSliceInSequence () ) 
     {
       m_cTDecTop.setFirstSliceInPicture (true);
@@ -217,6 +240,13 @@ Void TAppDecTop::decode()
         }
 
         m_cTVideoIOYuvReconFile.open( m_reconFileName, true, m_outputBitDepth, m_outputBitDepth, bitDepths.recon ); // write mode
+        const TComSPS &sps = pcListPic->front()->getPicSym()->getSPS();
+        if ( sps.getVuiParametersPresentFlag() && sps.getVuiParameters()->getTimingInfo()->getTimingInfoPresentFlag() )
+        {
+          // frame rate of a Y4M output
+          const TimingInfo *timingInfo = sps.getVuiParameters()->getTimingInfo();
+          m_cTVideoIOYuvReconFile.setY4MFrameRate( Int( timingInfo->getTimeScale() ), Int( timingInfo->getNumUnitsInTick() ) );
+        }
         openedReconFile = true;
       }
       // write reconstruction to file
@@ -252,6 +282,7 @@ Void TAppDecTop::decode()
   }
 
   xFlushOutput( pcListPic );
+  xStopWriteBehind();
   // delete buffers
   m_cTDecTop.deletePicBuffer();
 
@@ -266,6 +297,8 @@ Void TAppDecTop::decode()
 Void TAppDecTop::xCreateDecLib()
 {
   // create decoder class
+  m_cTDecTop.setNumThreads(m_numThreads);
+  m_cTDecTop.setFramePipeline(m_framePipeline);
   m_cTDecTop.create();
 }
 
@@ -286,6 +319,91 @@ Void TAppDecTop::xDestroyDecLib()
   }
 }
 
+/**
+ * Position the bitstream at the random access point or at the segment
+ * selected with the NAL unit index, after decoding the parameter sets
+ * that precede it.  The index is built and written first if it cannot
+ * be read.
+ * \param bitstreamIn   bitstream, which must be seekable
+ * \param bytestream    byte stream reader of bitstreamIn
+ * \param bitstreamPos  receives the byte offset to start decoding at
+ * \param bitstreamEnd  receives the byte offset to stop decoding at
+ */
+Void TAppDecTop::xSeekBitstream(std::istream& bitstreamIn, InputByteStream& bytestream, UInt64& bitstreamPos, UInt64& bitstreamEnd)
+{
+  bitstreamIn.seekg(0, std::ios::end);
+  const UInt64 streamSize = UInt64(bitstreamIn.tellg());
+  bitstreamIn.seekg(0, std::ios::beg);
+
+  NALIndex index;
+  if (!index.read(m_nalIndexFileName))
+  {
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+    TComCodingStatistics::TComCodingStatisticsData backupStats(TComCodingStatistics::GetStatistics());
+#endif
+    index.build(bitstreamIn);
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+    TComCodingStatistics::SetStatistics(backupStats); // the parsing for the index is not part of the decoding
+#endif
+    if (!index.write(m_nalIndexFileName))
+    {
+      fprintf(stderr, "\nfailed to write NAL unit index file `%s'\n", m_nalIndexFileName.c_str());
+      exit(EXIT_FAILURE);
+    }
+  }
+  if (index.getStreamSize() != streamSize)
+  {
+    fprintf(stderr, "\nNAL unit index file `%s' does not match the bitstream\n", m_nalIndexFileName.c_str());
+    exit(EXIT_FAILURE);
+  }
+
+  std::size_t firstEntry;
+  std::size_t endEntry;
+  if (m_startIRAP >= 0)
+  {
+    const std::vector<NALIndexRandomAccessPoint> &randomAccessPoints = index.getRandomAccessPoints();
+    if (m_startIRAP >= Int(randomAccessPoints.size()))
+    {
+      fprintf(stderr, "\nStartIRAP %d is not one of the %d random access points of the bitstream\n", m_startIRAP, Int(randomAccessPoints.size()));
+      exit(EXIT_FAILURE);
+    }
+    firstEntry = randomAccessPoints[m_startIRAP].m_accessUnitStart;
+    endEntry   = index.getEntries().size();
+  }
+  else
+  {
+    index.getSegment(m_segment, m_numSegments, firstEntry, endEntry);
+  }
+  bitstreamPos = index.getOffset(firstEntry);
+  bitstreamEnd = index.getOffset(endEntry);
+  printf("Decoding bytes %llu to %llu of the bitstream\n", (unsigned long long)bitstreamPos, (unsigned long long)bitstreamEnd);
+
+  // the active parameter sets may precede the start
+  std::vector<std::size_t> parameterSets;
+  index.getParameterSets(firstEntry, parameterSets);
+  for (std::size_t i = 0; i < parameterSets.size(); i++)
+  {
+    bitstreamIn.clear();
+    bitstreamIn.seekg(std::streamoff(index.getOffset(parameterSets[i])));
+    bytestream.reset();
+
+    AnnexBStats stats = AnnexBStats();
+    const uint8_t* nalUnitBytes = NULL;
+    std::size_t numNalUnitBytes = 0;
+    byteStreamNALUnit(bytestream, nalUnitBytes, numNalUnitBytes, stats);
+    if (numNalUnitBytes > 0)
+    {
+      InputNALUnit nalu;
+      read(nalu, nalUnitBytes, numNalUnitBytes);
+      m_cTDecTop.decode(nalu, m_iSkipFrame, m_iPOCLastDisplay);
+    }
+  }
+
+  bitstreamIn.clear();
+  bitstreamIn.seekg(std::streamoff(bitstreamPos));
+  bytestream.reset();
+}
+
 Void TAppDecTop::xInitDecLib()
 {
   // initialize decoder class
@@ -319,6 +437,8 @@ Void TAppDecTop::xWriteOutput( TComList<TComPic*>* pcListPic, UInt tId )
   TComList<TComPic*>::iterator iterPic   = pcListPic->begin();
   Int numPicsNotYetDisplayed = 0;
   Int dpbFullness = 0;
+  // the output marks of the pictures that are not written now are about to be cleared
+  const Bool bWaitForPictures = m_cTDecTop.getNoOutputPriorPicsFlag();
   const TComSPS* activeSPS = &(pcListPic->front()->getPicSym()->getSPS());
   UInt numReorderPicsHighestTid;
   UInt maxDecPicBufferingHighestTid;
@@ -374,6 +494,12 @@ Void TAppDecTop::xWriteOutput( TComList<TComPic*>* pcListPic, UInt tId )
           (!(pcPicTop->getPOC()%2) && pcPicBottom->getPOC() == pcPicTop->getPOC()+1) &&
           (pcPicTop->getPOC() == m_iPOCLastDisplay+1 || m_iPOCLastDisplay < 0))
       {
+        if ( !xIsPictureFinished( pcPicTop, bWaitForPictures ) || !xIsPictureFinished( pcPicBottom, bWaitForPictures ) )
+        {
+          // the pictures are still in the decoder pipeline, they are written by a later call
+          break;
+        }
+
         // write to file
         numPicsNotYetDisplayed = numPicsNotYetDisplayed-2;
         if ( !m_reconFileName.empty() )
@@ -395,12 +521,7 @@ Void TAppDecTop::xWriteOutput( TComList<TComPic*>* pcListPic, UInt tId )
 
           if (display)
           {
-            m_cTVideoIOYuvReconFile.write( pcPicTop->getPicYuvRec(), pcPicBottom->getPicYuvRec(),
-                                           m_outputColourSpaceConvert,
-                                           conf.getWindowLeftOffset() + defDisp.getWindowLeftOffset(),
-                                           conf.getWindowRightOffset() + defDisp.getWindowRightOffset(),
-                                           conf.getWindowTopOffset() + defDisp.getWindowTopOffset(),
-                                           conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(), NUM_CHROMA_FORMAT, isTff );
+            xWriteRecon( pcPicTop->getPicYuvRec(), pcPicBottom->getPicYuvRec(), conf, defDisp, isTff );
           }
         }
 
@@ -438,6 +559,12 @@ Void TAppDecTop::xWriteOutput( TComList<TComPic*>* pcListPic, UInt tId )
       if(pcPic->getOutputMark() && pcPic->getPOC() > m_iPOCLastDisplay &&
         (numPicsNotYetDisplayed >  numReorderPicsHighestTid || dpbFullness > maxDecPicBufferingHighestTid))
       {
+        if ( !xIsPictureFinished( pcPic, bWaitForPictures ) )
+        {
+          // the picture is still in the decoder pipeline, it is written by a later call
+          break;
+        }
+
         // write to file
          numPicsNotYetDisplayed--;
         if(pcPic->getSlice(0)->isReferenced() == false)
@@ -450,13 +577,7 @@ Void TAppDecTop::xWriteOutput( TComList<TComPic*>* pcListPic, UInt tId )
           const Window &conf    = pcPic->getConformanceWindow();
           const Window  defDisp = m_respectDefDispWindow ? pcPic->getDefDisplayWindow() : Window();
 
-          m_cTVideoIOYuvReconFile.write( pcPic->getPicYuvRec(),
-                                         m_outputColourSpaceConvert,
-                                         conf.getWindowLeftOffset() + defDisp.getWindowLeftOffset(),
-                                         conf.getWindowRightOffset() + defDisp.getWindowRightOffset(),
-                                         conf.getWindowTopOffset() + defDisp.getWindowTopOffset(),
-                                         conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
-                                         NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range  );
+          xWriteRecon( pcPic->getPicYuvRec(), NULL, conf, defDisp, false );
         }
 
         if (!m_colourRemapSEIFileName.empty())
@@ -493,6 +614,11 @@ Void TAppDecTop::xFlushOutput( TComList<TComPic*>* pcListPic )
   }
   TComList<TComPic*>::iterator iterPic   = pcListPic->begin();
 
+  while (iterPic != pcListPic->end())
+  {
+    xIsPictureFinished( *(iterPic++), true );
+  }
+
   iterPic   = pcListPic->begin();
   TComPic* pcPic = *(iterPic);
 
@@ -515,12 +641,7 @@ Void TAppDecTop::xFlushOutput( TComList<TComPic*>* pcListPic )
           const Window &conf = pcPicTop->getConformanceWindow();
           const Window  defDisp = m_respectDefDispWindow ? pcPicTop->getDefDisplayWindow() : Window();
           const Bool isTff = pcPicTop->isTopField();
-          m_cTVideoIOYuvReconFile.write( pcPicTop->getPicYuvRec(), pcPicBottom->getPicYuvRec(),
-                                         m_outputColourSpaceConvert,
-                                         conf.getWindowLeftOffset() + defDisp.getWindowLeftOffset(),
-                                         conf.getWindowRightOffset() + defDisp.getWindowRightOffset(),
-                                         conf.getWindowTopOffset() + defDisp.getWindowTopOffset(),
-                                         conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(), NUM_CHROMA_FORMAT, isTff );
+          xWriteRecon( pcPicTop->getPicYuvRec(), pcPicBottom->getPicYuvRec(), conf, defDisp, isTff );
         }
 
         // update POC of display order
@@ -573,13 +694,7 @@ Void TAppDecTop::xFlushOutput( TComList<TComPic*>* pcListPic )
           const Window &conf    = pcPic->getConformanceWindow();
           const Window  defDisp = m_respectDefDispWindow ? pcPic->getDefDisplayWindow() : Window();
 
-          m_cTVideoIOYuvReconFile.write( pcPic->getPicYuvRec(),
-                                         m_outputColourSpaceConvert,
-                                         conf.getWindowLeftOffset() + defDisp.getWindowLeftOffset(),
-                                         conf.getWindowRightOffset() + defDisp.getWindowRightOffset(),
-                                         conf.getWindowTopOffset() + defDisp.getWindowTopOffset(),
-                                         conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset(),
-                                         NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
+          xWriteRecon( pcPic->getPicYuvRec(), NULL, conf, defDisp, false );
         }
 
         if (!m_colourRemapSEIFileName.empty())
@@ -613,6 +728,127 @@ Void TAppDecTop::xFlushOutput( TComList<TComPic*>* pcListPic )
   m_iPOCLastDisplay = -MAX_INT;
 }
 
+/**
+  Write a decoded picture, or field pair, to the reconstruction file.
+  When WriteBehindFrames > 0, the picture is copied to a write-behind slot, which releases its buffer in the decoded
+  picture buffer at once, and the output thread converts and writes it while the decoding goes on.
+  \param pcPicYuvTop     decoded picture, or top field
+  \param pcPicYuvBottom  bottom field, or NULL for a frame
+  \param conf            conformance window of the picture
+  \param defDisp         default display window to remove as well
+  \param isTff           the top field is the first field
+ */
+Void TAppDecTop::xWriteRecon( TComPicYuv* pcPicYuvTop, TComPicYuv* pcPicYuvBottom, const Window &conf, const Window &defDisp, Bool isTff )
+{
+  const Int confLeft   = conf.getWindowLeftOffset()   + defDisp.getWindowLeftOffset();
+  const Int confRight  = conf.getWindowRightOffset()  + defDisp.getWindowRightOffset();
+  const Int confTop    = conf.getWindowTopOffset()    + defDisp.getWindowTopOffset();
+  const Int confBottom = conf.getWindowBottomOffset() + defDisp.getWindowBottomOffset();
+
+  if ( m_writeBehindFrames == 0 )
+  {
+    if ( pcPicYuvBottom != NULL )
+    {
+      m_cTVideoIOYuvReconFile.write( pcPicYuvTop, pcPicYuvBottom, m_outputColourSpaceConvert, confLeft, confRight, confTop, confBottom, NUM_CHROMA_FORMAT, isTff );
+    }
+    else
+    {
+      m_cTVideoIOYuvReconFile.write( pcPicYuvTop, m_outputColourSpaceConvert, confLeft, confRight, confTop, confBottom, NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
+    }
+    return;
+  }
+
+  if ( m_outputPictures.empty() )
+  {
+    m_outputPictures.resize( 2 * m_writeBehindFrames, NULL );
+    m_outputProgress.init( 1 );
+    m_outputThread.create( 1 );
+  }
+
+  // wait until the slot has been written out
+  const Int slot = m_numOutputQueued % m_writeBehindFrames;
+  m_outputProgress.waitFor( 0, m_numOutputQueued - m_writeBehindFrames + 1 );
+
+  TComPicYuv* apcPicYuv[2] = { pcPicYuvTop, pcPicYuvBottom };
+  for ( Int field = 0; field < 2; field++ )
+  {
+    if ( apcPicYuv[field] != NULL )
+    {
+      TComPicYuv*& rpcSlotPicYuv = m_outputPictures[2 * slot + field];
+      if ( rpcSlotPicYuv != NULL &&
+           (   rpcSlotPicYuv->getWidth( COMPONENT_Y ) != apcPicYuv[field]->getWidth( COMPONENT_Y )
+            || rpcSlotPicYuv->getHeight( COMPONENT_Y ) != apcPicYuv[field]->getHeight( COMPONENT_Y )
+            || rpcSlotPicYuv->getChromaFormat() != apcPicYuv[field]->getChromaFormat() ) )
+      {
+        // the picture size changed with a new SPS
+        rpcSlotPicYuv->destroy();
+        delete rpcSlotPicYuv;
+        rpcSlotPicYuv = NULL;
+      }
+      if ( rpcSlotPicYuv == NULL )
+      {
+        rpcSlotPicYuv = new TComPicYuv;
+        rpcSlotPicYuv->createWithoutCUInfo( apcPicYuv[field]->getWidth( COMPONENT_Y ), apcPicYuv[field]->getHeight( COMPONENT_Y ), apcPicYuv[field]->getChromaFormat() );
+      }
+      apcPicYuv[field]->copyToPic( rpcSlotPicYuv );
+    }
+  }
+
+  const Int  outputIdx   = m_numOutputQueued++;
+  const Bool isFieldPair = pcPicYuvBottom != NULL;
+  m_outputThread.addTask( [this, slot, outputIdx, isFieldPair, confLeft, confRight, confTop, confBottom, isTff]( Int )
+  {
+    if ( isFieldPair )
+    {
+      m_cTVideoIOYuvReconFile.write( m_outputPictures[2 * slot], m_outputPictures[2 * slot + 1], m_outputColourSpaceConvert,
+                                     confLeft, confRight, confTop, confBottom, NUM_CHROMA_FORMAT, isTff );
+    }
+    else
+    {
+      m_cTVideoIOYuvReconFile.write( m_outputPictures[2 * slot], m_outputColourSpaceConvert,
+                                     confLeft, confRight, confTop, confBottom, NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
+    }
+    m_outputProgress.set( 0, outputIdx + 1 );
+  } );
+}
+
+Void TAppDecTop::xStopWriteBehind()
+{
+  if ( m_outputPictures.empty() )
+  {
+    return;
+  }
+  m_outputThread.waitForAllTasks();
+  m_outputThread.destroy();
+
+  for ( UInt i = 0; i < m_outputPictures.size(); i++ )
+  {
+    if ( m_outputPictures[i] != NULL )
+    {
+      m_outputPictures[i]->destroy();
+      delete m_outputPictures[i];
+    }
+  }
+  m_outputPictures.clear();
+  m_numOutputQueued = 0;
+}
+
+/** Check whether all the CTU rows of a picture have been reconstructed and filtered by the decoder.
+    \param pcPic  picture to check
+    \param bWait  wait until the picture is finished
+    \returns true if the picture is finished
+ */
+Bool TAppDecTop::xIsPictureFinished( TComPic* pcPic, Bool bWait )
+{
+  const Int numCtuRows = pcPic->getPicSym()->getFrameHeightInCtus();
+  if ( bWait )
+  {
+    pcPic->waitForFinishedCtuRows( numCtuRows );
+    return true;
+  }
+  return pcPic->getNumFinishedCtuRows() >= numCtuRows;
+}
+
 /** \param nalu Input nalu to check whether its LayerId is within targetDecLayerIdSet
  */
 Bool TAppDecTop::isNaluWithinTargetDecLayerIdSet( InputNALUnit* nalu )
@@ -42,15 +42,20 @@
 #pragma once
 #endif // _MSC_VER > 1000
 
+#include <vector>
+
 #include "TLibVideoIO/TVideoIOYuv.h"
 #include "TLibCommon/TComList.h"
 #include "TLibCommon/TComPicYuv.h"
+#include "TLibCommon/TComThreadPool.h"
 #include "TLibDecoder/TDecTop.h"
 #include "TAppDecCfg.h"
 
 //! \ingroup TAppDecoder
 //! \{
 
+class InputByteStream;
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -69,6 +74,11 @@ private:
 
   SEIColourRemappingInfo*         m_pcSeiColourRemappingInfoPrevious;
 
+  TComThreadPool                  m_outputThread;                 ///< writes decoded pictures when WriteBehindFrames > 0
+  std::vector<TComPicYuv*>        m_outputPictures;               ///< write-behind slots, two pictures per slot for field pairs
+  TComRowProgress                 m_outputProgress;               ///< number of output slots written
+  Int                             m_numOutputQueued;              ///< number of output slots passed to the output thread
+
 public:
   TAppDecTop();
   virtual ~TAppDecTop() {}
@@ -82,9 +92,13 @@ protected:
   Void  xCreateDecLib     (); ///< create internal classes
   Void  xDestroyDecLib    (); ///< destroy internal classes
   Void  xInitDecLib       (); ///< initialize decoder class
+  Void  xSeekBitstream    ( std::istream& bitstreamIn, InputByteStream& bytestream, UInt64& bitstreamPos, UInt64& bitstreamEnd ); ///< seek to the random access point or segment to decode
 
   Void  xWriteOutput      ( TComList<TComPic*>* pcListPic , UInt tId); ///< write YUV to file
   Void  xFlushOutput      ( TComList<TComPic*>* pcListPic ); ///< flush all remaining decoded pictures to file
+  Void  xWriteRecon       ( TComPicYuv* pcPicYuvTop, TComPicYuv* pcPicYuvBottom, const Window &conf, const Window &defDisp, Bool isTff ); ///< write a picture or field pair, or pass it to the output thread
+  Void  xStopWriteBehind  (); ///< wait for the queued writes and free the slots
+  Bool  xIsPictureFinished( TComPic* pcPic, Bool bWait ); ///< check whether the decoder pipeline has finished a picture
   Bool  isNaluWithinTargetDecLayerIdSet ( InputNALUnit* nalu ); ///< check whether given Nalu is within targetDecLayerIdSet
 
 private:
@@ -35,7 +35,6 @@
     \brief    Encoder application class
 */
 
-#include <list>
 #include <fstream>
 #include <stdlib.h>
 #include <stdio.h>
@@ -44,7 +43,7 @@
 #include <iomanip>
 
 #include "TAppEncTop.h"
-#include "TLibEncoder/AnnexBwrite.h"
+#include "TLibVideoIO/TVideoIOStdio.h"
 
 using namespace std;
 
@@ -57,372 +56,13 @@ using namespace std;
 
 TAppEncTop::TAppEncTop()
 {
-  m_iFrameRcvd = 0;
-  m_totalBytes = 0;
-  m_essentialBytes = 0;
+  m_numOutputQueued = 0;
 }
 
 TAppEncTop::~TAppEncTop()
 {
 }
 
-Void TAppEncTop::xInitLibCfg()
-{
-  TComVPS vps;
-
-  vps.setMaxTLayers                                               ( m_maxTempLayer );
-  if (m_maxTempLayer == 1)
-  {
-    vps.setTemporalNestingFlag(true);
-  }
-  vps.setMaxLayers                                                ( 1 );
-  for(Int i = 0; i < MAX_TLAYER; i++)
-  {
-    vps.setNumReorderPics                                         ( m_numReorderPics[i], i );
-    vps.setMaxDecPicBuffering                                     ( m_maxDecPicBuffering[i], i );
-  }
-  m_cTEncTop.setVPS(&vps);
-
-  m_cTEncTop.setProfile                                           ( m_profile);
-  m_cTEncTop.setLevel                                             ( m_levelTier, m_level);
-  m_cTEncTop.setProgressiveSourceFlag                             ( m_progressiveSourceFlag);
-  m_cTEncTop.setInterlacedSourceFlag                              ( m_interlacedSourceFlag);
-  m_cTEncTop.setNonPackedConstraintFlag                           ( m_nonPackedConstraintFlag);
-  m_cTEncTop.setFrameOnlyConstraintFlag                           ( m_frameOnlyConstraintFlag);
-  m_cTEncTop.setBitDepthConstraintValue                           ( m_bitDepthConstraint );
-  m_cTEncTop.setChromaFormatConstraintValue                       ( m_chromaFormatConstraint );
-  m_cTEncTop.setIntraConstraintFlag                               ( m_intraConstraintFlag );
-  m_cTEncTop.setOnePictureOnlyConstraintFlag                      ( m_onePictureOnlyConstraintFlag );
-  m_cTEncTop.setLowerBitRateConstraintFlag                        ( m_lowerBitRateConstraintFlag );
-
-  m_cTEncTop.setPrintMSEBasedSequencePSNR                         ( m_printMSEBasedSequencePSNR);
-  m_cTEncTop.setPrintFrameMSE                                     ( m_printFrameMSE);
-  m_cTEncTop.setPrintSequenceMSE                                  ( m_printSequenceMSE);
-  m_cTEncTop.setCabacZeroWordPaddingEnabled                       ( m_cabacZeroWordPaddingEnabled );
-
-  m_cTEncTop.setFrameRate                                         ( m_iFrameRate );
-  m_cTEncTop.setFrameSkip                                         ( m_FrameSkip );
-  m_cTEncTop.setTemporalSubsampleRatio                            ( m_temporalSubsampleRatio );
-  m_cTEncTop.setSourceWidth                                       ( m_iSourceWidth );
-  m_cTEncTop.setSourceHeight                                      ( m_iSourceHeight );
-  m_cTEncTop.setConformanceWindow                                 ( m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom );
-  m_cTEncTop.setFramesToBeEncoded                                 ( m_framesToBeEncoded );
-
-  //====== Coding Structure ========
-  m_cTEncTop.setIntraPeriod                                       ( m_iIntraPeriod );
-  m_cTEncTop.setDecodingRefreshType                               ( m_iDecodingRefreshType );
-  m_cTEncTop.setGOPSize                                           ( m_iGOPSize );
-  m_cTEncTop.setGopList                                           ( m_GOPList );
-  m_cTEncTop.setExtraRPSs                                         ( m_extraRPSs );
-  for(Int i = 0; i < MAX_TLAYER; i++)
-  {
-    m_cTEncTop.setNumReorderPics                                  ( m_numReorderPics[i], i );
-    m_cTEncTop.setMaxDecPicBuffering                              ( m_maxDecPicBuffering[i], i );
-  }
-  for( UInt uiLoop = 0; uiLoop < MAX_TLAYER; ++uiLoop )
-  {
-    m_cTEncTop.setLambdaModifier                                  ( uiLoop, m_adLambdaModifier[ uiLoop ] );
-  }
-  m_cTEncTop.setIntraLambdaModifier                               ( m_adIntraLambdaModifier );
-  m_cTEncTop.setIntraQpFactor                                     ( m_dIntraQpFactor );
-
-  m_cTEncTop.setQP                                                ( m_iQP );
-
-  m_cTEncTop.setPad                                               ( m_aiPad );
-
-  m_cTEncTop.setAccessUnitDelimiter                               ( m_AccessUnitDelimiter );
-
-  m_cTEncTop.setMaxTempLayer                                      ( m_maxTempLayer );
-  m_cTEncTop.setUseAMP( m_enableAMP );
-
-  //===== Slice ========
-
-  //====== Loop/Deblock Filter ========
-  m_cTEncTop.setLoopFilterDisable                                 ( m_bLoopFilterDisable       );
-  m_cTEncTop.setLoopFilterOffsetInPPS                             ( m_loopFilterOffsetInPPS );
-  m_cTEncTop.setLoopFilterBetaOffset                              ( m_loopFilterBetaOffsetDiv2  );
-  m_cTEncTop.setLoopFilterTcOffset                                ( m_loopFilterTcOffsetDiv2    );
-#if W0038_DB_OPT
-  m_cTEncTop.setDeblockingFilterMetric                            ( m_deblockingFilterMetric );
-#else
-  m_cTEncTop.setDeblockingFilterMetric                            ( m_DeblockingFilterMetric );
-#endif
-
-  //====== Motion search ========
-  m_cTEncTop.setDisableIntraPUsInInterSlices                      ( m_bDisableIntraPUsInInterSlices );
-  m_cTEncTop.setMotionEstimationSearchMethod                      ( m_motionEstimationSearchMethod  );
-  m_cTEncTop.setSearchRange                                       ( m_iSearchRange );
-  m_cTEncTop.setBipredSearchRange                                 ( m_bipredSearchRange );
-  m_cTEncTop.setClipForBiPredMeEnabled                            ( m_bClipForBiPredMeEnabled );
-  m_cTEncTop.setFastMEAssumingSmootherMVEnabled                   ( m_bFastMEAssumingSmootherMVEnabled );
-  m_cTEncTop.setMinSearchWindow                                   ( m_minSearchWindow );
-  m_cTEncTop.setRestrictMESampling                                ( m_bRestrictMESampling );
-
-  //====== Quality control ========
-  m_cTEncTop.setMaxDeltaQP                                        ( m_iMaxDeltaQP  );
-  m_cTEncTop.setMaxCuDQPDepth                                     ( m_iMaxCuDQPDepth  );
-  m_cTEncTop.setDiffCuChromaQpOffsetDepth                         ( m_diffCuChromaQpOffsetDepth );
-  m_cTEncTop.setChromaCbQpOffset                                  ( m_cbQpOffset     );
-  m_cTEncTop.setChromaCrQpOffset                                  ( m_crQpOffset  );
-#if W0038_CQP_ADJ
-  m_cTEncTop.setSliceChromaOffsetQpIntraOrPeriodic                ( m_sliceChromaQpOffsetPeriodicity, m_sliceChromaQpOffsetIntraOrPeriodic );
-#endif
-  m_cTEncTop.setChromaFormatIdc                                   ( m_chromaFormatIDC  );
-
-#if ADAPTIVE_QP_SELECTION
-  m_cTEncTop.setUseAdaptQpSelect                                  ( m_bUseAdaptQpSelect   );
-#endif
-
-  m_cTEncTop.setUseAdaptiveQP                                     ( m_bUseAdaptiveQP  );
-  m_cTEncTop.setQPAdaptationRange                                 ( m_iQPAdaptationRange );
-  m_cTEncTop.setExtendedPrecisionProcessingFlag                   ( m_extendedPrecisionProcessingFlag );
-  m_cTEncTop.setHighPrecisionOffsetsEnabledFlag                   ( m_highPrecisionOffsetsEnabledFlag );
-
-  m_cTEncTop.setWeightedPredictionMethod( m_weightedPredictionMethod );
-
-  //====== Tool list ========
-  m_cTEncTop.setDeltaQpRD                                         ( m_uiDeltaQpRD  );
-  m_cTEncTop.setFastDeltaQp                                       ( m_bFastDeltaQP  );
-  m_cTEncTop.setUseASR                                            ( m_bUseASR      );
-  m_cTEncTop.setUseHADME                                          ( m_bUseHADME    );
-  m_cTEncTop.setdQPs                                              ( m_aidQP        );
-  m_cTEncTop.setUseRDOQ                                           ( m_useRDOQ     );
-  m_cTEncTop.setUseRDOQTS                                         ( m_useRDOQTS   );
-#if T0196_SELECTIVE_RDOQ
-  m_cTEncTop.setUseSelectiveRDOQ                                  ( m_useSelectiveRDOQ );
-#endif
-  m_cTEncTop.setRDpenalty                                         ( m_rdPenalty );
-  m_cTEncTop.setMaxCUWidth                                        ( m_uiMaxCUWidth );
-  m_cTEncTop.setMaxCUHeight                                       ( m_uiMaxCUHeight );
-  m_cTEncTop.setMaxTotalCUDepth                                   ( m_uiMaxTotalCUDepth );
-  m_cTEncTop.setLog2DiffMaxMinCodingBlockSize                     ( m_uiLog2DiffMaxMinCodingBlockSize );
-  m_cTEncTop.setQuadtreeTULog2MaxSize                             ( m_uiQuadtreeTULog2MaxSize );
-  m_cTEncTop.setQuadtreeTULog2MinSize                             ( m_uiQuadtreeTULog2MinSize );
-  m_cTEncTop.setQuadtreeTUMaxDepthInter                           ( m_uiQuadtreeTUMaxDepthInter );
-  m_cTEncTop.setQuadtreeTUMaxDepthIntra                           ( m_uiQuadtreeTUMaxDepthIntra );
-  m_cTEncTop.setFastInterSearchMode                               ( m_fastInterSearchMode );
-  m_cTEncTop.setUseEarlyCU                                        ( m_bUseEarlyCU  );
-  m_cTEncTop.setUseFastDecisionForMerge                           ( m_useFastDecisionForMerge  );
-  m_cTEncTop.setUseCbfFastMode                                    ( m_bUseCbfFastMode  );
-  m_cTEncTop.setUseEarlySkipDetection                             ( m_useEarlySkipDetection );
-  m_cTEncTop.setCrossComponentPredictionEnabledFlag               ( m_crossComponentPredictionEnabledFlag );
-  m_cTEncTop.setUseReconBasedCrossCPredictionEstimate             ( m_reconBasedCrossCPredictionEstimate );
-  m_cTEncTop.setLog2SaoOffsetScale                                ( CHANNEL_TYPE_LUMA  , m_log2SaoOffsetScale[CHANNEL_TYPE_LUMA]   );
-  m_cTEncTop.setLog2SaoOffsetScale                                ( CHANNEL_TYPE_CHROMA, m_log2SaoOffsetScale[CHANNEL_TYPE_CHROMA] );
-  m_cTEncTop.setUseTransformSkip                                  ( m_useTransformSkip      );
-  m_cTEncTop.setUseTransformSkipFast                              ( m_useTransformSkipFast  );
-  m_cTEncTop.setTransformSkipRotationEnabledFlag                  ( m_transformSkipRotationEnabledFlag );
-  m_cTEncTop.setTransformSkipContextEnabledFlag                   ( m_transformSkipContextEnabledFlag   );
-  m_cTEncTop.setPersistentRiceAdaptationEnabledFlag               ( m_persistentRiceAdaptationEnabledFlag );
-  m_cTEncTop.setCabacBypassAlignmentEnabledFlag                   ( m_cabacBypassAlignmentEnabledFlag );
-  m_cTEncTop.setLog2MaxTransformSkipBlockSize                     ( m_log2MaxTransformSkipBlockSize  );
-  for (UInt signallingModeIndex = 0; signallingModeIndex < NUMBER_OF_RDPCM_SIGNALLING_MODES; signallingModeIndex++)
-  {
-    m_cTEncTop.setRdpcmEnabledFlag                                ( RDPCMSignallingMode(signallingModeIndex), m_rdpcmEnabledFlag[signallingModeIndex]);
-  }
-  m_cTEncTop.setUseConstrainedIntraPred                           ( m_bUseConstrainedIntraPred );
-  m_cTEncTop.setFastUDIUseMPMEnabled                              ( m_bFastUDIUseMPMEnabled );
-  m_cTEncTop.setFastMEForGenBLowDelayEnabled                      ( m_bFastMEForGenBLowDelayEnabled );
-  m_cTEncTop.setUseBLambdaForNonKeyLowDelayPictures               ( m_bUseBLambdaForNonKeyLowDelayPictures );
-  m_cTEncTop.setPCMLog2MinSize                                    ( m_uiPCMLog2MinSize);
-  m_cTEncTop.setUsePCM                                            ( m_usePCM );
-
-  // set internal bit-depth and constants
-  for (UInt channelType = 0; channelType < MAX_NUM_CHANNEL_TYPE; channelType++)
-  {
-    m_cTEncTop.setBitDepth((ChannelType)channelType, m_internalBitDepth[channelType]);
-    m_cTEncTop.setPCMBitDepth((ChannelType)channelType, m_bPCMInputBitDepthFlag ? m_MSBExtendedBitDepth[channelType] : m_internalBitDepth[channelType]);
-  }
-
-  m_cTEncTop.setPCMLog2MaxSize                                    ( m_pcmLog2MaxSize);
-  m_cTEncTop.setMaxNumMergeCand                                   ( m_maxNumMergeCand );
-
-
-  //====== Weighted Prediction ========
-  m_cTEncTop.setUseWP                                             ( m_useWeightedPred     );
-  m_cTEncTop.setWPBiPred                                          ( m_useWeightedBiPred   );
-
-  //====== Parallel Merge Estimation ========
-  m_cTEncTop.setLog2ParallelMergeLevelMinus2                      ( m_log2ParallelMergeLevel - 2 );
-
-  //====== Slice ========
-  m_cTEncTop.setSliceMode                                         ( m_sliceMode );
-  m_cTEncTop.setSliceArgument                                     ( m_sliceArgument );
-
-  //====== Dependent Slice ========
-  m_cTEncTop.setSliceSegmentMode                                  ( m_sliceSegmentMode );
-  m_cTEncTop.setSliceSegmentArgument                              ( m_sliceSegmentArgument );
-
-  if(m_sliceMode == NO_SLICES )
-  {
-    m_bLFCrossSliceBoundaryFlag = true;
-  }
-  m_cTEncTop.setLFCrossSliceBoundaryFlag                          ( m_bLFCrossSliceBoundaryFlag );
-  m_cTEncTop.setUseSAO                                            ( m_bUseSAO );
-  m_cTEncTop.setTestSAODisableAtPictureLevel                      ( m_bTestSAODisableAtPictureLevel );
-  m_cTEncTop.setSaoEncodingRate                                   ( m_saoEncodingRate );
-  m_cTEncTop.setSaoEncodingRateChroma                             ( m_saoEncodingRateChroma );
-  m_cTEncTop.setMaxNumOffsetsPerPic                               ( m_maxNumOffsetsPerPic);
-
-  m_cTEncTop.setSaoCtuBoundary                                    ( m_saoCtuBoundary);
-#if OPTIONAL_RESET_SAO_ENCODING_AFTER_IRAP
-  m_cTEncTop.setSaoResetEncoderStateAfterIRAP                     ( m_saoResetEncoderStateAfterIRAP);
-#endif
-  m_cTEncTop.setPCMInputBitDepthFlag                              ( m_bPCMInputBitDepthFlag);
-  m_cTEncTop.setPCMFilterDisableFlag                              ( m_bPCMFilterDisableFlag);
-
-  m_cTEncTop.setIntraSmoothingDisabledFlag                        (!m_enableIntraReferenceSmoothing );
-  m_cTEncTop.setDecodedPictureHashSEIType                         ( m_decodedPictureHashSEIType );
-  m_cTEncTop.setRecoveryPointSEIEnabled                           ( m_recoveryPointSEIEnabled );
-  m_cTEncTop.setBufferingPeriodSEIEnabled                         ( m_bufferingPeriodSEIEnabled );
-  m_cTEncTop.setPictureTimingSEIEnabled                           ( m_pictureTimingSEIEnabled );
-  m_cTEncTop.setToneMappingInfoSEIEnabled                         ( m_toneMappingInfoSEIEnabled );
-  m_cTEncTop.setTMISEIToneMapId                                   ( m_toneMapId );
-  m_cTEncTop.setTMISEIToneMapCancelFlag                           ( m_toneMapCancelFlag );
-  m_cTEncTop.setTMISEIToneMapPersistenceFlag                      ( m_toneMapPersistenceFlag );
-  m_cTEncTop.setTMISEICodedDataBitDepth                           ( m_toneMapCodedDataBitDepth );
-  m_cTEncTop.setTMISEITargetBitDepth                              ( m_toneMapTargetBitDepth );
-  m_cTEncTop.setTMISEIModelID                                     ( m_toneMapModelId );
-  m_cTEncTop.setTMISEIMinValue                                    ( m_toneMapMinValue );
-  m_cTEncTop.setTMISEIMaxValue                                    ( m_toneMapMaxValue );
-  m_cTEncTop.setTMISEISigmoidMidpoint                             ( m_sigmoidMidpoint );
-  m_cTEncTop.setTMISEISigmoidWidth                                ( m_sigmoidWidth );
-  m_cTEncTop.setTMISEIStartOfCodedInterva                         ( m_startOfCodedInterval );
-  m_cTEncTop.setTMISEINumPivots                                   ( m_numPivots );
-  m_cTEncTop.setTMISEICodedPivotValue                             ( m_codedPivotValue );
-  m_cTEncTop.setTMISEITargetPivotValue                            ( m_targetPivotValue );
-  m_cTEncTop.setTMISEICameraIsoSpeedIdc                           ( m_cameraIsoSpeedIdc );
-  m_cTEncTop.setTMISEICameraIsoSpeedValue                         ( m_cameraIsoSpeedValue );
-  m_cTEncTop.setTMISEIExposureIndexIdc                            ( m_exposureIndexIdc );
-  m_cTEncTop.setTMISEIExposureIndexValue                          ( m_exposureIndexValue );
-  m_cTEncTop.setTMISEIExposureCompensationValueSignFlag           ( m_exposureCompensationValueSignFlag );
-  m_cTEncTop.setTMISEIExposureCompensationValueNumerator          ( m_exposureCompensationValueNumerator );
-  m_cTEncTop.setTMISEIExposureCompensationValueDenomIdc           ( m_exposureCompensationValueDenomIdc );
-  m_cTEncTop.setTMISEIRefScreenLuminanceWhite                     ( m_refScreenLuminanceWhite );
-  m_cTEncTop.setTMISEIExtendedRangeWhiteLevel                     ( m_extendedRangeWhiteLevel );
-  m_cTEncTop.setTMISEINominalBlackLevelLumaCodeValue              ( m_nominalBlackLevelLumaCodeValue );
-  m_cTEncTop.setTMISEINominalWhiteLevelLumaCodeValue              ( m_nominalWhiteLevelLumaCodeValue );
-  m_cTEncTop.setTMISEIExtendedWhiteLevelLumaCodeValue             ( m_extendedWhiteLevelLumaCodeValue );
-  m_cTEncTop.setChromaResamplingFilterHintEnabled                 ( m_chromaResamplingFilterSEIenabled );
-  m_cTEncTop.setChromaResamplingHorFilterIdc                      ( m_chromaResamplingHorFilterIdc );
-  m_cTEncTop.setChromaResamplingVerFilterIdc                      ( m_chromaResamplingVerFilterIdc );
-  m_cTEncTop.setFramePackingArrangementSEIEnabled                 ( m_framePackingSEIEnabled );
-  m_cTEncTop.setFramePackingArrangementSEIType                    ( m_framePackingSEIType );
-  m_cTEncTop.setFramePackingArrangementSEIId                      ( m_framePackingSEIId );
-  m_cTEncTop.setFramePackingArrangementSEIQuincunx                ( m_framePackingSEIQuincunx );
-  m_cTEncTop.setFramePackingArrangementSEIInterpretation          ( m_framePackingSEIInterpretation );
-  m_cTEncTop.setSegmentedRectFramePackingArrangementSEIEnabled    ( m_segmentedRectFramePackingSEIEnabled );
-  m_cTEncTop.setSegmentedRectFramePackingArrangementSEICancel     ( m_segmentedRectFramePackingSEICancel );
-  m_cTEncTop.setSegmentedRectFramePackingArrangementSEIType       ( m_segmentedRectFramePackingSEIType );
-  m_cTEncTop.setSegmentedRectFramePackingArrangementSEIPersistence( m_segmentedRectFramePackingSEIPersistence );
-  m_cTEncTop.setDisplayOrientationSEIAngle                        ( m_displayOrientationSEIAngle );
-  m_cTEncTop.setTemporalLevel0IndexSEIEnabled                     ( m_temporalLevel0IndexSEIEnabled );
-  m_cTEncTop.setGradualDecodingRefreshInfoEnabled                 ( m_gradualDecodingRefreshInfoEnabled );
-  m_cTEncTop.setNoDisplaySEITLayer                                ( m_noDisplaySEITLayer );
-  m_cTEncTop.setDecodingUnitInfoSEIEnabled                        ( m_decodingUnitInfoSEIEnabled );
-  m_cTEncTop.setSOPDescriptionSEIEnabled                          ( m_SOPDescriptionSEIEnabled );
-  m_cTEncTop.setScalableNestingSEIEnabled                         ( m_scalableNestingSEIEnabled );
-  m_cTEncTop.setTMCTSSEIEnabled                                   ( m_tmctsSEIEnabled );
-  m_cTEncTop.setTimeCodeSEIEnabled                                ( m_timeCodeSEIEnabled );
-  m_cTEncTop.setNumberOfTimeSets                                  ( m_timeCodeSEINumTs );
-  for(Int i = 0; i < m_timeCodeSEINumTs; i++)
-  {
-    m_cTEncTop.setTimeSet(m_timeSetArray[i], i);
-  }
-  m_cTEncTop.setKneeSEIEnabled                                    ( m_kneeSEIEnabled );
-  m_cTEncTop.setKneeSEIId                                         ( m_kneeSEIId );
-  m_cTEncTop.setKneeSEICancelFlag                                 ( m_kneeSEICancelFlag );
-  m_cTEncTop.setKneeSEIPersistenceFlag                            ( m_kneeSEIPersistenceFlag );
-  m_cTEncTop.setKneeSEIInputDrange                                ( m_kneeSEIInputDrange );
-  m_cTEncTop.setKneeSEIInputDispLuminance                         ( m_kneeSEIInputDispLuminance );
-  m_cTEncTop.setKneeSEIOutputDrange                               ( m_kneeSEIOutputDrange );
-  m_cTEncTop.setKneeSEIOutputDispLuminance                        ( m_kneeSEIOutputDispLuminance );
-  m_cTEncTop.setKneeSEINumKneePointsMinus1                        ( m_kneeSEINumKneePointsMinus1 );
-  m_cTEncTop.setKneeSEIInputKneePoint                             ( m_kneeSEIInputKneePoint );
-  m_cTEncTop.setKneeSEIOutputKneePoint                            ( m_kneeSEIOutputKneePoint );
-  m_cTEncTop.setColourRemapInfoSEIFileRoot                        ( m_colourRemapSEIFileRoot );
-  m_cTEncTop.setMasteringDisplaySEI                               ( m_masteringDisplay );
-#if U0033_ALTERNATIVE_TRANSFER_CHARACTERISTICS_SEI
-  m_cTEncTop.setSEIAlternativeTransferCharacteristicsSEIEnable    ( m_preferredTransferCharacteristics>=0     );
-  m_cTEncTop.setSEIPreferredTransferCharacteristics               ( UChar(m_preferredTransferCharacteristics) );
-#endif
-
-  m_cTEncTop.setTileUniformSpacingFlag                            ( m_tileUniformSpacingFlag );
-  m_cTEncTop.setNumColumnsMinus1                                  ( m_numTileColumnsMinus1 );
-  m_cTEncTop.setNumRowsMinus1                                     ( m_numTileRowsMinus1 );
-  if(!m_tileUniformSpacingFlag)
-  {
-    m_cTEncTop.setColumnWidth                                     ( m_tileColumnWidth );
-    m_cTEncTop.setRowHeight                                       ( m_tileRowHeight );
-  }
-  m_cTEncTop.xCheckGSParameters();
-  Int uiTilesCount = (m_numTileRowsMinus1+1) * (m_numTileColumnsMinus1+1);
-  if(uiTilesCount == 1)
-  {
-    m_bLFCrossTileBoundaryFlag = true;
-  }
-  m_cTEncTop.setLFCrossTileBoundaryFlag                           ( m_bLFCrossTileBoundaryFlag );
-  m_cTEncTop.setEntropyCodingSyncEnabledFlag                      ( m_entropyCodingSyncEnabledFlag );
-  m_cTEncTop.setTMVPModeId                                        ( m_TMVPModeId );
-  m_cTEncTop.setUseScalingListId                                  ( m_useScalingListId  );
-  m_cTEncTop.setScalingListFileName                               ( m_scalingListFileName );
-  m_cTEncTop.setSignHideFlag                                      ( m_signHideFlag);
-  m_cTEncTop.setUseRateCtrl                                       ( m_RCEnableRateControl );
-  m_cTEncTop.setTargetBitrate                                     ( m_RCTargetBitrate );
-  m_cTEncTop.setKeepHierBit                                       ( m_RCKeepHierarchicalBit );
-  m_cTEncTop.setLCULevelRC                                        ( m_RCLCULevelRC );
-  m_cTEncTop.setUseLCUSeparateModel                               ( m_RCUseLCUSeparateModel );
-  m_cTEncTop.setInitialQP                                         ( m_RCInitialQP );
-  m_cTEncTop.setForceIntraQP                                      ( m_RCForceIntraQP );
-#if U0132_TARGET_BITS_SATURATION
-  m_cTEncTop.setCpbSaturationEnabled                              ( m_RCCpbSaturationEnabled );
-  m_cTEncTop.setCpbSize                                           ( m_RCCpbSize );
-  m_cTEncTop.setInitialCpbFullness                                ( m_RCInitialCpbFullness );
-#endif
-  m_cTEncTop.setTransquantBypassEnableFlag                        ( m_TransquantBypassEnableFlag );
-  m_cTEncTop.setCUTransquantBypassFlagForceValue                  ( m_CUTransquantBypassFlagForce );
-  m_cTEncTop.setCostMode                                          ( m_costMode );
-  m_cTEncTop.setUseRecalculateQPAccordingToLambda                 ( m_recalculateQPAccordingToLambda );
-  m_cTEncTop.setUseStrongIntraSmoothing                           ( m_useStrongIntraSmoothing );
-  m_cTEncTop.setActiveParameterSetsSEIEnabled                     ( m_activeParameterSetsSEIEnabled );
-  m_cTEncTop.setVuiParametersPresentFlag                          ( m_vuiParametersPresentFlag );
-  m_cTEncTop.setAspectRatioInfoPresentFlag                        ( m_aspectRatioInfoPresentFlag);
-  m_cTEncTop.setAspectRatioIdc                                    ( m_aspectRatioIdc );
-  m_cTEncTop.setSarWidth                                          ( m_sarWidth );
-  m_cTEncTop.setSarHeight                                         ( m_sarHeight );
-  m_cTEncTop.setOverscanInfoPresentFlag                           ( m_overscanInfoPresentFlag );
-  m_cTEncTop.setOverscanAppropriateFlag                           ( m_overscanAppropriateFlag );
-  m_cTEncTop.setVideoSignalTypePresentFlag                        ( m_videoSignalTypePresentFlag );
-  m_cTEncTop.setVideoFormat                                       ( m_videoFormat );
-  m_cTEncTop.setVideoFullRangeFlag                                ( m_videoFullRangeFlag );
-  m_cTEncTop.setColourDescriptionPresentFlag                      ( m_colourDescriptionPresentFlag );
-  m_cTEncTop.setColourPrimaries                                   ( m_colourPrimaries );
-  m_cTEncTop.setTransferCharacteristics                           ( m_transferCharacteristics );
-  m_cTEncTop.setMatrixCoefficients                                ( m_matrixCoefficients );
-  m_cTEncTop.setChromaLocInfoPresentFlag                          ( m_chromaLocInfoPresentFlag );
-  m_cTEncTop.setChromaSampleLocTypeTopField                       ( m_chromaSampleLocTypeTopField );
-  m_cTEncTop.setChromaSampleLocTypeBottomField                    ( m_chromaSampleLocTypeBottomField );
-  m_cTEncTop.setNeutralChromaIndicationFlag                       ( m_neutralChromaIndicationFlag );
-  m_cTEncTop.setDefaultDisplayWindow                              ( m_defDispWinLeftOffset, m_defDispWinRightOffset, m_defDispWinTopOffset, m_defDispWinBottomOffset );
-  m_cTEncTop.setFrameFieldInfoPresentFlag                         ( m_frameFieldInfoPresentFlag );
-  m_cTEncTop.setPocProportionalToTimingFlag                       ( m_pocProportionalToTimingFlag );
-  m_cTEncTop.setNumTicksPocDiffOneMinus1                          ( m_numTicksPocDiffOneMinus1    );
-  m_cTEncTop.setBitstreamRestrictionFlag                          ( m_bitstreamRestrictionFlag );
-  m_cTEncTop.setTilesFixedStructureFlag                           ( m_tilesFixedStructureFlag );
-  m_cTEncTop.setMotionVectorsOverPicBoundariesFlag                ( m_motionVectorsOverPicBoundariesFlag );
-  m_cTEncTop.setMinSpatialSegmentationIdc                         ( m_minSpatialSegmentationIdc );
-  m_cTEncTop.setMaxBytesPerPicDenom                               ( m_maxBytesPerPicDenom );
-  m_cTEncTop.setMaxBitsPerMinCuDenom                              ( m_maxBitsPerMinCuDenom );
-  m_cTEncTop.setLog2MaxMvLengthHorizontal                         ( m_log2MaxMvLengthHorizontal );
-  m_cTEncTop.setLog2MaxMvLengthVertical                           ( m_log2MaxMvLengthVertical );
-  m_cTEncTop.setEfficientFieldIRAPEnabled                         ( m_bEfficientFieldIRAPEnabled );
-  m_cTEncTop.setHarmonizeGopFirstFieldCoupleEnabled               ( m_bHarmonizeGopFirstFieldCoupleEnabled );
-
-  m_cTEncTop.setSummaryOutFilename                                ( m_summaryOutFilename );
-  m_cTEncTop.setSummaryPicFilenameBase                            ( m_summaryPicFilenameBase );
-  m_cTEncTop.setSummaryVerboseness                                ( m_summaryVerboseness );
-}
-
 Void TAppEncTop::xCreateLib()
 {
   // Video I/O
@@ -432,25 +72,29 @@ Void TAppEncTop::xCreateLib()
   if (!m_reconFileName.empty())
   {
     m_cTVideoIOYuvReconFile.open(m_reconFileName, true, m_outputBitDepth, m_outputBitDepth, m_internalBitDepth);  // write mode
+    if (m_cTVideoIOYuvInputFile.isY4M())
+    {
+      const TVideoIOY4MHeader &inputHeader = m_cTVideoIOYuvInputFile.getY4MHeader();
+      m_cTVideoIOYuvReconFile.setY4MFrameRate(inputHeader.frameRateNum, inputHeader.frameRateDen * m_temporalSubsampleRatio);
+    }
+    else
+    {
+      m_cTVideoIOYuvReconFile.setY4MFrameRate(m_iFrameRate, m_temporalSubsampleRatio);
+    }
   }
 
   // Neo Decoder
-  m_cTEncTop.create();
+  m_cSession.open(*this);
 }
 
 Void TAppEncTop::xDestroyLib()
 {
+  // Neo Decoder
+  m_cSession.close();
+
   // Video I/O
   m_cTVideoIOYuvInputFile.close();
   m_cTVideoIOYuvReconFile.close();
-
-  // Neo Decoder
-  m_cTEncTop.destroy();
-}
-
-Void TAppEncTop::xInitLib(Bool isFieldCoding)
-{
-  m_cTEncTop.init(isFieldCoding);
 }
 
 // ====================================================================================================================
@@ -458,40 +102,49 @@ Void TAppEncTop::xInitLib(Bool isFieldCoding)
 // ====================================================================================================================
 
 /**
- - create internal class
- - initialize internal variable
- - until the end of input YUV file, call encoding function in TEncTop class
+ - open the files and the encoder session
+ - until the end of input YUV file, push the frames to the session and write its output
  - delete allocated buffers
- - destroy internal class
+ - close the encoder session and the files
  .
  */
 Void TAppEncTop::encode()
 {
-  fstream bitstreamFile(m_bitstreamFileName.c_str(), fstream::binary | fstream::out);
-  if (!bitstreamFile)
+  if (m_bitstreamFileName.empty())
+  {
+    fprintf(stderr, "\nA bitstream file name must be specified (BitstreamFile)\n");
+    exit(EXIT_FAILURE);
+  }
+  if (TVideoIOStdio::isStdio(m_bitstreamFileName) && TVideoIOStdio::isStdio(m_reconFileName))
+  {
+    fprintf(stderr, "\nBitstreamFile and ReconFile cannot both be the standard output\n");
+    exit(EXIT_FAILURE);
+  }
+
+  const Bool bStdoutBitstream = TVideoIOStdio::isStdio(m_bitstreamFileName);
+  fstream bitstreamFile;
+  if (!bStdoutBitstream)
+  {
+    bitstreamFile.open(m_bitstreamFileName.c_str(), fstream::binary | fstream::out);
+  }
+  std::ostream& bitstreamOut = bStdoutBitstream ? TVideoIOStdio::getOutput() : static_cast<std::ostream&>(bitstreamFile);
+  if (!bitstreamOut)
   {
     fprintf(stderr, "\nfailed to open bitstream file `%s' for writing\n", m_bitstreamFileName.c_str());
     exit(EXIT_FAILURE);
   }
 
   TComPicYuv*       pcPicYuvOrg = new TComPicYuv;
-  TComPicYuv*       pcPicYuvRec = NULL;
 
   // initialize internal class & member variables
-  xInitLibCfg();
   xCreateLib();
-  xInitLib(m_isField);
 
   printChromaFormat();
 
   // main encoder loop
-  Int   iNumEncoded = 0;
   Bool  bEos = false;
 
   const InputColourSpaceConversion ipCSC  =  m_inputColourSpaceConvert;
-  const InputColourSpaceConversion snrCSC = (!m_snrInternalColourSpace) ? m_inputColourSpaceConvert : IPCOLOURSPACE_UNCHANGED;
-
-  list<AccessUnit> outputAccessUnits; ///< list of access units to write out.  is populated by the encoding process
 
   TComPicYuv cPicYuvTrueOrg;
 
@@ -507,65 +160,76 @@ Void TAppEncTop::encode()
     cPicYuvTrueOrg.create(m_iSourceWidth, m_iSourceHeight, m_chromaFormatIDC, m_uiMaxCUWidth, m_uiMaxCUHeight, m_uiMaxTotalCUDepth, true );
   }
 
-  while ( !bEos )
+  if ( m_readAheadFrames > 0 )
   {
-    // get buffers
-    xGetBuffer(pcPicYuvRec);
-
-    // read input YUV file
-    m_cTVideoIOYuvInputFile.read( pcPicYuvOrg, &cPicYuvTrueOrg, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
-
-    // increase number of received frames
-    m_iFrameRcvd++;
-
-    bEos = (m_isField && (m_iFrameRcvd == (m_framesToBeEncoded >> 1) )) || ( !m_isField && (m_iFrameRcvd == m_framesToBeEncoded) );
+    xStartReadAhead( m_isField ? m_iSourceHeightOrg : m_iSourceHeight );
+  }
+  if ( m_writeBehindFrames > 0 )
+  {
+    m_outputThread.create( 1 );
+    m_outputProgress.init( 1 );
+  }
 
-    Bool flush = 0;
-    // if end of file (which is only detected on a read failure) flush the encoder of any queued pictures
-    if (m_cTVideoIOYuvInputFile.isEof())
+  while ( !bEos )
+  {
+    // read input YUV file, or take the frame read ahead
+    const Int   iFrameRcvd        = m_cSession.getNumFramesRcvd();
+    TComPicYuv* pcPicYuvOrgIn     = pcPicYuvOrg;
+    TComPicYuv* pcPicYuvTrueOrgIn = &cPicYuvTrueOrg;
+    Bool        bInputEof;
+    if ( m_readAheadFrames > 0 )
+    {
+      InputFrame* pcInputFrame = m_inputFrames[iFrameRcvd % m_readAheadFrames];
+      m_inputProgress.waitFor( 0, iFrameRcvd + 1 );
+      pcPicYuvOrgIn     = &pcInputFrame->cPicYuvOrg;
+      pcPicYuvTrueOrgIn = &pcInputFrame->cPicYuvTrueOrg;
+      bInputEof         = pcInputFrame->bEof;
+    }
+    else
     {
-      flush = true;
-      bEos = true;
-      m_iFrameRcvd--;
-      m_cTEncTop.setFramesToBeEncoded(m_iFrameRcvd);
+      m_cTVideoIOYuvInputFile.read( pcPicYuvOrg, &cPicYuvTrueOrg, ipCSC, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
+      bInputEof = m_cTVideoIOYuvInputFile.isEof();
     }
 
-    // call encoding function for one frame
-    if ( m_isField )
+    // if end of file (which is only detected on a read failure) flush the encoder of any queued pictures
+    if (bInputEof)
     {
-      m_cTEncTop.encode( bEos, flush ? 0 : pcPicYuvOrg, flush ? 0 : &cPicYuvTrueOrg, snrCSC, m_cListPicYuvRec, outputAccessUnits, iNumEncoded, m_isTopFieldFirst );
+      m_cSession.flush();
     }
     else
     {
-      m_cTEncTop.encode( bEos, flush ? 0 : pcPicYuvOrg, flush ? 0 : &cPicYuvTrueOrg, snrCSC, m_cListPicYuvRec, outputAccessUnits, iNumEncoded );
+      m_cSession.pushFrame( pcPicYuvOrgIn, pcPicYuvTrueOrgIn );
     }
+    bEos = m_cSession.isEos();
 
-    // write bistream to file if necessary
-    if ( iNumEncoded > 0 )
+    // the encoder has copied the frame, so its slot can take a later frame
+    if ( m_readAheadFrames > 0 && !bEos )
     {
-      xWriteOutput(bitstreamFile, iNumEncoded, outputAccessUnits);
-      outputAccessUnits.clear();
+      xQueueInputRead( iFrameRcvd + m_readAheadFrames );
     }
+
+    // write bistream to file if necessary
+    xWriteOutput(bitstreamOut);
     // temporally skip frames
-    if( m_temporalSubsampleRatio > 1 )
+    if( m_temporalSubsampleRatio > 1 && m_readAheadFrames == 0 )
     {
       m_cTVideoIOYuvInputFile.skipFrames(m_temporalSubsampleRatio-1, m_iSourceWidth - m_aiPad[0], m_iSourceHeight - m_aiPad[1], m_InputChromaFormatIDC);
     }
   }
 
-  m_cTEncTop.printSummary(m_isField);
+  xStopReadAhead();
+  xStopWriteBehind();
+  bitstreamOut.flush();
+
+  m_cSession.getTEncTop().printSummary(m_isField);
 
   // delete original YUV buffer
   pcPicYuvOrg->destroy();
   delete pcPicYuvOrg;
   pcPicYuvOrg = NULL;
-
-  // delete used buffers in encoder class
-  m_cTEncTop.deletePicBuffer();
   cPicYuvTrueOrg.destroy();
 
   // delete buffers & classes
-  xDeleteBuffer();
   xDestroyLib();
 
   printRateSummary();
@@ -578,163 +242,221 @@ Void TAppEncTop::encode()
 // ====================================================================================================================
 
 /**
- - application has picture buffer list with size of GOP
- - picture buffer list acts as ring buffer
- - end of the list has the latest picture
+ - create ReadAheadFrames input slots of the size of the original picture buffer
+ - start the input thread on the first frames
  .
  */
-Void TAppEncTop::xGetBuffer( TComPicYuv*& rpcPicYuvRec)
+Void TAppEncTop::xStartReadAhead( Int sourceHeight )
 {
-  assert( m_iGOPSize > 0 );
-
-  // org. buffer
-  if ( m_cListPicYuvRec.size() >= (UInt)m_iGOPSize ) // buffer will be 1 element longer when using field coding, to maintain first field whilst processing second.
+  m_inputFrames.resize( m_readAheadFrames );
+  for ( Int i = 0; i < m_readAheadFrames; i++ )
   {
-    rpcPicYuvRec = m_cListPicYuvRec.popFront();
-
+    m_inputFrames[i] = new InputFrame;
+    m_inputFrames[i]->cPicYuvOrg.create    ( m_iSourceWidth, sourceHeight, m_chromaFormatIDC, m_uiMaxCUWidth, m_uiMaxCUHeight, m_uiMaxTotalCUDepth, true );
+    m_inputFrames[i]->cPicYuvTrueOrg.create( m_iSourceWidth, sourceHeight, m_chromaFormatIDC, m_uiMaxCUWidth, m_uiMaxCUHeight, m_uiMaxTotalCUDepth, true );
+    m_inputFrames[i]->bEof = false;
   }
-  else
-  {
-    rpcPicYuvRec = new TComPicYuv;
-
-    rpcPicYuvRec->create( m_iSourceWidth, m_iSourceHeight, m_chromaFormatIDC, m_uiMaxCUWidth, m_uiMaxCUHeight, m_uiMaxTotalCUDepth, true );
 
+  m_inputProgress.init( 1 );
+  m_inputThread.create( 1 );
+  for ( Int i = 0; i < m_readAheadFrames; i++ )
+  {
+    xQueueInputRead( i );
   }
-  m_cListPicYuvRec.pushBack( rpcPicYuvRec );
 }
 
-Void TAppEncTop::xDeleteBuffer( )
+/**
+ - queue the read of frame frameIdx into slot frameIdx % ReadAheadFrames, which the encoder must have released
+ - the input thread runs the reads in order, each followed by the temporal subsampling skip
+ .
+ */
+Void TAppEncTop::xQueueInputRead( Int frameIdx )
 {
-  TComList<TComPicYuv*>::iterator iterPicYuvRec  = m_cListPicYuvRec.begin();
+  const Int numFramesToRead = m_isField ? (m_framesToBeEncoded >> 1) : m_framesToBeEncoded;
+  if ( numFramesToRead > 0 && frameIdx >= numFramesToRead )
+  {
+    return;
+  }
+
+  InputFrame* pcInputFrame = m_inputFrames[frameIdx % m_readAheadFrames];
+  m_inputThread.addTask( [this, pcInputFrame, frameIdx]( Int )
+  {
+    m_cTVideoIOYuvInputFile.read( &pcInputFrame->cPicYuvOrg, &pcInputFrame->cPicYuvTrueOrg, m_inputColourSpaceConvert, m_aiPad, m_InputChromaFormatIDC, m_bClipInputVideoToRec709Range );
+    pcInputFrame->bEof = m_cTVideoIOYuvInputFile.isEof();
+    if ( m_temporalSubsampleRatio > 1 )
+    {
+      m_cTVideoIOYuvInputFile.skipFrames( m_temporalSubsampleRatio-1, m_iSourceWidth - m_aiPad[0], m_iSourceHeight - m_aiPad[1], m_InputChromaFormatIDC );
+    }
+    m_inputProgress.set( 0, frameIdx + 1 );
+  } );
+}
 
-  Int iSize = Int( m_cListPicYuvRec.size() );
+Void TAppEncTop::xStopReadAhead()
+{
+  m_inputThread.waitForAllTasks();
+  m_inputThread.destroy();
 
-  for ( Int i = 0; i < iSize; i++ )
+  for ( UInt i = 0; i < m_inputFrames.size(); i++ )
   {
-    TComPicYuv*  pcPicYuvRec  = *(iterPicYuvRec++);
-    pcPicYuvRec->destroy();
-    delete pcPicYuvRec; pcPicYuvRec = NULL;
+    m_inputFrames[i]->cPicYuvOrg.destroy();
+    m_inputFrames[i]->cPicYuvTrueOrg.destroy();
+    delete m_inputFrames[i];
   }
-
+  m_inputFrames.clear();
 }
 
-/** 
-  Write access units to output file.
+/**
+  Write the reconstructed pictures and the access units output by the session to the files.
   \param bitstreamFile  target bitstream file
-  \param iNumEncoded    number of encoded frames
-  \param accessUnits    list of access units to be written
  */
-Void TAppEncTop::xWriteOutput(std::ostream& bitstreamFile, Int iNumEncoded, const std::list<AccessUnit>& accessUnits)
+Void TAppEncTop::xWriteOutput(std::ostream& bitstreamFile)
 {
   const InputColourSpaceConversion ipCSC = (!m_outputInternalColourSpace) ? m_inputColourSpaceConvert : IPCOLOURSPACE_UNCHANGED;
+  std::string accessUnitBytes;
 
   if (m_isField)
   {
     //Reinterlace fields
-    Int i;
-    TComList<TComPicYuv*>::iterator iterPicYuvRec = m_cListPicYuvRec.end();
-    list<AccessUnit>::const_iterator iterBitstream = accessUnits.begin();
-
-    for ( i = 0; i < iNumEncoded; i++ )
-    {
-      --iterPicYuvRec;
-    }
+    TComPicYuv*  pcPicYuvRecTop;
+    TComPicYuv*  pcPicYuvRecBottom;
 
-    for ( i = 0; i < iNumEncoded/2; i++ )
+    while ( m_cSession.getReconstruction(pcPicYuvRecTop) && m_cSession.getReconstruction(pcPicYuvRecBottom) )
     {
-      TComPicYuv*  pcPicYuvRecTop  = *(iterPicYuvRec++);
-      TComPicYuv*  pcPicYuvRecBottom  = *(iterPicYuvRec++);
+      if (m_writeBehindFrames > 0)
+      {
+        xQueueOutput(bitstreamFile, pcPicYuvRecTop, pcPicYuvRecBottom, 2);
+        continue;
+      }
 
       if (!m_reconFileName.empty())
       {
         m_cTVideoIOYuvReconFile.write( pcPicYuvRecTop, pcPicYuvRecBottom, ipCSC, m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom, NUM_CHROMA_FORMAT, m_isTopFieldFirst );
       }
 
-      const AccessUnit& auTop = *(iterBitstream++);
-      const vector<UInt>& statsTop = writeAnnexB(bitstreamFile, auTop);
-      rateStatsAccum(auTop, statsTop);
-
-      const AccessUnit& auBottom = *(iterBitstream++);
-      const vector<UInt>& statsBottom = writeAnnexB(bitstreamFile, auBottom);
-      rateStatsAccum(auBottom, statsBottom);
+      for ( Int i = 0; i < 2 && m_cSession.getAccessUnit(accessUnitBytes); i++ )
+      {
+        bitstreamFile.write( accessUnitBytes.data(), streamsize( accessUnitBytes.size() ) );
+      }
     }
   }
   else
   {
-    Int i;
-
-    TComList<TComPicYuv*>::iterator iterPicYuvRec = m_cListPicYuvRec.end();
-    list<AccessUnit>::const_iterator iterBitstream = accessUnits.begin();
+    TComPicYuv*  pcPicYuvRec;
 
-    for ( i = 0; i < iNumEncoded; i++ )
+    while ( m_cSession.getReconstruction(pcPicYuvRec) )
     {
-      --iterPicYuvRec;
-    }
+      if (m_writeBehindFrames > 0)
+      {
+        xQueueOutput(bitstreamFile, pcPicYuvRec, NULL, 1);
+        continue;
+      }
 
-    for ( i = 0; i < iNumEncoded; i++ )
-    {
-      TComPicYuv*  pcPicYuvRec  = *(iterPicYuvRec++);
       if (!m_reconFileName.empty())
       {
         m_cTVideoIOYuvReconFile.write( pcPicYuvRec, ipCSC, m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom,
             NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range  );
       }
 
-      const AccessUnit& au = *(iterBitstream++);
-      const vector<UInt>& stats = writeAnnexB(bitstreamFile, au);
-      rateStatsAccum(au, stats);
+      if ( m_cSession.getAccessUnit(accessUnitBytes) )
+      {
+        bitstreamFile.write( accessUnitBytes.data(), streamsize( accessUnitBytes.size() ) );
+      }
     }
   }
 }
 
 /**
- *
+  Pass one output picture, or field pair, to the output thread.
+  The reconstruction is copied to a write-behind slot, as the encoder reuses its buffer, and the next access units
+  of the session are moved to the slot; the output thread then writes both to the files.
+  \param bitstreamFile      target bitstream file
+  \param pcPicYuvRecTop     reconstructed picture, or top field
+  \param pcPicYuvRecBottom  bottom field, or NULL for a frame
+  \param numAccessUnits     number of access units to write
  */
-Void TAppEncTop::rateStatsAccum(const AccessUnit& au, const std::vector<UInt>& annexBsizes)
+Void TAppEncTop::xQueueOutput( std::ostream& bitstreamFile, TComPicYuv* pcPicYuvRecTop, TComPicYuv* pcPicYuvRecBottom,
+                               Int numAccessUnits )
 {
-  AccessUnit::const_iterator it_au = au.begin();
-  vector<UInt>::const_iterator it_stats = annexBsizes.begin();
+  if ( m_outputBytes.empty() )
+  {
+    m_outputBytes.resize( m_writeBehindFrames );
+    m_outputRecons.resize( 2 * m_writeBehindFrames, NULL );
+  }
+
+  // wait until the slot has been written out
+  const Int slot = m_numOutputQueued % m_writeBehindFrames;
+  m_outputProgress.waitFor( 0, m_numOutputQueued - m_writeBehindFrames + 1 );
+
+  TComPicYuv* apcRecons[2] = { pcPicYuvRecTop, pcPicYuvRecBottom };
+  for ( Int field = 0; field < 2 && !m_reconFileName.empty(); field++ )
+  {
+    if ( apcRecons[field] != NULL )
+    {
+      TComPicYuv*& rpcSlotRecon = m_outputRecons[2 * slot + field];
+      if ( rpcSlotRecon == NULL )
+      {
+        rpcSlotRecon = new TComPicYuv;
+        rpcSlotRecon->create( m_iSourceWidth, m_iSourceHeight, m_chromaFormatIDC, m_uiMaxCUWidth, m_uiMaxCUHeight, m_uiMaxTotalCUDepth, true );
+      }
+      apcRecons[field]->copyToPic( rpcSlotRecon );
+    }
+  }
+
+  std::string accessUnitBytes;
+  m_outputBytes[slot].clear();
+  for ( Int i = 0; i < numAccessUnits && m_cSession.getAccessUnit(accessUnitBytes); i++ )
+  {
+    m_outputBytes[slot] += accessUnitBytes;
+  }
 
-  for (; it_au != au.end(); it_au++, it_stats++)
+  const Int  outputIdx = m_numOutputQueued++;
+  const Bool isFieldPair = pcPicYuvRecBottom != NULL;
+  m_outputThread.addTask( [this, &bitstreamFile, slot, outputIdx, isFieldPair]( Int )
   {
-    switch ((*it_au)->m_nalUnitType)
+    const InputColourSpaceConversion ipCSC = (!m_outputInternalColourSpace) ? m_inputColourSpaceConvert : IPCOLOURSPACE_UNCHANGED;
+    if ( !m_reconFileName.empty() )
     {
-    case NAL_UNIT_CODED_SLICE_TRAIL_R:
-    case NAL_UNIT_CODED_SLICE_TRAIL_N:
-    case NAL_UNIT_CODED_SLICE_TSA_R:
-    case NAL_UNIT_CODED_SLICE_TSA_N:
-    case NAL_UNIT_CODED_SLICE_STSA_R:
-    case NAL_UNIT_CODED_SLICE_STSA_N:
-    case NAL_UNIT_CODED_SLICE_BLA_W_LP:
-    case NAL_UNIT_CODED_SLICE_BLA_W_RADL:
-    case NAL_UNIT_CODED_SLICE_BLA_N_LP:
-    case NAL_UNIT_CODED_SLICE_IDR_W_RADL:
-    case NAL_UNIT_CODED_SLICE_IDR_N_LP:
-    case NAL_UNIT_CODED_SLICE_CRA:
-    case NAL_UNIT_CODED_SLICE_RADL_N:
-    case NAL_UNIT_CODED_SLICE_RADL_R:
-    case NAL_UNIT_CODED_SLICE_RASL_N:
-    case NAL_UNIT_CODED_SLICE_RASL_R:
-    case NAL_UNIT_VPS:
-    case NAL_UNIT_SPS:
-    case NAL_UNIT_PPS:
-      m_essentialBytes += *it_stats;
-      break;
-    default:
-      break;
+      if ( isFieldPair )
+      {
+        m_cTVideoIOYuvReconFile.write( m_outputRecons[2 * slot], m_outputRecons[2 * slot + 1], ipCSC, m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom, NUM_CHROMA_FORMAT, m_isTopFieldFirst );
+      }
+      else
+      {
+        m_cTVideoIOYuvReconFile.write( m_outputRecons[2 * slot], ipCSC, m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom,
+            NUM_CHROMA_FORMAT, m_bClipOutputVideoToRec709Range );
+      }
     }
+    bitstreamFile.write( m_outputBytes[slot].data(), streamsize( m_outputBytes[slot].size() ) );
+    m_outputProgress.set( 0, outputIdx + 1 );
+  } );
+}
+
+Void TAppEncTop::xStopWriteBehind()
+{
+  m_outputThread.waitForAllTasks();
+  m_outputThread.destroy();
 
-    m_totalBytes += *it_stats;
+  for ( UInt i = 0; i < m_outputRecons.size(); i++ )
+  {
+    if ( m_outputRecons[i] != NULL )
+    {
+      m_outputRecons[i]->destroy();
+      delete m_outputRecons[i];
+    }
   }
+  m_outputRecons.clear();
+  m_outputBytes.clear();
 }
 
 Void TAppEncTop::printRateSummary()
 {
-  Double time = (Double) m_iFrameRcvd / m_iFrameRate * m_temporalSubsampleRatio;
-  printf("Bytes written to file: %u (%.3f kbps)\n", m_totalBytes, 0.008 * m_totalBytes / time);
+  const UInt totalBytes     = m_cSession.getTotalBytes();
+  const UInt essentialBytes = m_cSession.getEssentialBytes();
+  Double time = (Double) m_cSession.getNumFramesRcvd() / m_iFrameRate * m_temporalSubsampleRatio;
+  printf("Bytes written to file: %u (%.3f kbps)\n", totalBytes, 0.008 * totalBytes / time);
   if (m_summaryVerboseness > 0)
   {
-    printf("Bytes for SPS/PPS/Slice (Incl. Annex B): %u (%.3f kbps)\n", m_essentialBytes, 0.008 * m_essentialBytes / time);
+    printf("Bytes for SPS/PPS/Slice (Incl. Annex B): %u (%.3f kbps)\n", essentialBytes, 0.008 * essentialBytes / time);
   }
 }
 
@@ -754,7 +476,7 @@ Void TAppEncTop::printChromaFormat()
   std::cout << std::endl;
 
   std::cout << std::setw(43) << "Output (internal) ChromaFormatIDC = ";
-  switch (m_cTEncTop.getChromaFormatIdc())
+  switch (m_cSession.getTEncTop().getChromaFormatIdc())
   {
   case CHROMA_400:  std::cout << "  4:0:0"; break;
   case CHROMA_420:  std::cout << "  4:2:0"; break;
@@ -38,13 +38,14 @@
 #ifndef __TAPPENCTOP__
 #define __TAPPENCTOP__
 
-#include <list>
 #include <ostream>
+#include <string>
+#include <vector>
 
-#include "TLibEncoder/TEncTop.h"
+#include "TLibCommon/TComThreadPool.h"
 #include "TLibVideoIO/TVideoIOYuv.h"
-#include "TLibCommon/AccessUnit.h"
-#include "TAppEncCfg.h"
+#include "TAppEncoderLib/TAppEncCfg.h"
+#include "TAppEncoderLib/TAppEncSession.h"
 
 //! \ingroup TAppEncoder
 //! \{
@@ -53,38 +54,47 @@
 // Class definition
 // ====================================================================================================================
 
-/// encoder application class
+/// encoder application class, which reads and writes the files of an encoder session
 class TAppEncTop : public TAppEncCfg
 {
 private:
   // class interface
-  TEncTop                    m_cTEncTop;                    ///< encoder class
+  TAppEncSession             m_cSession;                    ///< encoder session
   TVideoIOYuv                m_cTVideoIOYuvInputFile;       ///< input YUV file
   TVideoIOYuv                m_cTVideoIOYuvReconFile;       ///< output reconstruction file
 
-  TComList<TComPicYuv*>      m_cListPicYuvRec;              ///< list of reconstruction YUV files
-
-  Int                        m_iFrameRcvd;                  ///< number of received frames
-
-  UInt m_essentialBytes;
-  UInt m_totalBytes;
+  /// input frame read ahead of the encoder
+  class InputFrame
+  {
+  public:
+    TComPicYuv  cPicYuvOrg;
+    TComPicYuv  cPicYuvTrueOrg;
+    Bool        bEof;                                       ///< the read of the frame reached the end of the input file
+  };
+
+  TComThreadPool             m_inputThread;                 ///< reads input frames when ReadAheadFrames > 0
+  std::vector<InputFrame*>   m_inputFrames;                 ///< read-ahead slots, frame n goes to slot n % ReadAheadFrames
+  TComRowProgress            m_inputProgress;               ///< number of input frames read
+
+  TComThreadPool             m_outputThread;                ///< writes reconstructed pictures and access units when WriteBehindFrames > 0
+  std::vector<TComPicYuv*>   m_outputRecons;                ///< write-behind slots, two pictures per slot for field pairs
+  std::vector<std::string>   m_outputBytes;                 ///< Annex B bytes of the access units of each write-behind slot
+  TComRowProgress            m_outputProgress;              ///< number of output slots written
+  Int                        m_numOutputQueued;             ///< number of output slots passed to the output thread
 
 protected:
   // initialization
-  Void  xCreateLib        ();                               ///< create files & encoder class
-  Void  xInitLibCfg       ();                               ///< initialize internal variables
-  Void  xInitLib          (Bool isFieldCoding);             ///< initialize encoder class
-  Void  xDestroyLib       ();                               ///< destroy encoder class
-
-  /// obtain required buffers
-  Void xGetBuffer(TComPicYuv*& rpcPicYuvRec);
-
-  /// delete allocated buffers
-  Void  xDeleteBuffer     ();
+  Void  xCreateLib        ();                               ///< open files & encoder session
+  Void  xDestroyLib       ();                               ///< close encoder session & files
 
   // file I/O
-  Void xWriteOutput(std::ostream& bitstreamFile, Int iNumEncoded, const std::list<AccessUnit>& accessUnits); ///< write bitstream to file
-  Void rateStatsAccum(const AccessUnit& au, const std::vector<UInt>& stats);
+  Void xStartReadAhead    ( Int sourceHeight );             ///< create the read-ahead slots and queue the first reads
+  Void xQueueInputRead    ( Int frameIdx );                 ///< queue the read of an input frame into its slot
+  Void xStopReadAhead     ();                               ///< wait for the queued reads and free the slots
+  Void xWriteOutput(std::ostream& bitstreamFile);          ///< write the output of the session to the files
+  Void xQueueOutput       ( std::ostream& bitstreamFile, TComPicYuv* pcPicYuvRecTop, TComPicYuv* pcPicYuvRecBottom,
+                            Int numAccessUnits );           ///< pass one output picture or field pair to the output thread
+  Void xStopWriteBehind   ();                               ///< wait for the queued writes and free the slots
   Void printRateSummary();
   Void printChromaFormat();
 
@@ -93,7 +103,7 @@ public:
   virtual ~TAppEncTop();
 
   Void        encode      ();                               ///< main encoding function
-  TEncTop&    getTEncTop  ()   { return  m_cTEncTop; }      ///< return encoder class pointer reference
+  TEncTop&    getTEncTop  ()   { return  m_cSession.getTEncTop(); } ///< return encoder class pointer reference
 
 };// END CLASS DEFINITION TAppEncTop
 
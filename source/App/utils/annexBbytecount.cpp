@@ -130,12 +130,13 @@ int main(int argc, char*argv[])
   unsigned numNALUnits = 0;
 
   cout << "NALUnits:" << endl;
-  while (!!in)
+  bool eof = false;
+  while (!eof)
   {
     AnnexBStats annexBStatsSingle = AnnexBStats();
     vector<uint8_t> nalUnit;
 
-    byteStreamNALUnit(bs, nalUnit, annexBStatsSingle);
+    eof = byteStreamNALUnit(bs, nalUnit, annexBStatsSingle);
 
     int nal_unit_type = -1;
     if (annexBStatsSingle.m_numBytesInNALUnit)
@@ -0,0 +1,107 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2016, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "TLibDecoder/NALindex.h"
+
+using namespace std;
+
+/**
+ * Build the NAL unit index of a byte stream and write it next to it, for
+ * the decoder options NalIndexFile, StartIRAP, Segment and NumSegments.
+ *
+ * usage: nalIndex <bitstream> [<index file> [<number of segments>]]
+ */
+int main(int argc, char*argv[])
+{
+  if (argc < 2 || argc > 4)
+  {
+    cerr << "usage: " << argv[0] << " <bitstream> [<index file> [<number of segments>]]" << endl
+         << "  writes the NAL unit index of the bitstream to the index file (default: <bitstream>.nalidx)" << endl
+         << "  and lists its random access points and the segments it splits into" << endl;
+    return 1;
+  }
+
+  const string bitstreamFileName = argv[1];
+  const string indexFileName     = argc > 2 ? string(argv[2]) : bitstreamFileName + ".nalidx";
+  const int    numSegments       = argc > 3 ? atoi(argv[3]) : 1;
+  if (numSegments < 1)
+  {
+    cerr << "the number of segments must be at least 1" << endl;
+    return 1;
+  }
+
+  ifstream in(bitstreamFileName.c_str(), ifstream::in | ifstream::binary);
+  if (!in)
+  {
+    cerr << "failed to open bitstream file `" << bitstreamFileName << "' for reading" << endl;
+    return 1;
+  }
+
+  NALIndex index;
+  index.build(in);
+  if (!index.write(indexFileName))
+  {
+    cerr << "failed to write the index file `" << indexFileName << "'" << endl;
+    return 1;
+  }
+
+  const vector<NALIndexEntry>&             entries            = index.getEntries();
+  const vector<NALIndexRandomAccessPoint>& randomAccessPoints = index.getRandomAccessPoints();
+  cout << "Bytes: " << index.getStreamSize() << ", NAL units: " << entries.size() << ", random access points: " << randomAccessPoints.size() << endl;
+
+  cout << "Random access points (StartIRAP):" << endl;
+  for (size_t rap = 0; rap < randomAccessPoints.size(); rap++)
+  {
+    const NALIndexEntry &entry = entries[randomAccessPoints[rap].m_entry];
+    cout << "  " << rap << ": offset " << index.getOffset(randomAccessPoints[rap].m_accessUnitStart)
+         << ", nal_unit_type " << entry.m_nalUnitType << ", POC " << entry.m_poc
+         << (randomAccessPoints[rap].m_clean ? "" : ", has RASL pictures or discards prior pictures") << endl;
+  }
+
+  cout << "Segments (Segment, NumSegments=" << numSegments << "):" << endl;
+  for (int segment = 0; segment < numSegments; segment++)
+  {
+    size_t firstEntry;
+    size_t endEntry;
+    index.getSegment(segment, numSegments, firstEntry, endEntry);
+    cout << "  " << segment << ": bytes " << index.getOffset(firstEntry) << " to " << index.getOffset(endEntry)
+         << (firstEntry == endEntry ? " (empty)" : "") << endl;
+  }
+
+  return 0;
+}
@@ -45,6 +45,8 @@
 #include "TAppEncCfg.h"
 #include "TAppCommon/program_options_lite.h"
 #include "TLibEncoder/TEncRateCtrl.h"
+#include "TLibVideoIO/TVideoIOStdio.h"
+#include "TLibVideoIO/TVideoIOYuv.h"
 #ifdef WIN32
 #define strdup _strdup
 #endif
@@ -94,7 +96,7 @@ enum ExtendedProfileName // this is used for determining profile strings, where
 };
 
 
-//! \ingroup TAppEncoder
+//! \ingroup TAppEncoderLib
 //! \{
 
 // ====================================================================================================================
@@ -660,9 +662,9 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("WarnUnknowParameter,w",                           warnUnknowParameter,                                  0, "warn for unknown configuration parameters instead of failing")
 
   // File, I/O and source parameters
-  ("InputFile,i",                                     m_inputFileName,                             string(""), "Original YUV input file name")
-  ("BitstreamFile,b",                                 m_bitstreamFileName,                         string(""), "Bitstream output file name")
-  ("ReconFile,o",                                     m_reconFileName,                             string(""), "Reconstructed YUV output file name")
+  ("InputFile,i",                                     m_inputFileName,                             string(""), "Original YUV or Y4M input file name (- for the standard input). The header of a Y4M file sets the source size, chroma format, bit depth and frame rate")
+  ("BitstreamFile,b",                                 m_bitstreamFileName,                         string(""), "Bitstream output file name (- for the standard output)")
+  ("ReconFile,o",                                     m_reconFileName,                             string(""), "Reconstructed YUV output file name (- for the standard output, extension .y4m for Y4M)")
   ("SourceWidth,-wdt",                                m_iSourceWidth,                                       0, "Source picture width")
   ("SourceHeight,-hgt",                               m_iSourceHeight,                                      0, "Source picture height")
   ("InputBitDepth",                                   m_inputBitDepth[CHANNEL_TYPE_LUMA],                   8, "Bit-depth of input file")
@@ -874,6 +876,11 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   ("TileRowHeightArray",                              cfg_RowHeight,                            cfg_RowHeight, "Array containing tile row height values in units of CTU")
   ("LFCrossTileBoundaryFlag",                         m_bLFCrossTileBoundaryFlag,                        true, "1: cross-tile-boundary loop filtering. 0:non-cross-tile-boundary loop filtering")
   ("WaveFrontSynchro",                                m_entropyCodingSyncEnabledFlag,                   false, "0: entropy coding sync disabled; 1 entropy coding sync enabled")
+  ("Threads",                                         m_numThreads,                                         1, "Number of worker threads compressing tiles and wavefront CTU rows in parallel (1: single-threaded)")
+  ("ParallelFrames",                                  m_numParallelFrames,                                  1, "Maximum number of pictures of a GOP compressed at the same time (1: one picture after the other). Above 1, the cabac_init_flag choices, and so the bitstream, may differ from those of 1")
+  ("RowLaggedLoopFilter",                             m_bRowLaggedLoopFilter,                           false, "Deblock, and apply SAO to, each CTU row as soon as the next row is compressed instead of once per picture")
+  ("ReadAheadFrames",                                 m_readAheadFrames,                                    0, "Number of input frames read and colour converted ahead of the encoder on a separate thread (0: read when needed)")
+  ("WriteBehindFrames",                               m_writeBehindFrames,                                  0, "Number of reconstructed pictures and access units queued for writing on a separate thread (0: written immediately)")
   ("ScalingList",                                     m_useScalingListId,                    SCALING_LIST_OFF, "0/off: no scaling list, 1/default: default scaling lists, 2/file: scaling lists specified in ScalingListFile")
   ("ScalingListFile",                                 m_scalingListFileName,                       string(""), "Scaling list file name. Use an empty string to produce help.")
   ("SignHideFlag,-SBH",                               m_signHideFlag,                                    true)
@@ -1086,6 +1093,32 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
     }
   }
 
+  // when data goes to the standard output, move the messages to stderr before any of them is flushed
+  if (TVideoIOStdio::isStdio(m_bitstreamFileName) || TVideoIOStdio::isStdio(m_reconFileName))
+  {
+    TVideoIOStdio::getOutput();
+  }
+
+  // a Y4M input describes itself, replacing the corresponding parameters
+  TVideoIOY4MHeader y4mHeader;
+  if (!m_inputFileName.empty() && TVideoIOYuv::readY4MHeader(m_inputFileName, y4mHeader))
+  {
+    static const Int chromaFormatNumbers[NUM_CHROMA_FORMAT] = { 400, 420, 422, 444 };
+    m_iSourceWidth                        = y4mHeader.width;
+    m_iSourceHeight                       = y4mHeader.height;
+    tmpInputChromaFormat                  = chromaFormatNumbers[y4mHeader.chromaFormat];
+    m_inputBitDepth[CHANNEL_TYPE_LUMA  ]  = y4mHeader.bitDepth;
+    m_inputBitDepth[CHANNEL_TYPE_CHROMA]  = y4mHeader.bitDepth;
+    if (y4mHeader.frameRateNum > 0)
+    {
+      m_iFrameRate = (y4mHeader.frameRateNum + y4mHeader.frameRateDen / 2) / y4mHeader.frameRateDen;
+    }
+    if (y4mHeader.isInterlaced)
+    {
+      m_isTopFieldFirst = y4mHeader.isTopFieldFirst;
+    }
+  }
+
   /*
    * Set any derived parameters
    */
@@ -1107,12 +1140,12 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
     if (cfg_ColumnWidth.values.size() > m_numTileColumnsMinus1)
     {
       printf( "The number of columns whose width are defined is larger than the allowed number of columns.\n" );
-      exit( EXIT_FAILURE );
+      return false;
     }
     else if (cfg_ColumnWidth.values.size() < m_numTileColumnsMinus1)
     {
       printf( "The width of some columns is not defined.\n" );
-      exit( EXIT_FAILURE );
+      return false;
     }
     else
     {
@@ -1133,12 +1166,12 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
     if (cfg_RowHeight.values.size() > m_numTileRowsMinus1)
     {
       printf( "The number of rows whose height are defined is larger than the allowed number of rows.\n" );
-      exit( EXIT_FAILURE );
+      return false;
     }
     else if (cfg_RowHeight.values.size() < m_numTileRowsMinus1)
     {
       printf( "The height of some rows is not defined.\n" );
-      exit( EXIT_FAILURE );
+      return false;
     }
     else
     {
@@ -1190,21 +1223,21 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   assert(tmpWeightedPredictionMethod>=0 && tmpWeightedPredictionMethod<=WP_PER_PICTURE_WITH_HISTOGRAM_AND_PER_COMPONENT_AND_CLIPPING_AND_EXTENSION);
   if (!(tmpWeightedPredictionMethod>=0 && tmpWeightedPredictionMethod<=WP_PER_PICTURE_WITH_HISTOGRAM_AND_PER_COMPONENT_AND_CLIPPING_AND_EXTENSION))
   {
-    exit(EXIT_FAILURE);
+    return false;
   }
   m_weightedPredictionMethod = WeightedPredictionMethod(tmpWeightedPredictionMethod);
 
   assert(tmpFastInterSearchMode>=0 && tmpFastInterSearchMode<=FASTINTERSEARCH_MODE3);
   if (tmpFastInterSearchMode<0 || tmpFastInterSearchMode>FASTINTERSEARCH_MODE3)
   {
-    exit(EXIT_FAILURE);
+    return false;
   }
   m_fastInterSearchMode = FastInterSearchMode(tmpFastInterSearchMode);
 
   assert(tmpMotionEstimationSearchMethod>=0 && tmpMotionEstimationSearchMethod<MESEARCH_NUMBER_OF_METHODS);
   if (tmpMotionEstimationSearchMethod<0 || tmpMotionEstimationSearchMethod>=MESEARCH_NUMBER_OF_METHODS)
   {
-    exit(EXIT_FAILURE);
+    return false;
   }
   m_motionEstimationSearchMethod=MESearchMethod(tmpMotionEstimationSearchMethod);
 
@@ -1214,7 +1247,7 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
     if (m_bitDepthConstraint != 0 || tmpConstraintChromaFormat != 0)
     {
       fprintf(stderr, "Error: The bit depth and chroma format constraints are not used when an explicit RExt profile is specified\n");
-      exit(EXIT_FAILURE);
+      return false;
     }
     m_bitDepthConstraint           = (extendedProfile%100);
     m_intraConstraintFlag          = ((extendedProfile%10000)>=2000);
@@ -1260,7 +1293,7 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
         if (m_intraConstraintFlag != true)
         {
           fprintf(stderr, "Error: Intra constraint flag must be true when one_picture_only_constraint_flag is true\n");
-          exit(EXIT_FAILURE);
+          return false;
         }
         const Int maxBitDepth = m_chromaFormatIDC==CHROMA_400 ? m_internalBitDepth[CHANNEL_TYPE_LUMA] : std::max(m_internalBitDepth[CHANNEL_TYPE_LUMA], m_internalBitDepth[CHANNEL_TYPE_CHROMA]);
         m_bitDepthConstraint = maxBitDepth>8 ? 16:8;
@@ -1281,7 +1314,7 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
     else if (m_bitDepthConstraint == 0 || tmpConstraintChromaFormat == 0)
     {
       fprintf(stderr, "Error: The bit depth and chroma format constraints must either both be specified or both be configured automatically\n");
-      exit(EXIT_FAILURE);
+      return false;
     }
     else
     {
@@ -1328,12 +1361,12 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
       if (m_aiPad[0] % TComSPS::getWinUnitX(m_chromaFormatIDC) != 0)
       {
         fprintf(stderr, "Error: picture width is not an integer multiple of the specified chroma subsampling\n");
-        exit(EXIT_FAILURE);
+        return false;
       }
       if (m_aiPad[1] % TComSPS::getWinUnitY(m_chromaFormatIDC) != 0)
       {
         fprintf(stderr, "Error: picture height is not an integer multiple of the specified chroma subsampling\n");
-        exit(EXIT_FAILURE);
+        return false;
       }
       break;
     }
@@ -1365,20 +1398,20 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   if (tmpSliceMode<0 || tmpSliceMode>=Int(NUMBER_OF_SLICE_CONSTRAINT_MODES))
   {
     fprintf(stderr, "Error: bad slice mode\n");
-    exit(EXIT_FAILURE);
+    return false;
   }
   m_sliceMode = SliceConstraint(tmpSliceMode);
   if (tmpSliceSegmentMode<0 || tmpSliceSegmentMode>=Int(NUMBER_OF_SLICE_CONSTRAINT_MODES))
   {
     fprintf(stderr, "Error: bad slice segment mode\n");
-    exit(EXIT_FAILURE);
+    return false;
   }
   m_sliceSegmentMode = SliceConstraint(tmpSliceSegmentMode);
 
   if (tmpDecodedPictureHashSEIMappedType<0 || tmpDecodedPictureHashSEIMappedType>=Int(NUMBER_OF_HASHTYPES))
   {
     fprintf(stderr, "Error: bad checksum mode\n");
-    exit(EXIT_FAILURE);
+    return false;
   }
   // Need to map values to match those of the SEI message:
   if (tmpDecodedPictureHashSEIMappedType==0)
@@ -1530,7 +1563,10 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
   }
 
   // check validity of input parameters
-  xCheckParameter();
+  if( xCheckParameter() )
+  {
+    return false;
+  }
 
   // compute actual CU depth with respect to config depth and max transform size
   UInt uiAddCUDepth  = 0;
@@ -1549,11 +1585,374 @@ Bool TAppEncCfg::parseCfg( Int argc, TChar* argv[] )
 }
 
 
+/** pass the configuration values to the encoder library
+ * \param encoderCfg  configuration of the encoder, usually the TEncTop of an encoder session
+ */
+Void TAppEncCfg::initLibCfg( TEncCfg& encoderCfg )
+{
+  TComVPS vps;
+
+  vps.setMaxTLayers                                               ( m_maxTempLayer );
+  if (m_maxTempLayer == 1)
+  {
+    vps.setTemporalNestingFlag(true);
+  }
+  vps.setMaxLayers                                                ( 1 );
+  for(Int i = 0; i < MAX_TLAYER; i++)
+  {
+    vps.setNumReorderPics                                         ( m_numReorderPics[i], i );
+    vps.setMaxDecPicBuffering                                     ( m_maxDecPicBuffering[i], i );
+  }
+  encoderCfg.setVPS(&vps);
+
+  encoderCfg.setProfile                                           ( m_profile);
+  encoderCfg.setLevel                                             ( m_levelTier, m_level);
+  encoderCfg.setProgressiveSourceFlag                             ( m_progressiveSourceFlag);
+  encoderCfg.setInterlacedSourceFlag                              ( m_interlacedSourceFlag);
+  encoderCfg.setNonPackedConstraintFlag                           ( m_nonPackedConstraintFlag);
+  encoderCfg.setFrameOnlyConstraintFlag                           ( m_frameOnlyConstraintFlag);
+  encoderCfg.setBitDepthConstraintValue                           ( m_bitDepthConstraint );
+  encoderCfg.setChromaFormatConstraintValue                       ( m_chromaFormatConstraint );
+  encoderCfg.setIntraConstraintFlag                               ( m_intraConstraintFlag );
+  encoderCfg.setOnePictureOnlyConstraintFlag                      ( m_onePictureOnlyConstraintFlag );
+  encoderCfg.setLowerBitRateConstraintFlag                        ( m_lowerBitRateConstraintFlag );
+
+  encoderCfg.setPrintMSEBasedSequencePSNR                         ( m_printMSEBasedSequencePSNR);
+  encoderCfg.setPrintFrameMSE                                     ( m_printFrameMSE);
+  encoderCfg.setPrintSequenceMSE                                  ( m_printSequenceMSE);
+  encoderCfg.setCabacZeroWordPaddingEnabled                       ( m_cabacZeroWordPaddingEnabled );
+
+  encoderCfg.setFrameRate                                         ( m_iFrameRate );
+  encoderCfg.setFrameSkip                                         ( m_FrameSkip );
+  encoderCfg.setTemporalSubsampleRatio                            ( m_temporalSubsampleRatio );
+  encoderCfg.setSourceWidth                                       ( m_iSourceWidth );
+  encoderCfg.setSourceHeight                                      ( m_iSourceHeight );
+  encoderCfg.setConformanceWindow                                 ( m_confWinLeft, m_confWinRight, m_confWinTop, m_confWinBottom );
+  encoderCfg.setFramesToBeEncoded                                 ( m_framesToBeEncoded );
+
+  //====== Coding Structure ========
+  encoderCfg.setIntraPeriod                                       ( m_iIntraPeriod );
+  encoderCfg.setDecodingRefreshType                               ( m_iDecodingRefreshType );
+  encoderCfg.setGOPSize                                           ( m_iGOPSize );
+  encoderCfg.setGopList                                           ( m_GOPList );
+  encoderCfg.setExtraRPSs                                         ( m_extraRPSs );
+  for(Int i = 0; i < MAX_TLAYER; i++)
+  {
+    encoderCfg.setNumReorderPics                                  ( m_numReorderPics[i], i );
+    encoderCfg.setMaxDecPicBuffering                              ( m_maxDecPicBuffering[i], i );
+  }
+  for( UInt uiLoop = 0; uiLoop < MAX_TLAYER; ++uiLoop )
+  {
+    encoderCfg.setLambdaModifier                                  ( uiLoop, m_adLambdaModifier[ uiLoop ] );
+  }
+  encoderCfg.setIntraLambdaModifier                               ( m_adIntraLambdaModifier );
+  encoderCfg.setIntraQpFactor                                     ( m_dIntraQpFactor );
+
+  encoderCfg.setQP                                                ( m_iQP );
+
+  encoderCfg.setPad                                               ( m_aiPad );
+
+  encoderCfg.setAccessUnitDelimiter                               ( m_AccessUnitDelimiter );
+
+  encoderCfg.setMaxTempLayer                                      ( m_maxTempLayer );
+  encoderCfg.setUseAMP( m_enableAMP );
+
+  //===== Slice ========
+
+  //====== Loop/Deblock Filter ========
+  encoderCfg.setLoopFilterDisable                                 ( m_bLoopFilterDisable       );
+  encoderCfg.setLoopFilterOffsetInPPS                             ( m_loopFilterOffsetInPPS );
+  encoderCfg.setLoopFilterBetaOffset                              ( m_loopFilterBetaOffsetDiv2  );
+  encoderCfg.setLoopFilterTcOffset                                ( m_loopFilterTcOffsetDiv2    );
+#if W0038_DB_OPT
+  encoderCfg.setDeblockingFilterMetric                            ( m_deblockingFilterMetric );
+#else
+  encoderCfg.setDeblockingFilterMetric                            ( m_DeblockingFilterMetric );
+#endif
+
+  //====== Motion search ========
+  encoderCfg.setDisableIntraPUsInInterSlices                      ( m_bDisableIntraPUsInInterSlices );
+  encoderCfg.setMotionEstimationSearchMethod                      ( m_motionEstimationSearchMethod  );
+  encoderCfg.setSearchRange                                       ( m_iSearchRange );
+  encoderCfg.setBipredSearchRange                                 ( m_bipredSearchRange );
+  encoderCfg.setClipForBiPredMeEnabled                            ( m_bClipForBiPredMeEnabled );
+  encoderCfg.setFastMEAssumingSmootherMVEnabled                   ( m_bFastMEAssumingSmootherMVEnabled );
+  encoderCfg.setMinSearchWindow                                   ( m_minSearchWindow );
+  encoderCfg.setRestrictMESampling                                ( m_bRestrictMESampling );
+
+  //====== Quality control ========
+  encoderCfg.setMaxDeltaQP                                        ( m_iMaxDeltaQP  );
+  encoderCfg.setMaxCuDQPDepth                                     ( m_iMaxCuDQPDepth  );
+  encoderCfg.setDiffCuChromaQpOffsetDepth                         ( m_diffCuChromaQpOffsetDepth );
+  encoderCfg.setChromaCbQpOffset                                  ( m_cbQpOffset     );
+  encoderCfg.setChromaCrQpOffset                                  ( m_crQpOffset  );
+#if W0038_CQP_ADJ
+  encoderCfg.setSliceChromaOffsetQpIntraOrPeriodic                ( m_sliceChromaQpOffsetPeriodicity, m_sliceChromaQpOffsetIntraOrPeriodic );
+#endif
+  encoderCfg.setChromaFormatIdc                                   ( m_chromaFormatIDC  );
+
+#if ADAPTIVE_QP_SELECTION
+  encoderCfg.setUseAdaptQpSelect                                  ( m_bUseAdaptQpSelect   );
+#endif
+
+  encoderCfg.setUseAdaptiveQP                                     ( m_bUseAdaptiveQP  );
+  encoderCfg.setQPAdaptationRange                                 ( m_iQPAdaptationRange );
+  encoderCfg.setExtendedPrecisionProcessingFlag                   ( m_extendedPrecisionProcessingFlag );
+  encoderCfg.setHighPrecisionOffsetsEnabledFlag                   ( m_highPrecisionOffsetsEnabledFlag );
+
+  encoderCfg.setWeightedPredictionMethod( m_weightedPredictionMethod );
+
+  //====== Tool list ========
+  encoderCfg.setDeltaQpRD                                         ( m_uiDeltaQpRD  );
+  encoderCfg.setFastDeltaQp                                       ( m_bFastDeltaQP  );
+  encoderCfg.setUseASR                                            ( m_bUseASR      );
+  encoderCfg.setUseHADME                                          ( m_bUseHADME    );
+  encoderCfg.setdQPs                                              ( m_aidQP        );
+  encoderCfg.setUseRDOQ                                           ( m_useRDOQ     );
+  encoderCfg.setUseRDOQTS                                         ( m_useRDOQTS   );
+#if T0196_SELECTIVE_RDOQ
+  encoderCfg.setUseSelectiveRDOQ                                  ( m_useSelectiveRDOQ );
+#endif
+  encoderCfg.setRDpenalty                                         ( m_rdPenalty );
+  encoderCfg.setMaxCUWidth                                        ( m_uiMaxCUWidth );
+  encoderCfg.setMaxCUHeight                                       ( m_uiMaxCUHeight );
+  encoderCfg.setMaxTotalCUDepth                                   ( m_uiMaxTotalCUDepth );
+  encoderCfg.setLog2DiffMaxMinCodingBlockSize                     ( m_uiLog2DiffMaxMinCodingBlockSize );
+  encoderCfg.setQuadtreeTULog2MaxSize                             ( m_uiQuadtreeTULog2MaxSize );
+  encoderCfg.setQuadtreeTULog2MinSize                             ( m_uiQuadtreeTULog2MinSize );
+  encoderCfg.setQuadtreeTUMaxDepthInter                           ( m_uiQuadtreeTUMaxDepthInter );
+  encoderCfg.setQuadtreeTUMaxDepthIntra                           ( m_uiQuadtreeTUMaxDepthIntra );
+  encoderCfg.setFastInterSearchMode                               ( m_fastInterSearchMode );
+  encoderCfg.setUseEarlyCU                                        ( m_bUseEarlyCU  );
+  encoderCfg.setUseFastDecisionForMerge                           ( m_useFastDecisionForMerge  );
+  encoderCfg.setUseCbfFastMode                                    ( m_bUseCbfFastMode  );
+  encoderCfg.setUseEarlySkipDetection                             ( m_useEarlySkipDetection );
+  encoderCfg.setCrossComponentPredictionEnabledFlag               ( m_crossComponentPredictionEnabledFlag );
+  encoderCfg.setUseReconBasedCrossCPredictionEstimate             ( m_reconBasedCrossCPredictionEstimate );
+  encoderCfg.setLog2SaoOffsetScale                                ( CHANNEL_TYPE_LUMA  , m_log2SaoOffsetScale[CHANNEL_TYPE_LUMA]   );
+  encoderCfg.setLog2SaoOffsetScale                                ( CHANNEL_TYPE_CHROMA, m_log2SaoOffsetScale[CHANNEL_TYPE_CHROMA] );
+  encoderCfg.setUseTransformSkip                                  ( m_useTransformSkip      );
+  encoderCfg.setUseTransformSkipFast                              ( m_useTransformSkipFast  );
+  encoderCfg.setTransformSkipRotationEnabledFlag                  ( m_transformSkipRotationEnabledFlag );
+  encoderCfg.setTransformSkipContextEnabledFlag                   ( m_transformSkipContextEnabledFlag   );
+  encoderCfg.setPersistentRiceAdaptationEnabledFlag               ( m_persistentRiceAdaptationEnabledFlag );
+  encoderCfg.setCabacBypassAlignmentEnabledFlag                   ( m_cabacBypassAlignmentEnabledFlag );
+  encoderCfg.setLog2MaxTransformSkipBlockSize                     ( m_log2MaxTransformSkipBlockSize  );
+  for (UInt signallingModeIndex = 0; signallingModeIndex < NUMBER_OF_RDPCM_SIGNALLING_MODES; signallingModeIndex++)
+  {
+    encoderCfg.setRdpcmEnabledFlag                                ( RDPCMSignallingMode(signallingModeIndex), m_rdpcmEnabledFlag[signallingModeIndex]);
+  }
+  encoderCfg.setUseConstrainedIntraPred                           ( m_bUseConstrainedIntraPred );
+  encoderCfg.setFastUDIUseMPMEnabled                              ( m_bFastUDIUseMPMEnabled );
+  encoderCfg.setFastMEForGenBLowDelayEnabled                      ( m_bFastMEForGenBLowDelayEnabled );
+  encoderCfg.setUseBLambdaForNonKeyLowDelayPictures               ( m_bUseBLambdaForNonKeyLowDelayPictures );
+  encoderCfg.setPCMLog2MinSize                                    ( m_uiPCMLog2MinSize);
+  encoderCfg.setUsePCM                                            ( m_usePCM );
+
+  // set internal bit-depth and constants
+  for (UInt channelType = 0; channelType < MAX_NUM_CHANNEL_TYPE; channelType++)
+  {
+    encoderCfg.setBitDepth((ChannelType)channelType, m_internalBitDepth[channelType]);
+    encoderCfg.setPCMBitDepth((ChannelType)channelType, m_bPCMInputBitDepthFlag ? m_MSBExtendedBitDepth[channelType] : m_internalBitDepth[channelType]);
+  }
+
+  encoderCfg.setPCMLog2MaxSize                                    ( m_pcmLog2MaxSize);
+  encoderCfg.setMaxNumMergeCand                                   ( m_maxNumMergeCand );
+
+
+  //====== Weighted Prediction ========
+  encoderCfg.setUseWP                                             ( m_useWeightedPred     );
+  encoderCfg.setWPBiPred                                          ( m_useWeightedBiPred   );
+
+  //====== Parallel Merge Estimation ========
+  encoderCfg.setLog2ParallelMergeLevelMinus2                      ( m_log2ParallelMergeLevel - 2 );
+
+  //====== Slice ========
+  encoderCfg.setSliceMode                                         ( m_sliceMode );
+  encoderCfg.setSliceArgument                                     ( m_sliceArgument );
+
+  //====== Dependent Slice ========
+  encoderCfg.setSliceSegmentMode                                  ( m_sliceSegmentMode );
+  encoderCfg.setSliceSegmentArgument                              ( m_sliceSegmentArgument );
+
+  if(m_sliceMode == NO_SLICES )
+  {
+    m_bLFCrossSliceBoundaryFlag = true;
+  }
+  encoderCfg.setLFCrossSliceBoundaryFlag                          ( m_bLFCrossSliceBoundaryFlag );
+  encoderCfg.setUseSAO                                            ( m_bUseSAO );
+  encoderCfg.setTestSAODisableAtPictureLevel                      ( m_bTestSAODisableAtPictureLevel );
+  encoderCfg.setSaoEncodingRate                                   ( m_saoEncodingRate );
+  encoderCfg.setSaoEncodingRateChroma                             ( m_saoEncodingRateChroma );
+  encoderCfg.setMaxNumOffsetsPerPic                               ( m_maxNumOffsetsPerPic);
+
+  encoderCfg.setSaoCtuBoundary                                    ( m_saoCtuBoundary);
+#if OPTIONAL_RESET_SAO_ENCODING_AFTER_IRAP
+  encoderCfg.setSaoResetEncoderStateAfterIRAP                     ( m_saoResetEncoderStateAfterIRAP);
+#endif
+  encoderCfg.setPCMInputBitDepthFlag                              ( m_bPCMInputBitDepthFlag);
+  encoderCfg.setPCMFilterDisableFlag                              ( m_bPCMFilterDisableFlag);
+
+  encoderCfg.setIntraSmoothingDisabledFlag                        (!m_enableIntraReferenceSmoothing );
+  encoderCfg.setDecodedPictureHashSEIType                         ( m_decodedPictureHashSEIType );
+  encoderCfg.setRecoveryPointSEIEnabled                           ( m_recoveryPointSEIEnabled );
+  encoderCfg.setBufferingPeriodSEIEnabled                         ( m_bufferingPeriodSEIEnabled );
+  encoderCfg.setPictureTimingSEIEnabled                           ( m_pictureTimingSEIEnabled );
+  encoderCfg.setToneMappingInfoSEIEnabled                         ( m_toneMappingInfoSEIEnabled );
+  encoderCfg.setTMISEIToneMapId                                   ( m_toneMapId );
+  encoderCfg.setTMISEIToneMapCancelFlag                           ( m_toneMapCancelFlag );
+  encoderCfg.setTMISEIToneMapPersistenceFlag                      ( m_toneMapPersistenceFlag );
+  encoderCfg.setTMISEICodedDataBitDepth                           ( m_toneMapCodedDataBitDepth );
+  encoderCfg.setTMISEITargetBitDepth                              ( m_toneMapTargetBitDepth );
+  encoderCfg.setTMISEIModelID                                     ( m_toneMapModelId );
+  encoderCfg.setTMISEIMinValue                                    ( m_toneMapMinValue );
+  encoderCfg.setTMISEIMaxValue                                    ( m_toneMapMaxValue );
+  encoderCfg.setTMISEISigmoidMidpoint                             ( m_sigmoidMidpoint );
+  encoderCfg.setTMISEISigmoidWidth                                ( m_sigmoidWidth );
+  encoderCfg.setTMISEIStartOfCodedInterva                         ( m_startOfCodedInterval );
+  encoderCfg.setTMISEINumPivots                                   ( m_numPivots );
+  encoderCfg.setTMISEICodedPivotValue                             ( m_codedPivotValue );
+  encoderCfg.setTMISEITargetPivotValue                            ( m_targetPivotValue );
+  encoderCfg.setTMISEICameraIsoSpeedIdc                           ( m_cameraIsoSpeedIdc );
+  encoderCfg.setTMISEICameraIsoSpeedValue                         ( m_cameraIsoSpeedValue );
+  encoderCfg.setTMISEIExposureIndexIdc                            ( m_exposureIndexIdc );
+  encoderCfg.setTMISEIExposureIndexValue                          ( m_exposureIndexValue );
+  encoderCfg.setTMISEIExposureCompensationValueSignFlag           ( m_exposureCompensationValueSignFlag );
+  encoderCfg.setTMISEIExposureCompensationValueNumerator          ( m_exposureCompensationValueNumerator );
+  encoderCfg.setTMISEIExposureCompensationValueDenomIdc           ( m_exposureCompensationValueDenomIdc );
+  encoderCfg.setTMISEIRefScreenLuminanceWhite                     ( m_refScreenLuminanceWhite );
+  encoderCfg.setTMISEIExtendedRangeWhiteLevel                     ( m_extendedRangeWhiteLevel );
+  encoderCfg.setTMISEINominalBlackLevelLumaCodeValue              ( m_nominalBlackLevelLumaCodeValue );
+  encoderCfg.setTMISEINominalWhiteLevelLumaCodeValue              ( m_nominalWhiteLevelLumaCodeValue );
+  encoderCfg.setTMISEIExtendedWhiteLevelLumaCodeValue             ( m_extendedWhiteLevelLumaCodeValue );
+  encoderCfg.setChromaResamplingFilterHintEnabled                 ( m_chromaResamplingFilterSEIenabled );
+  encoderCfg.setChromaResamplingHorFilterIdc                      ( m_chromaResamplingHorFilterIdc );
+  encoderCfg.setChromaResamplingVerFilterIdc                      ( m_chromaResamplingVerFilterIdc );
+  encoderCfg.setFramePackingArrangementSEIEnabled                 ( m_framePackingSEIEnabled );
+  encoderCfg.setFramePackingArrangementSEIType                    ( m_framePackingSEIType );
+  encoderCfg.setFramePackingArrangementSEIId                      ( m_framePackingSEIId );
+  encoderCfg.setFramePackingArrangementSEIQuincunx                ( m_framePackingSEIQuincunx );
+  encoderCfg.setFramePackingArrangementSEIInterpretation          ( m_framePackingSEIInterpretation );
+  encoderCfg.setSegmentedRectFramePackingArrangementSEIEnabled    ( m_segmentedRectFramePackingSEIEnabled );
+  encoderCfg.setSegmentedRectFramePackingArrangementSEICancel     ( m_segmentedRectFramePackingSEICancel );
+  encoderCfg.setSegmentedRectFramePackingArrangementSEIType       ( m_segmentedRectFramePackingSEIType );
+  encoderCfg.setSegmentedRectFramePackingArrangementSEIPersistence( m_segmentedRectFramePackingSEIPersistence );
+  encoderCfg.setDisplayOrientationSEIAngle                        ( m_displayOrientationSEIAngle );
+  encoderCfg.setTemporalLevel0IndexSEIEnabled                     ( m_temporalLevel0IndexSEIEnabled );
+  encoderCfg.setGradualDecodingRefreshInfoEnabled                 ( m_gradualDecodingRefreshInfoEnabled );
+  encoderCfg.setNoDisplaySEITLayer                                ( m_noDisplaySEITLayer );
+  encoderCfg.setDecodingUnitInfoSEIEnabled                        ( m_decodingUnitInfoSEIEnabled );
+  encoderCfg.setSOPDescriptionSEIEnabled                          ( m_SOPDescriptionSEIEnabled );
+  encoderCfg.setScalableNestingSEIEnabled                         ( m_scalableNestingSEIEnabled );
+  encoderCfg.setTMCTSSEIEnabled                                   ( m_tmctsSEIEnabled );
+  encoderCfg.setTimeCodeSEIEnabled                                ( m_timeCodeSEIEnabled );
+  encoderCfg.setNumberOfTimeSets                                  ( m_timeCodeSEINumTs );
+  for(Int i = 0; i < m_timeCodeSEINumTs; i++)
+  {
+    encoderCfg.setTimeSet(m_timeSetArray[i], i);
+  }
+  encoderCfg.setKneeSEIEnabled                                    ( m_kneeSEIEnabled );
+  encoderCfg.setKneeSEIId                                         ( m_kneeSEIId );
+  encoderCfg.setKneeSEICancelFlag                                 ( m_kneeSEICancelFlag );
+  encoderCfg.setKneeSEIPersistenceFlag                            ( m_kneeSEIPersistenceFlag );
+  encoderCfg.setKneeSEIInputDrange                                ( m_kneeSEIInputDrange );
+  encoderCfg.setKneeSEIInputDispLuminance                         ( m_kneeSEIInputDispLuminance );
+  encoderCfg.setKneeSEIOutputDrange                               ( m_kneeSEIOutputDrange );
+  encoderCfg.setKneeSEIOutputDispLuminance                        ( m_kneeSEIOutputDispLuminance );
+  encoderCfg.setKneeSEINumKneePointsMinus1                        ( m_kneeSEINumKneePointsMinus1 );
+  encoderCfg.setKneeSEIInputKneePoint                             ( m_kneeSEIInputKneePoint );
+  encoderCfg.setKneeSEIOutputKneePoint                            ( m_kneeSEIOutputKneePoint );
+  encoderCfg.setColourRemapInfoSEIFileRoot                        ( m_colourRemapSEIFileRoot );
+  encoderCfg.setMasteringDisplaySEI                               ( m_masteringDisplay );
+#if U0033_ALTERNATIVE_TRANSFER_CHARACTERISTICS_SEI
+  encoderCfg.setSEIAlternativeTransferCharacteristicsSEIEnable    ( m_preferredTransferCharacteristics>=0     );
+  encoderCfg.setSEIPreferredTransferCharacteristics               ( UChar(m_preferredTransferCharacteristics) );
+#endif
+
+  encoderCfg.setTileUniformSpacingFlag                            ( m_tileUniformSpacingFlag );
+  encoderCfg.setNumColumnsMinus1                                  ( m_numTileColumnsMinus1 );
+  encoderCfg.setNumRowsMinus1                                     ( m_numTileRowsMinus1 );
+  if(!m_tileUniformSpacingFlag)
+  {
+    encoderCfg.setColumnWidth                                     ( m_tileColumnWidth );
+    encoderCfg.setRowHeight                                       ( m_tileRowHeight );
+  }
+  encoderCfg.xCheckGSParameters();
+  Int uiTilesCount = (m_numTileRowsMinus1+1) * (m_numTileColumnsMinus1+1);
+  if(uiTilesCount == 1)
+  {
+    m_bLFCrossTileBoundaryFlag = true;
+  }
+  encoderCfg.setLFCrossTileBoundaryFlag                           ( m_bLFCrossTileBoundaryFlag );
+  encoderCfg.setEntropyCodingSyncEnabledFlag                      ( m_entropyCodingSyncEnabledFlag );
+  encoderCfg.setNumThreads                                        ( m_numThreads );
+  encoderCfg.setNumParallelFrames                                 ( m_numParallelFrames );
+  encoderCfg.setRowLaggedLoopFilter                               ( m_bRowLaggedLoopFilter );
+  encoderCfg.setTMVPModeId                                        ( m_TMVPModeId );
+  encoderCfg.setUseScalingListId                                  ( m_useScalingListId  );
+  encoderCfg.setScalingListFileName                               ( m_scalingListFileName );
+  encoderCfg.setSignHideFlag                                      ( m_signHideFlag);
+  encoderCfg.setUseRateCtrl                                       ( m_RCEnableRateControl );
+  encoderCfg.setTargetBitrate                                     ( m_RCTargetBitrate );
+  encoderCfg.setKeepHierBit                                       ( m_RCKeepHierarchicalBit );
+  encoderCfg.setLCULevelRC                                        ( m_RCLCULevelRC );
+  encoderCfg.setUseLCUSeparateModel                               ( m_RCUseLCUSeparateModel );
+  encoderCfg.setInitialQP                                         ( m_RCInitialQP );
+  encoderCfg.setForceIntraQP                                      ( m_RCForceIntraQP );
+#if U0132_TARGET_BITS_SATURATION
+  encoderCfg.setCpbSaturationEnabled                              ( m_RCCpbSaturationEnabled );
+  encoderCfg.setCpbSize                                           ( m_RCCpbSize );
+  encoderCfg.setInitialCpbFullness                                ( m_RCInitialCpbFullness );
+#endif
+  encoderCfg.setTransquantBypassEnableFlag                        ( m_TransquantBypassEnableFlag );
+  encoderCfg.setCUTransquantBypassFlagForceValue                  ( m_CUTransquantBypassFlagForce );
+  encoderCfg.setCostMode                                          ( m_costMode );
+  encoderCfg.setUseRecalculateQPAccordingToLambda                 ( m_recalculateQPAccordingToLambda );
+  encoderCfg.setUseStrongIntraSmoothing                           ( m_useStrongIntraSmoothing );
+  encoderCfg.setActiveParameterSetsSEIEnabled                     ( m_activeParameterSetsSEIEnabled );
+  encoderCfg.setVuiParametersPresentFlag                          ( m_vuiParametersPresentFlag );
+  encoderCfg.setAspectRatioInfoPresentFlag                        ( m_aspectRatioInfoPresentFlag);
+  encoderCfg.setAspectRatioIdc                                    ( m_aspectRatioIdc );
+  encoderCfg.setSarWidth                                          ( m_sarWidth );
+  encoderCfg.setSarHeight                                         ( m_sarHeight );
+  encoderCfg.setOverscanInfoPresentFlag                           ( m_overscanInfoPresentFlag );
+  encoderCfg.setOverscanAppropriateFlag                           ( m_overscanAppropriateFlag );
+  encoderCfg.setVideoSignalTypePresentFlag                        ( m_videoSignalTypePresentFlag );
+  encoderCfg.setVideoFormat                                       ( m_videoFormat );
+  encoderCfg.setVideoFullRangeFlag                                ( m_videoFullRangeFlag );
+  encoderCfg.setColourDescriptionPresentFlag                      ( m_colourDescriptionPresentFlag );
+  encoderCfg.setColourPrimaries                                   ( m_colourPrimaries );
+  encoderCfg.setTransferCharacteristics                           ( m_transferCharacteristics );
+  encoderCfg.setMatrixCoefficients                                ( m_matrixCoefficients );
+  encoderCfg.setChromaLocInfoPresentFlag                          ( m_chromaLocInfoPresentFlag );
+  encoderCfg.setChromaSampleLocTypeTopField                       ( m_chromaSampleLocTypeTopField );
+  encoderCfg.setChromaSampleLocTypeBottomField                    ( m_chromaSampleLocTypeBottomField );
+  encoderCfg.setNeutralChromaIndicationFlag                       ( m_neutralChromaIndicationFlag );
+  encoderCfg.setDefaultDisplayWindow                              ( m_defDispWinLeftOffset, m_defDispWinRightOffset, m_defDispWinTopOffset, m_defDispWinBottomOffset );
+  encoderCfg.setFrameFieldInfoPresentFlag                         ( m_frameFieldInfoPresentFlag );
+  encoderCfg.setPocProportionalToTimingFlag                       ( m_pocProportionalToTimingFlag );
+  encoderCfg.setNumTicksPocDiffOneMinus1                          ( m_numTicksPocDiffOneMinus1    );
+  encoderCfg.setBitstreamRestrictionFlag                          ( m_bitstreamRestrictionFlag );
+  encoderCfg.setTilesFixedStructureFlag                           ( m_tilesFixedStructureFlag );
+  encoderCfg.setMotionVectorsOverPicBoundariesFlag                ( m_motionVectorsOverPicBoundariesFlag );
+  encoderCfg.setMinSpatialSegmentationIdc                         ( m_minSpatialSegmentationIdc );
+  encoderCfg.setMaxBytesPerPicDenom                               ( m_maxBytesPerPicDenom );
+  encoderCfg.setMaxBitsPerMinCuDenom                              ( m_maxBitsPerMinCuDenom );
+  encoderCfg.setLog2MaxMvLengthHorizontal                         ( m_log2MaxMvLengthHorizontal );
+  encoderCfg.setLog2MaxMvLengthVertical                           ( m_log2MaxMvLengthVertical );
+  encoderCfg.setEfficientFieldIRAPEnabled                         ( m_bEfficientFieldIRAPEnabled );
+  encoderCfg.setHarmonizeGopFirstFieldCoupleEnabled               ( m_bHarmonizeGopFirstFieldCoupleEnabled );
+
+  encoderCfg.setSummaryOutFilename                                ( m_summaryOutFilename );
+  encoderCfg.setSummaryPicFilenameBase                            ( m_summaryPicFilenameBase );
+  encoderCfg.setSummaryVerboseness                                ( m_summaryVerboseness );
+}
+
 // ====================================================================================================================
 // Private member functions
 // ====================================================================================================================
 
-Void TAppEncCfg::xCheckParameter()
+Bool TAppEncCfg::xCheckParameter()
 {
   if (m_decodedPictureHashSEIType==HASHTYPE_NONE)
   {
@@ -1579,7 +1978,6 @@ Void TAppEncCfg::xCheckParameter()
   Bool check_failed = false; /* abort if there is a fatal configuration problem */
 #define xConfirmPara(a,b) check_failed |= confirmPara(a,b)
 
-  xConfirmPara(m_bitstreamFileName.empty(), "A bitstream file name must be specified (BitstreamFile)");
   const UInt maxBitDepth=(m_chromaFormatIDC==CHROMA_400) ? m_internalBitDepth[CHANNEL_TYPE_LUMA] : std::max(m_internalBitDepth[CHANNEL_TYPE_LUMA], m_internalBitDepth[CHANNEL_TYPE_CHROMA]);
   xConfirmPara(m_bitDepthConstraint<maxBitDepth, "The internalBitDepth must not be greater than the bitDepthConstraint value");
   xConfirmPara(m_chromaFormatConstraint<m_chromaFormatIDC, "The chroma format used must not be greater than the chromaFormatConstraint value");
@@ -1743,6 +2141,10 @@ Void TAppEncCfg::xCheckParameter()
   xConfirmPara( m_loopFilterTcOffsetDiv2 < -6 || m_loopFilterTcOffsetDiv2 > 6,            "Loop Filter Tc Offset div. 2 exceeds supported range (-6 to 6)");
   xConfirmPara( m_iSearchRange < 0 ,                                                        "Search Range must be more than 0" );
   xConfirmPara( m_bipredSearchRange < 0 ,                                                   "Bi-prediction refinement search range must be more than 0" );
+  xConfirmPara( m_numThreads < 1,                                                           "Threads must be at least 1" );
+  xConfirmPara( m_numParallelFrames < 1,                                                    "ParallelFrames must be at least 1" );
+  xConfirmPara( m_readAheadFrames < 0,                                                      "ReadAheadFrames must not be negative" );
+  xConfirmPara( m_writeBehindFrames < 0,                                                    "WriteBehindFrames must not be negative" );
   xConfirmPara( m_minSearchWindow < 0,                                                      "Minimum motion search window size for the adaptive window ME must be greater than or equal to 0" );
   xConfirmPara( m_iMaxDeltaQP > 7,                                                          "Absolute Delta QP exceeds supported range (0 to 7)" );
   xConfirmPara( m_iMaxCuDQPDepth > m_uiMaxCUDepth - 1,                                          "Absolute depth for a minimum CuDQP exceeds maximum coding unit depth" );
@@ -2349,10 +2751,7 @@ Void TAppEncCfg::xCheckParameter()
 #endif
 
 #undef xConfirmPara
-  if (check_failed)
-  {
-    exit(EXIT_FAILURE);
-  }
+  return check_failed;
 }
 
 const TChar *profileToString(const Profile::Name profile)
@@ -2544,6 +2943,8 @@ Void TAppEncCfg::xPrintParameter()
   printf("PME:%d ", m_log2ParallelMergeLevel);
   const Int iWaveFrontSubstreams = m_entropyCodingSyncEnabledFlag ? (m_iSourceHeight + m_uiMaxCUHeight - 1) / m_uiMaxCUHeight : 1;
   printf(" WaveFrontSynchro:%d WaveFrontSubstreams:%d", m_entropyCodingSyncEnabledFlag?1:0, iWaveFrontSubstreams);
+  printf(" Threads:%d ParallelFrames:%d RowLaggedLoopFilter:%d", m_numThreads, m_numParallelFrames, m_bRowLaggedLoopFilter ? 1 : 0);
+  printf(" ReadAheadFrames:%d WriteBehindFrames:%d", m_readAheadFrames, m_writeBehindFrames);
   printf(" ScalingList:%d ", m_useScalingListId );
   printf("TMVPMode:%d ", m_TMVPModeId     );
 #if ADAPTIVE_QP_SELECTION
@@ -43,7 +43,7 @@
 #include "TLibEncoder/TEncCfg.h"
 #include <sstream>
 #include <vector>
-//! \ingroup TAppEncoder
+//! \ingroup TAppEncoderLib
 //! \{
 
 // ====================================================================================================================
@@ -53,6 +53,8 @@
 /// encoder configuration class
 class TAppEncCfg
 {
+  friend class TAppEncSession;
+
 protected:
   // file I/O
   std::string m_inputFileName;                                ///< source file name
@@ -251,6 +253,11 @@ protected:
   std::vector<Int> m_tileColumnWidth;
   std::vector<Int> m_tileRowHeight;
   Bool      m_entropyCodingSyncEnabledFlag;
+  Int       m_numThreads;                                     ///< number of worker threads used for CTU compression
+  Int       m_numParallelFrames;                              ///< maximum number of pictures of a GOP being compressed at the same time
+  Bool      m_bRowLaggedLoopFilter;                           ///< filter each CTU row while the rows below it are compressed
+  Int       m_readAheadFrames;                                ///< number of input frames read ahead of the encoder on a separate thread
+  Int       m_writeBehindFrames;                              ///< number of output pictures queued for writing on a separate thread
 
   Bool      m_bUseConstrainedIntraPred;                       ///< flag for using constrained intra prediction
   Bool      m_bFastUDIUseMPMEnabled;
@@ -400,7 +407,7 @@ protected:
   UInt        m_summaryVerboseness;                           ///< Specifies the level of the verboseness of the text output.
 
   // internal member functions
-  Void  xCheckParameter ();                                   ///< check validity of configuration values
+  Bool  xCheckParameter ();                                   ///< check validity of configuration values, true on a fatal problem
   Void  xPrintParameter ();                                   ///< print configuration values
   Void  xPrintUsage     ();                                   ///< print usage
 public:
@@ -411,6 +418,7 @@ public:
   Void  create    ();                                         ///< create option handling class
   Void  destroy   ();                                         ///< destroy option handling class
   Bool  parseCfg  ( Int argc, TChar* argv[] );                ///< parse configuration file to fill member variables
+  Void  initLibCfg( TEncCfg& encoderCfg );                    ///< pass the configuration to the encoder library
 
 };// END CLASS DEFINITION TAppEncCfg
 
@@ -0,0 +1,347 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2016, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TAppEncSession.cpp
+    \brief    In-memory encoder session
+*/
+
+#include <assert.h>
+#include <sstream>
+
+#include "TAppEncSession.h"
+#include "TLibEncoder/AnnexBwrite.h"
+
+using namespace std;
+
+//! \ingroup TAppEncoderLib
+//! \{
+
+// ====================================================================================================================
+// Constructor / destructor / initialization / destroy
+// ====================================================================================================================
+
+TAppEncSession::TAppEncSession()
+: m_pcCfg( NULL )
+, m_iFrameRcvd( 0 )
+, m_bEos( false )
+, m_essentialBytes( 0 )
+, m_totalBytes( 0 )
+, m_cRawFrameStream( &m_cRawFrameBuffer )
+{
+}
+
+TAppEncSession::~TAppEncSession()
+{
+}
+
+/**
+ - pass the configuration to the encoder class
+ - create and initialise the encoder class
+ .
+ \param cfg  parsed configuration, which must not be destroyed before the session is closed
+ */
+Void TAppEncSession::open( TAppEncCfg& cfg )
+{
+  m_pcCfg          = &cfg;
+  m_iFrameRcvd     = 0;
+  m_bEos           = false;
+  m_essentialBytes = 0;
+  m_totalBytes     = 0;
+
+  cfg.initLibCfg( m_cTEncTop );
+  m_cTEncTop.create();
+  m_cTEncTop.init( cfg.m_isField );
+}
+
+/**
+ - delete the buffers of the encoder class and of the session
+ - destroy the encoder class
+ .
+ \param bPrintSummary  print the summary of the encoded sequence before destroying the encoder
+ */
+Void TAppEncSession::close( Bool bPrintSummary )
+{
+  if ( bPrintSummary )
+  {
+    m_cTEncTop.printSummary( m_pcCfg->m_isField );
+  }
+
+  m_cTEncTop.deletePicBuffer();
+  m_accessUnits.clear();
+  m_recons.clear();
+  xDeleteBuffer();
+  m_cRawFrameReader.close();
+  m_cPicYuvRawOrg.destroy();
+  m_cPicYuvRawTrueOrg.destroy();
+
+  m_cTEncTop.destroy();
+  m_pcCfg = NULL;
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/**
+ Encode one source frame. The encoder copies the frame, so the buffers can be reused when the call returns.
+ The session ends with the frame that makes up FramesToBeEncoded.
+ \param pcPicYuvOrg      original picture, at the internal bit depth and chroma format
+ \param pcPicYuvTrueOrg  original picture in the input colour space, for the SNR
+ \retval                 false if the session had already ended
+ */
+Bool TAppEncSession::pushFrame( TComPicYuv* pcPicYuvOrg, TComPicYuv* pcPicYuvTrueOrg )
+{
+  if ( m_bEos )
+  {
+    return false;
+  }
+
+  // increase number of received frames
+  m_iFrameRcvd++;
+
+  const Int framesToBeEncoded = m_pcCfg->m_framesToBeEncoded;
+  m_bEos = (m_pcCfg->m_isField && (m_iFrameRcvd == (framesToBeEncoded >> 1) )) || ( !m_pcCfg->m_isField && (m_iFrameRcvd == framesToBeEncoded) );
+
+  xEncode( false, pcPicYuvOrg, pcPicYuvTrueOrg );
+  return true;
+}
+
+/**
+ Encode one frame stored in memory in the layout of a raw input file of the configuration: the input bit depth,
+ chroma format and colour space conversion, the source size before padding and, when field coding, the full frame.
+ \param data  frame samples, one byte per sample up to 8 bits and two little-endian bytes above
+ \param size  number of bytes at data
+ \retval      false if the data is shorter than one frame, or the session had already ended
+ */
+Bool TAppEncSession::pushRawFrame( const UChar* data, UInt64 size )
+{
+  const TAppEncCfg& cfg = *m_pcCfg;
+  if ( m_cPicYuvRawOrg.getAddr( COMPONENT_Y ) == NULL )
+  {
+    const Int sourceHeight = cfg.m_isField ? cfg.m_iSourceHeightOrg : cfg.m_iSourceHeight;
+    m_cPicYuvRawOrg.create    ( cfg.m_iSourceWidth, sourceHeight, cfg.m_chromaFormatIDC, cfg.m_uiMaxCUWidth, cfg.m_uiMaxCUHeight, cfg.m_uiMaxTotalCUDepth, true );
+    m_cPicYuvRawTrueOrg.create( cfg.m_iSourceWidth, sourceHeight, cfg.m_chromaFormatIDC, cfg.m_uiMaxCUWidth, cfg.m_uiMaxCUHeight, cfg.m_uiMaxTotalCUDepth, true );
+    m_cRawFrameReader.open( m_cRawFrameStream, cfg.m_inputBitDepth, cfg.m_MSBExtendedBitDepth, cfg.m_internalBitDepth );
+  }
+
+  m_cRawFrameBuffer.set( data, size );
+  m_cRawFrameStream.clear();
+
+  Int aiPad[2] = { cfg.m_aiPad[0], cfg.m_aiPad[1] };
+  if ( !m_cRawFrameReader.read( &m_cPicYuvRawOrg, &m_cPicYuvRawTrueOrg, cfg.m_inputColourSpaceConvert, aiPad, cfg.m_InputChromaFormatIDC, cfg.m_bClipInputVideoToRec709Range ) )
+  {
+    return false;
+  }
+  return pushFrame( &m_cPicYuvRawOrg, &m_cPicYuvRawTrueOrg );
+}
+
+/**
+ End the session before FramesToBeEncoded frames have been pushed, as at the end of an input file,
+ and encode the frames the encoder still holds.
+ */
+Void TAppEncSession::flush()
+{
+  if ( m_bEos )
+  {
+    return;
+  }
+
+  m_bEos = true;
+  m_cTEncTop.setFramesToBeEncoded( m_iFrameRcvd );
+  xEncode( true, NULL, NULL );
+}
+
+/**
+ Take the next access unit of the encoded pictures.
+ \param bytes  set to the access unit, with the start codes of the Annex B byte stream
+ \retval       false if all the access units have been taken
+ */
+Bool TAppEncSession::getAccessUnit( std::string& bytes )
+{
+  if ( m_accessUnits.empty() )
+  {
+    return false;
+  }
+
+  bytes.swap( m_accessUnits.front() );
+  m_accessUnits.pop_front();
+  return true;
+}
+
+/**
+ Take the next reconstructed picture of the last push or flush. When field coding, the fields of a frame are taken
+ one after the other. The encoder reuses the buffer, so the picture must be copied to be kept beyond the next push.
+ \param rpcPicYuvRec  set to the reconstructed picture
+ \retval              false if all the pictures have been taken
+ */
+Bool TAppEncSession::getReconstruction( TComPicYuv*& rpcPicYuvRec )
+{
+  if ( m_recons.empty() )
+  {
+    return false;
+  }
+
+  rpcPicYuvRec = m_recons.front();
+  m_recons.pop_front();
+  return true;
+}
+
+// ====================================================================================================================
+// Protected member functions
+// ====================================================================================================================
+
+/**
+ - call the encoding function for one frame, or to flush the encoder
+ - queue the reconstructed pictures and the Annex B bytes of the access units output by the encoder
+ .
+ */
+Void TAppEncSession::xEncode( Bool bFlush, TComPicYuv* pcPicYuvOrg, TComPicYuv* pcPicYuvTrueOrg )
+{
+  const InputColourSpaceConversion snrCSC = (!m_pcCfg->m_snrInternalColourSpace) ? m_pcCfg->m_inputColourSpaceConvert : IPCOLOURSPACE_UNCHANGED;
+
+  // the buffers of the pictures not taken may be reused by the encoder
+  m_recons.clear();
+
+  // get buffers
+  TComPicYuv* pcPicYuvRec = NULL;
+  xGetBuffer( pcPicYuvRec );
+
+  // call encoding function for one frame
+  list<AccessUnit> outputAccessUnits;
+  Int              iNumEncoded = 0;
+  if ( m_pcCfg->m_isField )
+  {
+    m_cTEncTop.encode( m_bEos, bFlush ? 0 : pcPicYuvOrg, bFlush ? 0 : pcPicYuvTrueOrg, snrCSC, m_cListPicYuvRec, outputAccessUnits, iNumEncoded, m_pcCfg->m_isTopFieldFirst );
+  }
+  else
+  {
+    m_cTEncTop.encode( m_bEos, bFlush ? 0 : pcPicYuvOrg, bFlush ? 0 : pcPicYuvTrueOrg, snrCSC, m_cListPicYuvRec, outputAccessUnits, iNumEncoded );
+  }
+
+  // the pictures encoded are the last ones of the buffer list
+  TComList<TComPicYuv*>::iterator iterPicYuvRec = m_cListPicYuvRec.end();
+  for ( Int i = 0; i < iNumEncoded; i++ )
+  {
+    --iterPicYuvRec;
+  }
+  for ( Int i = 0; i < iNumEncoded; i++ )
+  {
+    m_recons.push_back( *(iterPicYuvRec++) );
+  }
+
+  for ( list<AccessUnit>::const_iterator iterBitstream = outputAccessUnits.begin(); iterBitstream != outputAccessUnits.end(); iterBitstream++ )
+  {
+    ostringstream accessUnitBytes;
+    const vector<UInt>& stats = writeAnnexB( accessUnitBytes, *iterBitstream );
+    xRateStatsAccum( *iterBitstream, stats );
+    m_accessUnits.push_back( accessUnitBytes.str() );
+  }
+}
+
+/**
+ - the session has a picture buffer list with the size of the GOP
+ - the picture buffer list acts as a ring buffer
+ - the end of the list has the latest picture
+ .
+ */
+Void TAppEncSession::xGetBuffer( TComPicYuv*& rpcPicYuvRec )
+{
+  assert( m_pcCfg->m_iGOPSize > 0 );
+
+  if ( m_cListPicYuvRec.size() >= (UInt)m_pcCfg->m_iGOPSize ) // buffer will be 1 element longer when using field coding, to maintain first field whilst processing second.
+  {
+    rpcPicYuvRec = m_cListPicYuvRec.popFront();
+  }
+  else
+  {
+    const TAppEncCfg& cfg = *m_pcCfg;
+    rpcPicYuvRec = new TComPicYuv;
+    rpcPicYuvRec->create( cfg.m_iSourceWidth, cfg.m_iSourceHeight, cfg.m_chromaFormatIDC, cfg.m_uiMaxCUWidth, cfg.m_uiMaxCUHeight, cfg.m_uiMaxTotalCUDepth, true );
+  }
+  m_cListPicYuvRec.pushBack( rpcPicYuvRec );
+}
+
+Void TAppEncSession::xDeleteBuffer()
+{
+  TComList<TComPicYuv*>::iterator iterPicYuvRec = m_cListPicYuvRec.begin();
+
+  Int iSize = Int( m_cListPicYuvRec.size() );
+
+  for ( Int i = 0; i < iSize; i++ )
+  {
+    TComPicYuv*  pcPicYuvRec  = *(iterPicYuvRec++);
+    pcPicYuvRec->destroy();
+    delete pcPicYuvRec; pcPicYuvRec = NULL;
+  }
+  m_cListPicYuvRec.clear();
+}
+
+Void TAppEncSession::xRateStatsAccum( const AccessUnit& au, const std::vector<UInt>& annexBsizes )
+{
+  AccessUnit::const_iterator it_au = au.begin();
+  vector<UInt>::const_iterator it_stats = annexBsizes.begin();
+
+  for (; it_au != au.end(); it_au++, it_stats++)
+  {
+    switch ((*it_au)->m_nalUnitType)
+    {
+    case NAL_UNIT_CODED_SLICE_TRAIL_R:
+    case NAL_UNIT_CODED_SLICE_TRAIL_N:
+    case NAL_UNIT_CODED_SLICE_TSA_R:
+    case NAL_UNIT_CODED_SLICE_TSA_N:
+    case NAL_UNIT_CODED_SLICE_STSA_R:
+    case NAL_UNIT_CODED_SLICE_STSA_N:
+    case NAL_UNIT_CODED_SLICE_BLA_W_LP:
+    case NAL_UNIT_CODED_SLICE_BLA_W_RADL:
+    case NAL_UNIT_CODED_SLICE_BLA_N_LP:
+    case NAL_UNIT_CODED_SLICE_IDR_W_RADL:
+    case NAL_UNIT_CODED_SLICE_IDR_N_LP:
+    case NAL_UNIT_CODED_SLICE_CRA:
+    case NAL_UNIT_CODED_SLICE_RADL_N:
+    case NAL_UNIT_CODED_SLICE_RADL_R:
+    case NAL_UNIT_CODED_SLICE_RASL_N:
+    case NAL_UNIT_CODED_SLICE_RASL_R:
+    case NAL_UNIT_VPS:
+    case NAL_UNIT_SPS:
+    case NAL_UNIT_PPS:
+      m_essentialBytes += *it_stats;
+      break;
+    default:
+      break;
+    }
+
+    m_totalBytes += *it_stats;
+  }
+}
+
+//! \}
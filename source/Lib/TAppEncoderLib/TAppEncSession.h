@@ -0,0 +1,131 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2016, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TAppEncSession.h
+    \brief    In-memory encoder session (header)
+*/
+
+#ifndef __TAPPENCSESSION__
+#define __TAPPENCSESSION__
+
+#include <deque>
+#include <istream>
+#include <streambuf>
+#include <string>
+
+#include "TLibEncoder/TEncTop.h"
+#include "TLibVideoIO/TVideoIOYuv.h"
+#include "TAppEncCfg.h"
+
+//! \ingroup TAppEncoderLib
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/**
+  Encoder session that takes source frames from memory and returns the access units as bytes, without any file.
+
+  The configuration is parsed once into a TAppEncCfg, as for the console encoder, and can then be used by any number
+  of sessions. Frames are pushed in display order, either as TComPicYuv pictures or as raw frames laid out as in an
+  input YUV file; the session ends when FramesToBeEncoded frames have been pushed, or on flush(). The access units
+  of the pictures encoded by each push are then taken in decoding order, and the reconstructed pictures in output
+  order.
+
+  The encoder library shares global tables between its instances, so the sessions of a process must be run one
+  after the other: a session must be closed before the next one is opened.
+ */
+class TAppEncSession
+{
+private:
+  /// stream buffer over a raw frame held by the caller
+  class RawFrameBuffer : public std::streambuf
+  {
+  public:
+    Void set( const UChar* data, UInt64 size ) { TChar* p = (TChar*)data; setg( p, p, p + size ); }
+  };
+
+  TAppEncCfg*                m_pcCfg;                       ///< configuration of the session
+  TEncTop                    m_cTEncTop;                    ///< encoder class
+  TComList<TComPicYuv*>      m_cListPicYuvRec;              ///< list of reconstruction YUV buffers
+
+  Int                        m_iFrameRcvd;                  ///< number of received frames
+  Bool                       m_bEos;                        ///< the last frame has been pushed, or the session flushed
+
+  std::deque<std::string>    m_accessUnits;                 ///< Annex B bytes of the access units not taken yet
+  std::deque<TComPicYuv*>    m_recons;                      ///< reconstructed pictures of the last push not taken yet
+
+  UInt                       m_essentialBytes;              ///< bytes of the parameter sets and slices
+  UInt                       m_totalBytes;                  ///< bytes of all the access units
+
+  RawFrameBuffer             m_cRawFrameBuffer;             ///< raw frame of pushRawFrame()
+  std::istream               m_cRawFrameStream;             ///< stream over m_cRawFrameBuffer
+  TVideoIOYuv                m_cRawFrameReader;             ///< converts raw frames as the input file of the console encoder
+  TComPicYuv                 m_cPicYuvRawOrg;               ///< original picture of a raw frame
+  TComPicYuv                 m_cPicYuvRawTrueOrg;           ///< raw frame in its original colour space
+
+  Void  xGetBuffer        ( TComPicYuv*& rpcPicYuvRec );    ///< obtain a reconstruction buffer
+  Void  xDeleteBuffer     ();                               ///< delete the reconstruction buffers
+  Void  xEncode           ( Bool bFlush, TComPicYuv* pcPicYuvOrg, TComPicYuv* pcPicYuvTrueOrg ); ///< encode and queue the output
+  Void  xRateStatsAccum   ( const AccessUnit& au, const std::vector<UInt>& annexBsizes );
+
+public:
+  TAppEncSession();
+  virtual ~TAppEncSession();
+
+  Void  open              ( TAppEncCfg& cfg );              ///< create and initialise the encoder; cfg must outlive the session
+  Void  close             ( Bool bPrintSummary = false );   ///< print the summary if requested and destroy the encoder
+
+  /// encode one source frame (a field pair when field coding), false once the session has ended
+  Bool  pushFrame         ( TComPicYuv* pcPicYuvOrg, TComPicYuv* pcPicYuvTrueOrg );
+  /// encode one frame laid out as in the input file: InputBitDepth, InputChromaFormat and InputColourSpaceConvert
+  Bool  pushRawFrame      ( const UChar* data, UInt64 size );
+  Void  flush             ();                               ///< end the session and encode the queued frames
+
+  /// take the next access unit in decoding order, in the Annex B byte stream format
+  Bool  getAccessUnit     ( std::string& bytes );
+  /// take the next reconstructed picture, or field, in output order; valid until the next push or flush
+  Bool  getReconstruction ( TComPicYuv*& rpcPicYuvRec );
+
+  Bool  isEos             () const { return m_bEos; }
+  Int   getNumFramesRcvd  () const { return m_iFrameRcvd; }
+  UInt  getEssentialBytes () const { return m_essentialBytes; }
+  UInt  getTotalBytes     () const { return m_totalBytes; }
+  TEncTop& getTEncTop     ()       { return m_cTEncTop; }
+
+};// END CLASS DEFINITION TAppEncSession
+
+//! \}
+
+#endif // __TAPPENCSESSION__
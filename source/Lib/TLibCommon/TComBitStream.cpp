@@ -90,13 +90,25 @@ Void TComInputBitstream::resetToStart()
   m_numBitsRead=0;
 }
 
-UChar* TComOutputBitstream::getByteStream() const
+Void TComInputBitstream::swap(TComInputBitstream &other)
 {
+  m_fifo.swap(other.m_fifo);
+  m_emulationPreventionByteLocation.swap(other.m_emulationPreventionByteLocation);
+  std::swap(m_fifo_idx,      other.m_fifo_idx);
+  std::swap(m_num_held_bits, other.m_num_held_bits);
+  std::swap(m_held_bits,     other.m_held_bits);
+  std::swap(m_numBitsRead,   other.m_numBitsRead);
+}
+
+UChar* TComOutputBitstream::getByteStream()
+{
+  xFlushHeldBytes();
   return (UChar*) &m_fifo.front();
 }
 
 UInt TComOutputBitstream::getByteStreamLength()
 {
+  xFlushHeldBytes();
   return UInt(m_fifo.size());
 }
 
@@ -112,43 +124,20 @@ Void TComOutputBitstream::write   ( UInt uiBits, UInt uiNumberOfBits )
   assert( uiNumberOfBits <= 32 );
   assert( uiNumberOfBits == 32 || (uiBits & (~0 << uiNumberOfBits)) == 0 );
 
-  /* any modulo 8 remainder of num_total_bits cannot be written this time,
-   * and will be held until next time. */
-  UInt num_total_bits = uiNumberOfBits + m_num_held_bits;
-  UInt next_num_held_bits = num_total_bits % 8;
-
-  /* form a byte aligned word (write_bits), by concatenating any held bits
-   * with the new bits, discarding the bits that will form the next_held_bits.
-   * eg: H = held bits, V = n new bits        /---- next_held_bits
-   * len(H)=7, len(V)=1: ... ---- HHHH HHHV . 0000 0000, next_num_held_bits=0
-   * len(H)=7, len(V)=2: ... ---- HHHH HHHV . V000 0000, next_num_held_bits=1
-   * if total_bits < 8, the value of v_ is not used */
-  UChar next_held_bits = uiBits << (8 - next_num_held_bits);
-
-  if (!(num_total_bits >> 3))
-  {
-    /* insufficient bits accumulated to write out, append new_held_bits to
-     * current held_bits */
-    /* NB, this requires that v only contains 0 in bit positions {31..n} */
-    m_held_bits |= next_held_bits;
-    m_num_held_bits = next_num_held_bits;
-    return;
-  }
-
-  /* topword serves to justify held_bits to align with the msb of uiBits */
-  UInt topword = (uiNumberOfBits - next_num_held_bits) & ~((1 << 3) -1);
-  UInt write_bits = (m_held_bits << topword) | (uiBits >> next_num_held_bits);
+  /* append the new bits below the held bits. Fewer than 32 bits are held
+   * between calls, so the accumulator cannot overflow; any bits above the
+   * m_num_held_bits least significant ones are stale and never read. */
+  m_held_bits = (m_held_bits << uiNumberOfBits) | uiBits;
+  m_num_held_bits += uiNumberOfBits;
 
-  switch (num_total_bits >> 3)
+  if (m_num_held_bits >= 32)
   {
-  case 4: m_fifo.push_back(write_bits >> 24);
-  case 3: m_fifo.push_back(write_bits >> 16);
-  case 2: m_fifo.push_back(write_bits >> 8);
-  case 1: m_fifo.push_back(write_bits);
+    /* flush a complete 32-bit word, most significant byte first */
+    m_num_held_bits -= 32;
+    const UInt write_bits = UInt(m_held_bits >> m_num_held_bits);
+    const uint8_t bytes[4] = { uint8_t(write_bits >> 24), uint8_t(write_bits >> 16), uint8_t(write_bits >> 8), uint8_t(write_bits) };
+    m_fifo.insert(m_fifo.end(), bytes, bytes + 4);
   }
-
-  m_held_bits = next_held_bits;
-  m_num_held_bits = next_num_held_bits;
 }
 
 Void TComOutputBitstream::writeAlignOne()
@@ -160,13 +149,7 @@ Void TComOutputBitstream::writeAlignOne()
 
 Void TComOutputBitstream::writeAlignZero()
 {
-  if (0 == m_num_held_bits)
-  {
-    return;
-  }
-  m_fifo.push_back(m_held_bits);
-  m_held_bits = 0;
-  m_num_held_bits = 0;
+  write(0, getNumBitsUntilByteAligned());
 }
 
 /**
@@ -179,9 +162,24 @@ Void   TComOutputBitstream::addSubstream( TComOutputBitstream* pcSubstream )
   UInt uiNumBits = pcSubstream->getNumberOfWrittenBits();
 
   const vector<uint8_t>& rbsp = pcSubstream->getFIFO();
-  for (vector<uint8_t>::const_iterator it = rbsp.begin(); it != rbsp.end();)
+  xFlushHeldBytes();
+  if (m_num_held_bits == 0)
   {
-    write(*it++, 8);
+    // byte-aligned: copy the complete bytes directly
+    m_fifo.insert(m_fifo.end(), rbsp.begin(), rbsp.end());
+  }
+  else
+  {
+    const UInt numBytes = UInt(rbsp.size());
+    UInt i = 0;
+    for (; i + 4 <= numBytes; i += 4)
+    {
+      write((rbsp[i] << 24) | (rbsp[i + 1] << 16) | (rbsp[i + 2] << 8) | rbsp[i + 3], 32);
+    }
+    for (; i < numBytes; i++)
+    {
+      write(rbsp[i], 8);
+    }
   }
   if (uiNumBits&0x7)
   {
@@ -238,7 +236,7 @@ Int TComOutputBitstream::countStartCodeEmulations()
 Void TComInputBitstream::pseudoRead ( UInt uiNumberOfBits, UInt& ruiBits )
 {
   UInt saved_num_held_bits = m_num_held_bits;
-  UChar saved_held_bits = m_held_bits;
+  UInt64 saved_held_bits = m_held_bits;
   UInt saved_fifo_idx = m_fifo_idx;
 
   UInt num_bits_to_read = min(uiNumberOfBits, getNumBitsLeft());
@@ -251,66 +249,46 @@ Void TComInputBitstream::pseudoRead ( UInt uiNumberOfBits, UInt& ruiBits )
 }
 
 
-Void TComInputBitstream::read (UInt uiNumberOfBits, UInt& ruiBits)
+/**
+ * load whole bytes from the FIFO into the accumulator until it holds more than
+ * 56 bits or the FIFO is exhausted.
+ */
+Void TComInputBitstream::xRefill()
 {
-  assert( uiNumberOfBits <= 32 );
-
-  m_numBitsRead += uiNumberOfBits;
+  const UInt fifoSize = UInt(m_fifo.size());
 
-  /* NB, bits are extracted from the MSB of each byte. */
-  UInt retval = 0;
-  if (uiNumberOfBits <= m_num_held_bits)
+  if (m_num_held_bits == 0 && m_fifo_idx + 8 <= fifoSize)
   {
-    /* n=1, len(H)=7:   -VHH HHHH, shift_down=6, mask=0xfe
-     * n=3, len(H)=7:   -VVV HHHH, shift_down=4, mask=0xf8
-     */
-    retval = m_held_bits >> (m_num_held_bits - uiNumberOfBits);
-    retval &= ~(0xff << uiNumberOfBits);
-    m_num_held_bits -= uiNumberOfBits;
-    ruiBits = retval;
+    const uint8_t *p = &m_fifo[m_fifo_idx];
+    m_held_bits = (UInt64(p[0]) << 56) | (UInt64(p[1]) << 48) | (UInt64(p[2]) << 40) | (UInt64(p[3]) << 32)
+                | (UInt64(p[4]) << 24) | (UInt64(p[5]) << 16) | (UInt64(p[6]) <<  8) |  UInt64(p[7]);
+    m_num_held_bits = 64;
+    m_fifo_idx += 8;
     return;
   }
 
-  /* all num_held_bits will go into retval
-   *   => need to mask leftover bits from previous extractions
-   *   => align retval with top of extracted word */
-  /* n=5, len(H)=3: ---- -VVV, mask=0x07, shift_up=5-3=2,
-   * n=9, len(H)=3: ---- -VVV, mask=0x07, shift_up=9-3=6 */
-  uiNumberOfBits -= m_num_held_bits;
-  retval = m_held_bits & ~(0xff << m_num_held_bits);
-  retval <<= uiNumberOfBits;
-
-  /* number of whole bytes that need to be loaded to form retval */
-  /* n=32, len(H)=0, load 4bytes, shift_down=0
-   * n=32, len(H)=1, load 4bytes, shift_down=1
-   * n=31, len(H)=1, load 4bytes, shift_down=1+1
-   * n=8,  len(H)=0, load 1byte,  shift_down=0
-   * n=8,  len(H)=3, load 1byte,  shift_down=3
-   * n=5,  len(H)=1, load 1byte,  shift_down=1+3
-   */
-  UInt aligned_word = 0;
-  UInt num_bytes_to_load = (uiNumberOfBits - 1) >> 3;
-  assert(m_fifo_idx + num_bytes_to_load < m_fifo.size());
-
-  switch (num_bytes_to_load)
+  while (m_num_held_bits <= 56 && m_fifo_idx < fifoSize)
   {
-  case 3: aligned_word  = m_fifo[m_fifo_idx++] << 24;
-  case 2: aligned_word |= m_fifo[m_fifo_idx++] << 16;
-  case 1: aligned_word |= m_fifo[m_fifo_idx++] <<  8;
-  case 0: aligned_word |= m_fifo[m_fifo_idx++];
+    m_held_bits = (m_held_bits << 8) | m_fifo[m_fifo_idx++];
+    m_num_held_bits += 8;
   }
+}
 
-  /* resolve remainder bits */
-  UInt next_num_held_bits = (32 - uiNumberOfBits) % 8;
+Void TComInputBitstream::read (UInt uiNumberOfBits, UInt& ruiBits)
+{
+  assert( uiNumberOfBits <= 32 );
 
-  /* copy required part of aligned_word into retval */
-  retval |= aligned_word >> next_num_held_bits;
+  m_numBitsRead += uiNumberOfBits;
 
-  /* store held bits */
-  m_num_held_bits = next_num_held_bits;
-  m_held_bits = aligned_word;
+  /* NB, bits are extracted from the MSB of each byte. */
+  if (uiNumberOfBits > m_num_held_bits)
+  {
+    xRefill();
+    assert(uiNumberOfBits <= m_num_held_bits);
+  }
 
-  ruiBits = retval;
+  m_num_held_bits -= uiNumberOfBits;
+  ruiBits = UInt(m_held_bits >> m_num_held_bits) & UInt((UInt64(1) << uiNumberOfBits) - 1);
 }
 
 /**
@@ -322,8 +300,18 @@ Void TComOutputBitstream::insertAt(const TComOutputBitstream& src, UInt pos)
   UInt src_bits = src.getNumberOfWrittenBits();
   assert(0 == src_bits % 8);
 
+  xFlushHeldBytes();
+  m_fifo.reserve(m_fifo.size() + (src_bits >> 3));
+
   vector<uint8_t>::iterator at = m_fifo.begin() + pos;
-  m_fifo.insert(at, src.m_fifo.begin(), src.m_fifo.end());
+  at = m_fifo.insert(at, src.m_fifo.begin(), src.m_fifo.end()) + src.m_fifo.size();
+
+  // complete bytes still held in the accumulator of src
+  for (UInt num_held_bits = src.m_num_held_bits; num_held_bits != 0; )
+  {
+    num_held_bits -= 8;
+    at = m_fifo.insert(at, uint8_t(src.m_held_bits >> num_held_bits)) + 1;
+  }
 }
 
 UInt TComInputBitstream::readOutTrailingBits ()
@@ -363,8 +351,9 @@ TComInputBitstream *TComInputBitstream::extractSubstream( UInt uiNumBits )
   std::vector<uint8_t> &buf = pResult->getFifo();
   buf.reserve((uiNumBits+7)>>3);
 
-  if (m_num_held_bits == 0)
+  if ((m_num_held_bits & 0x7) == 0)
   {
+    xReleaseHeldBytes();
     std::size_t currentOutputBufferSize=buf.size();
     const UInt uiNumBytesToReadFromFifo = std::min<UInt>(uiNumBytes, (UInt)m_fifo.size() - m_fifo_idx);
     buf.resize(currentOutputBufferSize+uiNumBytes);
@@ -376,7 +365,17 @@ TComInputBitstream *TComInputBitstream::extractSubstream( UInt uiNumBits )
   }
   else
   {
-    for (UInt ui = 0; ui < uiNumBytes; ui++)
+    UInt ui = 0;
+    for (; ui + 4 <= uiNumBytes; ui += 4)
+    {
+      UInt uiWord;
+      read(32, uiWord);
+      buf.push_back(uiWord >> 24);
+      buf.push_back(uiWord >> 16);
+      buf.push_back(uiWord >>  8);
+      buf.push_back(uiWord);
+    }
+    for (; ui < uiNumBytes; ui++)
     {
       UInt uiByte;
       read(8, uiByte);
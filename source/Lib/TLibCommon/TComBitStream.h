@@ -82,9 +82,20 @@ class TComOutputBitstream : public TComBitIf
    */
   std::vector<uint8_t> m_fifo;
 
-  UInt m_num_held_bits; /// number of bits not flushed to bytestream.
-  UChar m_held_bits; /// the bits held and not flushed to bytestream.
-                             /// this value is always msb-aligned, bigendian.
+  UInt   m_num_held_bits; /// number of bits not flushed to bytestream (fewer than 32 between calls).
+  UInt64 m_held_bits;     /// accumulator holding the bits not flushed to bytestream.
+                          /// the held bits are the m_num_held_bits least significant bits.
+
+  /** move all complete bytes from the accumulator to the FIFO, leaving fewer than 8 bits held */
+  Void        xFlushHeldBytes ()
+  {
+    while (m_num_held_bits >= 8)
+    {
+      m_num_held_bits -= 8;
+      m_fifo.push_back(uint8_t(m_held_bits >> m_num_held_bits));
+    }
+  }
+
 public:
   // create / destroy
   TComOutputBitstream();
@@ -114,7 +125,7 @@ public:
    * NB, data is arranged such that subsequent bytes in the
    * bytestream are stored in ascending addresses.
    */
-  UChar* getByteStream() const;
+  UChar* getByteStream();
 
   /**
    * Return the number of valid bytes available from  getByteStream()
@@ -126,6 +137,11 @@ public:
    */
   Void clear();
 
+  /**
+   * Pre-allocate the FIFO so that numBytes bytes can be held without reallocation.
+   */
+  Void reserve( UInt numBytes ) { m_fifo.reserve(numBytes); }
+
   /**
    * returns the number of bits that need to be written to
    * achieve byte alignment.
@@ -140,15 +156,14 @@ public:
   Void insertAt(const TComOutputBitstream& src, UInt pos);
 
   /**
-   * Return a reference to the internal fifo
+   * Return a reference to the internal fifo, after flushing all complete bytes to it
    */
-  std::vector<uint8_t>& getFIFO() { return m_fifo; }
+  std::vector<uint8_t>& getFIFO() { xFlushHeldBytes(); return m_fifo; }
 
-  UChar getHeldBits  ()          { return m_held_bits;          }
+  /** Return the bits that do not form a complete byte, msb-aligned */
+  UChar getHeldBits  ()          { xFlushHeldBytes(); return UChar(m_held_bits << (8 - m_num_held_bits)); }
 
   //TComOutputBitstream& operator= (const TComOutputBitstream& src);
-  /** Return a reference to the internal fifo */
-  const std::vector<uint8_t>& getFIFO() const { return m_fifo; }
 
   Void          addSubstream    ( TComOutputBitstream* pcSubstream );
   Void writeByteAlignment();
@@ -169,9 +184,22 @@ protected:
 
   UInt m_fifo_idx; /// Read index into m_fifo
 
-  UInt m_num_held_bits;
-  UChar m_held_bits;
-  UInt  m_numBitsRead;
+  UInt   m_num_held_bits; /// number of bits loaded from m_fifo but not yet read (a multiple of 8 plus any partial byte)
+  UInt64 m_held_bits;     /// accumulator; the held bits are the m_num_held_bits least significant bits
+  UInt   m_numBitsRead;
+
+  Void        xRefill         ();
+
+  /** return the complete bytes held in the accumulator to the FIFO, so that m_fifo_idx is the read position.
+   * The unread bits of a partially read byte are kept; they sit above the returned bytes in the accumulator. */
+  Void        xReleaseHeldBytes()
+  {
+    const UInt numHeldBytes = m_num_held_bits >> 3;
+    m_fifo_idx      -= numHeldBytes;
+    m_num_held_bits &= 0x7;
+    // 8 held bytes fill the accumulator, and leave no partial byte
+    m_held_bits      = numHeldBytes < 8 ? m_held_bits >> (numHeldBytes << 3) : 0;
+  }
 
 public:
   /**
@@ -182,26 +210,42 @@ public:
   TComInputBitstream(const TComInputBitstream &src);
 
   Void resetToStart();
+  Void swap        ( TComInputBitstream &other ); ///< exchange the contents of two bitstreams without copying their bytes
 
   // interface for decoding
   Void        pseudoRead      ( UInt uiNumberOfBits, UInt& ruiBits );
   Void        read            ( UInt uiNumberOfBits, UInt& ruiBits );
   Void        readByte        ( UInt &ruiBits )
   {
+    if (m_num_held_bits != 0)
+    {
+      assert((m_num_held_bits & 0x7) == 0);
+      xReleaseHeldBytes();
+    }
     assert(m_fifo_idx < m_fifo.size());
     ruiBits = m_fifo[m_fifo_idx++];
   }
 
   Void        peekPreviousByte( UInt &byte )
   {
+    xReleaseHeldBytes();
     assert(m_fifo_idx > 0);
     byte = m_fifo[m_fifo_idx - 1];
   }
 
+  /** step back over the last numBytes whole bytes obtained with readByte() */
+  Void        unreadBytes     ( UInt numBytes )
+  {
+    assert((m_num_held_bits & 0x7) == 0);
+    xReleaseHeldBytes();
+    assert(numBytes <= m_fifo_idx);
+    m_fifo_idx -= numBytes;
+  }
+
   UInt        readOutTrailingBits ();
-  UChar getHeldBits  ()          { return m_held_bits;          }
+  UChar getHeldBits  ()          { return UChar(m_held_bits);   }
   TComOutputBitstream& operator= (const TComOutputBitstream& src);
-  UInt  getByteLocation              ( )                     { return m_fifo_idx                    ; }
+  UInt  getByteLocation              ( )                     { return m_fifo_idx - (m_num_held_bits >> 3); }
 
   // Peek at bits in word-storage. Used in determining if we have completed reading of current bitstream and therefore slice in LCEC.
   UInt        peekBits (UInt uiBits) { UInt tmp; pseudoRead(uiBits, tmp); return tmp; }
@@ -942,7 +942,13 @@ Void TComDataCU::copyPartFrom( TComDataCU* pcCU, UInt uiPartUnitIdx, UInt uiDept
 
 // Copy current predicted part to a CU in picture.
 // It is used to predict for next part
-Void TComDataCU::copyToPic( UChar uhDepth )
+// The ARL coefficients are only copied when requested: the CTUs of a picture share one ARL buffer, which is only read
+// by the adaptive QP selection, and the CTUs are not compressed in parallel when it is enabled.
+Void TComDataCU::copyToPic( UChar uhDepth
+#if ADAPTIVE_QP_SELECTION
+                          , Bool bCopyArlCoeff
+#endif
+                          )
 {
   TComDataCU* pCtu = m_pcPic->getCtu( m_ctuRsAddr );
   const UInt numValidComp=pCtu->getPic()->getNumberValidComponents();
@@ -1009,7 +1015,10 @@ Void TComDataCU::copyToPic( UChar uhDepth )
     const UInt componentShift   = m_pcPic->getComponentScaleX(component) + m_pcPic->getComponentScaleY(component);
     memcpy( pCtu->getCoeff(component)   + (offsetY>>componentShift), m_pcTrCoeff[component], sizeof(TCoeff)*(numCoeffY>>componentShift) );
 #if ADAPTIVE_QP_SELECTION
-    memcpy( pCtu->getArlCoeff(component) + (offsetY>>componentShift), m_pcArlCoeff[component], sizeof(TCoeff)*(numCoeffY>>componentShift) );
+    if (bCopyArlCoeff)
+    {
+      memcpy( pCtu->getArlCoeff(component) + (offsetY>>componentShift), m_pcArlCoeff[component], sizeof(TCoeff)*(numCoeffY>>componentShift) );
+    }
 #endif
     memcpy( pCtu->getPCMSample(component) + (offsetY>>componentShift), m_pcIPCMSample[component], sizeof(Pel)*(numCoeffY>>componentShift) );
   }
@@ -2946,7 +2955,7 @@ Bool TComDataCU::xAddMVPCandWithScaling( AMVPInfo &info, const RefPicList eRefPi
 
   const Int  currPOC            = m_pcSlice->getPOC();
   const Int  currRefPOC         = m_pcSlice->getRefPic( eRefPicList, iRefIdx)->getPOC();
-  const Bool bIsCurrRefLongTerm = m_pcSlice->getRefPic( eRefPicList, iRefIdx)->getIsLongTerm();
+  const Bool bIsCurrRefLongTerm = m_pcSlice->getIsUsedAsLongTerm( eRefPicList, iRefIdx);
   const Int  neibPOC            = currPOC;
 
   for(Int predictorSource=0; predictorSource<2; predictorSource++) // examine the indicated reference picture list, then if not available, examine the other list.
@@ -2955,7 +2964,7 @@ Bool TComDataCU::xAddMVPCandWithScaling( AMVPInfo &info, const RefPicList eRefPi
     const Int        neibRefIdx       = neibCU->getCUMvField(eRefPicListIndex)->getRefIdx(neibPUPartIdx);
     if( neibRefIdx >= 0)
     {
-      const Bool bIsNeibRefLongTerm = neibCU->getSlice()->getRefPic( eRefPicListIndex, neibRefIdx )->getIsLongTerm();
+      const Bool bIsNeibRefLongTerm = neibCU->getSlice()->getIsUsedAsLongTerm( eRefPicListIndex, neibRefIdx );
 
       if ( bIsCurrRefLongTerm == bIsNeibRefLongTerm )
       {
@@ -2989,8 +2998,6 @@ Bool TComDataCU::xAddMVPCandWithScaling( AMVPInfo &info, const RefPicList eRefPi
 
 Bool TComDataCU::xGetColMVP( const RefPicList eRefPicList, const Int ctuRsAddr, const Int partUnitIdx, TComMv& rcMv, const Int refIdx ) const
 {
-  const UInt absPartAddr = partUnitIdx;
-
   // use coldir.
   const TComPic    * const pColPic = getSlice()->getRefPic( RefPicList(getSlice()->isInterB() ? 1-getSlice()->getColFromL0Flag() : 0), getSlice()->getColRefIdx());
   const TComDataCU * const pColCtu = pColPic->getCtu( ctuRsAddr );
@@ -2999,6 +3006,11 @@ Bool TComDataCU::xGetColMVP( const RefPicList eRefPicList, const Int ctuRsAddr,
     return false;
   }
 
+  // The motion is read from the first partition of its compression block (see compressMV), so that the result does not depend on
+  // whether the motion of the collocated picture has been compressed yet.
+  const Int  compressionScale = 4 * AMVP_DECIMATION_FACTOR / pColCtu->m_unitSize;
+  const UInt absPartAddr      = compressionScale > 0 ? ( partUnitIdx & ~( compressionScale * compressionScale - 1 ) ) : partUnitIdx;
+
   if (!pColCtu->isInter(absPartAddr))
   {
     return false;
@@ -3018,7 +3030,7 @@ Bool TComDataCU::xGetColMVP( const RefPicList eRefPicList, const Int ctuRsAddr,
     }
   }
 
-  const Bool bIsCurrRefLongTerm = m_pcSlice->getRefPic(eRefPicList, refIdx)->getIsLongTerm();
+  const Bool bIsCurrRefLongTerm = m_pcSlice->getIsUsedAsLongTerm(eRefPicList, refIdx);
   const Bool bIsColRefLongTerm  = pColCtu->getSlice()->getIsUsedAsLongTerm(eColRefPicList, iColRefIdx);
 
   if ( bIsCurrRefLongTerm != bIsColRefLongTerm )
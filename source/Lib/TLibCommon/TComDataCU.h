@@ -189,7 +189,11 @@ public:
   Void          copyInterPredInfoFrom         ( TComDataCU* pcCU, UInt uiAbsPartIdx, RefPicList eRefPicList );
   Void          copyPartFrom                  ( TComDataCU* pcCU, UInt uiPartUnitIdx, UInt uiDepth );
 
-  Void          copyToPic                     ( UChar uiDepth );
+  Void          copyToPic                     ( UChar uiDepth
+#if ADAPTIVE_QP_SELECTION
+                                                , Bool bCopyArlCoeff
+#endif
+                                              );
 
   // -------------------------------------------------------------------------------------------------------------------
   // member functions for CU description
@@ -73,6 +73,9 @@ const UChar TComLoopFilter::sm_betaTable[MAX_QP + 1] =
 TComLoopFilter::TComLoopFilter()
 : m_uiNumPartitions(0)
 , m_bLFCrossTileBoundary(true)
+, m_uiMaxCUDepth(0)
+, m_pcRowFilters(NULL)
+, m_numRowFilters(0)
 {
   for( Int edgeDir = 0; edgeDir < NUM_EDGE_DIR; edgeDir++ )
   {
@@ -96,6 +99,7 @@ Void TComLoopFilter::setCfg( Bool bLFCrossTileBoundary )
 Void TComLoopFilter::create( UInt uiMaxCUDepth )
 {
   destroy();
+  m_uiMaxCUDepth    = uiMaxCUDepth;
   m_uiNumPartitions = 1 << ( uiMaxCUDepth<<1 );
   for( Int edgeDir = 0; edgeDir < NUM_EDGE_DIR; edgeDir++ )
   {
@@ -120,6 +124,10 @@ Void TComLoopFilter::destroy()
       m_aapbEdgeFilter[edgeDir] = NULL;
     }
   }
+
+  delete [] m_pcRowFilters;
+  m_pcRowFilters  = NULL;
+  m_numRowFilters = 0;
 }
 
 /**
@@ -127,37 +135,105 @@ Void TComLoopFilter::destroy()
  .
  \param  pcPic   picture class (TComPic) pointer
  */
-Void TComLoopFilter::loopFilterPic( TComPic* pcPic )
+Void TComLoopFilter::loopFilterPic( TComPic* pcPic, TComThreadPool* pcThreadPool, Int threadIdx )
 {
-  // Horizontal filtering
-  for ( UInt ctuRsAddr = 0; ctuRsAddr < pcPic->getNumberOfCtusInFrame(); ctuRsAddr++ )
+  if ( pcThreadPool != NULL && pcThreadPool->getNumThreads() > 0 && pcPic->getFrameHeightInCtus() > 1 )
   {
-    TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
-
-    ::memset( m_aapucBS       [EDGE_VER], 0, sizeof( UChar ) * m_uiNumPartitions );
-    ::memset( m_aapbEdgeFilter[EDGE_VER], 0, sizeof( Bool  ) * m_uiNumPartitions );
+    xLoopFilterPicRows( pcPic, pcThreadPool, threadIdx );
+    return;
+  }
 
-    // CU-based deblocking
-    xDeblockCU( pCtu, 0, 0, EDGE_VER );
+  // Horizontal filtering
+  for ( UInt ctuRow = 0; ctuRow < pcPic->getFrameHeightInCtus(); ctuRow++ )
+  {
+    xDeblockCtuRow( pcPic, ctuRow, EDGE_VER );
   }
 
   // Vertical filtering
-  for ( UInt ctuRsAddr = 0; ctuRsAddr < pcPic->getNumberOfCtusInFrame(); ctuRsAddr++ )
+  for ( UInt ctuRow = 0; ctuRow < pcPic->getFrameHeightInCtus(); ctuRow++ )
+  {
+    xDeblockCtuRow( pcPic, ctuRow, EDGE_HOR );
+  }
+}
+
+
+// ====================================================================================================================
+// Protected member functions
+// ====================================================================================================================
+
+Void TComLoopFilter::xDeblockCtuRow( TComPic* pcPic, UInt ctuRow, DeblockEdgeDir edgeDir )
+{
+  const UInt frameWidthInCtus = pcPic->getFrameWidthInCtus();
+
+  for ( UInt ctuRsAddr = ctuRow * frameWidthInCtus; ctuRsAddr < ( ctuRow + 1 ) * frameWidthInCtus; ctuRsAddr++ )
   {
     TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
 
-    ::memset( m_aapucBS       [EDGE_HOR], 0, sizeof( UChar ) * m_uiNumPartitions );
-    ::memset( m_aapbEdgeFilter[EDGE_HOR], 0, sizeof( Bool  ) * m_uiNumPartitions );
+    ::memset( m_aapucBS       [edgeDir], 0, sizeof( UChar ) * m_uiNumPartitions );
+    ::memset( m_aapbEdgeFilter[edgeDir], 0, sizeof( Bool  ) * m_uiNumPartitions );
 
     // CU-based deblocking
-    xDeblockCU( pCtu, 0, 0, EDGE_HOR );
+    xDeblockCU( pCtu, 0, 0, edgeDir );
   }
 }
 
+/**
+ Deblock the CTU rows of a picture on a thread pool, with the same result as the picture-level passes.
+ The filtering of the vertical edges of a CTU row only touches the samples of that row. The filtering of its horizontal
+ edges also touches the last rows of samples of the CTU row above, so it has to follow the vertical edges of both rows;
+ it is done by the task that finishes the second of them. The horizontal edges of two CTU rows are at least 8 luma
+ samples apart, which keeps the samples read and written by the rows disjoint.
+ \param  pcPic         picture class (TComPic) pointer
+ \param  pcThreadPool  pool with at least one worker thread
+ \param  threadIdx     index of the calling worker of the pool, -1 if it is not one of them
+ */
+Void TComLoopFilter::xLoopFilterPicRows( TComPic* pcPic, TComThreadPool* pcThreadPool, Int threadIdx )
+{
+  if ( m_numRowFilters != pcThreadPool->getNumThreads() )
+  {
+    delete [] m_pcRowFilters;
+    m_numRowFilters = pcThreadPool->getNumThreads();
+    m_pcRowFilters  = new TComLoopFilter[m_numRowFilters];
+    for ( Int i = 0; i < m_numRowFilters; i++ )
+    {
+      m_pcRowFilters[i].create( m_uiMaxCUDepth );
+    }
+  }
 
-// ====================================================================================================================
-// Protected member functions
-// ====================================================================================================================
+  const UInt        frameHeightInCtus = pcPic->getFrameHeightInCtus();
+  std::vector<Bool> verticalEdgesDone( frameHeightInCtus, false );
+  std::mutex        verticalEdgesMutex;
+  TComTaskGroup     rows( pcThreadPool, threadIdx );
+
+  for ( UInt ctuRow = 0; ctuRow < frameHeightInCtus; ctuRow++ )
+  {
+    rows.addTask( [this, pcPic, ctuRow, frameHeightInCtus, &verticalEdgesDone, &verticalEdgesMutex]( Int rowThreadIdx )
+    {
+      TComLoopFilter& rowFilter = m_pcRowFilters[rowThreadIdx];
+      rowFilter.setCfg( m_bLFCrossTileBoundary );
+      rowFilter.xDeblockCtuRow( pcPic, ctuRow, EDGE_VER );
+
+      Bool filterThisRow;
+      Bool filterNextRow;
+      {
+        std::lock_guard<std::mutex> lock( verticalEdgesMutex );
+        verticalEdgesDone[ctuRow] = true;
+        filterThisRow = ( ctuRow == 0 || verticalEdgesDone[ctuRow - 1] );
+        filterNextRow = ( ctuRow + 1 < frameHeightInCtus && verticalEdgesDone[ctuRow + 1] );
+      }
+
+      if ( filterThisRow )
+      {
+        rowFilter.xDeblockCtuRow( pcPic, ctuRow, EDGE_HOR );
+      }
+      if ( filterNextRow )
+      {
+        rowFilter.xDeblockCtuRow( pcPic, ctuRow + 1, EDGE_HOR );
+      }
+    } );
+  }
+  rows.wait();
+}
 
 /**
  Deblocking filter process in CU-based (the same function as conventional's)
@@ -40,6 +40,7 @@
 
 #include "CommonDef.h"
 #include "TComPic.h"
+#include "TComThreadPool.h"
 
 //! \ingroup TLibCommon
 //! \{
@@ -62,9 +63,16 @@ private:
 
   Bool      m_bLFCrossTileBoundary;
 
+  UInt            m_uiMaxCUDepth;
+  TComLoopFilter* m_pcRowFilters;            ///< per-thread working buffers, used when the CTU rows are deblocked on a thread pool
+  Int             m_numRowFilters;
+
 protected:
   /// CU-level deblocking function
   Void xDeblockCU                 ( TComDataCU* pcCU, UInt uiAbsZorderIdx, UInt uiDepth, DeblockEdgeDir edgeDir );
+  /// deblocking of the edges of one direction in a CTU row
+  Void xDeblockCtuRow             ( TComPic* pcPic, UInt ctuRow, DeblockEdgeDir edgeDir );
+  Void xLoopFilterPicRows         ( TComPic* pcPic, TComThreadPool* pcThreadPool, Int threadIdx );
 
   // set / get functions
   Void xSetLoopfilterParam        ( TComDataCU* pcCU, UInt uiAbsZorderIdx );
@@ -128,8 +136,13 @@ public:
   /// set configuration
   Void setCfg( Bool bLFCrossTileBoundary );
 
-  /// picture-level deblocking filter
-  Void loopFilterPic( TComPic* pcPic );
+  /// picture-level deblocking filter, the CTU rows are processed on the worker threads of pcThreadPool if given.
+  /// threadIdx is the index of the calling worker of the pool, or -1 if it is not one of them
+  Void loopFilterPic( TComPic* pcPic, TComThreadPool* pcThreadPool = NULL, Int threadIdx = -1 );
+
+  /// deblocking of the edges of one direction of a CTU row. The vertical edges of a row only modify the row; the horizontal
+  /// edges also modify the bottom of the row above, and need the vertical edges of both rows to be filtered first
+  Void loopFilterCtuRow( TComPic* pcPic, UInt ctuRow, DeblockEdgeDir edgeDir ) { xDeblockCtuRow( pcPic, ctuRow, edgeDir ); }
 
   static Int getBeta( Int qp )
   {
@@ -92,6 +92,7 @@ Void TComPic::create( const TComSPS &sps, const TComPPS &pps, const Bool bIsVirt
     deleteSEIs (m_SEIs);
   }
   m_bUsedByCurr = false;
+  m_finishedCtuRows.init( 1 );
 }
 
 Void TComPic::destroy()
@@ -43,6 +43,7 @@
 #include "TComPicSym.h"
 #include "TComPicYuv.h"
 #include "TComBitStream.h"
+#include "TComThreadPool.h"
 
 //! \ingroup TLibCommon
 //! \{
@@ -79,6 +80,8 @@ private:
 
   std::vector<std::vector<TComDataCU*> > m_vSliceCUDataLink;
 
+  TComRowProgress       m_finishedCtuRows;        ///< decoder: number of CTU rows of the reconstruction that are final
+
   SEIMessages  m_SEIs; ///< Any SEI messages that have been received.  If !NULL we own the object.
 
 public:
@@ -136,6 +139,13 @@ public:
   Bool          getOutputMark () const      { return m_bNeededForOutput;  }
 
   Void          compressMotion();
+
+  /// decoder: the first numRows CTU rows of the reconstruction are in-loop filtered and border extended, so they can be predicted from
+  Void          setNumFinishedCtuRows( Int numRows )  { m_finishedCtuRows.set( 0, numRows ); }
+  Int           getNumFinishedCtuRows()               { return m_finishedCtuRows.get( 0 ); }
+  /// decoder: block until the first numRows CTU rows of the reconstruction are final
+  Void          waitForFinishedCtuRows( Int numRows ) { m_finishedCtuRows.waitFor( 0, numRows ); }
+
   UInt          getCurrSliceIdx() const           { return m_uiCurrSliceIdx;                }
   Void          setCurrSliceIdx(UInt i)      { m_uiCurrSliceIdx = i;                   }
   UInt          getNumAllocatedSlice() const      {return m_picSym.getNumAllocatedSlice();}
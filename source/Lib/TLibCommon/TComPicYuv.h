@@ -47,6 +47,8 @@
 //! \ingroup TLibCommon
 //! \{
 
+class TComThreadPool;
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -172,9 +174,11 @@ public:
 
 
 // These functions now return the length of the digest strings.
-UInt calcChecksum(const TComPicYuv& pic, TComPictureHash &digest, const BitDepths &bitDepths);
-UInt calcCRC     (const TComPicYuv& pic, TComPictureHash &digest, const BitDepths &bitDepths);
-UInt calcMD5     (const TComPicYuv& pic, TComPictureHash &digest, const BitDepths &bitDepths);
+// The components are hashed concurrently when a thread pool is given; threadIdx is the index of the calling worker of
+// the pool, or -1 if it is not one of them.
+UInt calcChecksum(const TComPicYuv& pic, TComPictureHash &digest, const BitDepths &bitDepths, TComThreadPool* pcThreadPool = NULL, Int threadIdx = -1);
+UInt calcCRC     (const TComPicYuv& pic, TComPictureHash &digest, const BitDepths &bitDepths, TComThreadPool* pcThreadPool = NULL, Int threadIdx = -1);
+UInt calcMD5     (const TComPicYuv& pic, TComPictureHash &digest, const BitDepths &bitDepths, TComThreadPool* pcThreadPool = NULL, Int threadIdx = -1);
 std::string hashToString(const TComPictureHash &digest, Int numChar);
 //! \}
 
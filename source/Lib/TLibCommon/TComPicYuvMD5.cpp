@@ -32,6 +32,7 @@
  */
 
 #include "TComPicYuv.h"
+#include "TComThreadPool.h"
 #include "libmd5/MD5.h"
 
 //! \ingroup TLibCommon
@@ -86,95 +87,226 @@ static Void md5_plane(MD5& md5, const Pel* plane, UInt width, UInt height, UInt
 }
 
 
-UInt compCRC(Int bitdepth, const Pel* plane, UInt width, UInt height, UInt stride, TComPictureHash &digest)
+/**
+ * Hash each valid component of pic with compHash, as tasks of a group, and
+ * append the digests to digest in component order. compHash receives the
+ * index of the worker thread that runs it; threadIdx is the one of the caller.
+ */
+static UInt calcComponentDigests(const TComPicYuv& pic, TComPictureHash &digest, TComThreadPool* pcThreadPool, Int threadIdx,
+                                 const std::function<Void(const ComponentID, TComPictureHash&, Int)> &compHash)
 {
-  UInt crcMsb;
-  UInt bitVal;
-  UInt crcVal = 0xffff;
-  UInt bitIdx;
-  for (UInt y = 0; y < height; y++)
+  TComPictureHash compDigest[MAX_NUM_COMPONENT];
+  UInt digestLen=0;
+  digest.hash.clear();
+
+  TComTaskGroup group(pcThreadPool, threadIdx);
+  for(Int chan=0; chan<pic.getNumberValidComponents(); chan++)
+  {
+    const ComponentID compID=ComponentID(chan);
+    group.addTask([&compHash, &compDigest, compID](Int compThreadIdx)
+                  {
+                    compHash(compID, compDigest[compID], compThreadIdx);
+                  },
+                  [&digest, &digestLen, &compDigest, compID]()
+                  {
+                    digestLen=UInt(compDigest[compID].hash.size());
+                    digest.hash.insert(digest.hash.end(), compDigest[compID].hash.begin(), compDigest[compID].hash.end());
+                  });
+  }
+  group.wait();
+  return digestLen;
+}
+
+/// number of rows of a plane hashed by one task of calcCRC and calcChecksum
+static const UInt HASH_STRIPE_HEIGHT = 64;
+
+/**
+ * Hash the plane of compID in stripes of HASH_STRIPE_HEIGHT rows, as tasks of a group, and pass the result of each
+ * stripe to combine, in stripe order. stripeHash receives the first row and the number of rows of its stripe.
+ * threadIdx is the index of the calling worker of pcThreadPool, or -1 if it is not one of them.
+ */
+static Void hashStripes(const TComPicYuv& pic, const ComponentID compID, TComThreadPool* pcThreadPool, Int threadIdx,
+                        const std::function<UInt(UInt, UInt)> &stripeHash, const std::function<Void(UInt, UInt)> &combine)
+{
+  const UInt height     = pic.getHeight(compID);
+  const UInt numStripes = (height + HASH_STRIPE_HEIGHT - 1) / HASH_STRIPE_HEIGHT;
+  std::vector<UInt> stripeResult(numStripes);
+
+  TComTaskGroup group(pcThreadPool, threadIdx);
+  for (UInt stripe = 0; stripe < numStripes; stripe++)
+  {
+    const UInt y0      = stripe * HASH_STRIPE_HEIGHT;
+    const UInt numRows = std::min(HASH_STRIPE_HEIGHT, height - y0);
+    group.addTask([&stripeHash, &stripeResult, stripe, y0, numRows](Int)
+                  {
+                    stripeResult[stripe] = stripeHash(y0, numRows);
+                  },
+                  [&combine, &stripeResult, stripe, numRows]()
+                  {
+                    combine(stripeResult[stripe], numRows);
+                  });
+  }
+  group.wait();
+}
+
+/// CRC generator polynomial x^16 + x^12 + x^5 + 1, without its x^16 term
+static const UInt CRC_POLY = 0x1021;
+
+/**
+ * Product of a and b, as polynomials over GF(2), modulo the CRC polynomial.
+ * The CRC register after a message M started from the value R is (R * x^len(M) + M) mod P, so the register of a picture
+ * can be assembled from the registers of its stripes, each computed from zero.
+ */
+static UInt crcMulMod(UInt a, UInt b)
+{
+  UInt product = 0;
+  for (Int bitIdx = 15; bitIdx >= 0; bitIdx--)
+  {
+    product = ((product << 1) & 0xffff) ^ (((product >> 15) & 1) * CRC_POLY);
+    if ((b >> bitIdx) & 1)
+    {
+      product ^= a;
+    }
+  }
+  return product;
+}
+
+/// x^n modulo the CRC polynomial
+static UInt crcPowX(UInt64 n)
+{
+  UInt result = 1;
+  UInt base   = 2;
+  for (; n != 0; n >>= 1)
+  {
+    if (n & 1)
+    {
+      result = crcMulMod(result, base);
+    }
+    base = crcMulMod(base, base);
+  }
+  return result;
+}
+
+/// shifting a byte into the CRC register adds the entry of the byte leaving the register, (h * x^16) mod P
+struct CRCByteTable
+{
+  UInt entry[256];
+  CRCByteTable()
+  {
+    for (UInt h = 0; h < 256; h++)
+    {
+      entry[h] = crcMulMod(h, CRC_POLY);
+    }
+  }
+};
+
+static const CRCByteTable s_crcByteTable;
+
+/// shift one byte into the CRC register, most significant bit first
+static inline UInt crcByte(UInt crcVal, UInt byteVal)
+{
+  return ((crcVal << 8) & 0xffff) ^ byteVal ^ s_crcByteTable.entry[crcVal >> 8];
+}
+
+/// CRC register of numRows rows of plane, starting from zero and not augmented
+static UInt compCRCStripe(Int bitdepth, const Pel* plane, UInt width, UInt numRows, UInt stride)
+{
+  UInt crcVal = 0;
+  for (UInt y = 0; y < numRows; y++, plane += stride)
   {
     for (UInt x = 0; x < width; x++)
     {
       // take CRC of first pictureData byte
-      for(bitIdx=0; bitIdx<8; bitIdx++)
-      {
-        crcMsb = (crcVal >> 15) & 1;
-        bitVal = (plane[y*stride+x] >> (7 - bitIdx)) & 1;
-        crcVal = (((crcVal << 1) + bitVal) & 0xffff) ^ (crcMsb * 0x1021);
-      }
+      crcVal = crcByte(crcVal, plane[x] & 0xff);
       // take CRC of second pictureData byte if bit depth is greater than 8-bits
       if(bitdepth > 8)
       {
-        for(bitIdx=0; bitIdx<8; bitIdx++)
-        {
-          crcMsb = (crcVal >> 15) & 1;
-          bitVal = (plane[y*stride+x] >> (15 - bitIdx)) & 1;
-          crcVal = (((crcVal << 1) + bitVal) & 0xffff) ^ (crcMsb * 0x1021);
-        }
+        crcVal = crcByte(crcVal, (plane[x] >> 8) & 0xff);
       }
     }
   }
-  for(bitIdx=0; bitIdx<16; bitIdx++)
-  {
-    crcMsb = (crcVal >> 15) & 1;
-    crcVal = ((crcVal << 1) & 0xffff) ^ (crcMsb * 0x1021);
-  }
-
-  digest.hash.push_back((crcVal>>8)  & 0xff);
-  digest.hash.push_back( crcVal      & 0xff);
-  return 2;
+  return crcVal;
 }
 
-UInt calcCRC(const TComPicYuv& pic, TComPictureHash &digest, const BitDepths &bitDepths)
+UInt calcCRC(const TComPicYuv& pic, TComPictureHash &digest, const BitDepths &bitDepths, TComThreadPool* pcThreadPool, Int threadIdx)
 {
-  UInt digestLen=0;
-  digest.hash.clear();
-  for(Int chan=0; chan<pic.getNumberValidComponents(); chan++)
+  return calcComponentDigests(pic, digest, pcThreadPool, threadIdx, [&pic, &bitDepths, pcThreadPool](const ComponentID compID, TComPictureHash &compDigest, Int compThreadIdx)
   {
-    const ComponentID compID=ComponentID(chan);
-    digestLen=compCRC(bitDepths.recon[toChannelType(compID)], pic.getAddr(compID), pic.getWidth(compID), pic.getHeight(compID), pic.getStride(compID), digest);
-  }
-  return digestLen;
+    const Int  bitdepth    = bitDepths.recon[toChannelType(compID)];
+    const UInt width       = pic.getWidth(compID);
+    const UInt stride      = pic.getStride(compID);
+    const Pel* plane       = pic.getAddr(compID);
+    const UInt bitsPerRow  = width * (bitdepth > 8 ? 16 : 8);
+    UInt       crcVal      = 0xffff;
+
+    hashStripes(pic, compID, pcThreadPool, compThreadIdx,
+                [bitdepth, plane, width, stride](UInt y0, UInt numRows)
+                {
+                  return compCRCStripe(bitdepth, plane + y0 * stride, width, numRows, stride);
+                },
+                [&crcVal, bitsPerRow](UInt stripeCrc, UInt numRows)
+                {
+                  crcVal = crcMulMod(crcVal, crcPowX(UInt64(bitsPerRow) * numRows)) ^ stripeCrc;
+                });
+
+    // augment the message with 16 zero bits
+    crcVal = crcMulMod(crcVal, crcPowX(16));
+
+    compDigest.hash.push_back((crcVal>>8)  & 0xff);
+    compDigest.hash.push_back( crcVal      & 0xff);
+  });
 }
 
-UInt compChecksum(Int bitdepth, const Pel* plane, UInt width, UInt height, UInt stride, TComPictureHash &digest, const BitDepths &/*bitDepths*/)
+/// sum of the checksum terms of numRows rows of plane, the first of which is row y0 of the picture
+static UInt compChecksumStripe(Int bitdepth, const Pel* plane, UInt width, UInt y0, UInt numRows, UInt stride)
 {
   UInt checksum = 0;
-  UChar xor_mask;
 
-  for (UInt y = 0; y < height; y++)
+  for (UInt y = y0; y < y0 + numRows; y++, plane += stride)
   {
+    const UInt yMask = (y & 0xff) ^ (y >> 8);
     for (UInt x = 0; x < width; x++)
     {
-      xor_mask = (x & 0xff) ^ (y & 0xff) ^ (x >> 8) ^ (y >> 8);
-      checksum = (checksum + ((plane[y*stride+x] & 0xff) ^ xor_mask)) & 0xffffffff;
+      const UInt xor_mask = ((x & 0xff) ^ (x >> 8) ^ yMask) & 0xff;
+      checksum += (plane[x] & 0xff) ^ xor_mask;
 
       if(bitdepth > 8)
       {
-        checksum = (checksum + ((plane[y*stride+x]>>8) ^ xor_mask)) & 0xffffffff;
+        checksum += ((plane[x]>>8) & 0xff) ^ xor_mask;
       }
     }
   }
-
-  digest.hash.push_back((checksum>>24) & 0xff);
-  digest.hash.push_back((checksum>>16) & 0xff);
-  digest.hash.push_back((checksum>>8)  & 0xff);
-  digest.hash.push_back( checksum      & 0xff);
-  return 4;
+  return checksum;
 }
 
-UInt calcChecksum(const TComPicYuv& pic, TComPictureHash &digest, const BitDepths &bitDepths)
+UInt calcChecksum(const TComPicYuv& pic, TComPictureHash &digest, const BitDepths &bitDepths, TComThreadPool* pcThreadPool, Int threadIdx)
 {
-  UInt digestLen=0;
-  digest.hash.clear();
-  for(Int chan=0; chan<pic.getNumberValidComponents(); chan++)
+  return calcComponentDigests(pic, digest, pcThreadPool, threadIdx, [&pic, &bitDepths, pcThreadPool](const ComponentID compID, TComPictureHash &compDigest, Int compThreadIdx)
   {
-    const ComponentID compID=ComponentID(chan);
-    digestLen=compChecksum(bitDepths.recon[toChannelType(compID)], pic.getAddr(compID), pic.getWidth(compID), pic.getHeight(compID), pic.getStride(compID), digest, bitDepths);
-  }
-  return digestLen;
+    const Int  bitdepth = bitDepths.recon[toChannelType(compID)];
+    const UInt width    = pic.getWidth(compID);
+    const UInt stride   = pic.getStride(compID);
+    const Pel* plane    = pic.getAddr(compID);
+    UInt       checksum = 0;
+
+    // the sum is taken modulo 2^32, so the stripes can be added in any grouping
+    hashStripes(pic, compID, pcThreadPool, compThreadIdx,
+                [bitdepth, plane, width, stride](UInt y0, UInt numRows)
+                {
+                  return compChecksumStripe(bitdepth, plane + y0 * stride, width, y0, numRows, stride);
+                },
+                [&checksum](UInt stripeChecksum, UInt)
+                {
+                  checksum += stripeChecksum;
+                });
+
+    compDigest.hash.push_back((checksum>>24) & 0xff);
+    compDigest.hash.push_back((checksum>>16) & 0xff);
+    compDigest.hash.push_back((checksum>>8)  & 0xff);
+    compDigest.hash.push_back( checksum      & 0xff);
+  });
 }
+
 /**
  * Calculate the MD5sum of pic, storing the result in digest.
  * MD5 calculation is performed on Y' then Cb, then Cr; each in raster order.
@@ -182,27 +314,23 @@ UInt calcChecksum(const TComPicYuv& pic, TComPictureHash &digest, const BitDepth
  * using sufficient bytes to represent the picture bitdepth.  Eg, 10bit data
  * uses little-endian two byte words; 8bit data uses single byte words.
  */
-UInt calcMD5(const TComPicYuv& pic, TComPictureHash &digest, const BitDepths &bitDepths)
+UInt calcMD5(const TComPicYuv& pic, TComPictureHash &digest, const BitDepths &bitDepths, TComThreadPool* pcThreadPool, Int threadIdx)
 {
-  /* choose an md5_plane packing function based on the system bitdepth */
-  typedef Void (*MD5PlaneFunc)(MD5&, const Pel*, UInt, UInt, UInt);
-  MD5PlaneFunc md5_plane_func;
-
-  MD5 md5[MAX_NUM_COMPONENT];
-
-  digest.hash.clear();
-  for(Int chan=0; chan<pic.getNumberValidComponents(); chan++)
+  calcComponentDigests(pic, digest, pcThreadPool, threadIdx, [&pic, &bitDepths](const ComponentID compID, TComPictureHash &compDigest, Int)
   {
-    const ComponentID compID=ComponentID(chan);
-    md5_plane_func = bitDepths.recon[toChannelType(compID)] <= 8 ? (MD5PlaneFunc)md5_plane<1> : (MD5PlaneFunc)md5_plane<2>;
+    /* choose an md5_plane packing function based on the system bitdepth */
+    typedef Void (*MD5PlaneFunc)(MD5&, const Pel*, UInt, UInt, UInt);
+    MD5PlaneFunc md5_plane_func = bitDepths.recon[toChannelType(compID)] <= 8 ? (MD5PlaneFunc)md5_plane<1> : (MD5PlaneFunc)md5_plane<2>;
+
+    MD5 md5;
     UChar tmp_digest[MD5_DIGEST_STRING_LENGTH];
-    md5_plane_func(md5[compID], pic.getAddr(compID), pic.getWidth(compID), pic.getHeight(compID), pic.getStride(compID));
-    md5[compID].finalize(tmp_digest);
+    md5_plane_func(md5, pic.getAddr(compID), pic.getWidth(compID), pic.getHeight(compID), pic.getStride(compID));
+    md5.finalize(tmp_digest);
     for(UInt i=0; i<MD5_DIGEST_STRING_LENGTH; i++)
     {
-      digest.hash.push_back(tmp_digest[i]);
+      compDigest.hash.push_back(tmp_digest[i]);
     }
-  }
+  });
   return 16;
 }
 
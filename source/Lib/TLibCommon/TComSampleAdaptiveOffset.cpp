@@ -105,6 +105,7 @@ TComSampleAdaptiveOffset::TComSampleAdaptiveOffset()
 {
   m_tempPicYuv = NULL;
   m_lineBufWidth = 0;
+  m_numLineBufs = 0;
   m_signLineBuf1 = NULL;
   m_signLineBuf2 = NULL;
 }
@@ -152,6 +153,36 @@ Void TComSampleAdaptiveOffset::create( Int picWidth, Int picHeight, ChromaFormat
   {
     m_offsetStepLog2  [compIdx] = isLuma(ComponentID(compIdx))? lumaBitShift : chromaBitShift;
   }
+
+  allocateLineBuffers(1);
+}
+
+/** Allocate the sign line buffers of the edge offset classes, so that numLineBufs threads can process CTUs at the same time.
+ * Each thread uses the buffers given by its index.
+ */
+Void TComSampleAdaptiveOffset::allocateLineBuffers(Int numLineBufs)
+{
+  if(m_lineBufWidth == m_maxCUWidth && m_numLineBufs >= numLineBufs)
+  {
+    return;
+  }
+
+  m_lineBufWidth = m_maxCUWidth;
+  m_numLineBufs  = std::max(numLineBufs, m_numLineBufs);
+
+  if (m_signLineBuf1)
+  {
+    delete[] m_signLineBuf1;
+    m_signLineBuf1 = NULL;
+  }
+  m_signLineBuf1 = new SChar[m_numLineBufs*(m_lineBufWidth+1)];
+
+  if (m_signLineBuf2)
+  {
+    delete[] m_signLineBuf2;
+    m_signLineBuf2 = NULL;
+  }
+  m_signLineBuf2 = new SChar[m_numLineBufs*(m_lineBufWidth+1)];
 }
 
 Void TComSampleAdaptiveOffset::destroy()
@@ -312,26 +343,12 @@ Void TComSampleAdaptiveOffset::reconstructBlkSAOParams(TComPic* pic, SAOBlkParam
 
 Void TComSampleAdaptiveOffset::offsetBlock(const Int channelBitDepth, Int typeIdx, Int* offset
                                           , Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride,  Int width, Int height
-                                          , Bool isLeftAvail,  Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail, Bool isBelowLeftAvail, Bool isBelowRightAvail)
+                                          , Bool isLeftAvail,  Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail, Bool isBelowLeftAvail, Bool isBelowRightAvail
+                                          , Int lineBufIdx)
 {
-  if(m_lineBufWidth != m_maxCUWidth)
-  {
-    m_lineBufWidth = m_maxCUWidth;
-
-    if (m_signLineBuf1)
-    {
-      delete[] m_signLineBuf1;
-      m_signLineBuf1 = NULL;
-    }
-    m_signLineBuf1 = new SChar[m_lineBufWidth+1];
-
-    if (m_signLineBuf2)
-    {
-      delete[] m_signLineBuf2;
-      m_signLineBuf2 = NULL;
-    }
-    m_signLineBuf2 = new SChar[m_lineBufWidth+1];
-  }
+  // the buffers of the calling thread, see allocateLineBuffers
+  SChar* signLineBuf1 = m_signLineBuf1 + lineBufIdx * (m_lineBufWidth + 1);
+  SChar* signLineBuf2 = m_signLineBuf2 + lineBufIdx * (m_lineBufWidth + 1);
 
   const Int maxSampleValueIncl = (1<< channelBitDepth )-1;
 
@@ -369,7 +386,7 @@ Void TComSampleAdaptiveOffset::offsetBlock(const Int channelBitDepth, Int typeId
   case SAO_TYPE_EO_90:
     {
       offset += 2;
-      SChar *signUpLine = m_signLineBuf1;
+      SChar *signUpLine = signLineBuf1;
 
       startY = isAboveAvail ? 0 : 1;
       endY   = isBelowAvail ? height : height-1;
@@ -409,8 +426,8 @@ Void TComSampleAdaptiveOffset::offsetBlock(const Int channelBitDepth, Int typeId
       offset += 2;
       SChar *signUpLine, *signDownLine, *signTmpLine;
 
-      signUpLine  = m_signLineBuf1;
-      signDownLine= m_signLineBuf2;
+      signUpLine  = signLineBuf1;
+      signDownLine= signLineBuf2;
 
       startX = isLeftAvail ? 0 : 1 ;
       endX   = isRightAvail ? width : (width-1);
@@ -474,7 +491,7 @@ Void TComSampleAdaptiveOffset::offsetBlock(const Int channelBitDepth, Int typeId
   case SAO_TYPE_EO_45:
     {
       offset += 2;
-      SChar *signUpLine = m_signLineBuf1+1;
+      SChar *signUpLine = signLineBuf1+1;
 
       startX = isLeftAvail ? 0 : 1;
       endX   = isRightAvail ? width : (width -1);
@@ -551,7 +568,7 @@ Void TComSampleAdaptiveOffset::offsetBlock(const Int channelBitDepth, Int typeId
   }
 }
 
-Void TComSampleAdaptiveOffset::offsetCTU(Int ctuRsAddr, TComPicYuv* srcYuv, TComPicYuv* resYuv, SAOBlkParam& saoblkParam, TComPic* pPic)
+Void TComSampleAdaptiveOffset::offsetCTU(Int ctuRsAddr, TComPicYuv* srcYuv, TComPicYuv* resYuv, SAOBlkParam& saoblkParam, TComPic* pPic, Int lineBufIdx)
 {
   Bool isLeftAvail,isRightAvail,isAboveAvail,isBelowAvail,isAboveLeftAvail,isAboveRightAvail,isBelowLeftAvail,isBelowRightAvail;
 
@@ -604,14 +621,37 @@ Void TComSampleAdaptiveOffset::offsetCTU(Int ctuRsAddr, TComPicYuv* srcYuv, TCom
                   , isAboveAvail, isBelowAvail
                   , isAboveLeftAvail, isAboveRightAvail
                   , isBelowLeftAvail, isBelowRightAvail
+                  , lineBufIdx
                   );
     }
   } //compIdx
 
 }
 
+/** Apply the offsets of all the CTUs of a picture, one task per CTU row.
+ * srcYuv is not modified, so the CTUs do not depend on each other.
+ * threadIdx is the index of the calling worker of pcThreadPool, or -1 if it is not one of them.
+ */
+Void TComSampleAdaptiveOffset::offsetCTUs(TComPic* pPic, TComPicYuv* srcYuv, TComPicYuv* resYuv, SAOBlkParam* saoBlkParams, TComThreadPool* pcThreadPool, Int threadIdx)
+{
+  allocateLineBuffers(pcThreadPool != NULL ? std::max(pcThreadPool->getNumThreads(), 1) : 1);
+
+  TComTaskGroup rows(pcThreadPool, threadIdx);
+  for(Int ctuRow = 0; ctuRow < m_numCTUInHeight; ctuRow++)
+  {
+    rows.addTask([this, pPic, srcYuv, resYuv, saoBlkParams, ctuRow](Int rowThreadIdx)
+    {
+      for(Int ctuRsAddr = ctuRow*m_numCTUInWidth; ctuRsAddr < (ctuRow+1)*m_numCTUInWidth; ctuRsAddr++)
+      {
+        offsetCTU(ctuRsAddr, srcYuv, resYuv, saoBlkParams[ctuRsAddr], pPic, rowThreadIdx);
+      }
+    });
+  }
+  rows.wait();
+}
+
 
-Void TComSampleAdaptiveOffset::SAOProcess(TComPic* pDecPic)
+Void TComSampleAdaptiveOffset::SAOProcess(TComPic* pDecPic, TComThreadPool* pcThreadPool, Int threadIdx)
 {
   const Int numberOfComponents = getNumberValidComponents(m_chromaFormatIDC);
   Bool bAllDisabled=true;
@@ -630,10 +670,7 @@ Void TComSampleAdaptiveOffset::SAOProcess(TComPic* pDecPic)
   TComPicYuv* resYuv = pDecPic->getPicYuvRec();
   TComPicYuv* srcYuv = m_tempPicYuv;
   resYuv->copyToPic(srcYuv);
-  for(Int ctuRsAddr= 0; ctuRsAddr < m_numCTUsPic; ctuRsAddr++)
-  {
-    offsetCTU(ctuRsAddr, srcYuv, resYuv, (pDecPic->getPicSym()->getSAOBlkParam())[ctuRsAddr], pDecPic);
-  } //ctu
+  offsetCTUs(pDecPic, srcYuv, resYuv, pDecPic->getPicSym()->getSAOBlkParam(), pcThreadPool, threadIdx);
 }
 
 
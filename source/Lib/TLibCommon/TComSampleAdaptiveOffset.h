@@ -40,6 +40,7 @@
 
 #include "CommonDef.h"
 #include "TComPic.h"
+#include "TComThreadPool.h"
 
 //! \ingroup TLibCommon
 //! \{
@@ -65,7 +66,7 @@ class TComSampleAdaptiveOffset
 public:
   TComSampleAdaptiveOffset();
   virtual ~TComSampleAdaptiveOffset();
-  Void SAOProcess(TComPic* pDecPic);
+  Void SAOProcess(TComPic* pDecPic, TComThreadPool* pcThreadPool = NULL, Int threadIdx = -1);
   Void create( Int picWidth, Int picHeight, ChromaFormat format, UInt maxCUWidth, UInt maxCUHeight, UInt maxCUDepth, UInt lumaBitShift, UInt chromaBitShift );
   Void destroy();
   Void reconstructBlkSAOParams(TComPic* pic, SAOBlkParam* saoBlkParams);
@@ -74,11 +75,14 @@ public:
 
 protected:
   Void offsetBlock(const Int channelBitDepth, Int typeIdx, Int* offset, Pel* srcBlk, Pel* resBlk, Int srcStride, Int resStride,  Int width, Int height
-                  , Bool isLeftAvail, Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail, Bool isBelowLeftAvail, Bool isBelowRightAvail);
+                  , Bool isLeftAvail, Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail, Bool isBelowLeftAvail, Bool isBelowRightAvail
+                  , Int lineBufIdx);
   Void invertQuantOffsets(ComponentID compIdx, Int typeIdc, Int typeAuxInfo, Int* dstOffsets, Int* srcOffsets);
   Void reconstructBlkSAOParam(SAOBlkParam& recParam, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES]);
   Int  getMergeList(TComPic* pic, Int ctuRsAddr, SAOBlkParam* blkParams, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES]);
-  Void offsetCTU(Int ctuRsAddr, TComPicYuv* srcYuv, TComPicYuv* resYuv, SAOBlkParam& saoblkParam, TComPic* pPic);
+  Void offsetCTU(Int ctuRsAddr, TComPicYuv* srcYuv, TComPicYuv* resYuv, SAOBlkParam& saoblkParam, TComPic* pPic, Int lineBufIdx = 0);
+  Void offsetCTUs(TComPic* pPic, TComPicYuv* srcYuv, TComPicYuv* resYuv, SAOBlkParam* saoBlkParams, TComThreadPool* pcThreadPool, Int threadIdx = -1);
+  Void allocateLineBuffers(Int numLineBufs);
   Void xPCMRestoration(TComPic* pcPic);
   Void xPCMCURestoration ( TComDataCU* pcCU, UInt uiAbsZorderIdx, UInt uiDepth );
   Void xPCMSampleRestoration (TComDataCU* pcCU, UInt uiAbsZorderIdx, UInt uiDepth, const ComponentID compID);
@@ -95,7 +99,8 @@ protected:
 
 
   Int m_lineBufWidth;
-  SChar* m_signLineBuf1;
+  Int m_numLineBufs;                 ///< number of threads that can use the line buffers at the same time
+  SChar* m_signLineBuf1;             ///< m_numLineBufs buffers of m_lineBufWidth+1 entries
   SChar* m_signLineBuf2;
   ChromaFormat m_chromaFormatIDC;
 private:
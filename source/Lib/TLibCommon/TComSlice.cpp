@@ -316,7 +316,7 @@ Void TComSlice::setList1IdxToList0Idx()
   }
 }
 
-Void TComSlice::setRefPicList( TComList<TComPic*>& rcListPic, Bool checkNumPocTotalCurr )
+Void TComSlice::setRefPicList( TComList<TComPic*>& rcListPic, Bool checkNumPocTotalCurr, Bool extendBorders )
 {
   if ( m_eSliceType == I_SLICE)
   {
@@ -345,7 +345,10 @@ Void TComSlice::setRefPicList( TComList<TComPic*>& rcListPic, Bool checkNumPocTo
     {
       pcRefPic = xGetRefPic(rcListPic, getPOC()+m_pRPS->getDeltaPOC(i));
       pcRefPic->setIsLongTerm(0);
-      pcRefPic->getPicYuvRec()->extendPicBorder();
+      if (extendBorders)
+      {
+        pcRefPic->getPicYuvRec()->extendPicBorder();
+      }
       RefPicSetStCurr0[NumPicStCurr0] = pcRefPic;
       NumPicStCurr0++;
       pcRefPic->setCheckLTMSBPresent(false);
@@ -358,7 +361,10 @@ Void TComSlice::setRefPicList( TComList<TComPic*>& rcListPic, Bool checkNumPocTo
     {
       pcRefPic = xGetRefPic(rcListPic, getPOC()+m_pRPS->getDeltaPOC(i));
       pcRefPic->setIsLongTerm(0);
-      pcRefPic->getPicYuvRec()->extendPicBorder();
+      if (extendBorders)
+      {
+        pcRefPic->getPicYuvRec()->extendPicBorder();
+      }
       RefPicSetStCurr1[NumPicStCurr1] = pcRefPic;
       NumPicStCurr1++;
       pcRefPic->setCheckLTMSBPresent(false);
@@ -371,7 +377,10 @@ Void TComSlice::setRefPicList( TComList<TComPic*>& rcListPic, Bool checkNumPocTo
     {
       pcRefPic = xGetLongTermRefPic(rcListPic, m_pRPS->getPOC(i), m_pRPS->getCheckLTMSBPresent(i));
       pcRefPic->setIsLongTerm(1);
-      pcRefPic->getPicYuvRec()->extendPicBorder();
+      if (extendBorders)
+      {
+        pcRefPic->getPicYuvRec()->extendPicBorder();
+      }
       RefPicSetLtCurr[NumPicLtCurr] = pcRefPic;
       NumPicLtCurr++;
     }
@@ -0,0 +1,319 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2016, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComThreadPool.cpp
+    \brief    thread pool and CTU-row progress tracking
+*/
+
+#include "TComThreadPool.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Constructor / destructor / create / destroy
+// ====================================================================================================================
+
+TComThreadPool::TComThreadPool()
+: m_numUnfinishedTasks ( 0 )
+, m_shutdown           ( false )
+{
+}
+
+TComThreadPool::~TComThreadPool()
+{
+  destroy();
+}
+
+Void TComThreadPool::create( Int numThreads )
+{
+  assert( m_threads.empty() );
+  m_shutdown = false;
+  m_localTasks.resize( numThreads );
+
+  // the workers take the lock before they look at the queues, so none of them runs a task before the pool is complete
+  std::lock_guard<std::mutex> lock( m_mutex );
+  m_threads.reserve( numThreads );
+  for ( Int threadIdx = 0; threadIdx < numThreads; threadIdx++ )
+  {
+    m_threads.push_back( std::thread( &TComThreadPool::xWorkerLoop, this, threadIdx ) );
+  }
+}
+
+Void TComThreadPool::destroy()
+{
+  if ( m_threads.empty() )
+  {
+    return;
+  }
+
+  waitForAllTasks();
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_shutdown = true;
+  }
+  m_taskAvailable.notify_all();
+
+  for ( UInt i = 0; i < m_threads.size(); i++ )
+  {
+    m_threads[i].join();
+  }
+  m_threads.clear();
+  m_localTasks.clear();
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+Void TComThreadPool::addTask( const Task& task )
+{
+  xQueueTask( task, NULL, -1 );
+}
+
+Void TComThreadPool::waitForAllTasks()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  while ( m_numUnfinishedTasks > 0 )
+  {
+    m_allTasksDone.wait( lock );
+  }
+}
+
+// ====================================================================================================================
+// Private member functions
+// ====================================================================================================================
+
+/** Queue a task, on the deque of the calling worker if threadIdx is not negative.
+ */
+Void TComThreadPool::xQueueTask( const Task& task, TComTaskGroup* pcGroup, Int threadIdx )
+{
+  assert( !m_threads.empty() );
+
+  QueuedTask queuedTask;
+  queuedTask.task    = task;
+  queuedTask.pcGroup = pcGroup;
+
+  std::lock_guard<std::mutex> lock( m_mutex );
+  if ( threadIdx >= 0 )
+  {
+    m_localTasks[threadIdx].push_back( queuedTask );
+  }
+  else
+  {
+    m_tasks.push_back( queuedTask );
+  }
+  m_numUnfinishedTasks++;
+  m_taskAvailable.notify_one();
+
+  if ( pcGroup != NULL )
+  {
+    pcGroup->m_numUnfinishedTasks++;
+    m_groupProgress.notify_all();
+  }
+}
+
+/** Take the next task to run on a worker: the newest task of its own deque, else the oldest task added from outside the
+ * pool, else the oldest task of another worker. If pcGroup is not NULL, only the tasks of that group are considered.
+ * The lock has to be held by the caller.
+ */
+Bool TComThreadPool::xPopTask( Int threadIdx, const TComTaskGroup* pcGroup, QueuedTask& rcTask )
+{
+  std::deque<QueuedTask>& localTasks = m_localTasks[threadIdx];
+  for ( std::deque<QueuedTask>::reverse_iterator it = localTasks.rbegin(); it != localTasks.rend(); it++ )
+  {
+    if ( pcGroup == NULL || it->pcGroup == pcGroup )
+    {
+      rcTask = *it;
+      localTasks.erase( --( it.base() ) );
+      return true;
+    }
+  }
+
+  const Int numThreads = Int( m_localTasks.size() );
+  for ( Int i = -1; i < numThreads; i++ )
+  {
+    std::deque<QueuedTask>& tasks = i < 0 ? m_tasks : m_localTasks[( threadIdx + 1 + i ) % numThreads];
+    for ( std::deque<QueuedTask>::iterator it = tasks.begin(); it != tasks.end(); it++ )
+    {
+      if ( pcGroup == NULL || it->pcGroup == pcGroup )
+      {
+        rcTask = *it;
+        tasks.erase( it );
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/** Run a task taken from the queues. The lock is released while the task runs.
+ */
+Void TComThreadPool::xRunTask( std::unique_lock<std::mutex>& lock, Int threadIdx, QueuedTask& rcTask )
+{
+  lock.unlock();
+  rcTask.task( threadIdx );
+  lock.lock();
+
+  // notify while holding the lock: the waiter of a group may destroy it as soon as it sees its last task finish
+  if ( rcTask.pcGroup != NULL && --rcTask.pcGroup->m_numUnfinishedTasks == 0 )
+  {
+    m_groupProgress.notify_all();
+  }
+  if ( --m_numUnfinishedTasks == 0 )
+  {
+    m_allTasksDone.notify_all();
+  }
+}
+
+Void TComThreadPool::xWorkerLoop( Int threadIdx )
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  for ( ;; )
+  {
+    QueuedTask queuedTask;
+    while ( !xPopTask( threadIdx, NULL, queuedTask ) )
+    {
+      if ( m_shutdown )
+      {
+        return;
+      }
+      m_taskAvailable.wait( lock );
+    }
+    xRunTask( lock, threadIdx, queuedTask );
+  }
+}
+
+// ====================================================================================================================
+// TComTaskGroup
+// ====================================================================================================================
+
+TComTaskGroup::TComTaskGroup( TComThreadPool* pcThreadPool, Int threadIdx )
+: m_pcThreadPool       ( pcThreadPool != NULL && pcThreadPool->getNumThreads() > 0 ? pcThreadPool : NULL )
+, m_threadIdx          ( threadIdx )
+, m_numUnfinishedTasks ( 0 )
+{
+}
+
+TComTaskGroup::~TComTaskGroup()
+{
+  wait();
+}
+
+/** Add a task to the group. Only the thread that owns the group may add tasks to it.
+ */
+Void TComTaskGroup::addTask( const TComThreadPool::Task& task, const Completion& completion )
+{
+  m_completions.push_back( completion );
+  if ( m_pcThreadPool == NULL )
+  {
+    task( 0 );
+  }
+  else
+  {
+    m_pcThreadPool->xQueueTask( task, this, m_threadIdx );
+  }
+}
+
+Void TComTaskGroup::wait()
+{
+  if ( m_pcThreadPool != NULL )
+  {
+    std::unique_lock<std::mutex> lock( m_pcThreadPool->m_mutex );
+    while ( m_numUnfinishedTasks > 0 )
+    {
+      // a worker helps with the tasks of the group instead of blocking, so that groups can be nested inside tasks
+      TComThreadPool::QueuedTask queuedTask;
+      if ( m_threadIdx >= 0 && m_pcThreadPool->xPopTask( m_threadIdx, this, queuedTask ) )
+      {
+        m_pcThreadPool->xRunTask( lock, m_threadIdx, queuedTask );
+      }
+      else
+      {
+        m_pcThreadPool->m_groupProgress.wait( lock );
+      }
+    }
+  }
+
+  std::vector<Completion> completions;
+  completions.swap( m_completions );
+  for ( UInt i = 0; i < completions.size(); i++ )
+  {
+    if ( completions[i] )
+    {
+      completions[i]();
+    }
+  }
+}
+
+// ====================================================================================================================
+// TComRowProgress
+// ====================================================================================================================
+
+Void TComRowProgress::init( UInt numRows, Int initialValue )
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+  m_progress.assign( numRows, initialValue );
+}
+
+Void TComRowProgress::set( UInt row, Int value )
+{
+  // notify while holding the lock: a waiter may destroy this object as soon as it sees the final value
+  std::lock_guard<std::mutex> lock( m_mutex );
+  m_progress[row] = value;
+  m_progressChanged.notify_all();
+}
+
+Void TComRowProgress::add( UInt row, Int delta )
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+  m_progress[row] += delta;
+  m_progressChanged.notify_all();
+}
+
+Int TComRowProgress::get( UInt row )
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+  return m_progress[row];
+}
+
+Void TComRowProgress::waitFor( UInt row, Int value )
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  while ( m_progress[row] < value )
+  {
+    m_progressChanged.wait( lock );
+  }
+}
+
+//! \}
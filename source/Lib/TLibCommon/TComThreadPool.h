@@ -0,0 +1,168 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2016, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComThreadPool.h
+    \brief    thread pool, task groups and CTU-row progress tracking (header)
+*/
+
+#ifndef __TCOMTHREADPOOL__
+#define __TCOMTHREADPOOL__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "CommonDef.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+class TComTaskGroup;
+
+/** fixed-size pool of worker threads.
+ * Tasks added from outside the pool are started in submission order. Tasks added by a running task, through a group that
+ * it created with its worker index, go to the deque of its worker, which runs them last-in first-out; idle workers steal
+ * them first-in first-out from the other deques.
+ * The tasks of this code base are coarse (CTU rows, tiles, picture planes), so a single lock protects all the queues.
+ */
+class TComThreadPool
+{
+public:
+  /// a task receives the index of the worker thread that runs it, so that callers can keep per-thread state
+  typedef std::function<Void(Int threadIdx)> Task;
+
+private:
+  class QueuedTask
+  {
+  public:
+    Task            task;
+    TComTaskGroup*  pcGroup;                        ///< group the task belongs to, or NULL
+  };
+
+  std::vector<std::thread>              m_threads;
+  std::deque<QueuedTask>                m_tasks;                ///< tasks added from outside the pool, not yet started
+  std::vector< std::deque<QueuedTask> > m_localTasks;           ///< tasks added by the tasks of each worker, not yet started
+  std::mutex                            m_mutex;
+  std::condition_variable               m_taskAvailable;
+  std::condition_variable               m_allTasksDone;
+  std::condition_variable               m_groupProgress;        ///< a task of a group was queued, or the last task of a group finished
+  Int                                   m_numUnfinishedTasks;   ///< queued plus running tasks
+  Bool                                  m_shutdown;
+
+  Void  xQueueTask          ( const Task& task, TComTaskGroup* pcGroup, Int threadIdx );
+  Bool  xPopTask            ( Int threadIdx, const TComTaskGroup* pcGroup, QueuedTask& rcTask );
+  Void  xRunTask            ( std::unique_lock<std::mutex>& lock, Int threadIdx, QueuedTask& rcTask );
+  Void  xWorkerLoop         ( Int threadIdx );
+
+public:
+  TComThreadPool();
+  virtual ~TComThreadPool();
+
+  Void  create              ( Int numThreads );
+  Void  destroy             ();
+
+  Int   getNumThreads       () const { return Int(m_threads.size()); }
+
+  /// queue a task. Tasks added from outside the pool are started in the order they were added, so such a task may block
+  /// waiting on any task added before it.
+  Void  addTask             ( const Task& task );
+  /// block until every task added so far has finished
+  Void  waitForAllTasks     ();
+
+  friend class TComTaskGroup;
+};
+
+/** set of tasks that can be waited for together.
+ * Each task may come with a completion function. wait() calls the completion functions on the waiting thread, in the order
+ * the tasks were added, so that reductions over the results of the tasks do not depend on the number of threads.
+ * Without a pool, or with a pool without threads, the tasks are run when they are added.
+ * A group created by a task gets the worker index that the task received. A worker waiting for such a group runs the queued
+ * tasks of the group meanwhile; these tasks get the index of the worker.
+ */
+class TComTaskGroup
+{
+public:
+  typedef std::function<Void()> Completion;
+
+private:
+  TComThreadPool*           m_pcThreadPool;
+  Int                       m_threadIdx;            ///< worker of the pool that owns the group, -1 for other threads
+  std::vector<Completion>   m_completions;
+  Int                       m_numUnfinishedTasks;   ///< queued plus running tasks, protected by the lock of the pool
+
+  Void  xTaskFinished       ();
+
+public:
+  TComTaskGroup( TComThreadPool* pcThreadPool, Int threadIdx = -1 );
+  virtual ~TComTaskGroup();
+
+  Void  addTask             ( const TComThreadPool::Task& task, const Completion& completion = Completion() );
+  /// block until all the tasks of the group have finished, then call their completion functions in submission order
+  Void  wait                ();
+
+  friend class TComThreadPool;
+};
+
+/// per-row progress counters, used to let a CTU row wait until the row above (or a reference picture) has advanced far enough
+class TComRowProgress
+{
+private:
+  std::vector<Int>          m_progress;
+  std::mutex                m_mutex;
+  std::condition_variable   m_progressChanged;
+
+public:
+  Void  init                ( UInt numRows, Int initialValue = 0 );
+
+  Void  set                 ( UInt row, Int value );
+  /// advance the progress of a row that several threads contribute to
+  Void  add                 ( UInt row, Int delta );
+  Int   get                 ( UInt row );
+  /// block until the progress of the given row is at least value
+  Void  waitFor             ( UInt row, Int value );
+};
+
+//! \}
+
+#endif // __TCOMTHREADPOOL__
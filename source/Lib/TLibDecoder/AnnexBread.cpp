@@ -39,6 +39,8 @@
 
 #include <stdint.h>
 #include <cassert>
+#include <cstring>
+#include <algorithm>
 #include <vector>
 #include "AnnexBread.h"
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
@@ -50,20 +52,113 @@ using namespace std;
 //! \ingroup TLibDecoder
 //! \{
 
+std::size_t InputByteStream::fill(std::size_t numBytes)
+{
+  if (m_End - m_Pos >= numBytes || m_bInputEnded)
+  {
+    return m_End - m_Pos;
+  }
+
+  /* move the bytes that are still needed to the front of the buffer,
+   * and make room for numBytes bytes after the current position */
+  const std::size_t keepFrom = m_bKeeping ? m_Kept : m_Pos;
+  if (keepFrom > 0)
+  {
+    memmove(&m_Buf[0], &m_Buf[keepFrom], m_End - keepFrom);
+    m_Pos  -= keepFrom;
+    m_End  -= keepFrom;
+    m_Kept -= std::min(m_Kept, keepFrom);
+  }
+  if (m_Buf.size() < m_Pos + numBytes)
+  {
+    m_Buf.resize(std::max(2 * m_Buf.size(), m_Pos + numBytes));
+  }
+
+  while (m_End - m_Pos < numBytes && !m_bInputEnded)
+  {
+    m_Input.read(reinterpret_cast<char*>(&m_Buf[m_End]), std::streamsize(m_Buf.size() - m_End));
+    const std::size_t numRead = std::size_t(m_Input.gcount());
+    m_End += numRead;
+    m_bInputEnded = numRead == 0 || !m_Input;
+  }
+  return m_End - m_Pos;
+}
+
+/**
+ * Find the next start code prefix, 0x000001 or 0x00000001, and
+ * consume the bytes before it, counting them into numSkipped.  Zero
+ * bytes are located with memchr, so that the bytes in between are not
+ * examined one by one.
+ *
+ * Returns false if the input ends without a start code prefix, in
+ * which case all remaining bytes are consumed.
+ */
+static Bool
+skipToStartCode(InputByteStream& bs, UInt& numSkipped)
+{
+  std::size_t scan = 0; /* bytes before scan cannot start a start code prefix */
+  while (true)
+  {
+    const std::size_t numBuffered = bs.fill(scan + 3);
+    if (numBuffered < scan + 3)
+    {
+      bs.skipBytes(numBuffered);
+      numSkipped += UInt(numBuffered);
+      return false;
+    }
+
+    const uint8_t* bytes = bs.getBufferedBytes();
+    const uint8_t* zero  = static_cast<const uint8_t*>(memchr(bytes + scan, 0x00, numBuffered - 2 - scan));
+    if (zero == NULL)
+    {
+      /* keep the last three bytes: a zero_byte and a start code
+       * prefix may begin there */
+      const std::size_t numDropped = numBuffered - 3;
+      bs.skipBytes(numDropped);
+      numSkipped += UInt(numDropped);
+      scan = 1;
+      continue;
+    }
+
+    const std::size_t offset = zero - bytes;
+    if (zero[1] == 0x00 && zero[2] == 0x01)
+    {
+      const std::size_t start = (offset > 0 && zero[-1] == 0x00) ? offset - 1 : offset;
+#ifndef NDEBUG
+      for (std::size_t i = 0; i < start; i++)
+      {
+        assert(bytes[i] == 0);
+      }
+#endif
+      bs.skipBytes(start);
+      numSkipped += UInt(start);
+      return true;
+    }
+    scan = offset + 1;
+  }
+}
+
 /**
  * Parse an AVC AnnexB Bytestream bs to extract a single nalUnit
  * while accumulating bytestream statistics into stats.
  *
- * If EOF occurs while trying to extract a NALunit, an exception
- * of std::ios_base::failure is thrown.  The contsnts of stats will
- * be correct at this point.
+ * The nalUnit is returned as nalUnitSize bytes in the buffer of bs,
+ * which remain valid until bs is next read.
+ *
+ * Returns true if EOF was reached (NB, nalunit data may be valid).
+ * The contents of stats will be correct at this point.
  */
-static Void
-_byteStreamNALUnit(
+Bool
+byteStreamNALUnit(
   InputByteStream& bs,
-  vector<uint8_t>& nalUnit,
+  const uint8_t*& nalUnit,
+  std::size_t& nalUnitSize,
   AnnexBStats& stats)
 {
+  nalUnit = NULL;
+  nalUnitSize = 0;
+  stats.m_numBytesInNALUnit = 0;
+
   /* At the beginning of the decoding process, the decoder initialises its
    * current position in the byte stream to the beginning of the byte stream.
    * It then extracts and discards each leading_zero_8bits syntax element (if
@@ -74,16 +169,15 @@ _byteStreamNALUnit(
    */
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   TComCodingStatistics::SStat &statBits=TComCodingStatistics::GetStatisticEP(STATS__NAL_UNIT_PACKING);
+  const UInt numLeadingZero8BitsBytes = stats.m_numLeadingZero8BitsBytes;
 #endif
-  while ((bs.eofBeforeNBytes(24/8) || bs.peekBytes(24/8) != 0x000001)
-  &&     (bs.eofBeforeNBytes(32/8) || bs.peekBytes(32/8) != 0x00000001))
-  {
-    uint8_t leading_zero_8bits = bs.readByte();
+  const Bool bStartCodeFound = skipToStartCode(bs, stats.m_numLeadingZero8BitsBytes);
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-    statBits.bits+=8; statBits.count++;
+  statBits.bits += 8*(stats.m_numLeadingZero8BitsBytes - numLeadingZero8BitsBytes); statBits.count += stats.m_numLeadingZero8BitsBytes - numLeadingZero8BitsBytes;
 #endif
-    assert(leading_zero_8bits == 0);
-    stats.m_numLeadingZero8BitsBytes++;
+  if (!bStartCodeFound)
+  {
+    return true;
   }
 
   /* 1. When the next four bytes in the bitstream form the four-byte sequence
@@ -92,15 +186,14 @@ _byteStreamNALUnit(
    * the byte stream is set equal to the position of the byte following this
    * discarded byte.
    */
-  /* NB, the previous step guarantees this will succeed -- if EOF was
-   * encountered, an exception will stop execution getting this far */
-  if (bs.peekBytes(24/8) != 0x000001)
+  /* NB, the previous step guarantees that the next three or four bytes are
+   * buffered and form a start code prefix */
+  if (bs.getBufferedBytes()[2] == 0x00)
   {
-    uint8_t zero_byte = bs.readByte();
+    bs.skipBytes(1);
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
     statBits.bits+=8; statBits.count++;
 #endif
-    assert(zero_byte == 0);
     stats.m_numZeroByteBytes++;
   }
 
@@ -110,11 +203,10 @@ _byteStreamNALUnit(
    * following this three-byte sequence.
    */
   /* NB, (1) guarantees that the next three bytes are 0x00 00 01 */
-  uint32_t start_code_prefix_one_3bytes = bs.readBytes(24/8);
+  bs.skipBytes(3);
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   statBits.bits+=24; statBits.count+=3;
 #endif
-  assert(start_code_prefix_one_3bytes == 0x000001);
   stats.m_numStartCodePrefixBytes += 3;
 
   /* 3. NumBytesInNALunit is set equal to the number of bytes starting with
@@ -130,19 +222,41 @@ _byteStreamNALUnit(
    * bytes. This sequence of bytes is nal_unit( NumBytesInNALunit ) and is
    * decoded using the NAL unit decoding process
    */
-  /* NB, (unsigned)x > 2 implies n!=0 && n!=1 */
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-  TComCodingStatistics::SStat &bodyStats=TComCodingStatistics::GetStatisticEP(STATS__NAL_UNIT_TOTAL_BODY);
-#endif
-  while (bs.eofBeforeNBytes(24/8) || bs.peekBytes(24/8) > 2)
+  /* NB, the bytes are left in the buffer of bs, which keeps them while
+   * the trailing bytes are read */
+  bs.keepBytes();
+  Bool eof = false;
+  std::size_t scan = 0; /* bytes before scan cannot start a three-byte sequence ending the NAL unit */
+  while (true)
   {
+    const std::size_t numBuffered = bs.fill(scan + 3);
+    if (numBuffered < scan + 3)
+    {
+      nalUnitSize = numBuffered;
+      eof = true;
+      break;
+    }
+    const uint8_t* bytes = bs.getBufferedBytes();
+    const uint8_t* zero  = static_cast<const uint8_t*>(memchr(bytes + scan, 0x00, numBuffered - 2 - scan));
+    if (zero == NULL)
+    {
+      scan = numBuffered - 2;
+    }
+    else if (zero[1] == 0x00 && zero[2] <= 0x02)
+    {
+      nalUnitSize = zero - bytes;
+      break;
+    }
+    else
+    {
+      scan = zero - bytes + 1;
+    }
+  }
+  bs.skipBytes(nalUnitSize);
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-    uint8_t thebyte=bs.readByte();bodyStats.bits+=8;bodyStats.count++;
-    nalUnit.push_back(thebyte);
-#else
-    nalUnit.push_back(bs.readByte());
+  TComCodingStatistics::SStat &bodyStats=TComCodingStatistics::GetStatisticEP(STATS__NAL_UNIT_TOTAL_BODY);
+  bodyStats.bits += 8*Int64(nalUnitSize); bodyStats.count += Int64(nalUnitSize);
 #endif
-  }
 
   /* 5. When the current position in the byte stream is:
    *  - not at the end of the byte stream (as determined by unspecified means)
@@ -158,25 +272,29 @@ _byteStreamNALUnit(
    *  - the end of the byte stream has been encountered (as determined by
    *    unspecified means).
    */
-  /* NB, (3) guarantees there are at least three bytes available or none */
-  while ((bs.eofBeforeNBytes(24/8) || bs.peekBytes(24/8) != 0x000001)
-  &&     (bs.eofBeforeNBytes(32/8) || bs.peekBytes(32/8) != 0x00000001))
+  if (!eof)
   {
-    uint8_t trailing_zero_8bits = bs.readByte();
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-    statBits.bits+=8; statBits.count++;
+    const UInt numTrailingZero8BitsBytes = stats.m_numTrailingZero8BitsBytes;
+#endif
+    eof = !skipToStartCode(bs, stats.m_numTrailingZero8BitsBytes);
+#if RExt__DECODER_DEBUG_BIT_STATISTICS
+    statBits.bits += 8*(stats.m_numTrailingZero8BitsBytes - numTrailingZero8BitsBytes); statBits.count += stats.m_numTrailingZero8BitsBytes - numTrailingZero8BitsBytes;
 #endif
-    assert(trailing_zero_8bits == 0);
-    stats.m_numTrailingZero8BitsBytes++;
   }
+
+  nalUnit = bs.releaseKeptBytes();
+  stats.m_numBytesInNALUnit = UInt(nalUnitSize);
+  return eof;
 }
 
 /**
  * Parse an AVC AnnexB Bytestream bs to extract a single nalUnit
- * while accumulating bytestream statistics into stats.
+ * while accumulating bytestream statistics into stats.  The nalUnit
+ * is copied into a vector.
  *
- * Returns false if EOF was reached (NB, nalunit data may be valid),
- *         otherwise true.
+ * Returns true if EOF was reached (NB, nalunit data may be valid),
+ *         otherwise false.
  */
 Bool
 byteStreamNALUnit(
@@ -184,16 +302,10 @@ byteStreamNALUnit(
   vector<uint8_t>& nalUnit,
   AnnexBStats& stats)
 {
-  Bool eof = false;
-  try
-  {
-    _byteStreamNALUnit(bs, nalUnit, stats);
-  }
-  catch (...)
-  {
-    eof = true;
-  }
-  stats.m_numBytesInNALUnit = UInt(nalUnit.size());
+  const uint8_t* nalUnitBytes = NULL;
+  std::size_t nalUnitSize = 0;
+  const Bool eof = byteStreamNALUnit(bs, nalUnitBytes, nalUnitSize, stats);
+  nalUnit.assign(nalUnitBytes, nalUnitBytes + nalUnitSize);
   return eof;
 }
 //! \}
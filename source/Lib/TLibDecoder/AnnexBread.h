@@ -42,6 +42,8 @@
 #define __ANNEXBREAD__
 
 #include <stdint.h>
+#include <cassert>
+#include <cstddef>
 #include <istream>
 #include <vector>
 
@@ -55,119 +57,79 @@ class InputByteStream
 public:
   /**
    * Create a bytestream reader that will extract bytes from
-   * istream.
+   * istream, which it reads in large blocks.
    *
    * NB, it isn't safe to access istream while in use by a
    * InputByteStream.
-   *
-   * Side-effects: the exception mask of istream is set to eofbit
    */
   InputByteStream(std::istream& istream)
-  : m_NumFutureBytes(0)
-  , m_FutureBytes(0)
-  , m_Input(istream)
+  : m_Input(istream)
+  , m_Buf(BLOCK_SIZE)
+  , m_Pos(0)
+  , m_End(0)
+  , m_Kept(0)
+  , m_bKeeping(false)
+  , m_bInputEnded(false)
   {
-    istream.exceptions(std::istream::eofbit | std::istream::badbit);
   }
 
   /**
-   * Reset the internal state.  Must be called if input stream is
-   * modified externally to this class
+   * Reset the internal state, dropping the buffered bytes.  Must be
+   * called if input stream is modified externally to this class
    */
   Void reset()
   {
-    m_NumFutureBytes = 0;
-    m_FutureBytes = 0;
+    m_Pos = m_End = m_Kept = 0;
+    m_bKeeping = false;
+    m_bInputEnded = false;
   }
 
   /**
-   * returns true if an EOF will be encountered within the next
-   * n bytes.
+   * Buffer at least numBytes bytes from the current position, unless
+   * the input ends before.  Returns the number of bytes buffered from
+   * the current position.  Pointers to the buffered bytes are not valid
+   * after a call to fill().
    */
-  Bool eofBeforeNBytes(UInt n)
-  {
-    assert(n <= 4);
-    if (m_NumFutureBytes >= n)
-    {
-      return false;
-    }
-
-    n -= m_NumFutureBytes;
-    try
-    {
-      for (UInt i = 0; i < n; i++)
-      {
-        m_FutureBytes = (m_FutureBytes << 8) | m_Input.get();
-        m_NumFutureBytes++;
-      }
-    }
-    catch (...)
-    {
-      return true;
-    }
-    return false;
-  }
+  std::size_t fill(std::size_t numBytes);
 
-  /**
-   * return the next n bytes in the stream without advancing
-   * the stream pointer.
-   *
-   * Returns: an unsigned integer representing an n byte bigendian
-   * word.
-   *
-   * If an attempt is made to read past EOF, an n-byte word is
-   * returned, but the portion that required input bytes beyond EOF
-   * is undefined.
-   *
-   */
-  uint32_t peekBytes(UInt n)
+  /// bytes buffered from the current position
+  const uint8_t* getBufferedBytes() const { return &m_Buf[m_Pos]; }
+
+  /// consume numBytes bytes, which must have been buffered
+  Void skipBytes(std::size_t numBytes)
   {
-    eofBeforeNBytes(n);
-    return m_FutureBytes >> 8*(m_NumFutureBytes - n);
+    assert(numBytes <= m_End - m_Pos);
+    m_Pos += numBytes;
   }
 
-  /**
-   * consume and return one byte from the input.
-   *
-   * If bytestream is already at EOF prior to a call to readByte(),
-   * an exception std::ios_base::failure is thrown.
-   */
-  uint8_t readByte()
+  /// keep the bytes from the current position buffered, until releaseKeptBytes()
+  Void keepBytes()
   {
-    if (!m_NumFutureBytes)
-    {
-      uint8_t byte = m_Input.get();
-      return byte;
-    }
-    m_NumFutureBytes--;
-    uint8_t wanted_byte = m_FutureBytes >> 8*m_NumFutureBytes;
-    m_FutureBytes &= ~(0xff << 8*m_NumFutureBytes);
-    return wanted_byte;
+    m_Kept = m_Pos;
+    m_bKeeping = true;
   }
 
-  /**
-   * consume and return n bytes from the input.  n bytes from
-   * bytestream are interpreted as bigendian when assembling
-   * the return value.
-   */
-  uint32_t readBytes(UInt n)
+  /// stop keeping bytes.  Returns the first kept byte, valid until the next call to fill()
+  const uint8_t* releaseKeptBytes()
   {
-    uint32_t val = 0;
-    for (UInt i = 0; i < n; i++)
-    {
-      val = (val << 8) | readByte();
-    }
-    return val;
+    m_bKeeping = false;
+    return &m_Buf[m_Kept];
   }
 
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-  UInt GetNumBufferedBytes() const { return m_NumFutureBytes; }
+  UInt GetNumBufferedBytes() const { return UInt(m_End - m_Pos); }
 #endif
 
 private:
-  UInt m_NumFutureBytes; /* number of valid bytes in m_FutureBytes */
-  uint32_t m_FutureBytes; /* bytes that have been peeked */
+  static const std::size_t BLOCK_SIZE = 1 << 20; /* bytes read from the input at once */
+
   std::istream& m_Input; /* Input stream to read from */
+  std::vector<uint8_t> m_Buf; /* bytes read from the input */
+  std::size_t m_Pos; /* offset in m_Buf of the current position */
+  std::size_t m_End; /* offset in m_Buf of the end of the bytes read */
+  std::size_t m_Kept; /* offset in m_Buf of the first kept byte */
+  Bool m_bKeeping; /* bytes from m_Kept are to be kept */
+  Bool m_bInputEnded; /* all bytes of the input have been read */
 };
 
 /**
@@ -190,8 +152,15 @@ struct AnnexBStats
     this->m_numTrailingZero8BitsBytes += rhs.m_numTrailingZero8BitsBytes;
     return *this;
   }
+
+  /// number of bytes of the byte stream the statistics account for
+  UInt getNumBytes() const
+  {
+    return m_numLeadingZero8BitsBytes + m_numZeroByteBytes + m_numStartCodePrefixBytes + m_numBytesInNALUnit + m_numTrailingZero8BitsBytes;
+  }
 };
 
+Bool byteStreamNALUnit(InputByteStream& bs, const uint8_t*& nalUnit, std::size_t& nalUnitSize, AnnexBStats& stats);
 Bool byteStreamNALUnit(InputByteStream& bs, std::vector<uint8_t>& nalUnit, AnnexBStats& stats);
 
 //! \}
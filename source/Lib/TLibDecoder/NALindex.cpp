@@ -0,0 +1,481 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2016, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ \file     NALindex.cpp
+ \brief    index of the NAL units of a byte stream, for random access
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <utility>
+
+#include "NALindex.h"
+#include "AnnexBread.h"
+#include "NALread.h"
+#include "TDecCAVLC.h"
+
+using namespace std;
+
+//! \ingroup TLibDecoder
+//! \{
+
+static const TChar* const NAL_INDEX_SIGNATURE = "NALINDEX";
+static const Int          NAL_INDEX_VERSION   = 1;
+
+static Bool isIrap(NalUnitType nalUnitType)
+{
+  return nalUnitType >= NAL_UNIT_CODED_SLICE_BLA_W_LP && nalUnitType <= NAL_UNIT_RESERVED_IRAP_VCL23;
+}
+
+static Bool isIdr(NalUnitType nalUnitType)
+{
+  return nalUnitType == NAL_UNIT_CODED_SLICE_IDR_W_RADL || nalUnitType == NAL_UNIT_CODED_SLICE_IDR_N_LP;
+}
+
+static Bool isBla(NalUnitType nalUnitType)
+{
+  return nalUnitType >= NAL_UNIT_CODED_SLICE_BLA_W_LP && nalUnitType <= NAL_UNIT_CODED_SLICE_BLA_N_LP;
+}
+
+static Bool isRasl(NalUnitType nalUnitType)
+{
+  return nalUnitType == NAL_UNIT_CODED_SLICE_RASL_N || nalUnitType == NAL_UNIT_CODED_SLICE_RASL_R;
+}
+
+static Bool isParameterSet(NalUnitType nalUnitType)
+{
+  return nalUnitType == NAL_UNIT_VPS || nalUnitType == NAL_UNIT_SPS || nalUnitType == NAL_UNIT_PPS;
+}
+
+/// NAL unit that starts an access unit when it precedes the first VCL NAL unit of a picture (7.4.2.4.4)
+static Bool canStartAccessUnit(NalUnitType nalUnitType)
+{
+  return nalUnitType == NAL_UNIT_ACCESS_UNIT_DELIMITER
+      || isParameterSet(nalUnitType)
+      || nalUnitType == NAL_UNIT_PREFIX_SEI
+      || (nalUnitType >= NAL_UNIT_RESERVED_NVCL41 && nalUnitType <= NAL_UNIT_RESERVED_NVCL44)
+      || (nalUnitType >= NAL_UNIT_UNSPECIFIED_48 && nalUnitType <= NAL_UNIT_UNSPECIFIED_55);
+}
+
+static UInt readUvlc(TComInputBitstream& bs)
+{
+  UInt numLeadingZeroBits = 0;
+  UInt bit;
+  bs.read(1, bit);
+  while (!bit && numLeadingZeroBits < 31)
+  {
+    numLeadingZeroBits++;
+    bs.read(1, bit);
+  }
+  UInt value = 0;
+  if (numLeadingZeroBits)
+  {
+    bs.read(numLeadingZeroBits, value);
+    value += (1 << numLeadingZeroBits) - 1;
+  }
+  return value;
+}
+
+NALIndex::NALIndex()
+: m_streamSize(0)
+, m_entries()
+, m_randomAccessPoints()
+{
+}
+
+/**
+ * Index the NAL units of a byte stream, parsing the parameter sets and
+ * the start of the slice segment headers to derive the picture order
+ * count of every picture (8.3.1).
+ */
+Void NALIndex::build(istream& bitstream)
+{
+  /// the parts of a PPS needed to parse the POC of a slice
+  struct PPSInfo
+  {
+    Int  spsId;
+    Int  numExtraSliceHeaderBits;
+    Bool outputFlagPresentFlag;
+  };
+  map<Int, UInt>    bitsForPOC; // by SPS id
+  map<Int, PPSInfo> ppsInfo;    // by PPS id
+
+  m_streamSize = 0;
+  m_entries.clear();
+
+  InputByteStream bytestream(bitstream);
+  TDecCavlc       cavlcDecoder;
+  Bool            bNoRaslOutput = true; // the first picture and the first picture after an EOS
+  Int             prevTid0POC   = 0;
+  Int             pocCurrPic    = 0;
+
+  Bool bBitstreamEnded = false;
+  while (!bBitstreamEnded)
+  {
+    AnnexBStats stats = AnnexBStats();
+    const uint8_t* nalUnitBytes = NULL;
+    std::size_t numNalUnitBytes = 0;
+    bBitstreamEnded = byteStreamNALUnit(bytestream, nalUnitBytes, numNalUnitBytes, stats);
+
+    const UInt64 offset = m_streamSize + stats.m_numLeadingZero8BitsBytes;
+    m_streamSize += stats.getNumBytes();
+    if (numNalUnitBytes == 0)
+    {
+      continue;
+    }
+
+    InputNALUnit nalu;
+    ::read(nalu, nalUnitBytes, numNalUnitBytes);
+    TComInputBitstream &bs = nalu.getBitstream();
+
+    NALIndexEntry entry;
+    entry.m_offset                   = offset;
+    entry.m_size                     = UInt(numNalUnitBytes);
+    entry.m_nalUnitType              = nalu.m_nalUnitType;
+    entry.m_temporalId               = nalu.m_temporalId;
+    entry.m_nuhLayerId               = nalu.m_nuhLayerId;
+    entry.m_poc                      = 0;
+    entry.m_parameterSetId           = -1;
+    entry.m_referencedParameterSetId = -1;
+    entry.m_firstSliceSegmentInPic   = false;
+    entry.m_noOutputOfPriorPics      = false;
+
+    if (nalu.m_nuhLayerId == 0)
+    {
+      cavlcDecoder.setBitstream(&bs);
+      switch (nalu.m_nalUnitType)
+      {
+        case NAL_UNIT_VPS:
+          {
+            UInt vpsId;
+            bs.read(4, vpsId); // vps_video_parameter_set_id
+            entry.m_parameterSetId = Int(vpsId);
+          }
+          break;
+
+        case NAL_UNIT_SPS:
+          {
+            TComSPS sps;
+            cavlcDecoder.parseSPS(&sps);
+            entry.m_parameterSetId           = sps.getSPSId();
+            entry.m_referencedParameterSetId = sps.getVPSId();
+            bitsForPOC[sps.getSPSId()]       = sps.getBitsForPOC();
+          }
+          break;
+
+        case NAL_UNIT_PPS:
+          {
+            TComPPS pps;
+            cavlcDecoder.parsePPS(&pps);
+            entry.m_parameterSetId           = pps.getPPSId();
+            entry.m_referencedParameterSetId = pps.getSPSId();
+            PPSInfo &info = ppsInfo[pps.getPPSId()];
+            info.spsId                   = pps.getSPSId();
+            info.numExtraSliceHeaderBits = pps.getNumExtraSliceHeaderBits();
+            info.outputFlagPresentFlag   = pps.getOutputFlagPresentFlag();
+          }
+          break;
+
+        case NAL_UNIT_EOS:
+          bNoRaslOutput = true;
+          break;
+
+        default:
+          if (nalu.isSlice())
+          {
+            UInt code;
+            bs.read(1, code);
+            entry.m_firstSliceSegmentInPic = code != 0;
+            if (isIrap(nalu.m_nalUnitType))
+            {
+              bs.read(1, code);
+              entry.m_noOutputOfPriorPics = code != 0;
+            }
+            entry.m_referencedParameterSetId = Int(readUvlc(bs)); // slice_pic_parameter_set_id
+
+            map<Int, PPSInfo>::const_iterator pps = ppsInfo.find(entry.m_referencedParameterSetId);
+            if (entry.m_firstSliceSegmentInPic && pps != ppsInfo.end() && bitsForPOC.count(pps->second.spsId))
+            {
+              const UInt bitsForPOCLsb = bitsForPOC[pps->second.spsId];
+              const Int  maxPOCLsb     = 1 << bitsForPOCLsb;
+              Int pocLsb = 0;
+              if (!isIdr(nalu.m_nalUnitType))
+              {
+                for (Int i = 0; i < pps->second.numExtraSliceHeaderBits; i++)
+                {
+                  bs.read(1, code); // slice_reserved_flag
+                }
+                readUvlc(bs); // slice_type
+                if (pps->second.outputFlagPresentFlag)
+                {
+                  bs.read(1, code); // pic_output_flag
+                }
+                bs.read(bitsForPOCLsb, code); // slice_pic_order_cnt_lsb
+                pocLsb = Int(code);
+              }
+
+              Int pocMsb = 0;
+              if (!(isIrap(nalu.m_nalUnitType) && (bNoRaslOutput || isIdr(nalu.m_nalUnitType) || isBla(nalu.m_nalUnitType))))
+              {
+                const Int prevPOCLsb = prevTid0POC & (maxPOCLsb - 1);
+                const Int prevPOCMsb = prevTid0POC - prevPOCLsb;
+                if (pocLsb < prevPOCLsb && prevPOCLsb - pocLsb >= maxPOCLsb / 2)
+                {
+                  pocMsb = prevPOCMsb + maxPOCLsb;
+                }
+                else if (pocLsb > prevPOCLsb && pocLsb - prevPOCLsb > maxPOCLsb / 2)
+                {
+                  pocMsb = prevPOCMsb - maxPOCLsb;
+                }
+                else
+                {
+                  pocMsb = prevPOCMsb;
+                }
+              }
+              pocCurrPic = pocMsb + pocLsb;
+
+              const Bool bSubLayerNonReference = nalu.m_nalUnitType <= NAL_UNIT_RESERVED_VCL_R15 && nalu.m_nalUnitType % 2 == 0;
+              if (nalu.m_temporalId == 0 && !bSubLayerNonReference
+                  && nalu.m_nalUnitType != NAL_UNIT_CODED_SLICE_RADL_R && nalu.m_nalUnitType != NAL_UNIT_CODED_SLICE_RASL_R)
+              {
+                prevTid0POC = pocCurrPic;
+              }
+              bNoRaslOutput = false;
+            }
+            entry.m_poc = pocCurrPic;
+          }
+          break;
+      }
+    }
+    m_entries.push_back(entry);
+  }
+
+  xDeriveRandomAccessPoints();
+}
+
+/**
+ * Read an index written by write().
+ * \returns false if the file cannot be opened or is not an index
+ */
+Bool NALIndex::read(const std::string& fileName)
+{
+  ifstream file(fileName.c_str());
+  string signature;
+  Int version = 0;
+  std::size_t numEntries = 0;
+  file >> signature >> version >> m_streamSize >> numEntries;
+  if (!file || signature != NAL_INDEX_SIGNATURE || version != NAL_INDEX_VERSION)
+  {
+    return false;
+  }
+
+  m_entries.resize(numEntries);
+  for (std::size_t i = 0; i < numEntries; i++)
+  {
+    NALIndexEntry &entry = m_entries[i];
+    Int nalUnitType;
+    Int firstSliceSegmentInPic;
+    Int noOutputOfPriorPics;
+    file >> entry.m_offset >> entry.m_size >> nalUnitType >> entry.m_temporalId >> entry.m_nuhLayerId >> entry.m_poc
+         >> entry.m_parameterSetId >> entry.m_referencedParameterSetId >> firstSliceSegmentInPic >> noOutputOfPriorPics;
+    entry.m_nalUnitType            = NalUnitType(nalUnitType);
+    entry.m_firstSliceSegmentInPic = firstSliceSegmentInPic != 0;
+    entry.m_noOutputOfPriorPics    = noOutputOfPriorPics != 0;
+  }
+  if (!file)
+  {
+    m_entries.clear();
+    return false;
+  }
+
+  xDeriveRandomAccessPoints();
+  return true;
+}
+
+/**
+ * Write the index as text: a header line, then one line per NAL unit with
+ * its offset, size, nal_unit_type, temporal_id, nuh_layer_id, POC,
+ * parameter set id, referenced parameter set id,
+ * first_slice_segment_in_pic_flag and no_output_of_prior_pics_flag.
+ */
+Bool NALIndex::write(const std::string& fileName) const
+{
+  ofstream file(fileName.c_str());
+  file << NAL_INDEX_SIGNATURE << " " << NAL_INDEX_VERSION << " " << m_streamSize << " " << m_entries.size() << "\n";
+  for (std::size_t i = 0; i < m_entries.size(); i++)
+  {
+    const NALIndexEntry &entry = m_entries[i];
+    file << entry.m_offset << " " << entry.m_size << " " << Int(entry.m_nalUnitType) << " " << entry.m_temporalId << " " << entry.m_nuhLayerId
+         << " " << entry.m_poc << " " << entry.m_parameterSetId << " " << entry.m_referencedParameterSetId
+         << " " << (entry.m_firstSliceSegmentInPic ? 1 : 0) << " " << (entry.m_noOutputOfPriorPics ? 1 : 0) << "\n";
+  }
+  file.close();
+  return !file.fail();
+}
+
+/**
+ * Get the parameter sets a decoder needs to start decoding at an entry:
+ * the last VPS, SPS and PPS of each id that precede it.
+ * \param entry          index of the entry to start decoding at
+ * \param parameterSets  receives the indices of the parameter set entries, in decoding order
+ */
+Void NALIndex::getParameterSets(std::size_t entry, std::vector<std::size_t>& parameterSets) const
+{
+  map<pair<Int, Int>, std::size_t> lastParameterSets; // by type and id
+  for (std::size_t i = 0; i < entry && i < m_entries.size(); i++)
+  {
+    if (isParameterSet(m_entries[i].m_nalUnitType) && m_entries[i].m_nuhLayerId == 0)
+    {
+      lastParameterSets[make_pair(Int(m_entries[i].m_nalUnitType), m_entries[i].m_parameterSetId)] = i;
+    }
+  }
+
+  parameterSets.clear();
+  for (map<pair<Int, Int>, std::size_t>::const_iterator it = lastParameterSets.begin(); it != lastParameterSets.end(); it++)
+  {
+    parameterSets.push_back(it->second);
+  }
+  sort(parameterSets.begin(), parameterSets.end());
+}
+
+/**
+ * Split the byte stream into segments of about equal size that decode
+ * independently.  Segments start at the access units of clean random
+ * access points, so that decoding all of them outputs the same pictures
+ * as decoding the whole byte stream; a segment is empty when there are
+ * too few of them.
+ * \param segment      index of the segment
+ * \param numSegments  number of segments
+ * \param firstEntry   receives the index of the first entry of the segment
+ * \param endEntry     receives the index of the entry after the segment
+ */
+Void NALIndex::getSegment(UInt segment, UInt numSegments, std::size_t& firstEntry, std::size_t& endEntry) const
+{
+  std::size_t segmentStart[2];
+  for (UInt i = 0; i < 2; i++)
+  {
+    const UInt startSegment = segment + i;
+    if (startSegment == 0)
+    {
+      segmentStart[i] = 0;
+      continue;
+    }
+    segmentStart[i] = m_entries.size();
+    if (startSegment >= numSegments)
+    {
+      continue;
+    }
+    const UInt64 targetOffset = m_streamSize * startSegment / numSegments;
+    for (std::size_t rap = 0; rap < m_randomAccessPoints.size(); rap++)
+    {
+      const NALIndexRandomAccessPoint &randomAccessPoint = m_randomAccessPoints[rap];
+      if (randomAccessPoint.m_clean && randomAccessPoint.m_accessUnitStart > 0 && getOffset(randomAccessPoint.m_accessUnitStart) >= targetOffset)
+      {
+        segmentStart[i] = randomAccessPoint.m_accessUnitStart;
+        break;
+      }
+    }
+  }
+  firstEntry = segmentStart[0];
+  endEntry   = segmentStart[1];
+}
+
+Void NALIndex::xDeriveRandomAccessPoints()
+{
+  m_randomAccessPoints.clear();
+
+  std::size_t accessUnitStart = m_entries.size(); // none since the last VCL NAL unit
+  Bool bNoRaslOutput = true;
+  for (std::size_t i = 0; i < m_entries.size(); i++)
+  {
+    const NALIndexEntry &entry = m_entries[i];
+    if (entry.m_nuhLayerId != 0)
+    {
+      continue;
+    }
+    if (entry.m_nalUnitType == NAL_UNIT_EOS)
+    {
+      bNoRaslOutput = true;
+    }
+    else if ((UInt)entry.m_nalUnitType < 32)
+    {
+      if (entry.m_firstSliceSegmentInPic)
+      {
+        if (isIrap(entry.m_nalUnitType))
+        {
+          NALIndexRandomAccessPoint randomAccessPoint;
+          randomAccessPoint.m_entry           = i;
+          randomAccessPoint.m_accessUnitStart = accessUnitStart < i ? accessUnitStart : i;
+          if (m_randomAccessPoints.empty() && randomAccessPoint.m_accessUnitStart == 0)
+          {
+            randomAccessPoint.m_clean = true;
+          }
+          else if (bNoRaslOutput || isIdr(entry.m_nalUnitType) || isBla(entry.m_nalUnitType))
+          {
+            // the RASL pictures are not output when decoding from the start either, but the prior pictures are
+            randomAccessPoint.m_clean = !entry.m_noOutputOfPriorPics;
+          }
+          else
+          {
+            // a CRA picture, whose RASL pictures need pictures that precede it
+            randomAccessPoint.m_clean = true;
+            for (std::size_t j = i + 1; j < m_entries.size(); j++)
+            {
+              const NALIndexEntry &following = m_entries[j];
+              if (following.m_nuhLayerId == 0 && ((following.m_firstSliceSegmentInPic && isIrap(following.m_nalUnitType)) || following.m_nalUnitType == NAL_UNIT_EOS))
+              {
+                break;
+              }
+              if (isRasl(following.m_nalUnitType))
+              {
+                randomAccessPoint.m_clean = false;
+                break;
+              }
+            }
+          }
+          m_randomAccessPoints.push_back(randomAccessPoint);
+        }
+        bNoRaslOutput = false;
+      }
+      accessUnitStart = m_entries.size();
+    }
+    else if (accessUnitStart == m_entries.size() && canStartAccessUnit(entry.m_nalUnitType))
+    {
+      accessUnitStart = i;
+    }
+  }
+}
+
+//! \}
@@ -0,0 +1,113 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2016, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ \file     NALindex.h
+ \brief    index of the NAL units of a byte stream, for random access
+ */
+
+#pragma once
+
+#ifndef __NALINDEX__
+#define __NALINDEX__
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "TLibCommon/CommonDef.h"
+
+//! \ingroup TLibDecoder
+//! \{
+
+/// position, picture and parameter set dependencies of a NAL unit of a byte stream
+struct NALIndexEntry
+{
+  UInt64      m_offset;                   ///< byte offset of the zero_byte or start code prefix of the NAL unit
+  UInt        m_size;                     ///< number of bytes in the NAL unit
+  NalUnitType m_nalUnitType;              ///< nal_unit_type
+  UInt        m_temporalId;               ///< temporal_id
+  UInt        m_nuhLayerId;               ///< nuh_layer_id
+  Int         m_poc;                      ///< picture order count of the picture of a slice, 0 for other NAL units
+  Int         m_parameterSetId;           ///< id of a VPS, SPS or PPS, -1 for other NAL units
+  Int         m_referencedParameterSetId; ///< VPS of an SPS, SPS of a PPS or PPS of a slice, -1 for other NAL units
+  Bool        m_firstSliceSegmentInPic;   ///< first_slice_segment_in_pic_flag of a slice
+  Bool        m_noOutputOfPriorPics;      ///< no_output_of_prior_pics_flag of an IRAP slice
+};
+
+/// picture at which decoding can start
+struct NALIndexRandomAccessPoint
+{
+  std::size_t m_entry;           ///< index of the first slice of the IRAP picture
+  std::size_t m_accessUnitStart; ///< index of the first NAL unit of the access unit of the IRAP picture
+  Bool        m_clean;           ///< decoding from here outputs the same pictures as decoding the byte stream from its start
+};
+
+/**
+ * Index of the NAL units of an Annex B byte stream, with their byte
+ * offsets, types, POCs and parameter set dependencies.  It is built by
+ * scanning the byte stream once, and stored in a text file next to it,
+ * so that a decoder can seek directly to any random access point or
+ * split the byte stream into segments that decode independently.
+ */
+class NALIndex
+{
+public:
+  NALIndex();
+
+  Void build(std::istream& bitstream); ///< scan a byte stream from its current position to its end
+  Bool read (const std::string& fileName);
+  Bool write(const std::string& fileName) const;
+
+  UInt64                                        getStreamSize() const          { return m_streamSize; }
+  const std::vector<NALIndexEntry>&             getEntries() const             { return m_entries; }
+  const std::vector<NALIndexRandomAccessPoint>& getRandomAccessPoints() const  { return m_randomAccessPoints; }
+
+  /// byte offset of an entry, or the size of the byte stream for the end of the entries
+  UInt64 getOffset(std::size_t entry) const { return entry < m_entries.size() ? m_entries[entry].m_offset : m_streamSize; }
+
+  Void getParameterSets(std::size_t entry, std::vector<std::size_t>& parameterSets) const;
+  Void getSegment(UInt segment, UInt numSegments, std::size_t& firstEntry, std::size_t& endEntry) const;
+
+private:
+  Void xDeriveRandomAccessPoints();
+
+  UInt64                                 m_streamSize;         ///< number of bytes of the byte stream
+  std::vector<NALIndexEntry>             m_entries;            ///< NAL units, in decoding order
+  std::vector<NALIndexRandomAccessPoint> m_randomAccessPoints; ///< IRAP pictures, in decoding order
+};
+
+//! \}
+
+#endif
@@ -40,6 +40,7 @@
 #include <vector>
 #include <algorithm>
 #include <ostream>
+#include <string.h>
 
 #include "NALread.h"
 #include "TLibCommon/NAL.h"
@@ -55,44 +56,79 @@ using namespace std;
 
 //! \ingroup TLibDecoder
 //! \{
-static Void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, TComInputBitstream *bitstream, Bool isVclNalUnit)
+/**
+ * Remove the emulation prevention bytes from the payloadSize bytes of a
+ * NAL unit at payload, into nalUnitBuf.  payload may point at the start
+ * of nalUnitBuf itself.
+ */
+static Void convertPayloadToRBSP(const uint8_t* payload, std::size_t payloadSize, vector<uint8_t>& nalUnitBuf, TComInputBitstream *bitstream, Bool isVclNalUnit)
 {
-  UInt zeroCount = 0;
-  vector<uint8_t>::iterator it_read, it_write;
-
-  UInt pos = 0;
   bitstream->clearEmulationPreventionByteLocation();
-  for (it_read = it_write = nalUnitBuf.begin(); it_read != nalUnitBuf.end(); it_read++, it_write++, pos++)
+  nalUnitBuf.resize(payloadSize);
+  if (payloadSize == 0)
+  {
+    return;
+  }
+
+  /* An emulation_prevention_three_byte can only follow two zero bytes, so
+   * locate zero bytes with memchr and copy the clean runs in between over
+   * the removed bytes with a single memmove each. */
+  uint8_t *const       bufBegin = &nalUnitBuf.front();
+  const uint8_t *const bufEnd   = payload + payloadSize;
+  const uint8_t       *runStart = payload;
+  const uint8_t       *scan     = payload;
+  uint8_t             *writePtr = bufBegin;
+
+  assert(bufEnd[-1] != 0x00);
+
+  while (true)
   {
-    assert(zeroCount < 2 || *it_read >= 0x03);
-    if (zeroCount == 2 && *it_read == 0x03)
+    const uint8_t *zero = static_cast<const uint8_t*>(memchr(scan, 0x00, bufEnd - scan));
+    if (zero == NULL || zero + 2 >= bufEnd)
+    {
+      break;
+    }
+    if (zero[1] != 0x00)
     {
-      bitstream->pushEmulationPreventionByteLocation( pos );
-      pos++;
-      it_read++;
-      zeroCount = 0;
+      scan = zero + 2;
+    }
+    else if (zero[2] > 0x03)
+    {
+      scan = zero + 3;
+    }
+    else
+    {
+      assert(zero[2] == 0x03);
+      const std::size_t runLength = zero + 2 - runStart;
+      if (writePtr != runStart)
+      {
+        memmove(writePtr, runStart, runLength);
+      }
+      writePtr += runLength;
+
+      bitstream->pushEmulationPreventionByteLocation( UInt(zero + 2 - payload) );
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
       TComCodingStatistics::IncrementStatisticEP(STATS__EMULATION_PREVENTION_3_BYTES, 8, 0);
 #endif
-      if (it_read == nalUnitBuf.end())
-      {
-        break;
-      }
-      assert(*it_read <= 0x03);
+      runStart = scan = zero + 3;
+      assert(runStart == bufEnd || *runStart <= 0x03);
     }
-    zeroCount = (*it_read == 0x00) ? zeroCount+1 : 0;
-    *it_write = *it_read;
   }
-  assert(zeroCount == 0);
+  const std::size_t runLength = bufEnd - runStart;
+  if (writePtr != runStart)
+  {
+    memmove(writePtr, runStart, runLength);
+  }
+  writePtr += runLength;
 
   if (isVclNalUnit)
   {
     // Remove cabac_zero_word from payload if present
     Int n = 0;
 
-    while (it_write[-1] == 0x00)
+    while (writePtr[-1] == 0x00)
     {
-      it_write--;
+      writePtr--;
       n++;
     }
 
@@ -102,7 +138,7 @@ static Void convertPayloadToRBSP(vector<uint8_t>& nalUnitBuf, TComInputBitstream
     }
   }
 
-  nalUnitBuf.resize(it_write - nalUnitBuf.begin());
+  nalUnitBuf.resize(writePtr - bufBegin);
 }
 
 #if ENC_DEC_TRACE && DEC_NUH_TRACE
@@ -173,11 +209,20 @@ Void readNalUnitHeader(InputNALUnit& nalu)
  * a bitstream
  */
 Void read(InputNALUnit& nalu)
+{
+  vector<uint8_t>& nalUnitBuf=nalu.getBitstream().getFifo();
+  read(nalu, &nalUnitBuf[0], nalUnitBuf.size());
+}
+
+/**
+ * fill a NALunit structure from the payloadSize bytes of a NAL unit at
+ * payload, which are unescaped straight into its bitstream
+ */
+Void read(InputNALUnit& nalu, const uint8_t* payload, std::size_t payloadSize)
 {
   TComInputBitstream &bitstream = nalu.getBitstream();
-  vector<uint8_t>& nalUnitBuf=bitstream.getFifo();
   // perform anti-emulation prevention
-  convertPayloadToRBSP(nalUnitBuf, &bitstream, (nalUnitBuf[0] & 64) == 0);
+  convertPayloadToRBSP(payload, payloadSize, bitstream.getFifo(), &bitstream, (payload[0] & 64) == 0);
   bitstream.resetToStart();
   readNalUnitHeader(nalu);
 }
@@ -66,6 +66,7 @@ class InputNALUnit : public NALUnit
 };
 
 Void read(InputNALUnit& nalu);
+Void read(InputNALUnit& nalu, const uint8_t* payload, std::size_t payloadSize);
 Void readNalUnitHeader(InputNALUnit& nalu);
 
 //! \}
@@ -72,10 +72,11 @@ TDecBinCABAC::start()
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   TComCodingStatistics::UpdateCABACStat(STATS__CABAC_INITIALISATION, 512, 510, 0);
 #endif
-  m_uiRange    = 510;
-  m_bitsNeeded = -8;
-  m_uiValue    = (m_pcTComBitstream->readByte() << 8);
-  m_uiValue   |= m_pcTComBitstream->readByte();
+  m_uiRange         = 510;
+  m_uiValue         = 0;
+  m_bitsLeft        = -9;
+  m_numPaddingBytes = 0;
+  xRefill();
 }
 
 Void
@@ -83,9 +84,10 @@ TDecBinCABAC::finish()
 {
   UInt lastByte;
 
+  xReleaseUnusedBytes();
   m_pcTComBitstream->peekPreviousByte( lastByte );
   // Check for proper stop/alignment pattern
-  assert( ((lastByte << (8 + m_bitsNeeded)) & 0xff) == 0x80 );
+  assert( ((lastByte << (7 - m_bitsLeft)) & 0xff) == 0x80 );
 }
 
 /**
@@ -97,9 +99,74 @@ Void
 TDecBinCABAC::copyState( const TDecBinIf* pcTDecBinIf )
 {
   const TDecBinCABAC* pcTDecBinCABAC = pcTDecBinIf->getTDecBinCABAC();
-  m_uiRange   = pcTDecBinCABAC->m_uiRange;
-  m_uiValue   = pcTDecBinCABAC->m_uiValue;
-  m_bitsNeeded= pcTDecBinCABAC->m_bitsNeeded;
+  m_uiRange         = pcTDecBinCABAC->m_uiRange;
+  m_uiValue         = pcTDecBinCABAC->m_uiValue;
+  m_bitsLeft        = pcTDecBinCABAC->m_bitsLeft;
+  m_numPaddingBytes = pcTDecBinCABAC->m_numPaddingBytes;
+}
+
+/**
+ - Load as many whole bytes into m_uiValue as it can hold.
+ .
+ Beyond the end of the bitstream zero bytes are loaded instead; they are
+ never consumed by a conforming substream.
+ */
+Void
+TDecBinCABAC::xRefill()
+{
+  const Int  numBytes     = ( MAX_BITS_LEFT - m_bitsLeft ) >> 3;
+  const UInt numBytesLeft = m_pcTComBitstream->getNumBitsLeft() >> 3;
+
+  if ( numBytesLeft >= numBytes )
+  {
+    for ( Int i = 0; i < numBytes; i++ )
+    {
+      m_uiValue = ( m_uiValue << 8 ) | m_pcTComBitstream->readByte();
+    }
+  }
+  else
+  {
+    for ( Int i = 0; i < numBytes; i++ )
+    {
+      m_uiValue <<= 8;
+      if ( i < numBytesLeft )
+      {
+        m_uiValue |= m_pcTComBitstream->readByte();
+      }
+      else
+      {
+        m_numPaddingBytes++;
+      }
+    }
+  }
+  m_bitsLeft += numBytes << 3;
+}
+
+/**
+ - Return the whole bytes that were read ahead but not used to the bitstream.
+ .
+ Afterwards the bitstream is positioned at the first byte boundary following
+ the bits used by the arithmetic decoder, and at most 7 bits are left in
+ m_uiValue. This is required before the bitstream is read directly (PCM
+ samples, trailing bits).
+ */
+Void
+TDecBinCABAC::xReleaseUnusedBytes()
+{
+  const Int numUnusedBytes = m_bitsLeft >> 3;
+
+  if ( numUnusedBytes > m_numPaddingBytes )
+  {
+    m_pcTComBitstream->unreadBytes( numUnusedBytes - m_numPaddingBytes );
+    m_numPaddingBytes = 0;
+  }
+  else
+  {
+    m_numPaddingBytes -= numUnusedBytes;
+  }
+
+  m_uiValue >>= numUnusedBytes << 3;
+  m_bitsLeft -= numUnusedBytes << 3;
 }
 
 
@@ -114,9 +181,15 @@ Void TDecBinCABAC::decodeBin( UInt& ruiBin, ContextModel &rcCtxModel )
   const UInt startingRange = m_uiRange;
 #endif
 
+  // renormalisation uses at most 6 bits
+  if ( m_bitsLeft < 6 )
+  {
+    xRefill();
+  }
+
   UInt uiLPS = TComCABACTables::sm_aucLPSTable[ rcCtxModel.getState() ][ ( m_uiRange >> 6 ) - 4 ];
   m_uiRange -= uiLPS;
-  UInt scaledRange = m_uiRange << 7;
+  const UInt64 scaledRange = UInt64( m_uiRange ) << m_bitsLeft;
 
   if( m_uiValue < scaledRange )
   {
@@ -127,17 +200,10 @@ Void TDecBinCABAC::decodeBin( UInt& ruiBin, ContextModel &rcCtxModel )
 #endif
     rcCtxModel.updateMPS();
 
-    if ( scaledRange < ( 256 << 7 ) )
-    {
-      m_uiRange = scaledRange >> 6;
-      m_uiValue += m_uiValue;
-
-      if ( ++m_bitsNeeded == 0 )
-      {
-        m_bitsNeeded = -8;
-        m_uiValue += m_pcTComBitstream->readByte();
-      }
-    }
+    // the MPS range is at least 128, so renormalisation takes at most one bit
+    const Int numBits = ( m_uiRange >> 8 ) ^ 1;
+    m_uiRange <<= numBits;
+    m_bitsLeft -= numBits;
   }
   else
   {
@@ -146,18 +212,11 @@ Void TDecBinCABAC::decodeBin( UInt& ruiBin, ContextModel &rcCtxModel )
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
     TComCodingStatistics::UpdateCABACStat(whichStat, m_uiRange+uiLPS, uiLPS, Int(ruiBin));
 #endif
-    Int numBits = TComCABACTables::sm_aucRenormTable[ uiLPS >> 3 ];
-    m_uiValue   = ( m_uiValue - scaledRange ) << numBits;
+    const Int numBits = TComCABACTables::sm_aucRenormTable[ uiLPS >> 3 ];
+    m_uiValue  -= scaledRange;
     m_uiRange   = uiLPS << numBits;
+    m_bitsLeft -= numBits;
     rcCtxModel.updateLPS();
-
-    m_bitsNeeded += numBits;
-
-    if ( m_bitsNeeded >= 0 )
-    {
-      m_uiValue += m_pcTComBitstream->readByte() << m_bitsNeeded;
-      m_bitsNeeded -= 8;
-    }
   }
 
 #if DEBUG_CABAC_BINS
@@ -186,26 +245,15 @@ Void TDecBinCABAC::decodeBinEP( UInt& ruiBin, const TComCodingStatisticsClassTyp
 Void TDecBinCABAC::decodeBinEP( UInt& ruiBin )
 #endif
 {
-  if (m_uiRange == 256)
+  if ( m_bitsLeft < 1 )
   {
-#if RExt__DECODER_DEBUG_BIT_STATISTICS
-    decodeAlignedBinsEP(ruiBin, 1, whichStat);
-#else
-    decodeAlignedBinsEP(ruiBin, 1);
-#endif
-    return;
+    xRefill();
   }
 
-  m_uiValue += m_uiValue;
-
-  if ( ++m_bitsNeeded >= 0 )
-  {
-    m_bitsNeeded = -8;
-    m_uiValue += m_pcTComBitstream->readByte();
-  }
+  m_bitsLeft--;
+  const UInt64 scaledRange = UInt64( m_uiRange ) << m_bitsLeft;
 
   ruiBin = 0;
-  UInt scaledRange = m_uiRange << 7;
   if ( m_uiValue >= scaledRange )
   {
     ruiBin = 1;
@@ -216,69 +264,85 @@ Void TDecBinCABAC::decodeBinEP( UInt& ruiBin )
 #endif
 }
 
+/**
+ - Decode a run of bypass bins at once.
+ .
+ Decoding n bypass bins bin-by-bin is a restoring binary division of the offset
+ extended by the next n bits by the (unchanged) range, so the bins are the
+ quotient and the new offset is the remainder.
+ */
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
 Void TDecBinCABAC::decodeBinsEP( UInt& ruiBin, Int numBins, const TComCodingStatisticsClassType &whichStat )
 #else
 Void TDecBinCABAC::decodeBinsEP( UInt& ruiBin, Int numBins )
 #endif
 {
-  if (m_uiRange == 256)
+  assert( numBins <= 32 );
+
+  if ( m_bitsLeft < numBins )
   {
+    xRefill();
+  }
+
+  m_bitsLeft -= numBins;
+  const UInt64 bins = ( m_uiValue >> m_bitsLeft ) / m_uiRange;
+  m_uiValue -= ( bins * m_uiRange ) << m_bitsLeft;
+
+  ruiBin = UInt( bins );
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-    decodeAlignedBinsEP(ruiBin, numBins, whichStat);
-#else
-    decodeAlignedBinsEP(ruiBin, numBins);
+  TComCodingStatistics::IncrementStatisticEP(whichStat, numBins, Int(ruiBin));
 #endif
-    return;
-  }
+}
 
-  UInt bins = 0;
+/**
+ - Decode bypass bins up to and including the first 0 bin, or until maxNumOnes 1 bins have been decoded.
+ .
+ \param ruiNumOnes  number of 1 bins decoded
+ \param maxNumOnes  maximum number of 1 bins
+ */
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-  Int origNumBins=numBins;
+Void TDecBinCABAC::decodeUnaryBinsEP( UInt& ruiNumOnes, UInt maxNumOnes, const TComCodingStatisticsClassType &whichStat )
+#else
+Void TDecBinCABAC::decodeUnaryBinsEP( UInt& ruiNumOnes, UInt maxNumOnes )
 #endif
-  while ( numBins > 8 )
+{
+  const Int maxBinsPerStep = 16;
+
+  ruiNumOnes = 0;
+
+  while ( ruiNumOnes < maxNumOnes )
   {
-    m_uiValue = ( m_uiValue << 8 ) + ( m_pcTComBitstream->readByte() << ( 8 + m_bitsNeeded ) );
+    const Int numBins = Int( std::min<UInt>( maxNumOnes - ruiNumOnes, maxBinsPerStep ) );
 
-    UInt scaledRange = m_uiRange << 15;
-    for ( Int i = 0; i < 8; i++ )
+    if ( m_bitsLeft < numBins )
     {
-      bins += bins;
-      scaledRange >>= 1;
-      if ( m_uiValue >= scaledRange )
-      {
-        bins++;
-        m_uiValue -= scaledRange;
-      }
+      xRefill();
     }
-    numBins -= 8;
-  }
 
-  m_bitsNeeded += numBins;
-  m_uiValue <<= numBins;
-
-  if ( m_bitsNeeded >= 0 )
-  {
-    m_uiValue += m_pcTComBitstream->readByte() << m_bitsNeeded;
-    m_bitsNeeded -= 8;
-  }
+    // look ahead numBins bins, then keep only those up to the first 0 bin
+    const UInt bins = UInt( ( m_uiValue >> ( m_bitsLeft - numBins ) ) / m_uiRange );
 
-  UInt scaledRange = m_uiRange << ( numBins + 7 );
-  for ( Int i = 0; i < numBins; i++ )
-  {
-    bins += bins;
-    scaledRange >>= 1;
-    if ( m_uiValue >= scaledRange )
+    Int numLeadingOnes = 0;
+    while ( numLeadingOnes < numBins && ( ( bins >> ( numBins - 1 - numLeadingOnes ) ) & 1 ) )
     {
-      bins++;
-      m_uiValue -= scaledRange;
+      numLeadingOnes++;
     }
-  }
 
-  ruiBin = bins;
+    const Int  numBinsUsed = ( numLeadingOnes < numBins ) ? ( numLeadingOnes + 1 ) : numBins;
+    const UInt binsUsed    = bins >> ( numBins - numBinsUsed );
+
+    m_bitsLeft -= numBinsUsed;
+    m_uiValue  -= ( UInt64( binsUsed ) * m_uiRange ) << m_bitsLeft;
+    ruiNumOnes += numLeadingOnes;
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
-  TComCodingStatistics::IncrementStatisticEP(whichStat, origNumBins, Int(ruiBin));
+    TComCodingStatistics::IncrementStatisticEP(whichStat, numBinsUsed, Int(binsUsed));
 #endif
+
+    if ( numLeadingOnes < numBins )
+    {
+      break;
+    }
+  }
 }
 
 Void TDecBinCABAC::align()
@@ -295,40 +359,21 @@ Void TDecBinCABAC::decodeAlignedBinsEP( UInt& ruiBins, Int numBins, const class
 Void TDecBinCABAC::decodeAlignedBinsEP( UInt& ruiBins, Int numBins )
 #endif
 {
-  Int binsRemaining = numBins;
-  ruiBins = 0;
-
   assert(m_uiRange == 256); //aligned decode only works when range = 256
+  assert(numBins <= 32);
 
-  while (binsRemaining > 0)
+  if ( m_bitsLeft < numBins )
   {
-    const UInt binsToRead = std::min<UInt>(binsRemaining, 8); //read bytes if able to take advantage of the system's byte-read function
-    const UInt binMask    = (1 << binsToRead) - 1;
-
-    //The MSB of m_uiValue is known to be 0 because range is 256. Therefore:
-    // > The comparison against the symbol range of 128 is simply a test on the next-most-significant bit
-    // > "Subtracting" the symbol range if the decoded bin is 1 simply involves clearing that bit.
-    //
-    //As a result, the required bins are simply the <binsToRead> next-most-significant bits of m_uiValue
-    //(m_uiValue is stored MSB-aligned in a 16-bit buffer - hence the shift of 15)
-    //
-    //   m_uiValue = |0|V|V|V|V|V|V|V|V|B|B|B|B|B|B|B|        (V = usable bit, B = potential buffered bit (buffer refills when m_bitsNeeded >= 0))
-    //
-    const UInt newBins = (m_uiValue >> (15 - binsToRead)) & binMask;
-
-    ruiBins   = (ruiBins   << binsToRead) | newBins;
-    m_uiValue = (m_uiValue << binsToRead) & 0x7FFF;
-
-    binsRemaining -= binsToRead;
-    m_bitsNeeded  += binsToRead;
-
-    if (m_bitsNeeded >= 0)
-    {
-      m_uiValue    |= m_pcTComBitstream->readByte() << m_bitsNeeded;
-      m_bitsNeeded -= 8;
-    }
+    xRefill();
   }
 
+  //The offset is known to be below 256 because range is 256. Therefore the bins are simply the
+  //<numBins> bits following the offset's 8 least significant bits, and the new offset is what remains.
+  m_bitsLeft -= numBins;
+  const UInt64 bins = m_uiValue >> ( m_bitsLeft + 8 );
+  m_uiValue -= bins << ( m_bitsLeft + 8 );
+
+  ruiBins = UInt( bins );
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
   TComCodingStatistics::IncrementStatisticEP(whichStat, numBins, Int(ruiBins));
 #endif
@@ -337,14 +382,21 @@ Void TDecBinCABAC::decodeAlignedBinsEP( UInt& ruiBins, Int numBins )
 Void
 TDecBinCABAC::decodeBinTrm( UInt& ruiBin )
 {
+  if ( m_bitsLeft < 1 )
+  {
+    xRefill();
+  }
+
   m_uiRange -= 2;
-  UInt scaledRange = m_uiRange << 7;
+  const UInt64 scaledRange = UInt64( m_uiRange ) << m_bitsLeft;
   if( m_uiValue >= scaledRange )
   {
     ruiBin = 1;
+    // the following data (PCM samples or trailing bits) is read from the bitstream directly
+    xReleaseUnusedBytes();
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
     TComCodingStatistics::UpdateCABACStat(STATS__CABAC_TRM_BITS, m_uiRange+2, 2, ruiBin);
-    TComCodingStatistics::IncrementStatisticEP(STATS__BYTE_ALIGNMENT_BITS, -m_bitsNeeded, 0);
+    TComCodingStatistics::IncrementStatisticEP(STATS__BYTE_ALIGNMENT_BITS, m_bitsLeft + 1, 0);
 #endif
   }
   else
@@ -353,16 +405,10 @@ TDecBinCABAC::decodeBinTrm( UInt& ruiBin )
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
     TComCodingStatistics::UpdateCABACStat(STATS__CABAC_TRM_BITS, m_uiRange+2, m_uiRange, ruiBin);
 #endif
-    if ( scaledRange < ( 256 << 7 ) )
+    if ( m_uiRange < 256 )
     {
-      m_uiRange = scaledRange >> 6;
-      m_uiValue += m_uiValue;
-
-      if ( ++m_bitsNeeded == 0 )
-      {
-        m_bitsNeeded = -8;
-        m_uiValue += m_pcTComBitstream->readByte();
-      }
+      m_uiRange <<= 1;
+      m_bitsLeft--;
     }
   }
 }
@@ -60,11 +60,13 @@ public:
   Void  decodeBin          ( UInt& ruiBin, ContextModel& rcCtxModel, const class TComCodingStatisticsClassType &whichStat );
   Void  decodeBinEP        ( UInt& ruiBin                          , const class TComCodingStatisticsClassType &whichStat );
   Void  decodeBinsEP       ( UInt& ruiBin, Int numBins             , const class TComCodingStatisticsClassType &whichStat );
+  Void  decodeUnaryBinsEP  ( UInt& ruiNumOnes, UInt maxNumOnes     , const class TComCodingStatisticsClassType &whichStat );
   Void  decodeAlignedBinsEP( UInt& ruiBins, Int numBins            , const class TComCodingStatisticsClassType &whichStat );
 #else
   Void  decodeBin         ( UInt& ruiBin, ContextModel& rcCtxModel );
   Void  decodeBinEP       ( UInt& ruiBin                           );
   Void  decodeBinsEP      ( UInt& ruiBin, Int numBins              );
+  Void  decodeUnaryBinsEP ( UInt& ruiNumOnes, UInt maxNumOnes      );
   Void  decodeAlignedBinsEP( UInt& ruiBins, Int numBins             );
 #endif
 
@@ -79,10 +81,18 @@ public:
   const TDecBinCABAC* getTDecBinCABAC() const { return this; }
 
 private:
+  Void  xRefill           ();
+  Void  xReleaseUnusedBytes();
+
+  // m_uiValue holds the 9-bit arithmetic decoder offset followed by m_bitsLeft bits read ahead from the
+  // bitstream, so renormalisation only decrements m_bitsLeft and whole bytes are loaded when it runs low
+  static const Int    MAX_BITS_LEFT = 64 - 9;
+
   TComInputBitstream* m_pcTComBitstream;
   UInt                m_uiRange;
-  UInt                m_uiValue;
-  Int                 m_bitsNeeded;
+  UInt64              m_uiValue;
+  Int                 m_bitsLeft;
+  Int                 m_numPaddingBytes;     ///< zero bytes loaded into m_uiValue beyond the end of the bitstream
 };
 
 //! \}
@@ -38,6 +38,7 @@
 #include "TDecCu.h"
 #include "TLibCommon/TComTU.h"
 #include "TLibCommon/TComPrediction.h"
+#include "TLibCommon/TComInterpolationFilter.h"
 
 //! \ingroup TLibDecoder
 //! \{
@@ -99,14 +100,6 @@ Void TDecCu::create( UInt uiMaxDepth, UInt uiMaxWidth, UInt uiMaxHeight, ChromaF
 
   m_bDecodeDQP = false;
   m_IsChromaQpAdjCoded = false;
-
-  // initialize partition order.
-  UInt* piTmp = &g_auiZscanToRaster[0];
-  initZscanToRaster(m_uiMaxDepth, 1, 0, piTmp);
-  initRasterToZscan( uiMaxWidth, uiMaxHeight, m_uiMaxDepth );
-
-  // initialize conversion matrix from partition index to pel
-  initRasterToPelXY( uiMaxWidth, uiMaxHeight, m_uiMaxDepth );
 }
 
 Void TDecCu::destroy()
@@ -414,8 +407,44 @@ Void TDecCu::xDecompressCU( TComDataCU* pCtu, UInt uiAbsPartIdx,  UInt uiDepth )
   xCopyToPic( m_ppcCU[uiDepth], pcPic, uiAbsPartIdx, uiDepth );
 }
 
+/** wait until the reference picture rows used by the motion compensation of a CU are final
+ * \param pcCU pointer to the CU
+ *
+ * Each prediction unit needs its reference block plus the interpolation filter margin. The rows below a picture are
+ * padded from its last row, so positions are clipped to the picture before they are converted to CTU rows.
+ */
+Void TDecCu::xWaitForReferenceRows( TComDataCU* pcCU )
+{
+  const TComSPS &sps        = *(pcCU->getSlice()->getSPS());
+  const Int      picHeight  = sps.getPicHeightInLumaSamples();
+  const Int      ctuHeight  = sps.getMaxCUHeight();
+
+  for ( UInt partIdx = 0; partIdx < pcCU->getNumPartitions(); partIdx++ )
+  {
+    UInt partAddr;
+    Int  width;
+    Int  height;
+    pcCU->getPartIndexAndSize( partIdx, partAddr, width, height );
+
+    for ( Int refList = 0; refList < NUM_REF_PIC_LIST_01; refList++ )
+    {
+      const RefPicList eRefPicList = RefPicList( refList );
+      const Int        refIdx      = pcCU->getCUMvField( eRefPicList )->getRefIdx( partAddr );
+      if ( refIdx < 0 )
+      {
+        continue;
+      }
+
+      const Int lastRow = Int( pcCU->getCUPelY() + g_auiRasterToPelY[g_auiZscanToRaster[partAddr]] ) + height - 1
+                        + ( pcCU->getCUMvField( eRefPicList )->getMv( partAddr ).getVer() >> 2 ) + NTAPS_LUMA;
+      pcCU->getSlice()->getRefPic( eRefPicList, refIdx )->waitForFinishedCtuRows( Clip3( 0, picHeight - 1, lastRow ) / ctuHeight + 1 );
+    }
+  }
+}
+
 Void TDecCu::xReconInter( TComDataCU* pcCU, UInt uiDepth )
 {
+  xWaitForReferenceRows( pcCU );
 
   // inter prediction
   m_pcPrediction->motionCompensation( pcCU, m_ppcYuvReco[uiDepth] );
@@ -47,7 +47,7 @@
 
 //! \ingroup TLibDecoder
 //! \{
-static Void calcAndPrintHashStatus(TComPicYuv& pic, const SEIDecodedPictureHash* pictureHashSEI, const BitDepths &bitDepths, UInt &numChecksumErrors);
+static Void calcAndPrintHashStatus(TComPicYuv& pic, const SEIDecodedPictureHash* pictureHashSEI, const BitDepths &bitDepths, UInt &numChecksumErrors, TComThreadPool* pcThreadPool, Int threadIdx);
 // ====================================================================================================================
 // Constructor / destructor / initialization / destroy
 // ====================================================================================================================
@@ -79,7 +79,8 @@ Void TDecGop::init( TDecEntropy*            pcEntropyDecoder,
                    TDecCavlc*              pcCavlcDecoder,
                    TDecSlice*              pcSliceDecoder,
                    TComLoopFilter*         pcLoopFilter,
-                   TComSampleAdaptiveOffset* pcSAO
+                   TComSampleAdaptiveOffset* pcSAO,
+                   TComThreadPool*         pcThreadPool
                    )
 {
   m_pcEntropyDecoder      = pcEntropyDecoder;
@@ -89,6 +90,7 @@ Void TDecGop::init( TDecEntropy*            pcEntropyDecoder,
   m_pcSliceDecoder        = pcSliceDecoder;
   m_pcLoopFilter          = pcLoopFilter;
   m_pcSAO                 = pcSAO;
+  m_pcThreadPool          = pcThreadPool;
   m_numberOfChecksumErrorsDetected = 0;
 }
 
@@ -132,9 +134,16 @@ Void TDecGop::decompressSlice(TComInputBitstream* pcBitstream, TComPic* pcPic)
   m_dDecTime += (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
 }
 
-Void TDecGop::filterPicture(TComPic* pcPic)
+/** Apply the in-loop filters to a reconstructed picture, extend its borders and print its status line.
+ * \param pcPic          picture to filter
+ * \param uiSliceIdx     slice segment reported in the status line
+ * \param threadIdx      index of the calling worker of the thread pool, -1 if it is not one of them
+ * \param bIsReferenced  whether the picture was marked as used for reference when it was decoded
+ * \param dDecTime       time already spent decoding the picture
+ */
+Void TDecGop::filterPicture(TComPic* pcPic, UInt uiSliceIdx, Int threadIdx, Bool bIsReferenced, Double dDecTime)
 {
-  TComSlice*  pcSlice = pcPic->getSlice(pcPic->getCurrSliceIdx());
+  TComSlice*  pcSlice = pcPic->getSlice(uiSliceIdx);
 
   //-- For time output for each slice
   clock_t iBeforeTime = clock();
@@ -142,18 +151,20 @@ Void TDecGop::filterPicture(TComPic* pcPic)
   // deblocking filter
   Bool bLFCrossTileBoundary = pcSlice->getPPS()->getLoopFilterAcrossTilesEnabledFlag();
   m_pcLoopFilter->setCfg(bLFCrossTileBoundary);
-  m_pcLoopFilter->loopFilterPic( pcPic );
+  m_pcLoopFilter->loopFilterPic( pcPic, m_pcThreadPool, threadIdx );
 
   if( pcSlice->getSPS()->getUseSAO() )
   {
     m_pcSAO->reconstructBlkSAOParams(pcPic, pcPic->getPicSym()->getSAOBlkParam());
-    m_pcSAO->SAOProcess(pcPic);
+    m_pcSAO->SAOProcess(pcPic, m_pcThreadPool, threadIdx);
     m_pcSAO->PCMLFDisableProcess(pcPic);
   }
 
-  pcPic->compressMotion();
+  // the border is only needed once the picture is final, it is used by the motion compensation of later pictures
+  pcPic->getPicYuvRec()->extendPicBorder();
+
   TChar c = (pcSlice->isIntra() ? 'I' : pcSlice->isInterP() ? 'P' : 'B');
-  if (!pcSlice->isReferenced())
+  if (!bIsReferenced)
   {
     c += 32;
   }
@@ -164,9 +175,8 @@ Void TDecGop::filterPicture(TComPic* pcPic)
                                                   c,
                                                   pcSlice->getSliceQp() );
 
-  m_dDecTime += (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
-  printf ("[DT %6.3f] ", m_dDecTime );
-  m_dDecTime  = 0;
+  dDecTime += (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
+  printf ("[DT %6.3f] ", dDecTime );
 
   for (Int iRefList = 0; iRefList < 2; iRefList++)
   {
@@ -185,13 +195,10 @@ Void TDecGop::filterPicture(TComPic* pcPic)
     {
       printf ("Warning: Got multiple decoded picture hash SEI messages. Using first.");
     }
-    calcAndPrintHashStatus(*(pcPic->getPicYuvRec()), hash, pcSlice->getSPS()->getBitDepths(), m_numberOfChecksumErrorsDetected);
+    calcAndPrintHashStatus(*(pcPic->getPicYuvRec()), hash, pcSlice->getSPS()->getBitDepths(), m_numberOfChecksumErrorsDetected, m_pcThreadPool, threadIdx);
   }
 
   printf("\n");
-
-  pcPic->setOutputMark(pcPic->getSlice(0)->getPicOutputFlag() ? true : false);
-  pcPic->setReconMark(true);
 }
 
 /**
@@ -205,7 +212,7 @@ Void TDecGop::filterPicture(TComPic* pcPic)
  *            ***ERROR*** - calculated hash does not match the SEI message
  *            unk         - no SEI message was available for comparison
  */
-static Void calcAndPrintHashStatus(TComPicYuv& pic, const SEIDecodedPictureHash* pictureHashSEI, const BitDepths &bitDepths, UInt &numChecksumErrors)
+static Void calcAndPrintHashStatus(TComPicYuv& pic, const SEIDecodedPictureHash* pictureHashSEI, const BitDepths &bitDepths, UInt &numChecksumErrors, TComThreadPool* pcThreadPool, Int threadIdx)
 {
   /* calculate MD5sum for entire reconstructed picture */
   TComPictureHash recon_digest;
@@ -219,19 +226,19 @@ static Void calcAndPrintHashStatus(TComPicYuv& pic, const SEIDecodedPictureHash*
       case HASHTYPE_MD5:
         {
           hashType = "MD5";
-          numChar = calcMD5(pic, recon_digest, bitDepths);
+          numChar = calcMD5(pic, recon_digest, bitDepths, pcThreadPool, threadIdx);
           break;
         }
       case HASHTYPE_CRC:
         {
           hashType = "CRC";
-          numChar = calcCRC(pic, recon_digest, bitDepths);
+          numChar = calcCRC(pic, recon_digest, bitDepths, pcThreadPool, threadIdx);
           break;
         }
       case HASHTYPE_CHECKSUM:
         {
           hashType = "Checksum";
-          numChar = calcChecksum(pic, recon_digest, bitDepths);
+          numChar = calcChecksum(pic, recon_digest, bitDepths, pcThreadPool, threadIdx);
           break;
         }
       default:
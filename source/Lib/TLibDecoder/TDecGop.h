@@ -49,6 +49,7 @@
 #include "TLibCommon/TComPic.h"
 #include "TLibCommon/TComLoopFilter.h"
 #include "TLibCommon/TComSampleAdaptiveOffset.h"
+#include "TLibCommon/TComThreadPool.h"
 
 #include "TDecEntropy.h"
 #include "TDecSlice.h"
@@ -77,6 +78,7 @@ private:
   TComLoopFilter*       m_pcLoopFilter;
 
   TComSampleAdaptiveOffset*     m_pcSAO;
+  TComThreadPool*       m_pcThreadPool;
   Double                m_dDecTime;
   Int                   m_decodedPictureHashSEIEnabled;  ///< Checksum(3)/CRC(2)/MD5(1)/disable(0) acting on decoded picture hash SEI message
   UInt                  m_numberOfChecksumErrorsDetected;
@@ -91,12 +93,15 @@ public:
                  TDecCavlc*              pcCavlcDecoder,
                  TDecSlice*              pcSliceDecoder,
                  TComLoopFilter*         pcLoopFilter,
-                 TComSampleAdaptiveOffset* pcSAO
+                 TComSampleAdaptiveOffset* pcSAO,
+                 TComThreadPool*         pcThreadPool
                  );
   Void  create  ();
   Void  destroy ();
   Void  decompressSlice(TComInputBitstream* pcBitstream, TComPic* pcPic );
-  Void  filterPicture  (TComPic* pcPic );
+  Void  filterPicture  (TComPic* pcPic, UInt uiSliceIdx, Int threadIdx, Bool bIsReferenced, Double dDecTime );
+  /// return the time spent decoding the slices of the current picture and restart the measurement
+  Double popDecTime    ()                  { const Double dDecTime = m_dDecTime; m_dDecTime = 0; return dDecTime; }
 
   Void setDecodedPictureHashSEIEnabled(Int enabled) { m_decodedPictureHashSEIEnabled = enabled; }
   UInt getNumberOfChecksumErrorsDetected() const { return m_numberOfChecksumErrorsDetected; }
@@ -54,6 +54,23 @@
 #include "../TLibCommon/Debug.h"
 #endif
 
+#if !RExt__DECODER_DEBUG_BIT_STATISTICS
+//! significance map context increments of a 4x4 TU, indexed by diagonal scan position
+static const UChar sigCtxInc4x4Diag[1 << MLS_CG_SIZE] =
+{
+  0, 2, 1, 6, 3, 4, 7, 6, 4, 5, 7, 8, 5, 8, 8, 8
+};
+
+//! significance map context increments inside a 4x4 group of a larger TU, indexed by [patternSigCtx][diagonal scan position]
+static const UChar sigCtxIncDiag[4][1 << MLS_CG_SIZE] =
+{
+  { 2, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+  { 2, 1, 2, 0, 1, 2, 0, 0, 1, 2, 0, 0, 1, 0, 0, 0 },
+  { 2, 2, 1, 2, 1, 0, 2, 1, 0, 0, 1, 0, 0, 0, 0, 0 },
+  { 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2 }
+};
+#endif
+
 
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
@@ -310,25 +327,13 @@ Void TDecSbac::xReadCoefRemainExGolomb ( UInt &rSymbol, UInt &rParam, const Bool
   {
     const UInt longestPossiblePrefix = (32 - (COEF_REMAIN_BIN_REDUCTION + maxLog2TrDynamicRange)) + COEF_REMAIN_BIN_REDUCTION;
 
-    do
-    {
-      prefix++;
-      m_pcTDecBinIf->decodeBinEP( codeWord RExt__DECODER_DEBUG_BIT_STATISTICS_PASS_OPT_ARG(whichStat) );
-    } while((codeWord != 0) && (prefix < longestPossiblePrefix));
+    m_pcTDecBinIf->decodeUnaryBinsEP( prefix, longestPossiblePrefix RExt__DECODER_DEBUG_BIT_STATISTICS_PASS_OPT_ARG(whichStat) );
   }
   else
   {
-    do
-    {
-      prefix++;
-      m_pcTDecBinIf->decodeBinEP( codeWord RExt__DECODER_DEBUG_BIT_STATISTICS_PASS_OPT_ARG(whichStat) );
-    } while( codeWord);
+    m_pcTDecBinIf->decodeUnaryBinsEP( prefix, MAX_UINT RExt__DECODER_DEBUG_BIT_STATISTICS_PASS_OPT_ARG(whichStat) );
   }
 
-  codeWord  = 1 - codeWord;
-  prefix -= codeWord;
-  codeWord=0;
-
   if (prefix < COEF_REMAIN_BIN_REDUCTION )
   {
     m_pcTDecBinIf->decodeBinsEP(codeWord,rParam RExt__DECODER_DEBUG_BIT_STATISTICS_PASS_OPT_ARG(whichStat));
@@ -1222,6 +1227,233 @@ Void TDecSbac::parseLastSignificantXY( UInt& uiPosLastX, UInt& uiPosLastY, Int w
   }
 }
 
+#if !RExt__DECODER_DEBUG_BIT_STATISTICS
+/** Parse the coefficient groups of a square, diagonally scanned TU that uses none of the range extension
+ *  coding tools (extended precision, bypass alignment, persistent Rice adaptation, single significance context).
+ *  The scan tables and group layout are resolved at compile time for each TU size.
+ * \param pcCoef                 coefficient buffer of the TU
+ * \param compID                 component being parsed
+ * \param uiScanPosLast          scan position of the last significant coefficient
+ * \param uiBlkPosLast           raster position of the last significant coefficient
+ * \param beValid                true if sign data hiding may be applied to this TU
+ * \param maxLog2TrDynamicRange  dynamic range of the coefficients
+ */
+template <UInt log2TrSize>
+Void TDecSbac::xParseCoeffGroupsDiag( TCoeff* pcCoef, const ComponentID compID, const UInt uiScanPosLast, const UInt uiBlkPosLast, const Bool beValid, const Int maxLog2TrDynamicRange )
+{
+  const UInt         log2WidthInGroups = log2TrSize - MLS_CG_LOG2_WIDTH;
+  const UInt         widthInGroups     = 1 << log2WidthInGroups;
+  const UInt * const scan              = g_scanOrder[ SCAN_GROUPED_4x4 ][ SCAN_DIAG ][ log2TrSize        ][ log2TrSize        ];
+  const UInt * const scanCG            = g_scanOrder[ SCAN_UNGROUPED   ][ SCAN_DIAG ][ log2WidthInGroups ][ log2WidthInGroups ];
+
+  const ChannelType  chType            = toChannelType(compID);
+  const UInt         firstSigCtx       = significanceMapContextSetStart[chType][(log2TrSize == 2) ? CONTEXT_TYPE_4x4 : ((log2TrSize == 3) ? CONTEXT_TYPE_8x8 : CONTEXT_TYPE_NxN)];
+  const UInt         notFirstGroupCtx  = firstSigCtx + notFirstGroupNeighbourhoodContextOffset[chType];
+
+  ContextModel * const baseCoeffGroupCtx = m_cCUSigCoeffGroupSCModel.get( 0, isChroma(chType) );
+  ContextModel * const baseCtx           = m_cCUSigSCModel.get( 0, 0 ) + getSignificanceMapContextOffset(compID);
+
+  const Int  iLastScanSet  = uiScanPosLast >> MLS_CG_SIZE;
+  UInt c1                  = 1;
+
+  UInt uiSigCoeffGroupFlag[ MLS_GRP_NUM ];
+  memset( uiSigCoeffGroupFlag, 0, sizeof(UInt) * MLS_GRP_NUM );
+
+  Int  iScanPosSig         = (Int) uiScanPosLast;
+  for( Int iSubSet = iLastScanSet; iSubSet >= 0; iSubSet-- )
+  {
+    const Int iSubPos       = iSubSet << MLS_CG_SIZE;
+    UInt      uiGoRiceParam = 0;
+    Int       numNonZero    = 0;
+
+    Int lastNZPosInCG  = -1;
+    Int firstNZPosInCG = 1 << MLS_CG_SIZE;
+
+    Bool escapeDataPresentInGroup = false;
+
+    Int pos[1 << MLS_CG_SIZE];
+
+    if( iScanPosSig == (Int) uiScanPosLast )
+    {
+      lastNZPosInCG  = iScanPosSig;
+      firstNZPosInCG = iScanPosSig;
+      iScanPosSig--;
+      pos[ numNonZero ] = uiBlkPosLast;
+      numNonZero = 1;
+    }
+
+    // decode significant_coeffgroup_flag
+    const Int iCGBlkPos = scanCG[ iSubSet ];
+    const Int iCGPosY   = iCGBlkPos >> log2WidthInGroups;
+    const Int iCGPosX   = iCGBlkPos & (widthInGroups - 1);
+
+    if( iSubSet == iLastScanSet || iSubSet == 0)
+    {
+      uiSigCoeffGroupFlag[ iCGBlkPos ] = 1;
+    }
+    else
+    {
+      UInt uiSigCoeffGroup;
+      UInt uiCtxSig  = TComTrQuant::getSigCoeffGroupCtxInc( uiSigCoeffGroupFlag, iCGPosX, iCGPosY, widthInGroups, widthInGroups );
+      m_pcTDecBinIf->decodeBin( uiSigCoeffGroup, baseCoeffGroupCtx[ uiCtxSig ] );
+      uiSigCoeffGroupFlag[ iCGBlkPos ] = uiSigCoeffGroup;
+    }
+
+    // decode significant_coeff_flag
+    if( uiSigCoeffGroupFlag[ iCGBlkPos ] )
+    {
+      const UChar *ctxInc  = sigCtxInc4x4Diag;
+      UInt         ctxBase = firstSigCtx;
+      if (log2TrSize > 2)
+      {
+        ctxInc  = sigCtxIncDiag[ TComTrQuant::calcPatternSigCtx( uiSigCoeffGroupFlag, iCGPosX, iCGPosY, widthInGroups, widthInGroups ) ];
+        ctxBase = (iSubSet > 0) ? notFirstGroupCtx : firstSigCtx;
+      }
+
+      for( ; iScanPosSig >= iSubPos; iScanPosSig-- )
+      {
+        const UInt uiBlkPos = scan[ iScanPosSig ];
+        UInt       uiSig    = 1;
+
+        if( iScanPosSig > iSubPos || iSubSet == 0  || numNonZero )
+        {
+          const UInt uiCtxSig = (iScanPosSig == 0) ? 0 : (ctxBase + ctxInc[ iScanPosSig - iSubPos ]); //DC always uses context 0
+          m_pcTDecBinIf->decodeBin( uiSig, baseCtx[ uiCtxSig ] );
+        }
+
+        pcCoef[ uiBlkPos ] = uiSig;
+        if( uiSig )
+        {
+          pos[ numNonZero ] = uiBlkPos;
+          numNonZero ++;
+          if( lastNZPosInCG == -1 )
+          {
+            lastNZPosInCG = iScanPosSig;
+          }
+          firstNZPosInCG = iScanPosSig;
+        }
+      }
+    }
+    else
+    {
+      for( ; iScanPosSig >= iSubPos; iScanPosSig-- )
+      {
+        pcCoef[ scan[ iScanPosSig ] ] = 0;
+      }
+    }
+
+    if( numNonZero > 0 )
+    {
+      const Bool signHidden = beValid && ( lastNZPosInCG - firstNZPosInCG >= SBH_THRESHOLD );
+
+      const UInt uiCtxSet = getContextSetIndex(compID, iSubSet, (c1 == 0));
+      c1 = 1;
+      UInt uiBin;
+
+      ContextModel *baseCtxMod = m_cCUOneSCModel.get( 0, 0 ) + (NUM_ONE_FLAG_CTX_PER_SET * uiCtxSet);
+
+      Int absCoeff[1 << MLS_CG_SIZE];
+
+      for ( Int i = 0; i < numNonZero; i++)
+      {
+        absCoeff[i] = 1;
+      }
+      const Int numC1Flag = min(numNonZero, C1FLAG_NUMBER);
+      Int firstC2FlagIdx = -1;
+
+      for( Int idx = 0; idx < numC1Flag; idx++ )
+      {
+        m_pcTDecBinIf->decodeBin( uiBin, baseCtxMod[c1] );
+        if( uiBin == 1 )
+        {
+          c1 = 0;
+          if (firstC2FlagIdx == -1)
+          {
+            firstC2FlagIdx = idx;
+          }
+          else //if a greater-than-one has been encountered already this group
+          {
+            escapeDataPresentInGroup = true;
+          }
+        }
+        else if( (c1 < 3) && (c1 > 0) )
+        {
+          c1++;
+        }
+        absCoeff[ idx ] = uiBin + 1;
+      }
+
+      if (c1 == 0)
+      {
+        baseCtxMod = m_cCUAbsSCModel.get( 0, 0 ) + (NUM_ABS_FLAG_CTX_PER_SET * uiCtxSet);
+        if ( firstC2FlagIdx != -1)
+        {
+          m_pcTDecBinIf->decodeBin( uiBin, baseCtxMod[0] );
+          absCoeff[ firstC2FlagIdx ] = uiBin + 2;
+          if (uiBin != 0)
+          {
+            escapeDataPresentInGroup = true;
+          }
+        }
+      }
+
+      escapeDataPresentInGroup = escapeDataPresentInGroup || (numNonZero > C1FLAG_NUMBER);
+
+      const Int numSigns = signHidden ? (numNonZero - 1) : numNonZero;
+      UInt coeffSigns;
+      m_pcTDecBinIf->decodeBinsEP( coeffSigns, numSigns );
+      coeffSigns <<= 32 - numSigns;
+
+      if (escapeDataPresentInGroup)
+      {
+        Int iFirstCoeff2 = 1;
+        for( Int idx = 0; idx < numNonZero; idx++ )
+        {
+          UInt baseLevel  = (idx < C1FLAG_NUMBER)? (2 + iFirstCoeff2) : 1;
+
+          if( absCoeff[ idx ] == baseLevel)
+          {
+            UInt uiLevel;
+            xReadCoefRemainExGolomb( uiLevel, uiGoRiceParam, false, maxLog2TrDynamicRange );
+
+            absCoeff[ idx ] = uiLevel + baseLevel;
+
+            if (absCoeff[idx] > (3 << uiGoRiceParam))
+            {
+              uiGoRiceParam = std::min<UInt>((uiGoRiceParam + 1), 4);
+            }
+          }
+
+          if(absCoeff[ idx ] >= 2)
+          {
+            iFirstCoeff2 = 0;
+          }
+        }
+      }
+
+      UInt absSum = 0;
+      for( Int idx = 0; idx < numNonZero; idx++ )
+      {
+        const Int blkPos = pos[ idx ];
+        absSum += absCoeff[ idx ];
+
+        if ( idx == numNonZero-1 && signHidden )
+        {
+          // Infer sign of 1st element.
+          pcCoef[ blkPos ] = (absSum & 0x1) ? -absCoeff[ idx ] : absCoeff[ idx ];
+        }
+        else
+        {
+          const Int sign = static_cast<Int>( coeffSigns ) >> 31;
+          pcCoef[ blkPos ] = ( absCoeff[ idx ] ^ sign ) - sign;
+          coeffSigns <<= 1;
+        }
+      }
+    }
+  }
+}
+#endif
+
 Void TDecSbac::parseCoeffNxN(  TComTU &rTu, ComponentID compID )
 {
   TComDataCU* pcCU=rTu.getCU();
@@ -1370,6 +1602,28 @@ Void TDecSbac::parseCoeffNxN(  TComTU &rTu, ComponentID compID )
     }
   }
 
+#if !RExt__DECODER_DEBUG_BIT_STATISTICS
+  // square diagonal scans without range extension coding tools use a per-size specialised parser
+  if (   (codingParameters.scanType == SCAN_DIAG) && (uiWidth == uiHeight)
+      && !extendedPrecision && !alignCABACBeforeBypass && !bUseGolombRiceParameterAdaptation
+      && (codingParameters.firstSignificanceMapContext != significanceMapContextSetStart[chType][CONTEXT_TYPE_SINGLE]))
+  {
+    switch (uiLog2BlockWidth)
+    {
+      case 2:  xParseCoeffGroupsDiag<2>( pcCoef, compID, uiScanPosLast, uiBlkPosLast, beValid, maxLog2TrDynamicRange ); break;
+      case 3:  xParseCoeffGroupsDiag<3>( pcCoef, compID, uiScanPosLast, uiBlkPosLast, beValid, maxLog2TrDynamicRange ); break;
+      case 4:  xParseCoeffGroupsDiag<4>( pcCoef, compID, uiScanPosLast, uiBlkPosLast, beValid, maxLog2TrDynamicRange ); break;
+      case 5:  xParseCoeffGroupsDiag<5>( pcCoef, compID, uiScanPosLast, uiBlkPosLast, beValid, maxLog2TrDynamicRange ); break;
+      default: assert(0); break;
+    }
+
+#if ENVIRONMENT_VARIABLE_DEBUG_AND_TEST
+    printSBACCoeffData(uiPosLastX, uiPosLastY, uiWidth, uiHeight, compID, uiAbsPartIdx, codingParameters.scanType, pcCoef);
+#endif
+    return;
+  }
+#endif
+
   ContextModel * const baseCoeffGroupCtx = m_cCUSigCoeffGroupSCModel.get( 0, isChroma(chType) );
   ContextModel * const baseCtx = m_cCUSigSCModel.get( 0, 0 ) + getSignificanceMapContextOffset(compID);
 
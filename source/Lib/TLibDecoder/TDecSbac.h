@@ -102,6 +102,9 @@ private:
   Void  xReadUnaryMaxSymbol ( UInt& ruiSymbol, ContextModel* pcSCModel, Int iOffset, UInt uiMaxSymbol );
   Void  xReadEpExGolomb     ( UInt& ruiSymbol, UInt uiCount );
   Void  xReadCoefRemainExGolomb ( UInt &rSymbol, UInt &rParam, const Bool useLimitedPrefixLength, const Int maxLog2TrDynamicRange );
+
+  template <UInt log2TrSize>
+  Void  xParseCoeffGroupsDiag ( TCoeff* pcCoef, const ComponentID compID, const UInt uiScanPosLast, const UInt uiBlkPosLast, const Bool beValid, const Int maxLog2TrDynamicRange );
 #endif
 private:
   TComInputBitstream* m_pcBitstream;
@@ -45,11 +45,17 @@
 //////////////////////////////////////////////////////////////////////
 
 TDecSlice::TDecSlice()
+: m_pcEntropyCodingSyncContextStates ( NULL )
+, m_numEntropyCodingSyncContextStates( 0 )
+, m_pcThreadPool                     ( NULL )
+, m_pcCtuWorkers                     ( NULL )
+, m_bDeferReconstruction             ( false )
 {
 }
 
 TDecSlice::~TDecSlice()
 {
+  delete [] m_pcEntropyCodingSyncContextStates;
 }
 
 Void TDecSlice::create()
@@ -60,10 +66,13 @@ Void TDecSlice::destroy()
 {
 }
 
-Void TDecSlice::init(TDecEntropy* pcEntropyDecoder, TDecCu* pcCuDecoder)
+Void TDecSlice::init(TDecEntropy* pcEntropyDecoder, TDecCu* pcCuDecoder, TComThreadPool* pcThreadPool, TDecCtuWorker* pcCtuWorkers, Bool bDeferReconstruction)
 {
-  m_pcEntropyDecoder  = pcEntropyDecoder;
-  m_pcCuDecoder       = pcCuDecoder;
+  m_pcEntropyDecoder     = pcEntropyDecoder;
+  m_pcCuDecoder          = pcCuDecoder;
+  m_pcThreadPool         = pcThreadPool;
+  m_pcCtuWorkers         = pcCtuWorkers;
+  m_bDeferReconstruction = bDeferReconstruction;
 }
 
 Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcPic, TDecSbac* pcSbacDecoder)
@@ -75,17 +84,61 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcP
   const UInt numCtusInFrame          = pcPic->getNumberOfCtusInFrame();
 
   const UInt frameWidthInCtus        = pcPic->getPicSym()->getFrameWidthInCtus();
+  const UInt numTileColumns          = pcPic->getPicSym()->getNumTileColumnsMinus1()+1;
   const Bool depSliceSegmentsEnabled = pcSlice->getPPS()->getDependentSliceSegmentsEnabledFlag();
   const Bool wavefrontsEnabled       = pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag();
 
-  m_pcEntropyDecoder->setEntropyDecoder ( pcSbacDecoder  );
-  m_pcEntropyDecoder->setBitstream      ( ppcSubstreams[0] );
-  m_pcEntropyDecoder->resetEntropy      (pcSlice);
-
   // decoder doesn't need prediction & residual frame buffer
   pcPic->setPicYuvPred( 0 );
   pcPic->setPicYuvResi( 0 );
 
+  // one WPP context storage per CTU row and tile column. They are kept across calls, as a dependent slice segment may continue a row.
+  const UInt numSyncStates = pcPic->getFrameHeightInCtus() * numTileColumns;
+  if ( m_numEntropyCodingSyncContextStates != numSyncStates )
+  {
+    delete [] m_pcEntropyCodingSyncContextStates;
+    m_pcEntropyCodingSyncContextStates  = new TDecSbac[numSyncStates];
+    m_numEntropyCodingSyncContextStates = numSyncStates;
+  }
+
+  std::vector<UInt> runStartCtuTsAddr;
+  if ( xCanDecompressSliceInParallel( pcPic, pcSlice->getNumberOfSubstreamSizes()+1, runStartCtuTsAddr ) )
+  {
+    const UInt numRuns = UInt(runStartCtuTsAddr.size()) - 1;
+
+    // The CTUs are initialised beforehand, as the availability checks of a run read the slice of the CTUs in neighbouring runs.
+    // The last run may end before its bound, in which case the next slice segment initialises the remaining CTUs again.
+    for( UInt ctuTsAddr = runStartCtuTsAddr.front(); ctuTsAddr < runStartCtuTsAddr.back(); ctuTsAddr++ )
+    {
+      const UInt ctuRsAddr = pcPic->getPicSym()->getCtuTsToRsAddrMap(ctuTsAddr);
+      pcPic->getCtu( ctuRsAddr )->initCtu( pcPic, ctuRsAddr );
+    }
+
+    // the progress of a run is the frame column following its last decoded CTU
+    TComRowProgress runProgress;
+    runProgress.init( numRuns );
+    for ( UInt runIdx = 0; runIdx < numRuns; runIdx++ )
+    {
+      runProgress.set( runIdx, pcPic->getPicSym()->getCtuTsToRsAddrMap(runStartCtuTsAddr[runIdx]) % frameWidthInCtus );
+    }
+
+    TComTaskGroup runs( m_pcThreadPool );
+    for ( UInt runIdx = 0; runIdx < numRuns; runIdx++ )
+    {
+      runs.addTask( [this, ppcSubstreams, pcPic, &runStartCtuTsAddr, runIdx, &runProgress]( Int threadIdx )
+      {
+        TDecCtuWorker* pcWorker = &m_pcCtuWorkers[threadIdx];
+        xDecompressCtuRun( ppcSubstreams, pcPic, pcWorker->getEntropyDecoder(), pcWorker->getSbacDecoder(), pcWorker->getCuDecoder(), runStartCtuTsAddr, runIdx, &runProgress );
+      } );
+    }
+    runs.wait();
+    return;
+  }
+
+  m_pcEntropyDecoder->setEntropyDecoder ( pcSbacDecoder  );
+  m_pcEntropyDecoder->setBitstream      ( ppcSubstreams[0] );
+  m_pcEntropyDecoder->resetEntropy      (pcSlice);
+
 #if ENC_DEC_TRACE
   g_bJustDoIt = g_bEncDecTraceEnable;
 #endif
@@ -125,12 +178,14 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcP
   for( UInt ctuTsAddr = startCtuTsAddr; !isLastCtuOfSliceSegment && ctuTsAddr < numCtusInFrame; ctuTsAddr++)
   {
     const UInt ctuRsAddr = pcPic->getPicSym()->getCtuTsToRsAddrMap(ctuTsAddr);
-    const TComTile &currentTile = *(pcPic->getPicSym()->getTComTile(pcPic->getPicSym()->getTileIdxMap(ctuRsAddr)));
+    const UInt tileIdx = pcPic->getPicSym()->getTileIdxMap(ctuRsAddr);
+    const TComTile &currentTile = *(pcPic->getPicSym()->getTComTile(tileIdx));
     const UInt firstCtuRsAddrOfTile = currentTile.getFirstCtuRsAddr();
     const UInt tileXPosInCtus = firstCtuRsAddrOfTile % frameWidthInCtus;
     const UInt tileYPosInCtus = firstCtuRsAddrOfTile / frameWidthInCtus;
     const UInt ctuXPosInCtus  = ctuRsAddr % frameWidthInCtus;
     const UInt ctuYPosInCtus  = ctuRsAddr / frameWidthInCtus;
+    const UInt syncStateIdx   = ctuYPosInCtus * numTileColumns + tileIdx % numTileColumns;
     const UInt uiSubStrm=pcPic->getSubstreamForCtuAddr(ctuRsAddr, true, pcSlice)-subStreamOffset;
     TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
     pCtu->initCtu( pcPic, ctuRsAddr );
@@ -159,67 +214,261 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcP
         if ( pCtu->CUIsFromSameSliceAndTile(pCtuTR) )
         {
           // Top-right is available, so use it.
-          pcSbacDecoder->loadContexts( &m_entropyCodingSyncContextState );
+          pcSbacDecoder->loadContexts( &m_pcEntropyCodingSyncContextStates[syncStateIdx - numTileColumns] );
         }
       }
     }
 
+    xDecompressCtu( pcPic, pCtu, pcSbacDecoder, m_pcCuDecoder, isLastCtuOfSliceSegment );
+
+    //Store probabilities of second CTU in line into buffer
+    if ( ctuXPosInCtus == tileXPosInCtus+1 && wavefrontsEnabled)
+    {
+      m_pcEntropyCodingSyncContextStates[syncStateIdx].loadContexts( pcSbacDecoder );
+    }
+
+    if (isLastCtuOfSliceSegment)
+    {
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+      pcSbacDecoder->parseRemainingBytes(false);
+#endif
+      if(!pcSlice->getDependentSliceSegmentFlag())
+      {
+        pcSlice->setSliceCurEndCtuTsAddr( ctuTsAddr+1 );
+      }
+      pcSlice->setSliceSegmentCurEndCtuTsAddr( ctuTsAddr+1 );
+    }
+    else if (  ctuXPosInCtus + 1 == tileXPosInCtus + currentTile.getTileWidthInCtus() &&
+             ( ctuYPosInCtus + 1 == tileYPosInCtus + currentTile.getTileHeightInCtus() || wavefrontsEnabled)
+            )
+    {
+      // The sub-stream/stream should be terminated after this CTU.
+      // (end of slice-segment, end of tile, end of wavefront-CTU-row)
+      UInt binVal;
+      pcSbacDecoder->parseTerminatingBit( binVal );
+      assert( binVal );
+#if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
+      pcSbacDecoder->parseRemainingBytes(true);
+#endif
+    }
+
+  }
+
+  assert(isLastCtuOfSliceSegment == true);
+
+
+  if( depSliceSegmentsEnabled )
+  {
+    m_lastSliceSegmentEndContextState.loadContexts( pcSbacDecoder );//ctx end of dep.slice
+  }
+
+}
+
+/** Parse the SAO parameters and the coding tree of a CTU, and reconstruct it unless the reconstruction is deferred.
+ * \param pcPic                    picture class
+ * \param pCtu                     CTU to decode, already initialised
+ * \param pcSbacDecoder            CABAC decoder positioned at the start of the CTU
+ * \param pcCuDecoder              CU decoder using pcSbacDecoder
+ * \param isLastCtuOfSliceSegment  set to the value of end_of_slice_segment_flag
+ */
+Void TDecSlice::xDecompressCtu( TComPic* pcPic, TComDataCU* pCtu, TDecSbac* pcSbacDecoder, TDecCu* pcCuDecoder, Bool& isLastCtuOfSliceSegment )
+{
+  TComSlice* pcSlice          = pCtu->getSlice();
+  const UInt ctuRsAddr        = pCtu->getCtuRsAddr();
+  const UInt frameWidthInCtus = pcPic->getPicSym()->getFrameWidthInCtus();
+
 #if ENC_DEC_TRACE
-    g_bJustDoIt = g_bEncDecTraceEnable;
+  g_bJustDoIt = g_bEncDecTraceEnable;
 #endif
 
-    if ( pcSlice->getSPS()->getUseSAO() )
+  if ( pcSlice->getSPS()->getUseSAO() )
+  {
+    SAOBlkParam& saoblkParam = (pcPic->getPicSym()->getSAOBlkParam())[ctuRsAddr];
+    Bool bIsSAOSliceEnabled = false;
+    Bool sliceEnabled[MAX_NUM_COMPONENT];
+    for(Int comp=0; comp < MAX_NUM_COMPONENT; comp++)
     {
-      SAOBlkParam& saoblkParam = (pcPic->getPicSym()->getSAOBlkParam())[ctuRsAddr];
-      Bool bIsSAOSliceEnabled = false;
-      Bool sliceEnabled[MAX_NUM_COMPONENT];
-      for(Int comp=0; comp < MAX_NUM_COMPONENT; comp++)
+      ComponentID compId=ComponentID(comp);
+      sliceEnabled[compId] = pcSlice->getSaoEnabledFlag(toChannelType(compId)) && (comp < pcPic->getNumberValidComponents());
+      if (sliceEnabled[compId])
       {
-        ComponentID compId=ComponentID(comp);
-        sliceEnabled[compId] = pcSlice->getSaoEnabledFlag(toChannelType(compId)) && (comp < pcPic->getNumberValidComponents());
-        if (sliceEnabled[compId])
-        {
-          bIsSAOSliceEnabled=true;
-        }
-        saoblkParam[compId].modeIdc = SAO_MODE_OFF;
+        bIsSAOSliceEnabled=true;
       }
-      if (bIsSAOSliceEnabled)
-      {
-        Bool leftMergeAvail = false;
-        Bool aboveMergeAvail= false;
-
-        //merge left condition
-        Int rx = (ctuRsAddr % frameWidthInCtus);
-        if(rx > 0)
-        {
-          leftMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-1);
-        }
-        //merge up condition
-        Int ry = (ctuRsAddr / frameWidthInCtus);
-        if(ry > 0)
-        {
-          aboveMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-frameWidthInCtus);
-        }
+      saoblkParam[compId].modeIdc = SAO_MODE_OFF;
+    }
+    if (bIsSAOSliceEnabled)
+    {
+      Bool leftMergeAvail = false;
+      Bool aboveMergeAvail= false;
 
-        pcSbacDecoder->parseSAOBlkParam( saoblkParam, sliceEnabled, leftMergeAvail, aboveMergeAvail, pcSlice->getSPS()->getBitDepths());
+      //merge left condition
+      Int rx = (ctuRsAddr % frameWidthInCtus);
+      if(rx > 0)
+      {
+        leftMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-1);
       }
+      //merge up condition
+      Int ry = (ctuRsAddr / frameWidthInCtus);
+      if(ry > 0)
+      {
+        aboveMergeAvail = pcPic->getSAOMergeAvailability(ctuRsAddr, ctuRsAddr-frameWidthInCtus);
+      }
+
+      pcSbacDecoder->parseSAOBlkParam( saoblkParam, sliceEnabled, leftMergeAvail, aboveMergeAvail, pcSlice->getSPS()->getBitDepths());
     }
+  }
 
-    m_pcCuDecoder->decodeCtu     ( pCtu, isLastCtuOfSliceSegment );
-    m_pcCuDecoder->decompressCtu ( pCtu );
+  pcCuDecoder->decodeCtu     ( pCtu, isLastCtuOfSliceSegment );
+  if ( !m_bDeferReconstruction )
+  {
+    pcCuDecoder->decompressCtu ( pCtu );
+  }
 
 #if ENC_DEC_TRACE
-    g_bJustDoIt = g_bEncDecTraceDisable;
+  g_bJustDoIt = g_bEncDecTraceDisable;
 #endif
+}
+
+/** Whether the substreams of the current slice segment can be decoded by the worker threads, and the first CTU of each of them.
+ * Each substream is a run of CTUs that starts at the beginning of a tile, or of a CTU row of a tile when wavefronts are enabled,
+ * except for the first one, which starts with the slice segment. The bound of the last run is the end of its tile or row: the
+ * slice segment may end before.
+ * \param pcPic              picture class
+ * \param numSubstreams      number of substreams signalled by the entry points of the slice segment header
+ * \param runStartCtuTsAddr  returns the first CTU of each run, followed by the bound of the last run
+ */
+Bool TDecSlice::xCanDecompressSliceInParallel( TComPic* pcPic, const UInt numSubstreams, std::vector<UInt>& runStartCtuTsAddr )
+{
+#if ENC_DEC_TRACE || RExt__DECODER_DEBUG_BIT_STATISTICS
+  // the trace and the bit statistics are shared by all the CTUs
+  return false;
+#else
+  if ( m_pcThreadPool == NULL || m_pcThreadPool->getNumThreads() == 0 || numSubstreams < 2 )
+  {
+    return false;
+  }
+
+  TComPicSym* const pcPicSym          = pcPic->getPicSym();
+  const TComSlice*  pcSlice           = pcPic->getSlice(pcPic->getCurrSliceIdx());
+  const UInt        startCtuTsAddr    = pcSlice->getSliceSegmentCurStartCtuTsAddr();
+  const UInt        numCtusInFrame    = pcPic->getNumberOfCtusInFrame();
+  const UInt        frameWidthInCtus  = pcPicSym->getFrameWidthInCtus();
+  const Bool        wavefrontsEnabled = pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag();
+
+  UInt boundingCtuTsAddr = numCtusInFrame;
+  for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < numCtusInFrame; ctuTsAddr++ )
+  {
+    const UInt ctuRsAddr            = pcPicSym->getCtuTsToRsAddrMap(ctuTsAddr);
+    const UInt firstCtuRsAddrOfTile = pcPicSym->getTComTile(pcPicSym->getTileIdxMap(ctuRsAddr))->getFirstCtuRsAddr();
+    if ( ctuTsAddr == startCtuTsAddr || ctuRsAddr == firstCtuRsAddrOfTile || ( wavefrontsEnabled && ctuRsAddr % frameWidthInCtus == firstCtuRsAddrOfTile % frameWidthInCtus ) )
+    {
+      if ( runStartCtuTsAddr.size() == numSubstreams )
+      {
+        boundingCtuTsAddr = ctuTsAddr;
+        break;
+      }
+      runStartCtuTsAddr.push_back(ctuTsAddr);
+    }
+  }
+  if ( runStartCtuTsAddr.size() != numSubstreams )
+  {
+    // the entry points do not match the tiles and rows of the picture: let the sequential loop deal with the stream
+    runStartCtuTsAddr.clear();
+    return false;
+  }
+  runStartCtuTsAddr.push_back(boundingCtuTsAddr);
+  return true;
+#endif
+}
+
+/** Decode one run of CTUs, using its own substream and CABAC decoder, on a worker thread.
+ * Within a tile, a CTU is only started once the run above has decoded the CTU above-right of it. Each run starts from the same
+ * contexts as in the sequential loop, so the result is identical.
+ * \param ppcSubstreams      substreams of the slice segment
+ * \param pcPic              picture class
+ * \param pcEntropyDecoder   entropy decoder of the worker
+ * \param pcSbacDecoder      CABAC decoder of the worker
+ * \param pcCuDecoder        CU decoder of the worker
+ * \param runStartCtuTsAddr  first CTU of each run, followed by the bound of the last run
+ * \param runIdx             run to decode, which is also the index of its substream
+ * \param pcRunProgress      frame column following the last decoded CTU of each run
+ */
+Void TDecSlice::xDecompressCtuRun( TComInputBitstream** ppcSubstreams, TComPic* pcPic, TDecEntropy* pcEntropyDecoder, TDecSbac* pcSbacDecoder, TDecCu* pcCuDecoder,
+                                   const std::vector<UInt>& runStartCtuTsAddr, const UInt runIdx, TComRowProgress* pcRunProgress )
+{
+  TComSlice*  const pcSlice                 = pcPic->getSlice(pcPic->getCurrSliceIdx());
+  TComPicSym* const pcPicSym                = pcPic->getPicSym();
+  const UInt        frameWidthInCtus        = pcPicSym->getFrameWidthInCtus();
+  const UInt        numTileColumns          = pcPicSym->getNumTileColumnsMinus1()+1;
+  const Bool        depSliceSegmentsEnabled = pcSlice->getPPS()->getDependentSliceSegmentsEnabledFlag();
+  const Bool        wavefrontsEnabled       = pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag();
+  const UInt        startCtuTsAddr          = runStartCtuTsAddr[runIdx];
+  const UInt        boundingCtuTsAddr       = runStartCtuTsAddr[runIdx+1];
+  const Bool        bLastRun                = runIdx+2 == runStartCtuTsAddr.size();
+
+  pcEntropyDecoder->setEntropyDecoder ( pcSbacDecoder );
+  pcEntropyDecoder->setBitstream      ( ppcSubstreams[runIdx] );
+  pcEntropyDecoder->resetEntropy      ( pcSlice );
+
+  const UInt  startCtuRsAddr = pcPicSym->getCtuTsToRsAddrMap(startCtuTsAddr);
+  if ( runIdx == 0 && depSliceSegmentsEnabled && pcSlice->getDependentSliceSegmentFlag() )
+  {
+    // modify initial contexts with previous slice segment if this is a dependent slice.
+    const TComTile *pCurrentTile = pcPicSym->getTComTile(pcPicSym->getTileIdxMap(startCtuRsAddr));
+    if ( startCtuRsAddr != pCurrentTile->getFirstCtuRsAddr() && ( pCurrentTile->getTileWidthInCtus() >= 2 || !wavefrontsEnabled ) )
+    {
+      pcSbacDecoder->loadContexts(&m_lastSliceSegmentEndContextState);
+    }
+  }
+
+  Bool isLastCtuOfSliceSegment = false;
+  for( UInt ctuTsAddr = startCtuTsAddr; !isLastCtuOfSliceSegment && ctuTsAddr < boundingCtuTsAddr; ctuTsAddr++)
+  {
+    const UInt ctuRsAddr = pcPicSym->getCtuTsToRsAddrMap(ctuTsAddr);
+    const UInt tileIdx = pcPicSym->getTileIdxMap(ctuRsAddr);
+    const TComTile &currentTile = *(pcPicSym->getTComTile(tileIdx));
+    const UInt firstCtuRsAddrOfTile = currentTile.getFirstCtuRsAddr();
+    const UInt tileXPosInCtus = firstCtuRsAddrOfTile % frameWidthInCtus;
+    const UInt tileYPosInCtus = firstCtuRsAddrOfTile / frameWidthInCtus;
+    const UInt tileEndXPosInCtus = tileXPosInCtus + currentTile.getTileWidthInCtus();
+    const UInt ctuXPosInCtus  = ctuRsAddr % frameWidthInCtus;
+    const UInt ctuYPosInCtus  = ctuRsAddr / frameWidthInCtus;
+    const UInt syncStateIdx   = ctuYPosInCtus * numTileColumns + tileIdx % numTileColumns;
+    TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
+
+    // wait for the CTU above-right, if the run above is in the same tile
+    if ( runIdx > 0 && pcPicSym->getTileIdxMap( pcPicSym->getCtuTsToRsAddrMap(startCtuTsAddr - 1) ) == tileIdx )
+    {
+      pcRunProgress->waitFor( runIdx-1, min(ctuXPosInCtus+2, tileEndXPosInCtus) );
+    }
+
+    // a run begins with a reset of the contexts; at the start of a CTU row, they are then synchronized with the upper-right CTU
+    if ( ctuRsAddr != firstCtuRsAddrOfTile && ctuXPosInCtus == tileXPosInCtus && wavefrontsEnabled )
+    {
+      TComDataCU *pCtuUp = pCtu->getCtuAbove();
+      if ( pCtuUp && ((ctuRsAddr%frameWidthInCtus+1) < frameWidthInCtus)  )
+      {
+        TComDataCU *pCtuTR = pcPic->getCtu( ctuRsAddr - frameWidthInCtus + 1 );
+        if ( pCtu->CUIsFromSameSliceAndTile(pCtuTR) )
+        {
+          pcSbacDecoder->loadContexts( &m_pcEntropyCodingSyncContextStates[syncStateIdx - numTileColumns] );
+        }
+      }
+    }
+
+    xDecompressCtu( pcPic, pCtu, pcSbacDecoder, pcCuDecoder, isLastCtuOfSliceSegment );
 
     //Store probabilities of second CTU in line into buffer
     if ( ctuXPosInCtus == tileXPosInCtus+1 && wavefrontsEnabled)
     {
-      m_entropyCodingSyncContextState.loadContexts( pcSbacDecoder );
+      m_pcEntropyCodingSyncContextStates[syncStateIdx].loadContexts( pcSbacDecoder );
     }
 
+    pcRunProgress->set( runIdx, ctuXPosInCtus+1 );
+
     if (isLastCtuOfSliceSegment)
     {
+      assert( bLastRun );
 #if DECODER_CHECK_SUBSTREAM_AND_SLICE_TRAILING_BYTES
       pcSbacDecoder->parseRemainingBytes(false);
 #endif
@@ -229,12 +478,12 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcP
       }
       pcSlice->setSliceSegmentCurEndCtuTsAddr( ctuTsAddr+1 );
     }
-    else if (  ctuXPosInCtus + 1 == tileXPosInCtus + currentTile.getTileWidthInCtus() &&
+    else if (  ctuXPosInCtus + 1 == tileEndXPosInCtus &&
              ( ctuYPosInCtus + 1 == tileYPosInCtus + currentTile.getTileHeightInCtus() || wavefrontsEnabled)
             )
     {
-      // The sub-stream/stream should be terminated after this CTU.
-      // (end of slice-segment, end of tile, end of wavefront-CTU-row)
+      // The sub-stream should be terminated after this CTU.
+      // (end of tile, end of wavefront-CTU-row)
       UInt binVal;
       pcSbacDecoder->parseTerminatingBit( binVal );
       assert( binVal );
@@ -242,17 +491,17 @@ Void TDecSlice::decompressSlice(TComInputBitstream** ppcSubstreams, TComPic* pcP
       pcSbacDecoder->parseRemainingBytes(true);
 #endif
     }
-
   }
 
-  assert(isLastCtuOfSliceSegment == true);
+  // a run that ends early (in a corrupt stream) must not block the runs below it
+  pcRunProgress->set( runIdx, frameWidthInCtus );
 
+  assert( isLastCtuOfSliceSegment == bLastRun );
 
-  if( depSliceSegmentsEnabled )
+  if( bLastRun && depSliceSegmentsEnabled )
   {
     m_lastSliceSegmentEndContextState.loadContexts( pcSbacDecoder );//ctx end of dep.slice
   }
-
 }
 
 //! \}
@@ -45,10 +45,14 @@
 #include "TLibCommon/CommonDef.h"
 #include "TLibCommon/TComBitStream.h"
 #include "TLibCommon/TComPic.h"
+#include "TLibCommon/TComThreadPool.h"
 #include "TDecEntropy.h"
 #include "TDecCu.h"
 #include "TDecSbac.h"
 #include "TDecBinCoderCABAC.h"
+#include "TDecCtuWorker.h"
+
+#include <vector>
 
 //! \ingroup TLibDecoder
 //! \{
@@ -66,13 +70,23 @@ private:
   TDecCu*         m_pcCuDecoder;
 
   TDecSbac        m_lastSliceSegmentEndContextState;    ///< context storage for state at the end of the previous slice-segment (used for dependent slices only).
-  TDecSbac        m_entropyCodingSyncContextState;      ///< context storate for state of contexts at the wavefront/WPP/entropy-coding-sync second CTU of tile-row
+  TDecSbac*       m_pcEntropyCodingSyncContextStates;   ///< context storage for state of contexts at the wavefront/WPP/entropy-coding-sync second CTU, one per CTU row and tile column
+  UInt            m_numEntropyCodingSyncContextStates;
+
+  TComThreadPool* m_pcThreadPool;                       ///< worker threads for wavefront- and tile-parallel decoding
+  TDecCtuWorker*  m_pcCtuWorkers;                       ///< tools of each worker thread
+  Bool            m_bDeferReconstruction;               ///< only parse the CTUs, their reconstruction is done by a later pipeline stage
+
+  Void  xDecompressCtu    ( TComPic* pcPic, TComDataCU* pCtu, TDecSbac* pcSbacDecoder, TDecCu* pcCuDecoder, Bool& isLastCtuOfSliceSegment );
+  Bool  xCanDecompressSliceInParallel ( TComPic* pcPic, const UInt numSubstreams, std::vector<UInt>& runStartCtuTsAddr );
+  Void  xDecompressCtuRun ( TComInputBitstream** ppcSubstreams, TComPic* pcPic, TDecEntropy* pcEntropyDecoder, TDecSbac* pcSbacDecoder, TDecCu* pcCuDecoder,
+                            const std::vector<UInt>& runStartCtuTsAddr, const UInt runIdx, TComRowProgress* pcRunProgress );
 
 public:
   TDecSlice();
   virtual ~TDecSlice();
 
-  Void  init              ( TDecEntropy* pcEntropyDecoder, TDecCu* pcMbDecoder );
+  Void  init              ( TDecEntropy* pcEntropyDecoder, TDecCu* pcMbDecoder, TComThreadPool* pcThreadPool = NULL, TDecCtuWorker* pcCtuWorkers = NULL, Bool bDeferReconstruction = false );
   Void  create            ();
   Void  destroy           ();
 
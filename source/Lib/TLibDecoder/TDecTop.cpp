@@ -41,6 +41,14 @@
 //! \ingroup TLibDecoder
 //! \{
 
+/// stages of the frame pipeline, each one is completed for the pictures in decoding order
+enum PipelineStage
+{
+  RECONSTRUCTION_STAGE = 0,
+  FILTERING_STAGE      = 1,
+  NUM_PIPELINE_STAGES  = 2
+};
+
 TDecTop::TDecTop()
   : m_iMaxRefPicNum(0)
   , m_associatedIRAPType(NAL_UNIT_INVALID)
@@ -62,6 +70,16 @@ TDecTop::TDecTop()
   , m_seiReader()
   , m_cLoopFilter()
   , m_cSAO()
+  , m_cThreadPool()
+  , m_numThreads(1)
+  , m_pcCtuWorkers(NULL)
+  , m_framePipeline(false)
+  , m_cReconstructionWorker()
+  , m_pipelineProgress()
+  , m_numPicturesInPipeline(0)
+  , m_partitionTablesMaxCUWidth(0)
+  , m_partitionTablesMaxCUHeight(0)
+  , m_partitionTablesMaxTotalCUDepth(0)
   , m_pcPic(NULL)
   , m_prevPOC(MAX_INT)
   , m_prevTid0POC(0)
@@ -79,6 +97,7 @@ TDecTop::TDecTop()
   , m_pDecodedSEIOutputStream(NULL)
   , m_warningMessageSkipPicture(false)
   , m_prefixSEINALUs()
+  , m_pendingNalUnits()
 {
 #if ENC_DEC_TRACE
   if (g_hTrace == NULL)
@@ -103,6 +122,11 @@ TDecTop::~TDecTop()
     delete m_prefixSEINALUs.front();
     m_prefixSEINALUs.pop_front();
   }
+  while (!m_pendingNalUnits.empty())
+  {
+    delete m_pendingNalUnits.front();
+    m_pendingNalUnits.pop_front();
+  }
 }
 
 Void TDecTop::create()
@@ -110,10 +134,25 @@ Void TDecTop::create()
   m_cGopDecoder.create();
   m_apcSlicePilot = new TComSlice;
   m_uiSliceIdx = 0;
+
+  if ( m_numThreads > 1 )
+  {
+    m_pcCtuWorkers = new TDecCtuWorker[m_numThreads];
+    m_cThreadPool.create( m_numThreads );
+  }
+  else
+  {
+    m_framePipeline = false;
+  }
+  m_pipelineProgress.init( NUM_PIPELINE_STAGES );
+  m_numPicturesInPipeline = 0;
 }
 
 Void TDecTop::destroy()
 {
+  m_cThreadPool.destroy();
+  delete [] m_pcCtuWorkers;
+  m_pcCtuWorkers = NULL;
   m_cGopDecoder.destroy();
 
   delete m_apcSlicePilot;
@@ -126,13 +165,15 @@ Void TDecTop::init()
 {
   // initialize ROM
   initROM();
-  m_cGopDecoder.init( &m_cEntropyDecoder, &m_cSbacDecoder, &m_cBinCABAC, &m_cCavlcDecoder, &m_cSliceDecoder, &m_cLoopFilter, &m_cSAO);
-  m_cSliceDecoder.init( &m_cEntropyDecoder, &m_cCuDecoder );
+  m_cGopDecoder.init( &m_cEntropyDecoder, &m_cSbacDecoder, &m_cBinCABAC, &m_cCavlcDecoder, &m_cSliceDecoder, &m_cLoopFilter, &m_cSAO, &m_cThreadPool);
+  m_cSliceDecoder.init( &m_cEntropyDecoder, &m_cCuDecoder, &m_cThreadPool, m_pcCtuWorkers, m_framePipeline );
   m_cEntropyDecoder.init(&m_cPrediction);
 }
 
 Void TDecTop::deletePicBuffer ( )
 {
+  m_cThreadPool.waitForAllTasks();
+
   TComList<TComPic*>::iterator  iterPic   = m_cListPic.begin();
   Int iSize = Int( m_cListPic.size() );
 
@@ -174,6 +215,7 @@ Void TDecTop::xGetNewPicBuffer ( const TComSPS &sps, const TComPPS &pps, TComPic
     rpcPic = *(iterPic++);
     if ( rpcPic->getReconMark() == false && rpcPic->getOutputMark() == false)
     {
+      xWaitUntilPictureUnused( rpcPic );
       rpcPic->setOutputMark(false);
       bBufferIsAvailable = true;
       break;
@@ -181,6 +223,7 @@ Void TDecTop::xGetNewPicBuffer ( const TComSPS &sps, const TComPPS &pps, TComPic
 
     if ( rpcPic->getSlice( 0 )->isReferenced() == false  && rpcPic->getOutputMark() == false)
     {
+      xWaitUntilPictureUnused( rpcPic );
       rpcPic->setOutputMark(false);
       rpcPic->setReconMark( false );
       rpcPic->getPicYuvRec()->setBorderExtension( false );
@@ -210,19 +253,177 @@ Void TDecTop::executeLoopFilters(Int& poc, TComList<TComPic*>*& rpcListPic)
 
   TComPic*   pcPic         = m_pcPic;
 
-  // Execute Deblock + Cleanup
+  // the marking of the reference picture set of the next picture may change these
+  const Bool   bIsReferenced = pcPic->getSlice(pcPic->getCurrSliceIdx())->isReferenced();
+  const Double dDecTime      = m_cGopDecoder.popDecTime();
+
+  if (m_framePipeline)
+  {
+    // bound the number of pictures in flight to the number of worker threads
+    const Int  pictureIdx       = m_numPicturesInPipeline++;
+    const UInt numSliceSegments = m_uiSliceIdx;
+    m_pipelineProgress.waitFor( FILTERING_STAGE, pictureIdx + 1 - m_cThreadPool.getNumThreads() );
+    m_cThreadPool.addTask( [this, pcPic, numSliceSegments, bIsReferenced, dDecTime, pictureIdx]( Int threadIdx )
+    {
+      xFinishPicture( pcPic, numSliceSegments, threadIdx, bIsReferenced, dDecTime, pictureIdx );
+    } );
+  }
+  else
+  {
+    // Execute Deblock + Cleanup
+    xFilterPicture( pcPic, m_uiSliceIdx, -1, bIsReferenced, dDecTime );
+  }
 
-  m_cGopDecoder.filterPicture(pcPic);
+  pcPic->setOutputMark(pcPic->getSlice(0)->getPicOutputFlag() ? true : false);
+  pcPic->setReconMark(true);
 
   TComSlice::sortPicList( m_cListPic ); // sorting for application output
   poc                 = pcPic->getSlice(m_uiSliceIdx-1)->getPOC();
   rpcListPic          = &m_cListPic;
   m_cCuDecoder.destroy();
+  for ( Int threadIdx = 0; threadIdx < m_cThreadPool.getNumThreads(); threadIdx++ )
+  {
+    m_pcCtuWorkers[threadIdx].destroy();
+  }
   m_bFirstSliceInPicture  = true;
 
   return;
 }
 
+/** Reconstruct the CTUs of a picture that have been parsed with deferred reconstruction.
+ * \param pcPic             picture to reconstruct
+ * \param numSliceSegments  number of slice segments of the picture
+ */
+Void TDecTop::xReconstructPicture(TComPic* pcPic, UInt numSliceSegments)
+{
+  TComPicSym* pcPicSym = pcPic->getPicSym();
+
+  m_cReconstructionWorker.create( pcPicSym->getSPS() );
+  for ( UInt sliceSegmentIdx = 0; sliceSegmentIdx < numSliceSegments; sliceSegmentIdx++ )
+  {
+    const TComSlice* pcSlice = pcPic->getSlice( sliceSegmentIdx );
+    xUpdateScalingList( m_cReconstructionWorker.getTrQuant(), pcSlice );
+
+    for ( UInt ctuTsAddr = pcSlice->getSliceSegmentCurStartCtuTsAddr(); ctuTsAddr < pcSlice->getSliceSegmentCurEndCtuTsAddr(); ctuTsAddr++ )
+    {
+      m_cReconstructionWorker.getCuDecoder()->decompressCtu( pcPic->getCtu( pcPicSym->getCtuTsToRsAddrMap( ctuTsAddr ) ) );
+    }
+  }
+  m_cReconstructionWorker.destroy();
+}
+
+/** Apply the in-loop filters to a reconstructed picture and make its rows available to the pictures that reference it.
+ * \param pcPic             picture to filter
+ * \param numSliceSegments  number of slice segments of the picture
+ * \param threadIdx         index of the calling worker of the thread pool, -1 if it is not one of them
+ * \param bIsReferenced     whether the picture was marked as used for reference when it was decoded
+ * \param dDecTime          time already spent decoding the picture
+ */
+Void TDecTop::xFilterPicture(TComPic* pcPic, UInt numSliceSegments, Int threadIdx, Bool bIsReferenced, Double dDecTime)
+{
+  const TComSPS &sps = pcPic->getPicSym()->getSPS();
+  const TComPPS &pps = pcPic->getPicSym()->getPPS();
+
+  // Initialise the filters for the settings of the picture
+  m_cSAO.create( sps.getPicWidthInLumaSamples(), sps.getPicHeightInLumaSamples(), sps.getChromaFormatIdc(), sps.getMaxCUWidth(), sps.getMaxCUHeight(), sps.getMaxTotalCUDepth(), pps.getPpsRangeExtension().getLog2SaoOffsetScale(CHANNEL_TYPE_LUMA), pps.getPpsRangeExtension().getLog2SaoOffsetScale(CHANNEL_TYPE_CHROMA) );
+  m_cLoopFilter.create( sps.getMaxTotalCUDepth() );
+
+  // the current slice index of the picture is reset by the main thread while it is in the frame pipeline
+  m_cGopDecoder.filterPicture( pcPic, numSliceSegments - 1, threadIdx, bIsReferenced, dDecTime );
+
+  pcPic->setNumFinishedCtuRows( pcPic->getPicSym()->getFrameHeightInCtus() );
+}
+
+/** Frame pipeline task: reconstruct and filter a parsed picture.
+ * The stages are each completed for one picture after the other, so the reconstruction of a picture overlaps the filtering of
+ * the previous one, and both overlap the parsing of the next pictures on the main thread.
+ * \param pcPic             parsed picture
+ * \param numSliceSegments  number of slice segments of the picture
+ * \param threadIdx         index of the worker thread that runs the task
+ * \param bIsReferenced     whether the picture was marked as used for reference when it was decoded
+ * \param dDecTime          time spent parsing the picture
+ * \param pictureIdx        position of the picture in the pipeline
+ */
+Void TDecTop::xFinishPicture(TComPic* pcPic, UInt numSliceSegments, Int threadIdx, Bool bIsReferenced, Double dDecTime, Int pictureIdx)
+{
+  m_pipelineProgress.waitFor( RECONSTRUCTION_STAGE, pictureIdx );
+  clock_t iBeforeTime = clock();
+  xReconstructPicture( pcPic, numSliceSegments );
+  dDecTime += (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
+  m_pipelineProgress.set( RECONSTRUCTION_STAGE, pictureIdx + 1 );
+
+  m_pipelineProgress.waitFor( FILTERING_STAGE, pictureIdx );
+  xFilterPicture( pcPic, numSliceSegments, threadIdx, bIsReferenced, dDecTime );
+  m_pipelineProgress.set( FILTERING_STAGE, pictureIdx + 1 );
+}
+
+/** Wait until a picture buffer that is about to be reused is no longer accessed by the frame pipeline, either because the picture
+ * itself or one of the pictures that reference it is still being reconstructed or filtered.
+ * \param pcPic  picture buffer to reuse
+ */
+Void TDecTop::xWaitUntilPictureUnused(TComPic* pcPic)
+{
+  if (!m_framePipeline)
+  {
+    return;
+  }
+
+  for (TComList<TComPic*>::iterator iterPic = m_cListPic.begin(); iterPic != m_cListPic.end(); iterPic++)
+  {
+    TComPic*  pcOtherPic    = *iterPic;
+    const Int numCtuRows    = pcOtherPic->getPicSym()->getFrameHeightInCtus();
+    Bool      bUsesPicture  = (pcOtherPic == pcPic);
+
+    for (UInt sliceIdx = 0; sliceIdx < pcOtherPic->getPicSym()->getNumAllocatedSlice() && !bUsesPicture && pcOtherPic->getNumFinishedCtuRows() < numCtuRows; sliceIdx++)
+    {
+      const TComSlice* pcSlice = pcOtherPic->getSlice(sliceIdx);
+      for (Int iRefList = 0; iRefList < NUM_REF_PIC_LIST_01 && !bUsesPicture; iRefList++)
+      {
+        for (Int iRefIdx = 0; iRefIdx < pcSlice->getNumRefIdx(RefPicList(iRefList)) && !bUsesPicture; iRefIdx++)
+        {
+          bUsesPicture = (pcSlice->getRefPic(RefPicList(iRefList), iRefIdx) == pcPic);
+        }
+      }
+    }
+
+    if (bUsesPicture)
+    {
+      pcOtherPic->waitForFinishedCtuRows( numCtuRows );
+    }
+  }
+}
+
+/** Fill the global partition order tables for the CTU geometry of an SPS, when it differs from the one they hold.
+ * The tables are read by the reconstruction and the filtering of the pictures in the frame pipeline, so the pipeline is
+ * drained before they are rewritten.
+ * \param sps  SPS of the picture about to be decoded
+ */
+Void TDecTop::xInitPartitionTables(const TComSPS& sps)
+{
+  if (sps.getMaxCUWidth() == m_partitionTablesMaxCUWidth && sps.getMaxCUHeight() == m_partitionTablesMaxCUHeight && sps.getMaxTotalCUDepth() == m_partitionTablesMaxTotalCUDepth)
+  {
+    return;
+  }
+
+  if (m_framePipeline)
+  {
+    m_pipelineProgress.waitFor( FILTERING_STAGE, m_numPicturesInPipeline );
+  }
+
+  m_partitionTablesMaxCUWidth      = sps.getMaxCUWidth();
+  m_partitionTablesMaxCUHeight     = sps.getMaxCUHeight();
+  m_partitionTablesMaxTotalCUDepth = sps.getMaxTotalCUDepth();
+
+  // initialize partition order.
+  const UInt uiMaxDepth = m_partitionTablesMaxTotalCUDepth + 1;
+  UInt* piTmp = &g_auiZscanToRaster[0];
+  initZscanToRaster( uiMaxDepth, 1, 0, piTmp );
+  initRasterToZscan( m_partitionTablesMaxCUWidth, m_partitionTablesMaxCUHeight, uiMaxDepth );
+
+  // initialize conversion matrix from partition index to pel
+  initRasterToPelXY( m_partitionTablesMaxCUWidth, m_partitionTablesMaxCUHeight, uiMaxDepth );
+}
+
 Void TDecTop::checkNoOutputPriorPics (TComList<TComPic*>* pcListPic)
 {
   if (!pcListPic || !m_isNoOutputPriorPics)
@@ -266,10 +467,13 @@ Void TDecTop::xCreateLostPicture(Int iLostPoc)
     if(abs(rpcPic->getPicSym()->getSlice(0)->getPOC() -iLostPoc)==closestPoc&&rpcPic->getPicSym()->getSlice(0)->getPOC()!=m_apcSlicePilot->getPOC())
     {
       printf("copying picture %d to %d (%d)\n",rpcPic->getPicSym()->getSlice(0)->getPOC() ,iLostPoc,m_apcSlicePilot->getPOC());
+      rpcPic->waitForFinishedCtuRows(rpcPic->getPicSym()->getFrameHeightInCtus());
       rpcPic->getPicYuvRec()->copyToPic(cFillPic->getPicYuvRec());
       break;
     }
   }
+  cFillPic->getPicYuvRec()->extendPicBorder();
+  cFillPic->setNumFinishedCtuRows(cFillPic->getPicSym()->getFrameHeightInCtus());
   cFillPic->setCurrSliceIdx(0);
   for(Int ctuRsAddr=0; ctuRsAddr<cFillPic->getNumberOfCtusInFrame(); ctuRsAddr++)
   {
@@ -321,6 +525,8 @@ Void TDecTop::xActivateParameterSets()
     // g_uiMaxCUDepth = sps->getMaxTotalCUDepth();
     // g_uiAddCUDepth = sps->getMaxTotalCUDepth() - sps->getLog2DiffMaxMinCodingBlockSize()
 
+    xInitPartitionTables(*sps);
+
     //  Get a new picture buffer. This will also set up m_pcPic, and therefore give us a SPS and PPS pointer that we can use.
     xGetNewPicBuffer (*(sps), *(pps), m_pcPic, m_apcSlicePilot->getTLayer());
     m_apcSlicePilot->applyReferencePictureSet(m_cListPic, m_apcSlicePilot->getRPS());
@@ -337,8 +543,6 @@ Void TDecTop::xActivateParameterSets()
     sps=pSlice->getSPS();
 
     // Initialise the various objects for the new set of settings
-    m_cSAO.create( sps->getPicWidthInLumaSamples(), sps->getPicHeightInLumaSamples(), sps->getChromaFormatIdc(), sps->getMaxCUWidth(), sps->getMaxCUHeight(), sps->getMaxTotalCUDepth(), pps->getPpsRangeExtension().getLog2SaoOffsetScale(CHANNEL_TYPE_LUMA), pps->getPpsRangeExtension().getLog2SaoOffsetScale(CHANNEL_TYPE_CHROMA) );
-    m_cLoopFilter.create( sps->getMaxTotalCUDepth() );
     m_cPrediction.initTempBuff(sps->getChromaFormatIdc());
 
 
@@ -369,6 +573,10 @@ Void TDecTop::xActivateParameterSets()
     m_cCuDecoder.create ( sps->getMaxTotalCUDepth(), sps->getMaxCUWidth(), sps->getMaxCUHeight(), sps->getChromaFormatIdc() );
     m_cCuDecoder.init   ( &m_cEntropyDecoder, &m_cTrQuant, &m_cPrediction );
     m_cTrQuant.init     ( sps->getMaxTrSize() );
+    for ( Int threadIdx = 0; threadIdx < m_cThreadPool.getNumThreads(); threadIdx++ )
+    {
+      m_pcCtuWorkers[threadIdx].create( *sps );
+    }
 
     m_cSliceDecoder.create();
   }
@@ -613,7 +821,8 @@ Bool TDecTop::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisp
   {
     pcSlice->checkCRA(pcSlice->getRPS(), m_pocCRA, m_associatedIRAPType, m_cListPic );
     // Set reference list
-    pcSlice->setRefPicList( m_cListPic, true );
+    // the borders of the reference pictures are extended when they are filtered
+    pcSlice->setRefPicList( m_cListPic, true, false );
 
     // For generalized B
     // note: maybe not existed case (always L0 is copied to L1 if L1 is empty)
@@ -659,6 +868,25 @@ Bool TDecTop::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisp
   }
 
   m_pcPic->setCurrSliceIdx(m_uiSliceIdx);
+  xUpdateScalingList( &m_cTrQuant, pcSlice );
+  for ( Int threadIdx = 0; threadIdx < m_cThreadPool.getNumThreads(); threadIdx++ )
+  {
+    xUpdateScalingList( m_pcCtuWorkers[threadIdx].getTrQuant(), pcSlice );
+  }
+
+  //  Decode a picture
+  m_cGopDecoder.decompressSlice(&(nalu.getBitstream()), m_pcPic);
+
+  m_bFirstSliceInPicture = false;
+  m_uiSliceIdx++;
+
+  return false;
+}
+
+/** Set up the scaling lists of a transform and quantization class for a slice.
+ */
+Void TDecTop::xUpdateScalingList(TComTrQuant* pcTrQuant, const TComSlice* pcSlice)
+{
   if(pcSlice->getSPS()->getScalingListFlag())
   {
     TComScalingList scalingList;
@@ -674,8 +902,8 @@ Bool TDecTop::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisp
     {
       scalingList.setDefaultScalingList();
     }
-    m_cTrQuant.setScalingListDec(scalingList);
-    m_cTrQuant.setUseScalingList(true);
+    pcTrQuant->setScalingListDec(scalingList);
+    pcTrQuant->setUseScalingList(true);
   }
   else
   {
@@ -684,17 +912,9 @@ Bool TDecTop::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisp
         pcSlice->getSPS()->getMaxLog2TrDynamicRange(CHANNEL_TYPE_LUMA),
         pcSlice->getSPS()->getMaxLog2TrDynamicRange(CHANNEL_TYPE_CHROMA)
     };
-    m_cTrQuant.setFlatScalingList(maxLog2TrDynamicRange, pcSlice->getSPS()->getBitDepths());
-    m_cTrQuant.setUseScalingList(false);
+    pcTrQuant->setFlatScalingList(maxLog2TrDynamicRange, pcSlice->getSPS()->getBitDepths());
+    pcTrQuant->setUseScalingList(false);
   }
-
-  //  Decode a picture
-  m_cGopDecoder.decompressSlice(&(nalu.getBitstream()), m_pcPic);
-
-  m_bFirstSliceInPicture = false;
-  m_uiSliceIdx++;
-
-  return false;
 }
 
 Void TDecTop::xDecodeVPS(const std::vector<UChar> &naluData)
@@ -722,6 +942,24 @@ Void TDecTop::xDecodePPS(const std::vector<UChar> &naluData)
   m_parameterSetManager.storePPS( pps, naluData);
 }
 
+/** Take the oldest NAL unit kept back by decode() when it started a new picture.
+ * \param nalu receives the NAL unit header and its unescaped payload, positioned after the NAL unit header
+ * \returns false if no NAL unit is pending
+ */
+Bool TDecTop::takePendingNalUnit(InputNALUnit& nalu)
+{
+  if (m_pendingNalUnits.empty())
+  {
+    return false;
+  }
+  InputNALUnit *pending = m_pendingNalUnits.front();
+  m_pendingNalUnits.pop_front();
+  static_cast<NALUnit&>(nalu) = *pending;
+  nalu.getBitstream().swap(pending->getBitstream());
+  delete pending;
+  return true;
+}
+
 Bool TDecTop::decode(InputNALUnit& nalu, Int& iSkipFrame, Int& iPOCLastDisplay)
 {
   // ignore all NAL units of layers > 0
@@ -780,8 +1018,19 @@ Bool TDecTop::decode(InputNALUnit& nalu, Int& iSkipFrame, Int& iPOCLastDisplay)
     case NAL_UNIT_CODED_SLICE_RADL_R:
     case NAL_UNIT_CODED_SLICE_RASL_N:
     case NAL_UNIT_CODED_SLICE_RASL_R:
-      return xDecodeSlice(nalu, iSkipFrame, iPOCLastDisplay);
-      break;
+      if (xDecodeSlice(nalu, iSkipFrame, iPOCLastDisplay))
+      {
+        // Keep the slice, already unescaped, until the previous picture is finished.
+        InputNALUnit *pending = new InputNALUnit;
+        static_cast<NALUnit&>(*pending) = nalu;
+        pending->getBitstream().swap(nalu.getBitstream());
+        UInt nalUnitHeader;
+        pending->getBitstream().resetToStart();
+        pending->getBitstream().read(16, nalUnitHeader); // the header has been parsed already
+        m_pendingNalUnits.push_back(pending);
+        return true;
+      }
+      return false;
 
     case NAL_UNIT_EOS:
       m_associatedIRAPType = NAL_UNIT_INVALID;
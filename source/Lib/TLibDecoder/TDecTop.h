@@ -44,9 +44,11 @@
 #include "TLibCommon/TComPic.h"
 #include "TLibCommon/TComTrQuant.h"
 #include "TLibCommon/TComPrediction.h"
+#include "TLibCommon/TComThreadPool.h"
 #include "TLibCommon/SEI.h"
 
 #include "TDecGop.h"
+#include "TDecCtuWorker.h"
 #include "TDecEntropy.h"
 #include "TDecSbac.h"
 #include "TDecCAVLC.h"
@@ -90,6 +92,16 @@ private:
   SEIReader               m_seiReader;
   TComLoopFilter          m_cLoopFilter;
   TComSampleAdaptiveOffset m_cSAO;
+  TComThreadPool          m_cThreadPool;      ///< worker threads, only started when more than one thread is requested
+  Int                     m_numThreads;
+  TDecCtuWorker*          m_pcCtuWorkers;     ///< tools of each worker thread
+  Bool                    m_framePipeline;    ///< reconstruct and filter each picture on a worker thread while the next one is parsed
+  TDecCtuWorker           m_cReconstructionWorker; ///< tools of the reconstruction stage of the frame pipeline
+  TComRowProgress         m_pipelineProgress; ///< number of pictures that have completed each stage of the frame pipeline
+  Int                     m_numPicturesInPipeline; ///< number of pictures submitted to the frame pipeline
+  UInt                    m_partitionTablesMaxCUWidth;  ///< CTU geometry of the global partition order tables, 0 before they are filled
+  UInt                    m_partitionTablesMaxCUHeight;
+  UInt                    m_partitionTablesMaxTotalCUDepth;
 
   Bool isSkipPictureForBLA(Int& iPOCLastDisplay);
   Bool isRandomAccessSkipPicture(Int& iSkipFrame,  Int& iPOCLastDisplay);
@@ -113,6 +125,7 @@ private:
   Bool                    m_warningMessageSkipPicture;
 
   std::list<InputNALUnit*> m_prefixSEINALUs; /// Buffered up prefix SEI NAL Units.
+  std::list<InputNALUnit*> m_pendingNalUnits; ///< NAL units that start a new picture, to be decoded again once the previous picture is finished
 public:
   TDecTop();
   virtual ~TDecTop();
@@ -121,9 +134,13 @@ public:
   Void  destroy ();
 
   Void setDecodedPictureHashSEIEnabled(Int enabled) { m_cGopDecoder.setDecodedPictureHashSEIEnabled(enabled); }
+  Void setNumThreads(Int numThreads) { m_numThreads = numThreads; }   ///< to be called before create()
+  Void setFramePipeline(Bool b)      { m_framePipeline = b; }         ///< to be called before create()
 
   Void  init();
   Bool  decode(InputNALUnit& nalu, Int& iSkipFrame, Int& iPOCLastDisplay);
+  Bool  hasPendingNalUnit() const { return !m_pendingNalUnits.empty(); }
+  Bool  takePendingNalUnit(InputNALUnit& nalu);
   Void  deletePicBuffer();
 
   
@@ -144,8 +161,14 @@ public:
 protected:
   Void  xGetNewPicBuffer  (const TComSPS &sps, const TComPPS &pps, TComPic*& rpcPic, const UInt temporalLayer);
   Void  xCreateLostPicture (Int iLostPOC);
+  Void  xWaitUntilPictureUnused (TComPic* pcPic);
+  Void  xInitPartitionTables (const TComSPS& sps);
+  Void  xReconstructPicture (TComPic* pcPic, UInt numSliceSegments);
+  Void  xFilterPicture    (TComPic* pcPic, UInt numSliceSegments, Int threadIdx, Bool bIsReferenced, Double dDecTime);
+  Void  xFinishPicture    (TComPic* pcPic, UInt numSliceSegments, Int threadIdx, Bool bIsReferenced, Double dDecTime, Int pictureIdx);
 
   Void      xActivateParameterSets();
+  Void      xUpdateScalingList(TComTrQuant* pcTrQuant, const TComSlice* pcSlice);
   Bool      xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisplay);
   Void      xDecodeVPS(const std::vector<UChar> &naluData);
   Void      xDecodeSPS(const std::vector<UChar> &naluData);
@@ -34,6 +34,7 @@
 #include <vector>
 #include <algorithm>
 #include <ostream>
+#include <string.h>
 
 #include "TLibCommon/NAL.h"
 #include "TLibCommon/TComBitStream.h"
@@ -86,40 +87,50 @@ Void write(ostream& out, OutputNALUnit& nalu)
    */
   vector<uint8_t>& rbsp   = nalu.m_Bitstream.getFIFO();
 
-  vector<uint8_t> outputBuffer;
-  outputBuffer.resize(rbsp.size()*2+1); //there can never be enough emulation_prevention_three_bytes to require this much space
-  std::size_t outputAmount = 0;
-  Int         zeroCount    = 0;
-  for (vector<uint8_t>::iterator it = rbsp.begin(); it != rbsp.end(); it++)
+  if (rbsp.empty())
   {
-    const uint8_t v=(*it);
-    if (zeroCount==2 && v<=3)
+    return;
+  }
+
+  /* An emulation_prevention_three_byte is only needed after two zero bytes,
+   * so locate zero bytes with memchr and write out the clean runs in
+   * between them with a single call each. */
+  const uint8_t *const rbspEnd = &rbsp.front() + rbsp.size();
+  const uint8_t *runStart = &rbsp.front();
+  const uint8_t *scan     = runStart;
+  while (true)
+  {
+    const uint8_t *zero = static_cast<const uint8_t*>(memchr(scan, 0x00, rbspEnd - scan));
+    if (zero == NULL || zero + 2 >= rbspEnd)
     {
-      outputBuffer[outputAmount++]=emulation_prevention_three_byte[0];
-      zeroCount=0;
+      break;
     }
-
-    if (v==0)
+    if (zero[1] != 0x00)
+    {
+      scan = zero + 2;
+    }
+    else if (zero[2] > 0x03)
     {
-      zeroCount++;
+      scan = zero + 3;
     }
     else
     {
-      zeroCount=0;
+      out.write(reinterpret_cast<const TChar*>(runStart), zero + 2 - runStart);
+      out.write(reinterpret_cast<const TChar*>(emulation_prevention_three_byte), 1);
+      runStart = scan = zero + 2;
     }
-    outputBuffer[outputAmount++]=v;
   }
+  out.write(reinterpret_cast<const TChar*>(runStart), rbspEnd - runStart);
 
   /* 7.4.1.1
    * ... when the last byte of the RBSP data is equal to 0x00 (which can
    * only occur when the RBSP ends in a cabac_zero_word), a final byte equal
    * to 0x03 is appended to the end of the data.
    */
-  if (zeroCount>0)
+  if (rbspEnd[-1] == 0x00)
   {
-    outputBuffer[outputAmount++]=emulation_prevention_three_byte[0];
+    out.write(reinterpret_cast<const TChar*>(emulation_prevention_three_byte), 1);
   }
-  out.write(reinterpret_cast<const TChar*>(&(*outputBuffer.begin())), outputAmount);
 }
 
 //! \}
@@ -298,20 +298,20 @@ Void SEIEncoder::initDecodedPictureHashSEI(SEIDecodedPictureHash *decodedPicture
   {
     case HASHTYPE_MD5:
       {
-        UInt numChar=calcMD5(*pcPic->getPicYuvRec(), decodedPictureHashSEI->m_pictureHash, bitDepths);
+        UInt numChar=calcMD5(*pcPic->getPicYuvRec(), decodedPictureHashSEI->m_pictureHash, bitDepths, m_pcEncTop->getThreadPool());
         rHashString = hashToString(decodedPictureHashSEI->m_pictureHash, numChar);
       }
       break;
     case HASHTYPE_CRC:
       {
-        UInt numChar=calcCRC(*pcPic->getPicYuvRec(), decodedPictureHashSEI->m_pictureHash, bitDepths);
+        UInt numChar=calcCRC(*pcPic->getPicYuvRec(), decodedPictureHashSEI->m_pictureHash, bitDepths, m_pcEncTop->getThreadPool());
         rHashString = hashToString(decodedPictureHashSEI->m_pictureHash, numChar);
       }
       break;
     case HASHTYPE_CHECKSUM:
     default:
       {
-        UInt numChar=calcChecksum(*pcPic->getPicYuvRec(), decodedPictureHashSEI->m_pictureHash, bitDepths);
+        UInt numChar=calcChecksum(*pcPic->getPicYuvRec(), decodedPictureHashSEI->m_pictureHash, bitDepths, m_pcEncTop->getThreadPool());
         rHashString = hashToString(decodedPictureHashSEI->m_pictureHash, numChar);
       }
       break;
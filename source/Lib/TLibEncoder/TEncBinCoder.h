@@ -45,6 +45,9 @@
 //! \{
 
 class TEncBinCABAC;
+#if FAST_BIT_EST
+class TEncBinCABACCounter;
+#endif
 
 class TEncBinIf
 {
@@ -73,6 +76,9 @@ public:
 
   virtual TEncBinCABAC*   getTEncBinCABAC   ()  { return 0; }
   virtual const TEncBinCABAC*   getTEncBinCABAC   () const { return 0; }
+#if FAST_BIT_EST
+  virtual TEncBinCABACCounter*  getTEncBinCABACCounter() { return 0; }
+#endif
 
   virtual ~TEncBinIf() {}
 };
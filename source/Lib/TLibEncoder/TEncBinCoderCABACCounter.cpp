@@ -65,75 +65,6 @@ UInt TEncBinCABACCounter::getNumWrittenBits()
   return m_pcTComBitIf->getNumberOfWrittenBits() + UInt( m_fracBits >> 15 );
 }
 
-/**
- * \brief Encode bin
- *
- * \param binValue   bin value
- * \param rcCtxModel context model
- */
-Void TEncBinCABACCounter::encodeBin( UInt binValue, ContextModel &rcCtxModel )
-{
-#if DEBUG_ENCODER_SEARCH_BINS
-  const UInt64 startingFracBits = m_fracBits;
-#endif
-
-  m_uiBinsCoded += m_binCountIncrement;
-  m_fracBits += rcCtxModel.getEntropyBits( binValue );
-  rcCtxModel.update( binValue );
-
-#if DEBUG_ENCODER_SEARCH_BINS
-  if ((g_debugCounter + debugEncoderSearchBinWindow) >= debugEncoderSearchBinTargetLine)
-  {
-    std::cout << g_debugCounter << ": coding bin value " << binValue << ", fracBits = [" << startingFracBits << "->" << m_fracBits << "]\n";
-  }
-
-  if (g_debugCounter >= debugEncoderSearchBinTargetLine)
-  {
-    UChar breakPointThis;
-    breakPointThis = 7;
-  }
-  if (g_debugCounter >= (debugEncoderSearchBinTargetLine + debugEncoderSearchBinWindow))
-  {
-    exit(0);
-  }
-  g_debugCounter++;
-#endif
-}
-
-/**
- * \brief Encode equiprobable bin
- *
- * \param binValue bin value
- */
-Void TEncBinCABACCounter::encodeBinEP( UInt /*binValue*/ )
-{
-  m_uiBinsCoded += m_binCountIncrement;
-  m_fracBits += 32768;
-}
-
-/**
- * \brief Encode equiprobable bins
- *
- * \param binValues bin values
- * \param numBins number of bins
- */
-Void TEncBinCABACCounter::encodeBinsEP( UInt /*binValues*/, Int numBins )
-{
-  m_uiBinsCoded += numBins & -m_binCountIncrement;
-  m_fracBits += 32768 * numBins;
-}
-
-/**
- * \brief Encode terminating bin
- *
- * \param binValue bin value
- */
-Void TEncBinCABACCounter::encodeBinTrm( UInt binValue )
-{
-  m_uiBinsCoded += m_binCountIncrement;
-  m_fracBits += ContextModel::getEntropyBitsTrm( binValue );
-}
-
 Void TEncBinCABACCounter::align()
 {
   m_fracBits = (m_fracBits + 32767) & (~32767);
@@ -43,10 +43,15 @@
 
 #if FAST_BIT_EST
 
+#if DEBUG_ENCODER_SEARCH_BINS
+#include "TLibCommon/Debug.h"
+#endif
+
 //! \ingroup TLibEncoder
 //! \{
 
 
+/// rate estimation bin coder: accumulates fractional bits from the context state tables instead of range coding
 class TEncBinCABACCounter : public TEncBinCABAC
 {
 public:
@@ -63,9 +68,99 @@ public:
 
   Void  align             ();
 
+  // bulk estimators (no bin values are needed to estimate bypass-coded data)
+  Void  encodeNumBinsEP   ( UInt  numBins                             );
+
+  TEncBinCABACCounter* getTEncBinCABACCounter() { return this; }
+
 private:
 };
 
+// the per-bin estimators are defined here so that callers holding a TEncBinCABACCounter
+// (see TEncSbac) can invoke them without virtual dispatch
+
+/**
+ * \brief Encode bin
+ *
+ * \param binValue   bin value
+ * \param rcCtxModel context model
+ */
+inline Void TEncBinCABACCounter::encodeBin( UInt binValue, ContextModel &rcCtxModel )
+{
+#if DEBUG_ENCODER_SEARCH_BINS
+  const UInt64 startingFracBits = m_fracBits;
+#endif
+
+  m_uiBinsCoded += m_binCountIncrement;
+  m_fracBits += rcCtxModel.getEntropyBits( binValue );
+  rcCtxModel.update( binValue );
+
+#if DEBUG_ENCODER_SEARCH_BINS
+  if ((g_debugCounter + debugEncoderSearchBinWindow) >= debugEncoderSearchBinTargetLine)
+  {
+    std::cout << g_debugCounter << ": coding bin value " << binValue << ", fracBits = [" << startingFracBits << "->" << m_fracBits << "]\n";
+  }
+
+  if (g_debugCounter >= debugEncoderSearchBinTargetLine)
+  {
+    UChar breakPointThis;
+    breakPointThis = 7;
+  }
+  if (g_debugCounter >= (debugEncoderSearchBinTargetLine + debugEncoderSearchBinWindow))
+  {
+    exit(0);
+  }
+  g_debugCounter++;
+#endif
+}
+
+/**
+ * \brief Encode equiprobable bin
+ *
+ * \param binValue bin value
+ */
+inline Void TEncBinCABACCounter::encodeBinEP( UInt /*binValue*/ )
+{
+  m_uiBinsCoded += m_binCountIncrement;
+  m_fracBits += 32768;
+}
+
+/**
+ * \brief Encode equiprobable bins
+ *
+ * \param binValues bin values
+ * \param numBins number of bins
+ */
+inline Void TEncBinCABACCounter::encodeBinsEP( UInt /*binValues*/, Int numBins )
+{
+  m_uiBinsCoded += numBins & -m_binCountIncrement;
+  m_fracBits += 32768 * numBins;
+}
+
+/**
+ * \brief Account for a run of equiprobable bins whose values are irrelevant to the estimate
+ *
+ * Unlike encodeBinsEP, the run is not limited to 32 bins.
+ *
+ * \param numBins number of bins
+ */
+inline Void TEncBinCABACCounter::encodeNumBinsEP( UInt numBins )
+{
+  m_uiBinsCoded += numBins & -m_binCountIncrement;
+  m_fracBits += UInt64(numBins) << 15;
+}
+
+/**
+ * \brief Encode terminating bin
+ *
+ * \param binValue bin value
+ */
+inline Void TEncBinCABACCounter::encodeBinTrm( UInt binValue )
+{
+  m_uiBinsCoded += m_binCountIncrement;
+  m_fracBits += ContextModel::getEntropyBitsTrm( binValue );
+}
+
 //! \}
 
 #endif
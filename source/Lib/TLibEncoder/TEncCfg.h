@@ -278,6 +278,9 @@ protected:
   std::vector<Int> m_tileRowHeight;
 
   Bool      m_entropyCodingSyncEnabledFlag;
+  Int       m_numThreads;                                     ///< number of worker threads used for CTU compression
+  Int       m_numParallelFrames;                              ///< maximum number of pictures of a GOP being compressed at the same time
+  Bool      m_bRowLaggedLoopFilter;                           ///< filter each CTU row as soon as the rows it is read by are compressed
 
   HashType  m_decodedPictureHashSEIType;
   Bool      m_bufferingPeriodSEIEnabled;
@@ -423,6 +426,9 @@ public:
   TEncCfg()
   : m_tileColumnWidth()
   , m_tileRowHeight()
+  , m_numThreads(1)
+  , m_numParallelFrames(1)
+  , m_bRowLaggedLoopFilter(false)
   {
     m_PCMBitDepth[CHANNEL_TYPE_LUMA]=8;
     m_PCMBitDepth[CHANNEL_TYPE_CHROMA]=8;
@@ -592,6 +598,7 @@ public:
   Bool      getDisableIntraPUsInInterSlices    () const { return m_bDisableIntraPUsInInterSlices; }
   MESearchMethod getMotionEstimationSearchMethod ( ) const { return m_motionEstimationSearchMethod; }
   Int       getSearchRange                     () const { return m_iSearchRange; }
+  Int       getBipredSearchRange               () const { return m_bipredSearchRange; }
   Bool      getClipForBiPredMeEnabled          () const { return m_bClipForBiPredMeEnabled; }
   Bool      getFastMEAssumingSmootherMVEnabled () const { return m_bFastMEAssumingSmootherMVEnabled; }
   Int       getMinSearchWindow                 () const { return m_minSearchWindow; }
@@ -729,6 +736,12 @@ public:
   Void  xCheckGSParameters();
   Void  setEntropyCodingSyncEnabledFlag(Bool b)                      { m_entropyCodingSyncEnabledFlag = b; }
   Bool  getEntropyCodingSyncEnabledFlag() const                      { return m_entropyCodingSyncEnabledFlag; }
+  Void  setNumThreads(Int i)                                         { m_numThreads = i; }
+  Int   getNumThreads() const                                        { return m_numThreads; }
+  Void  setNumParallelFrames(Int i)                                  { m_numParallelFrames = i; }
+  Int   getNumParallelFrames() const                                 { return m_numParallelFrames; }
+  Void  setRowLaggedLoopFilter(Bool b)                               { m_bRowLaggedLoopFilter = b; }
+  Bool  getRowLaggedLoopFilter() const                               { return m_bRowLaggedLoopFilter; }
   Void  setDecodedPictureHashSEIType(HashType m)                     { m_decodedPictureHashSEIType = m; }
   HashType getDecodedPictureHashSEIType() const                      { return m_decodedPictureHashSEIType; }
   Void  setBufferingPeriodSEIEnabled(Bool b)                         { m_bufferingPeriodSEIEnabled = b; }
@@ -1109,6 +1109,12 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     m_pcCfg->setEncodedFlag(iGOPid, false);
   }
 
+  // Pictures whose compression has been started, but which have not been filtered and written yet. When more than one picture may be
+  // in flight, a picture is compressed while the pictures before it that it does not refer to are still being compressed or written.
+  // The adaptive search range and field coding carry state from one picture to the next, so they allow one picture only.
+  std::deque<PictureInFlight> picturesInFlight;
+  const UInt maxPicturesInFlight = ( !m_pcSliceEncoder->canCompressConcurrently() || m_pcCfg->getUseASR() || isField ) ? 1 : m_pcCfg->getNumParallelFrames();
+
   for ( Int iGOPid=0; iGOPid < m_iGopSize; iGOPid++ )
   {
     if (m_pcCfg->getEfficientFieldIRAPEnabled())
@@ -1150,7 +1156,17 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       continue;
     }
 
-    if( getNalUnitType(pocCurr, m_iLastIDR, isField) == NAL_UNIT_CODED_SLICE_IDR_W_RADL || getNalUnitType(pocCurr, m_iLastIDR, isField) == NAL_UNIT_CODED_SLICE_IDR_N_LP )
+    // The reference pictures have to be complete before the reference picture lists are built, as their borders are extended then.
+    // An IDR picture changes the state with which the SEI messages of the pictures before it are written.
+    const Bool bIDR = getNalUnitType(pocCurr, m_iLastIDR, isField) == NAL_UNIT_CODED_SLICE_IDR_W_RADL || getNalUnitType(pocCurr, m_iLastIDR, isField) == NAL_UNIT_CODED_SLICE_IDR_N_LP;
+    while ( !picturesInFlight.empty() && ( bIDR || xRefersToPicturesInFlight( iGOPid, pocCurr, picturesInFlight ) ) )
+    {
+      xFinishPicture( picturesInFlight.front(), rcListPic, isField, isTff, snr_conversion, printFrameMSE, pcBitstreamRedirect,
+                      leadingSeiMessages, nestedSeiMessages, duInfoSeiMessages, trailingSeiMessages, duData );
+      picturesInFlight.pop_front();
+    }
+
+    if( bIDR )
     {
       m_iLastIDR = pocCurr;
     }
@@ -1325,6 +1341,7 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
     {
       pcSlice->setSliceType ( P_SLICE );
     }
+    // choice made when the last picture was coded: with pictures in flight, this is not necessarily the previous picture
     pcSlice->setEncCABACTableIdx(m_pcSliceEncoder->getEncCABACTableIdx());
 
     if (pcSlice->getSliceType() == B_SLICE)
@@ -1419,10 +1436,7 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
 
 
     Double lambda            = 0.0;
-    Int actualHeadBits       = 0;
-    Int actualTotalBits      = 0;
     Int estimatedBits        = 0;
-    Int tmpBitsBeforeWriting = 0;
     if ( m_pcCfg->getUseRateCtrl() ) // TODO: does this work with multiple slices and slice-segments?
     {
       Int frameLevel = m_pcRateCtrl->getRCSeq()->getGOPID2Level( iGOPid );
@@ -1536,22 +1550,18 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
 
     UInt uiNumSliceSegments = 1;
 
-    // Allocate some coders, now the number of tiles are known.
-    const Int numSubstreamsColumns = (pcSlice->getPPS()->getNumTileColumnsMinus1() + 1);
-    const Int numSubstreamRows     = pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag() ? pcPic->getFrameHeightInCtus() : (pcSlice->getPPS()->getNumTileRowsMinus1() + 1);
-    const Int numSubstreams        = numSubstreamRows * numSubstreamsColumns;
-    std::vector<TComOutputBitstream> substreamsOut(numSubstreams);
-
     // now compress (trial encode) the various slice segments (slices, and dependent slices)
     {
       const UInt numberOfCtusInFrame=pcPic->getPicSym()->getNumberOfCtusInFrame();
       pcSlice->setSliceCurStartCtuTsAddr( 0 );
       pcSlice->setSliceSegmentCurStartCtuTsAddr( 0 );
+      // with the row-lagged filters, the rows of the picture are filtered while its compression carries on
+      const Bool bConcurrent = maxPicturesInFlight > 1 || ( xUseRowLaggedLoopFilter() && m_pcSliceEncoder->canCompressConcurrently() );
 
       for(UInt nextCtuTsAddr = 0; nextCtuTsAddr < numberOfCtusInFrame; )
       {
         m_pcSliceEncoder->precompressSlice( pcPic );
-        m_pcSliceEncoder->compressSlice   ( pcPic, false, false );
+        m_pcSliceEncoder->compressSlice   ( pcPic, false, false, bConcurrent );
 
         const UInt curSliceSegmentEnd = pcSlice->getSliceSegmentCurEndCtuTsAddr();
         if (curSliceSegmentEnd < numberOfCtusInFrame)
@@ -1585,13 +1595,105 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       }
     }
 
-    duData.clear();
-    pcSlice = pcPic->getSlice(0);
+    // the filtering and writing of the picture may be deferred, so that the next pictures can be compressed meanwhile
+    PictureInFlight picture;
+    picture.iGOPid             = iGOPid;
+    picture.pcPic              = pcPic;
+    picture.pcPicYuvRecOut     = pcPicYuvRecOut;
+    picture.pcAccessUnit       = &accessUnit;
+    picture.uiNumSliceSegments = uiNumSliceSegments;
+    picture.iBeforeTime        = iBeforeTime;
+    picture.IRAPGOPid          = m_pcCfg->getEfficientFieldIRAPEnabled()?effFieldIRAPMap.GetIRAPGOPid():0;
+    picture.lambda             = lambda;
+    picture.estimatedBits      = estimatedBits;
+    picturesInFlight.push_back(picture);
+
+    while ( picturesInFlight.size() >= maxPicturesInFlight )
+    {
+      xFinishPicture( picturesInFlight.front(), rcListPic, isField, isTff, snr_conversion, printFrameMSE, pcBitstreamRedirect,
+                      leadingSeiMessages, nestedSeiMessages, duInfoSeiMessages, trailingSeiMessages, duData );
+      picturesInFlight.pop_front();
+    }
+
+    if (m_pcCfg->getEfficientFieldIRAPEnabled())
+    {
+      iGOPid=effFieldIRAPMap.restoreGOPid(iGOPid);
+    }
+  } // iGOPid-loop
+
+  while ( !picturesInFlight.empty() )
+  {
+    xFinishPicture( picturesInFlight.front(), rcListPic, isField, isTff, snr_conversion, printFrameMSE, pcBitstreamRedirect,
+                    leadingSeiMessages, nestedSeiMessages, duInfoSeiMessages, trailingSeiMessages, duData );
+    picturesInFlight.pop_front();
+  }
+
+  delete pcBitstreamRedirect;
+
+  assert ( (m_iNumPicCoded == iNumPicRcvd) );
+}
 
+/** Whether a picture refers to one of the pictures in flight, according to the reference picture set it will use.
+ */
+Bool TEncGOP::xRefersToPicturesInFlight( Int iGOPid, Int pocCurr, const std::deque<PictureInFlight>& picturesInFlight )
+{
+  const GOPEntry& rpsEntry = m_pcCfg->getGOPEntry( m_pcEncTop->getReferencePictureSetIdxForSOP( pocCurr, iGOPid ) );
+
+  for ( std::deque<PictureInFlight>::const_iterator it = picturesInFlight.begin(); it != picturesInFlight.end(); it++ )
+  {
+    for ( Int i = 0; i < rpsEntry.m_numRefPics; i++ )
+    {
+      if ( rpsEntry.m_usedByCurrPic[i] && it->pcPic->getPOC() == pocCurr + rpsEntry.m_referencePics[i] )
+      {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/** Complete the encoding of a picture whose slices have been compressed: in-loop filtering, writing of the slices and SEI messages into
+ *  the access unit, and statistics. Pictures are completed in coding order.
+ */
+Void TEncGOP::xFinishPicture( const PictureInFlight& picture, TComList<TComPic*>& rcListPic, Bool isField, Bool isTff,
+                              const InputColourSpaceConversion snr_conversion, const Bool printFrameMSE, TComOutputBitstream* pcBitstreamRedirect,
+                              SEIMessages& leadingSeiMessages, SEIMessages& nestedSeiMessages, SEIMessages& duInfoSeiMessages,
+                              SEIMessages& trailingSeiMessages, std::deque<DUData>& duData )
+{
+  const Int   iGOPid             = picture.iGOPid;
+  TComPic*    pcPic              = picture.pcPic;
+  TComPicYuv* pcPicYuvRecOut     = picture.pcPicYuvRecOut;
+  AccessUnit& accessUnit         = *picture.pcAccessUnit;
+  const UInt  uiNumSliceSegments = picture.uiNumSliceSegments;
+  TComSlice*  pcSlice            = pcPic->getSlice(0);
+
+  Int actualHeadBits       = 0;
+  Int actualTotalBits      = 0;
+  Int tmpBitsBeforeWriting = 0;
+
+  const Bool bRowLaggedLoopFilter = xUseRowLaggedLoopFilter();
+  Bool sliceEnabled[MAX_NUM_COMPONENT];
+  if ( bRowLaggedLoopFilter )
+  {
+    xLoopFilterCtuRows( pcPic, sliceEnabled );
+  }
+
+  m_pcSliceEncoder->finishCompressSlice( pcPic );
+
+  // Allocate some coders, now the number of tiles are known.
+  const Int numSubstreamsColumns = (pcSlice->getPPS()->getNumTileColumnsMinus1() + 1);
+  const Int numSubstreamRows     = pcSlice->getPPS()->getEntropyCodingSyncEnabledFlag() ? pcPic->getFrameHeightInCtus() : (pcSlice->getPPS()->getNumTileRowsMinus1() + 1);
+  const Int numSubstreams        = numSubstreamRows * numSubstreamsColumns;
+  std::vector<TComOutputBitstream> substreamsOut(numSubstreams);
+
+  duData.clear();
+
+  if ( !bRowLaggedLoopFilter )
+  {
     // SAO parameter estimation using non-deblocked pixels for CTU bottom and right boundary areas
     if( pcSlice->getSPS()->getUseSAO() && m_pcCfg->getSaoCtuBoundary() )
     {
-      m_pcSAO->getPreDBFStatistics(pcPic);
+      m_pcSAO->getPreDBFStatistics(pcPic, m_pcEncTop->getThreadPool());
     }
 
     //-- Loop filter
@@ -1612,41 +1714,43 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
       }
 #endif
     }
-    m_pcLoopFilter->loopFilterPic( pcPic );
+    m_pcLoopFilter->loopFilterPic( pcPic, m_pcEncTop->getThreadPool() );
+  }
 
-    /////////////////////////////////////////////////////////////////////////////////////////////////// File writing
-    // Set entropy coder
-    m_pcEntropyCoder->setEntropyCoder   ( m_pcCavlcCoder );
+  /////////////////////////////////////////////////////////////////////////////////////////////////// File writing
+  // Set entropy coder
+  m_pcEntropyCoder->setEntropyCoder   ( m_pcCavlcCoder );
 
-    if ( m_bSeqFirst )
-    {
-      // write various parameter sets
-      actualTotalBits += xWriteParameterSets(accessUnit, pcSlice);
+  if ( m_bSeqFirst )
+  {
+    // write various parameter sets
+    actualTotalBits += xWriteParameterSets(accessUnit, pcSlice);
 
-      // create prefix SEI messages at the beginning of the sequence
-      assert(leadingSeiMessages.empty());
-      xCreateIRAPLeadingSEIMessages(leadingSeiMessages, pcSlice->getSPS(), pcSlice->getPPS());
+    // create prefix SEI messages at the beginning of the sequence
+    assert(leadingSeiMessages.empty());
+    xCreateIRAPLeadingSEIMessages(leadingSeiMessages, pcSlice->getSPS(), pcSlice->getPPS());
 
-      m_bSeqFirst = false;
-    }
-    if (m_pcCfg->getAccessUnitDelimiter())
-    {
-      xWriteAccessUnitDelimiter(accessUnit, pcSlice);
-    }
+    m_bSeqFirst = false;
+  }
+  if (m_pcCfg->getAccessUnitDelimiter())
+  {
+    xWriteAccessUnitDelimiter(accessUnit, pcSlice);
+  }
 
-    // reset presence of BP SEI indication
-    m_bufferingPeriodSEIPresentInAU = false;
-    // create prefix SEI associated with a picture
-    xCreatePerPictureSEIMessages(iGOPid, leadingSeiMessages, nestedSeiMessages, pcSlice);
+  // reset presence of BP SEI indication
+  m_bufferingPeriodSEIPresentInAU = false;
+  // create prefix SEI associated with a picture
+  xCreatePerPictureSEIMessages(iGOPid, leadingSeiMessages, nestedSeiMessages, pcSlice);
 
-    /* use the main bitstream buffer for storing the marshalled picture */
-    m_pcEntropyCoder->setBitstream(NULL);
+  /* use the main bitstream buffer for storing the marshalled picture */
+  m_pcEntropyCoder->setBitstream(NULL);
 
-    pcSlice = pcPic->getSlice(0);
+  pcSlice = pcPic->getSlice(0);
 
-    if (pcSlice->getSPS()->getUseSAO())
+  if (pcSlice->getSPS()->getUseSAO())
+  {
+    if ( !bRowLaggedLoopFilter )
     {
-      Bool sliceEnabled[MAX_NUM_COMPONENT];
       TComBitCounter tempBitCounter;
       tempBitCounter.resetBits();
       m_pcEncTop->getRDGoOnSbacCoder()->setBitstream(&tempBitCounter);
@@ -1657,215 +1761,275 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
                           m_pcCfg->getSaoEncodingRate(),
                           m_pcCfg->getSaoEncodingRateChroma(),
                           m_pcCfg->getSaoCtuBoundary(),
-                          m_pcCfg->getSaoResetEncoderStateAfterIRAP());
+                          m_pcCfg->getSaoResetEncoderStateAfterIRAP(),
+                          m_pcEncTop->getThreadPool());
 #else
-      m_pcSAO->SAOProcess(pcPic, sliceEnabled, pcPic->getSlice(0)->getLambdas(), m_pcCfg->getTestSAODisableAtPictureLevel(), m_pcCfg->getSaoEncodingRate(), m_pcCfg->getSaoEncodingRateChroma(), m_pcCfg->getSaoCtuBoundary());
+      m_pcSAO->SAOProcess(pcPic, sliceEnabled, pcPic->getSlice(0)->getLambdas(), m_pcCfg->getTestSAODisableAtPictureLevel(), m_pcCfg->getSaoEncodingRate(), m_pcCfg->getSaoEncodingRateChroma(), m_pcCfg->getSaoCtuBoundary(), m_pcEncTop->getThreadPool());
 #endif
-      m_pcSAO->PCMLFDisableProcess(pcPic);
       m_pcEncTop->getRDGoOnSbacCoder()->setBitstream(NULL);
+    }
+    m_pcSAO->PCMLFDisableProcess(pcPic);
 
-      //assign SAO slice header
-      for(Int s=0; s< uiNumSliceSegments; s++)
-      {
-        pcPic->getSlice(s)->setSaoEnabledFlag(CHANNEL_TYPE_LUMA, sliceEnabled[COMPONENT_Y]);
-        assert(sliceEnabled[COMPONENT_Cb] == sliceEnabled[COMPONENT_Cr]);
-        pcPic->getSlice(s)->setSaoEnabledFlag(CHANNEL_TYPE_CHROMA, sliceEnabled[COMPONENT_Cb]);
-      }
+    //assign SAO slice header
+    for(Int s=0; s< uiNumSliceSegments; s++)
+    {
+      pcPic->getSlice(s)->setSaoEnabledFlag(CHANNEL_TYPE_LUMA, sliceEnabled[COMPONENT_Y]);
+      assert(sliceEnabled[COMPONENT_Cb] == sliceEnabled[COMPONENT_Cr]);
+      pcPic->getSlice(s)->setSaoEnabledFlag(CHANNEL_TYPE_CHROMA, sliceEnabled[COMPONENT_Cb]);
     }
+  }
 
-    // pcSlice is currently slice 0.
-    std::size_t binCountsInNalUnits   = 0; // For implementation of cabac_zero_word stuffing (section 7.4.3.10)
-    std::size_t numBytesInVclNalUnits = 0; // For implementation of cabac_zero_word stuffing (section 7.4.3.10)
+  // pcSlice is currently slice 0.
+  std::size_t binCountsInNalUnits   = 0; // For implementation of cabac_zero_word stuffing (section 7.4.3.10)
+  std::size_t numBytesInVclNalUnits = 0; // For implementation of cabac_zero_word stuffing (section 7.4.3.10)
 
-    for( UInt sliceSegmentStartCtuTsAddr = 0, sliceIdxCount=0; sliceSegmentStartCtuTsAddr < pcPic->getPicSym()->getNumberOfCtusInFrame(); sliceIdxCount++, sliceSegmentStartCtuTsAddr=pcSlice->getSliceSegmentCurEndCtuTsAddr() )
+  for( UInt sliceSegmentStartCtuTsAddr = 0, sliceIdxCount=0; sliceSegmentStartCtuTsAddr < pcPic->getPicSym()->getNumberOfCtusInFrame(); sliceIdxCount++, sliceSegmentStartCtuTsAddr=pcSlice->getSliceSegmentCurEndCtuTsAddr() )
+  {
+    pcSlice = pcPic->getSlice(sliceIdxCount);
+    if(sliceIdxCount > 0 && pcSlice->getSliceType()!= I_SLICE)
     {
-      pcSlice = pcPic->getSlice(sliceIdxCount);
-      if(sliceIdxCount > 0 && pcSlice->getSliceType()!= I_SLICE)
-      {
-        pcSlice->checkColRefIdx(sliceIdxCount, pcPic);
-      }
-      pcPic->setCurrSliceIdx(sliceIdxCount);
-      m_pcSliceEncoder->setSliceIdx(sliceIdxCount);
+      pcSlice->checkColRefIdx(sliceIdxCount, pcPic);
+    }
+    pcPic->setCurrSliceIdx(sliceIdxCount);
+    m_pcSliceEncoder->setSliceIdx(sliceIdxCount);
 
-      pcSlice->setRPS(pcPic->getSlice(0)->getRPS());
-      pcSlice->setRPSidx(pcPic->getSlice(0)->getRPSidx());
+    pcSlice->setRPS(pcPic->getSlice(0)->getRPS());
+    pcSlice->setRPSidx(pcPic->getSlice(0)->getRPSidx());
 
-      for ( UInt ui = 0 ; ui < numSubstreams; ui++ )
-      {
-        substreamsOut[ui].clear();
-      }
+    for ( UInt ui = 0 ; ui < numSubstreams; ui++ )
+    {
+      substreamsOut[ui].clear();
+    }
 
-      m_pcEntropyCoder->setEntropyCoder   ( m_pcCavlcCoder );
-      m_pcEntropyCoder->resetEntropy      ( pcSlice );
-      /* start slice NALunit */
-      OutputNALUnit nalu( pcSlice->getNalUnitType(), pcSlice->getTLayer() );
-      m_pcEntropyCoder->setBitstream(&nalu.m_Bitstream);
+    m_pcEntropyCoder->setEntropyCoder   ( m_pcCavlcCoder );
+    m_pcEntropyCoder->resetEntropy      ( pcSlice );
+    /* start slice NALunit */
+    OutputNALUnit nalu( pcSlice->getNalUnitType(), pcSlice->getTLayer() );
+    m_pcEntropyCoder->setBitstream(&nalu.m_Bitstream);
 
-      pcSlice->setNoRaslOutputFlag(false);
-      if (pcSlice->isIRAP())
+    pcSlice->setNoRaslOutputFlag(false);
+    if (pcSlice->isIRAP())
+    {
+      if (pcSlice->getNalUnitType() >= NAL_UNIT_CODED_SLICE_BLA_W_LP && pcSlice->getNalUnitType() <= NAL_UNIT_CODED_SLICE_IDR_N_LP)
       {
-        if (pcSlice->getNalUnitType() >= NAL_UNIT_CODED_SLICE_BLA_W_LP && pcSlice->getNalUnitType() <= NAL_UNIT_CODED_SLICE_IDR_N_LP)
-        {
-          pcSlice->setNoRaslOutputFlag(true);
-        }
-        //the inference for NoOutputPriorPicsFlag
-        // KJS: This cannot happen at the encoder
-        if (!m_bFirst && pcSlice->isIRAP() && pcSlice->getNoRaslOutputFlag())
+        pcSlice->setNoRaslOutputFlag(true);
+      }
+      //the inference for NoOutputPriorPicsFlag
+      // KJS: This cannot happen at the encoder
+      if (!m_bFirst && pcSlice->isIRAP() && pcSlice->getNoRaslOutputFlag())
+      {
+        if (pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_CRA)
         {
-          if (pcSlice->getNalUnitType() == NAL_UNIT_CODED_SLICE_CRA)
-          {
-            pcSlice->setNoOutputPriorPicsFlag(true);
-          }
+          pcSlice->setNoOutputPriorPicsFlag(true);
         }
       }
+    }
 
-      pcSlice->setEncCABACTableIdx(m_pcSliceEncoder->getEncCABACTableIdx());
+    pcSlice->setEncCABACTableIdx(m_pcSliceEncoder->getEncCABACTableIdx());
 
-      tmpBitsBeforeWriting = m_pcEntropyCoder->getNumberOfWrittenBits();
-      m_pcEntropyCoder->encodeSliceHeader(pcSlice);
-      actualHeadBits += ( m_pcEntropyCoder->getNumberOfWrittenBits() - tmpBitsBeforeWriting );
+    tmpBitsBeforeWriting = m_pcEntropyCoder->getNumberOfWrittenBits();
+    m_pcEntropyCoder->encodeSliceHeader(pcSlice);
+    actualHeadBits += ( m_pcEntropyCoder->getNumberOfWrittenBits() - tmpBitsBeforeWriting );
 
-      pcSlice->setFinalized(true);
+    pcSlice->setFinalized(true);
 
-      pcSlice->clearSubstreamSizes(  );
+    pcSlice->clearSubstreamSizes(  );
+    {
+      UInt numBinsCoded = 0;
+      m_pcSliceEncoder->encodeSlice(pcPic, &(substreamsOut[0]), numBinsCoded);
+      binCountsInNalUnits+=numBinsCoded;
+    }
+
+    {
+      // Construct the final bitstream by concatenating substreams.
+      // The final bitstream is either nalu.m_Bitstream or pcBitstreamRedirect;
+      // Complete the slice header info.
+      m_pcEntropyCoder->setEntropyCoder   ( m_pcCavlcCoder );
+      m_pcEntropyCoder->setBitstream(&nalu.m_Bitstream);
+      m_pcEntropyCoder->encodeTilesWPPEntryPoint( pcSlice );
+
+      // Append substreams...
+      TComOutputBitstream *pcOut = pcBitstreamRedirect;
+      const Int numZeroSubstreamsAtStartOfSlice  = pcPic->getSubstreamForCtuAddr(pcSlice->getSliceSegmentCurStartCtuTsAddr(), false, pcSlice);
+      const Int numSubstreamsToCode  = pcSlice->getNumberOfSubstreamSizes()+1;
+      UInt totalNumBits = pcOut->getNumberOfWrittenBits();
+      for ( UInt ui = 0 ; ui < numSubstreamsToCode; ui++ )
       {
-        UInt numBinsCoded = 0;
-        m_pcSliceEncoder->encodeSlice(pcPic, &(substreamsOut[0]), numBinsCoded);
-        binCountsInNalUnits+=numBinsCoded;
+        totalNumBits += substreamsOut[ui+numZeroSubstreamsAtStartOfSlice].getNumberOfWrittenBits();
       }
-
+      pcOut->reserve((totalNumBits + 7) >> 3);
+      for ( UInt ui = 0 ; ui < numSubstreamsToCode; ui++ )
       {
-        // Construct the final bitstream by concatenating substreams.
-        // The final bitstream is either nalu.m_Bitstream or pcBitstreamRedirect;
-        // Complete the slice header info.
-        m_pcEntropyCoder->setEntropyCoder   ( m_pcCavlcCoder );
-        m_pcEntropyCoder->setBitstream(&nalu.m_Bitstream);
-        m_pcEntropyCoder->encodeTilesWPPEntryPoint( pcSlice );
-
-        // Append substreams...
-        TComOutputBitstream *pcOut = pcBitstreamRedirect;
-        const Int numZeroSubstreamsAtStartOfSlice  = pcPic->getSubstreamForCtuAddr(pcSlice->getSliceSegmentCurStartCtuTsAddr(), false, pcSlice);
-        const Int numSubstreamsToCode  = pcSlice->getNumberOfSubstreamSizes()+1;
-        for ( UInt ui = 0 ; ui < numSubstreamsToCode; ui++ )
-        {
-          pcOut->addSubstream(&(substreamsOut[ui+numZeroSubstreamsAtStartOfSlice]));
-        }
+        pcOut->addSubstream(&(substreamsOut[ui+numZeroSubstreamsAtStartOfSlice]));
       }
+    }
+
+    // If current NALU is the first NALU of slice (containing slice header) and more NALUs exist (due to multiple dependent slices) then buffer it.
+    // If current NALU is the last NALU of slice and a NALU was buffered, then (a) Write current NALU (b) Update an write buffered NALU at approproate location in NALU list.
+    Bool bNALUAlignedWrittenToList    = false; // used to ensure current NALU is not written more than once to the NALU list.
+    xAttachSliceDataToNalUnit(nalu, pcBitstreamRedirect);
+    accessUnit.push_back(new NALUnitEBSP(nalu));
+    actualTotalBits += UInt(accessUnit.back()->m_nalUnitData.str().size()) * 8;
+    numBytesInVclNalUnits += (std::size_t)(accessUnit.back()->m_nalUnitData.str().size());
+    bNALUAlignedWrittenToList = true;
 
-      // If current NALU is the first NALU of slice (containing slice header) and more NALUs exist (due to multiple dependent slices) then buffer it.
-      // If current NALU is the last NALU of slice and a NALU was buffered, then (a) Write current NALU (b) Update an write buffered NALU at approproate location in NALU list.
-      Bool bNALUAlignedWrittenToList    = false; // used to ensure current NALU is not written more than once to the NALU list.
-      xAttachSliceDataToNalUnit(nalu, pcBitstreamRedirect);
+    if (!bNALUAlignedWrittenToList)
+    {
+      nalu.m_Bitstream.writeAlignZero();
       accessUnit.push_back(new NALUnitEBSP(nalu));
-      actualTotalBits += UInt(accessUnit.back()->m_nalUnitData.str().size()) * 8;
-      numBytesInVclNalUnits += (std::size_t)(accessUnit.back()->m_nalUnitData.str().size());
-      bNALUAlignedWrittenToList = true;
+    }
 
-      if (!bNALUAlignedWrittenToList)
+    if( ( m_pcCfg->getPictureTimingSEIEnabled() || m_pcCfg->getDecodingUnitInfoSEIEnabled() ) &&
+        ( pcSlice->getSPS()->getVuiParametersPresentFlag() ) &&
+        ( ( pcSlice->getSPS()->getVuiParameters()->getHrdParameters()->getNalHrdParametersPresentFlag() )
+       || ( pcSlice->getSPS()->getVuiParameters()->getHrdParameters()->getVclHrdParametersPresentFlag() ) ) &&
+        ( pcSlice->getSPS()->getVuiParameters()->getHrdParameters()->getSubPicCpbParamsPresentFlag() ) )
+    {
+        UInt numNalus = 0;
+      UInt numRBSPBytes = 0;
+      for (AccessUnit::const_iterator it = accessUnit.begin(); it != accessUnit.end(); it++)
       {
-        nalu.m_Bitstream.writeAlignZero();
-        accessUnit.push_back(new NALUnitEBSP(nalu));
+        numRBSPBytes += UInt((*it)->m_nalUnitData.str().size());
+        numNalus ++;
       }
+      duData.push_back(DUData());
+      duData.back().accumBitsDU = ( numRBSPBytes << 3 );
+      duData.back().accumNalsDU = numNalus;
+    }
+  } // end iteration over slices
 
-      if( ( m_pcCfg->getPictureTimingSEIEnabled() || m_pcCfg->getDecodingUnitInfoSEIEnabled() ) &&
-          ( pcSlice->getSPS()->getVuiParametersPresentFlag() ) &&
-          ( ( pcSlice->getSPS()->getVuiParameters()->getHrdParameters()->getNalHrdParametersPresentFlag() )
-         || ( pcSlice->getSPS()->getVuiParameters()->getHrdParameters()->getVclHrdParametersPresentFlag() ) ) &&
-          ( pcSlice->getSPS()->getVuiParameters()->getHrdParameters()->getSubPicCpbParamsPresentFlag() ) )
-      {
-          UInt numNalus = 0;
-        UInt numRBSPBytes = 0;
-        for (AccessUnit::const_iterator it = accessUnit.begin(); it != accessUnit.end(); it++)
-        {
-          numRBSPBytes += UInt((*it)->m_nalUnitData.str().size());
-          numNalus ++;
-        }
-        duData.push_back(DUData());
-        duData.back().accumBitsDU = ( numRBSPBytes << 3 );
-        duData.back().accumNalsDU = numNalus;
-      }
-    } // end iteration over slices
+  // cabac_zero_words processing
+  cabac_zero_word_padding(pcSlice, pcPic, binCountsInNalUnits, numBytesInVclNalUnits, accessUnit.back()->m_nalUnitData, m_pcCfg->getCabacZeroWordPaddingEnabled());
 
-    // cabac_zero_words processing
-    cabac_zero_word_padding(pcSlice, pcPic, binCountsInNalUnits, numBytesInVclNalUnits, accessUnit.back()->m_nalUnitData, m_pcCfg->getCabacZeroWordPaddingEnabled());
+  pcPic->compressMotion();
 
-    pcPic->compressMotion();
+  //-- For time output for each slice
+  Double dEncTime = (Double)(clock()-picture.iBeforeTime) / CLOCKS_PER_SEC;
 
-    //-- For time output for each slice
-    Double dEncTime = (Double)(clock()-iBeforeTime) / CLOCKS_PER_SEC;
+  std::string digestStr;
+  if (m_pcCfg->getDecodedPictureHashSEIType()!=HASHTYPE_NONE)
+  {
+    SEIDecodedPictureHash *decodedPictureHashSei = new SEIDecodedPictureHash();
+    m_seiEncoder.initDecodedPictureHashSEI(decodedPictureHashSei, pcPic, digestStr, pcSlice->getSPS()->getBitDepths());
+    trailingSeiMessages.push_back(decodedPictureHashSei);
+  }
+  xWriteTrailingSEIMessages(trailingSeiMessages, accessUnit, pcSlice->getTLayer(), pcSlice->getSPS());
 
-    std::string digestStr;
-    if (m_pcCfg->getDecodedPictureHashSEIType()!=HASHTYPE_NONE)
+  m_pcCfg->setEncodedFlag(iGOPid, true);
+
+  xCalculateAddPSNRs( isField, isTff, iGOPid, pcPic, accessUnit, rcListPic, dEncTime, snr_conversion, printFrameMSE );
+
+  printHash(m_pcCfg->getDecodedPictureHashSEIType(), digestStr);
+
+  if ( m_pcCfg->getUseRateCtrl() )
+  {
+    Double avgQP     = m_pcRateCtrl->getRCPic()->calAverageQP();
+    Double avgLambda = m_pcRateCtrl->getRCPic()->calAverageLambda();
+    if ( avgLambda < 0.0 )
     {
-      SEIDecodedPictureHash *decodedPictureHashSei = new SEIDecodedPictureHash();
-      m_seiEncoder.initDecodedPictureHashSEI(decodedPictureHashSei, pcPic, digestStr, pcSlice->getSPS()->getBitDepths());
-      trailingSeiMessages.push_back(decodedPictureHashSei);
+      avgLambda = picture.lambda;
     }
-    xWriteTrailingSEIMessages(trailingSeiMessages, accessUnit, pcSlice->getTLayer(), pcSlice->getSPS());
 
-    m_pcCfg->setEncodedFlag(iGOPid, true);
+    m_pcRateCtrl->getRCPic()->updateAfterPicture( actualHeadBits, actualTotalBits, avgQP, avgLambda, pcSlice->getSliceType());
+    m_pcRateCtrl->getRCPic()->addToPictureLsit( m_pcRateCtrl->getPicList() );
 
-    xCalculateAddPSNRs( isField, isTff, iGOPid, pcPic, accessUnit, rcListPic, dEncTime, snr_conversion, printFrameMSE );
+    m_pcRateCtrl->getRCSeq()->updateAfterPic( actualTotalBits );
+    if ( pcSlice->getSliceType() != I_SLICE )
+    {
+      m_pcRateCtrl->getRCGOP()->updateAfterPicture( actualTotalBits );
+    }
+    else    // for intra picture, the estimated bits are used to update the current status in the GOP
+    {
+      m_pcRateCtrl->getRCGOP()->updateAfterPicture( picture.estimatedBits );
+    }
+#if U0132_TARGET_BITS_SATURATION
+    if (m_pcRateCtrl->getCpbSaturationEnabled())
+    {
+      m_pcRateCtrl->updateCpbState(actualTotalBits);
+      printf(" [CPB %6d bits]", m_pcRateCtrl->getCpbState());
+    }
+#endif
+  }
 
-    printHash(m_pcCfg->getDecodedPictureHashSEIType(), digestStr);
+  xCreatePictureTimingSEI(picture.IRAPGOPid, leadingSeiMessages, nestedSeiMessages, duInfoSeiMessages, pcSlice, isField, duData);
+  if (m_pcCfg->getScalableNestingSEIEnabled())
+  {
+    xCreateScalableNestingSEI (leadingSeiMessages, nestedSeiMessages);
+  }
+  xWriteLeadingSEIMessages(leadingSeiMessages, duInfoSeiMessages, accessUnit, pcSlice->getTLayer(), pcSlice->getSPS(), duData);
+  xWriteDuSEIMessages(duInfoSeiMessages, accessUnit, pcSlice->getTLayer(), pcSlice->getSPS(), duData);
 
-    if ( m_pcCfg->getUseRateCtrl() )
-    {
-      Double avgQP     = m_pcRateCtrl->getRCPic()->calAverageQP();
-      Double avgLambda = m_pcRateCtrl->getRCPic()->calAverageLambda();
-      if ( avgLambda < 0.0 )
-      {
-        avgLambda = lambda;
-      }
+  pcPic->getPicYuvRec()->copyToPic(pcPicYuvRecOut);
 
-      m_pcRateCtrl->getRCPic()->updateAfterPicture( actualHeadBits, actualTotalBits, avgQP, avgLambda, pcSlice->getSliceType());
-      m_pcRateCtrl->getRCPic()->addToPictureLsit( m_pcRateCtrl->getPicList() );
+  pcPic->setReconMark   ( true );
+  m_bFirst = false;
+  m_iNumPicCoded++;
+  m_totalCoded ++;
+  /* logging: insert a newline at end of picture period */
+  printf("\n");
+  fflush(stdout);
+}
 
-      m_pcRateCtrl->getRCSeq()->updateAfterPic( actualTotalBits );
-      if ( pcSlice->getSliceType() != I_SLICE )
-      {
-        m_pcRateCtrl->getRCGOP()->updateAfterPicture( actualTotalBits );
-      }
-      else    // for intra picture, the estimated bits are used to update the current status in the GOP
+/** Deblocking and SAO of a picture CTU row by CTU row, each row being filtered as soon as the rows that read its unfiltered
+ * samples are compressed: the intra prediction of the row below reads the bottom line of a row, and so do the statistics of
+ * the non-deblocked samples of the row below. The result is the same as the one of the passes over the whole picture.
+ * \param pcPic         picture class
+ * \param sliceEnabled  receives the SAO enabling of each component
+ */
+Void TEncGOP::xLoopFilterCtuRows( TComPic* pcPic, Bool* sliceEnabled )
+{
+  TComSlice* pcSlice      = pcPic->getSlice(0);
+  const UInt numCtuRows   = pcPic->getFrameHeightInCtus();
+  const Bool bUseSAO      = pcSlice->getSPS()->getUseSAO();
+  const Bool bPreDBFStats = bUseSAO && m_pcCfg->getSaoCtuBoundary();
+  TComBitCounter tempBitCounter;
+
+  m_pcLoopFilter->setCfg( pcSlice->getPPS()->getLoopFilterAcrossTilesEnabledFlag() );
+
+  if ( bUseSAO )
+  {
+    tempBitCounter.resetBits();
+    m_pcEncTop->getRDGoOnSbacCoder()->setBitstream(&tempBitCounter);
+    m_pcSAO->initRDOCabacCoder(m_pcEncTop->getRDGoOnSbacCoder(), pcSlice);
+#if OPTIONAL_RESET_SAO_ENCODING_AFTER_IRAP
+    m_pcSAO->startSAOCtuRows( pcPic, sliceEnabled, pcSlice->getLambdas(), m_pcCfg->getSaoEncodingRate(), m_pcCfg->getSaoEncodingRateChroma(), m_pcCfg->getSaoResetEncoderStateAfterIRAP() );
+#else
+    m_pcSAO->startSAOCtuRows( pcPic, sliceEnabled, pcSlice->getLambdas(), m_pcCfg->getSaoEncodingRate(), m_pcCfg->getSaoEncodingRateChroma() );
+#endif
+  }
+
+  for ( UInt ctuRow = 0; ctuRow < numCtuRows; ctuRow++ )
+  {
+    // the non-deblocked statistics of the next row read the bottom line of this row, which its vertical edges modify
+    m_pcSliceEncoder->waitForCompressedCtuRows( pcPic, std::min( ctuRow + ( bPreDBFStats ? 3 : 2 ), numCtuRows ) );
+    if ( bPreDBFStats )
+    {
+      if ( ctuRow == 0 )
       {
-        m_pcRateCtrl->getRCGOP()->updateAfterPicture( estimatedBits );
+        m_pcSAO->getPreDBFRowStatistics( pcPic, 0 );
       }
-#if U0132_TARGET_BITS_SATURATION
-      if (m_pcRateCtrl->getCpbSaturationEnabled())
+      if ( ctuRow + 1 < numCtuRows )
       {
-        m_pcRateCtrl->updateCpbState(actualTotalBits);
-        printf(" [CPB %6d bits]", m_pcRateCtrl->getCpbState());
+        m_pcSAO->getPreDBFRowStatistics( pcPic, ctuRow + 1 );
       }
-#endif
     }
 
-    xCreatePictureTimingSEI(m_pcCfg->getEfficientFieldIRAPEnabled()?effFieldIRAPMap.GetIRAPGOPid():0, leadingSeiMessages, nestedSeiMessages, duInfoSeiMessages, pcSlice, isField, duData);
-    if (m_pcCfg->getScalableNestingSEIEnabled())
-    {
-      xCreateScalableNestingSEI (leadingSeiMessages, nestedSeiMessages);
-    }
-    xWriteLeadingSEIMessages(leadingSeiMessages, duInfoSeiMessages, accessUnit, pcSlice->getTLayer(), pcSlice->getSPS(), duData);
-    xWriteDuSEIMessages(duInfoSeiMessages, accessUnit, pcSlice->getTLayer(), pcSlice->getSPS(), duData);
+    m_pcLoopFilter->loopFilterCtuRow( pcPic, ctuRow, EDGE_VER );
+    m_pcLoopFilter->loopFilterCtuRow( pcPic, ctuRow, EDGE_HOR );
 
-    pcPic->getPicYuvRec()->copyToPic(pcPicYuvRecOut);
-
-    pcPic->setReconMark   ( true );
-    m_bFirst = false;
-    m_iNumPicCoded++;
-    m_totalCoded ++;
-    /* logging: insert a newline at end of picture period */
-    printf("\n");
-    fflush(stdout);
-
-    if (m_pcCfg->getEfficientFieldIRAPEnabled())
+    // the horizontal edges of this row complete the deblocking of the row above
+    if ( bUseSAO && ctuRow > 0 )
     {
-      iGOPid=effFieldIRAPMap.restoreGOPid(iGOPid);
+      m_pcSAO->processDeblockedCtuRow( pcPic, sliceEnabled, ctuRow - 1, bPreDBFStats );
     }
-  } // iGOPid-loop
-
-  delete pcBitstreamRedirect;
+  }
 
-  assert ( (m_iNumPicCoded == iNumPicRcvd) );
+  if ( bUseSAO )
+  {
+    m_pcSAO->processDeblockedCtuRow( pcPic, sliceEnabled, numCtuRows - 1, bPreDBFStats );
+    m_pcSAO->finishSAOCtuRows( pcPic, sliceEnabled, m_pcCfg->getTestSAODisableAtPictureLevel(), m_pcCfg->getSaoEncodingRate(), m_pcCfg->getSaoEncodingRateChroma() );
+    m_pcEncTop->getRDGoOnSbacCoder()->setBitstream(NULL);
+  }
 }
 
 Void TEncGOP::printOutSummary(UInt uiNumAllPicCoded, Bool isField, const Bool printMSEBasedSNR, const Bool printSequenceMSE, const BitDepths &bitDepths)
@@ -1933,7 +2097,7 @@ Void TEncGOP::preLoopFilterPicAll( TComPic* pcPic, UInt64& ruiDist )
 {
   Bool bCalcDist = false;
   m_pcLoopFilter->setCfg(m_pcCfg->getLFCrossTileBoundaryFlag());
-  m_pcLoopFilter->loopFilterPic( pcPic );
+  m_pcLoopFilter->loopFilterPic( pcPic, m_pcEncTop->getThreadPool() );
 
   if (!bCalcDist)
   {
@@ -1994,9 +2158,10 @@ Void TEncGOP::xGetBuffer( TComList<TComPic*>&      rcListPic,
   while (iterPic != rcListPic.end())
   {
     rpcPic = *(iterPic);
-    rpcPic->setCurrSliceIdx(0);
+    // only the picture being started may be touched here: earlier pictures of the GOP can still be in flight
     if (rpcPic->getPOC() == pocCurr)
     {
+      rpcPic->setCurrSliceIdx(0);
       break;
     }
     iterPic++;
@@ -2008,6 +2173,32 @@ Void TEncGOP::xGetBuffer( TComList<TComPic*>&      rcListPic,
   return;
 }
 
+/// number of rows of a plane summed by one task of xCalculateAddPSNR
+static const Int PSNR_STRIPE_HEIGHT = 64;
+
+/**
+ * Sum of squared differences between two blocks of samples.
+ * The squares of a row are taken as unsigned values of the width of Intermediate_Int, so that the inner loop vectorises,
+ * and added to a 64-bit row sum.
+ */
+static UInt64 getBlockSSD( const Pel* pOrg, const Int iOrgStride, const Pel* pRec, const Int iRecStride, const Int iWidth, const Int iHeight )
+{
+  UInt64 uiSSD = 0;
+  for(Int y = 0; y < iHeight; y++ )
+  {
+    UInt64 uiRowSSD = 0;
+    for(Int x = 0; x < iWidth; x++ )
+    {
+      const Intermediate_UInt iDiff = (Intermediate_UInt)(Intermediate_Int)( pOrg[x] - pRec[x] );
+      uiRowSSD += iDiff * iDiff;
+    }
+    uiSSD += uiRowSSD;
+    pOrg += iOrgStride;
+    pRec += iRecStride;
+  }
+  return uiSSD;
+}
+
 UInt64 TEncGOP::xFindDistortionFrame (TComPicYuv* pcPic0, TComPicYuv* pcPic1, const BitDepths &bitDepths)
 {
   UInt64  uiTotalDiff = 0;
@@ -2124,6 +2315,12 @@ Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const Acces
 
   //===== calculate PSNR =====
   Double MSEyuvframe[MAX_NUM_COMPONENT] = {0, 0, 0};
+  UInt64 uiSSD[MAX_NUM_COMPONENT] = {0, 0, 0};
+
+  // the planes are summed in stripes of rows on the thread pool, and the stripe sums added up in the completions
+  const Int numStripes = (pcPicD->getHeight(COMPONENT_Y) + PSNR_STRIPE_HEIGHT - 1) / PSNR_STRIPE_HEIGHT;
+  std::vector<UInt64> stripeSSD(MAX_NUM_COMPONENT * numStripes);
+  TComTaskGroup ssdGroup( m_pcEncTop->getThreadPool() );
 
   for(Int chan=0; chan<pcPicD->getNumberValidComponents(); chan++)
   {
@@ -2131,24 +2328,36 @@ Void TEncGOP::xCalculateAddPSNR( TComPic* pcPic, TComPicYuv* pcPicD, const Acces
     const TComPicYuv *pOrgPicYuv =(conversion!=IPCOLOURSPACE_UNCHANGED) ? pcPic ->getPicYuvTrueOrg() : pcPic ->getPicYuvOrg();
     const Pel*  pOrg       = pOrgPicYuv->getAddr(ch);
     const Int   iOrgStride = pOrgPicYuv->getStride(ch);
-    Pel*  pRec             = picd.getAddr(ch);
+    const Pel*  pRec       = picd.getAddr(ch);
     const Int   iRecStride = picd.getStride(ch);
     const Int   iWidth  = pcPicD->getWidth (ch) - (m_pcEncTop->getPad(0) >> pcPic->getComponentScaleX(ch));
     const Int   iHeight = pcPicD->getHeight(ch) - ((m_pcEncTop->getPad(1) >> (pcPic->isField()?1:0)) >> pcPic->getComponentScaleY(ch));
 
-    Int   iSize   = iWidth*iHeight;
-
-    UInt64 uiSSDtemp=0;
-    for(Int y = 0; y < iHeight; y++ )
+    for(Int y0 = 0; y0 < iHeight; y0 += PSNR_STRIPE_HEIGHT )
     {
-      for(Int x = 0; x < iWidth; x++ )
-      {
-        Intermediate_Int iDiff = (Intermediate_Int)( pOrg[x] - pRec[x] );
-        uiSSDtemp   += iDiff * iDiff;
-      }
-      pOrg += iOrgStride;
-      pRec += iRecStride;
+      const Int numRows = std::min(PSNR_STRIPE_HEIGHT, iHeight - y0);
+      UInt64 &uiStripeSSD = stripeSSD[chan * numStripes + y0 / PSNR_STRIPE_HEIGHT];
+      ssdGroup.addTask( [&uiStripeSSD, pOrg, iOrgStride, pRec, iRecStride, iWidth, y0, numRows]( Int )
+                        {
+                          uiStripeSSD = getBlockSSD( pOrg + y0 * iOrgStride, iOrgStride, pRec + y0 * iRecStride, iRecStride, iWidth, numRows );
+                        },
+                        [&uiSSD, &uiStripeSSD, ch]()
+                        {
+                          uiSSD[ch] += uiStripeSSD;
+                        } );
     }
+  }
+  ssdGroup.wait();
+
+  for(Int chan=0; chan<pcPicD->getNumberValidComponents(); chan++)
+  {
+    const ComponentID ch=ComponentID(chan);
+    const Int   iWidth  = pcPicD->getWidth (ch) - (m_pcEncTop->getPad(0) >> pcPic->getComponentScaleX(ch));
+    const Int   iHeight = pcPicD->getHeight(ch) - ((m_pcEncTop->getPad(1) >> (pcPic->isField()?1:0)) >> pcPic->getComponentScaleY(ch));
+
+    Int   iSize   = iWidth*iHeight;
+
+    const UInt64 uiSSDtemp = uiSSD[ch];
     const Int maxval = 255 << (pcPic->getPicSym()->getSPS().getBitDepth(toChannelType(ch)) - 8);
     const Double fRefValue = (Double) maxval * maxval * iSize;
     dPSNR[ch]         = ( uiSSDtemp ? 10.0 * log10( fRefValue / (Double)uiSSDtemp ) : 999.99 );
@@ -2288,20 +2497,10 @@ Void TEncGOP::xCalculateInterlacedAddPSNR( TComPic* pcPicOrgFirstField, TComPic*
       TComPicYuv *pcPicD=apcPicRecFields[fieldNum];
 
       const Pel*  pOrg    = (conversion!=IPCOLOURSPACE_UNCHANGED) ? pcPic ->getPicYuvTrueOrg()->getAddr(ch) : pcPic ->getPicYuvOrg()->getAddr(ch);
-      Pel*  pRec    = pcPicD->getAddr(ch);
+      const Pel*  pRec    = pcPicD->getAddr(ch);
       const Int   iStride = pcPicD->getStride(ch);
 
-
-      for(Int y = 0; y < iHeight; y++ )
-      {
-        for(Int x = 0; x < iWidth; x++ )
-        {
-          Intermediate_Int iDiff = (Intermediate_Int)( pOrg[x] - pRec[x] );
-          uiSSDtemp   += iDiff * iDiff;
-        }
-        pOrg += iStride;
-        pRec += iStride;
-      }
+      uiSSDtemp += getBlockSSD( pOrg, iStride, pRec, iStride, iWidth, iHeight );
     }
     const Int maxval = 255 << (sps.getBitDepth(toChannelType(ch)) - 8);
     const Double fRefValue = (Double) maxval * maxval * iSize*2;
@@ -2730,7 +2929,7 @@ Void TEncGOP::applyDeblockingFilterParameterSelection( TComPic* pcPic, const UIn
         pcPic->getSlice(i)->setDeblockingFilterTcOffsetDiv2( tcOffsetDiv2 );
       }
       m_pcDeblockingTempPicYuv->copyToPic(pcPicYuvRec); // restore reconstruction
-      m_pcLoopFilter->loopFilterPic( pcPic );
+      m_pcLoopFilter->loopFilterPic( pcPic, m_pcEncTop->getThreadPool() );
       const UInt64 dist = xFindDistortionFrame(pcPicYuvOrg, pcPicYuvRec, pcPic->getPicSym()->getSPS().getBitDepths());
       if(dist < distMin)
       {
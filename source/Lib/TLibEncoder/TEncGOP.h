@@ -38,9 +38,11 @@
 #ifndef __TENCGOP__
 #define __TENCGOP__
 
+#include <deque>
 #include <list>
 
 #include <stdlib.h>
+#include <time.h>
 
 #include "TLibCommon/TComList.h"
 #include "TLibCommon/TComPic.h"
@@ -81,6 +83,32 @@ class TEncGOP
     Int accumNalsDU;
   };
 
+  /// picture whose compression has been started, and which has still to be filtered and written
+  class PictureInFlight
+  {
+  public:
+    PictureInFlight()
+    :iGOPid(0)
+    ,pcPic(NULL)
+    ,pcPicYuvRecOut(NULL)
+    ,pcAccessUnit(NULL)
+    ,uiNumSliceSegments(0)
+    ,iBeforeTime(0)
+    ,IRAPGOPid(0)
+    ,lambda(0.0)
+    ,estimatedBits(0) {};
+
+    Int          iGOPid;
+    TComPic*     pcPic;
+    TComPicYuv*  pcPicYuvRecOut;
+    AccessUnit*  pcAccessUnit;
+    UInt         uiNumSliceSegments;
+    clock_t      iBeforeTime;      ///< start of the encoding of the picture, for the time output
+    Int          IRAPGOPid;        ///< GOP index of the IRAP picture, for the picture timing SEI
+    Double       lambda;           ///< picture lambda estimated by the rate control
+    Int          estimatedBits;    ///< target bits of the rate control
+  };
+
 private:
 
   TEncAnalyze             m_gcAnalyzeAll;
@@ -168,6 +196,14 @@ protected:
 
   Void  xInitGOP          ( Int iPOCLast, Int iNumPicRcvd, Bool isField );
   Void  xGetBuffer        ( TComList<TComPic*>& rcListPic, TComList<TComPicYuv*>& rcListPicYuvRecOut, Int iNumPicRcvd, Int iTimeOffset, TComPic*& rpcPic, TComPicYuv*& rpcPicYuvRecOut, Int pocCurr, Bool isField );
+  Bool  xRefersToPicturesInFlight ( Int iGOPid, Int pocCurr, const std::deque<PictureInFlight>& picturesInFlight );
+  Void  xFinishPicture    ( const PictureInFlight& picture, TComList<TComPic*>& rcListPic, Bool isField, Bool isTff,
+                            const InputColourSpaceConversion snr_conversion, const Bool printFrameMSE, TComOutputBitstream* pcBitstreamRedirect,
+                            SEIMessages& leadingSeiMessages, SEIMessages& nestedSeiMessages, SEIMessages& duInfoSeiMessages,
+                            SEIMessages& trailingSeiMessages, std::deque<DUData>& duData );
+  /// the deblocking parameter selection needs the whole picture before deblocking
+  Bool  xUseRowLaggedLoopFilter () const { return m_pcCfg->getRowLaggedLoopFilter() && !m_pcCfg->getDeblockingFilterMetric(); }
+  Void  xLoopFilterCtuRows( TComPic* pcPic, Bool* sliceEnabled );
 
   Void  xCalculateAddPSNRs         ( const Bool isField, const Bool isFieldTopFieldFirst, const Int iGOPid, TComPic* pcPic, const AccessUnit&accessUnit, TComList<TComPic*> &rcListPic, Double dEncTime, const InputColourSpaceConversion snr_conversion, const Bool printFrameMSE );
   Void  xCalculateAddPSNR          ( TComPic* pcPic, TComPicYuv* pcPicD, const AccessUnit&, Double dEncTime, const InputColourSpaceConversion snr_conversion, const Bool printFrameMSE );
@@ -64,6 +64,9 @@ TEncSampleAdaptiveOffset::TEncSampleAdaptiveOffset()
   m_pppcBinCoderCABAC = NULL;
   m_statData = NULL;
   m_preDBFstatData = NULL;
+  m_reconParams = NULL;
+  m_allBlksDisabled = true;
+  m_totalCost = 0;
 }
 
 TEncSampleAdaptiveOffset::~TEncSampleAdaptiveOffset()
@@ -94,6 +97,8 @@ Void TEncSampleAdaptiveOffset::createEncData(Bool isPreDBFSamplesUsed)
   }
 
 
+  m_reconParams = new SAOBlkParam[m_numCTUsPic];
+
   //statistics
   m_statData = new SAOStatData**[m_numCTUsPic];
   for(Int i=0; i< m_numCTUsPic; i++)
@@ -204,6 +209,11 @@ Void TEncSampleAdaptiveOffset::destroyEncData()
     delete[] m_pppcBinCoderCABAC; m_pppcBinCoderCABAC = NULL;
   }
 
+  if(m_reconParams != NULL)
+  {
+    delete[] m_reconParams; m_reconParams = NULL;
+  }
+
   if(m_statData != NULL)
   {
     for(Int i=0; i< m_numCTUsPic; i++)
@@ -242,9 +252,9 @@ Void TEncSampleAdaptiveOffset::initRDOCabacCoder(TEncSbac* pcRDGoOnSbacCoder, TC
 
 
 #if OPTIONAL_RESET_SAO_ENCODING_AFTER_IRAP
-Void TEncSampleAdaptiveOffset::SAOProcess(TComPic* pPic, Bool* sliceEnabled, const Double *lambdas, const Bool bTestSAODisableAtPictureLevel, const Double saoEncodingRate, const Double saoEncodingRateChroma, const Bool isPreDBFSamplesUsed, const Bool bResetStateAfterIRAP )
+Void TEncSampleAdaptiveOffset::SAOProcess(TComPic* pPic, Bool* sliceEnabled, const Double *lambdas, const Bool bTestSAODisableAtPictureLevel, const Double saoEncodingRate, const Double saoEncodingRateChroma, const Bool isPreDBFSamplesUsed, const Bool bResetStateAfterIRAP, TComThreadPool* pcThreadPool )
 #else
-Void TEncSampleAdaptiveOffset::SAOProcess(TComPic* pPic, Bool* sliceEnabled, const Double *lambdas, const Bool bTestSAODisableAtPictureLevel, const Double saoEncodingRate, const Double saoEncodingRateChroma, Bool isPreDBFSamplesUsed )
+Void TEncSampleAdaptiveOffset::SAOProcess(TComPic* pPic, Bool* sliceEnabled, const Double *lambdas, const Bool bTestSAODisableAtPictureLevel, const Double saoEncodingRate, const Double saoEncodingRateChroma, Bool isPreDBFSamplesUsed, TComThreadPool* pcThreadPool )
 #endif
 {
   TComPicYuv* orgYuv= pPic->getPicYuvOrg();
@@ -256,7 +266,7 @@ Void TEncSampleAdaptiveOffset::SAOProcess(TComPic* pPic, Bool* sliceEnabled, con
   srcYuv->extendPicBorder();
 
   //collect statistics
-  getStatistics(m_statData, orgYuv, srcYuv, pPic);
+  getStatistics(m_statData, orgYuv, srcYuv, pPic, pcThreadPool);
   if(isPreDBFSamplesUsed)
   {
     addPreDBFStatistics(m_statData);
@@ -270,37 +280,156 @@ Void TEncSampleAdaptiveOffset::SAOProcess(TComPic* pPic, Bool* sliceEnabled, con
 #endif
 
   //block on/off
-  SAOBlkParam* reconParams = new SAOBlkParam[m_numCTUsPic]; //temporary parameter buffer for storing reconstructed SAO parameters
-  decideBlkParams(pPic, sliceEnabled, m_statData, srcYuv, resYuv, reconParams, pPic->getPicSym()->getSAOBlkParam(), bTestSAODisableAtPictureLevel, saoEncodingRate, saoEncodingRateChroma);
-  delete[] reconParams;
+  decideBlkParams(pPic, sliceEnabled, m_statData, srcYuv, resYuv, m_reconParams, pPic->getPicSym()->getSAOBlkParam(), bTestSAODisableAtPictureLevel, saoEncodingRate, saoEncodingRateChroma, pcThreadPool);
+}
+
+#if OPTIONAL_RESET_SAO_ENCODING_AFTER_IRAP
+Void TEncSampleAdaptiveOffset::startSAOCtuRows(TComPic* pPic, Bool* sliceEnabled, const Double *lambdas, const Double saoEncodingRate, const Double saoEncodingRateChroma, const Bool bResetStateAfterIRAP)
+#else
+Void TEncSampleAdaptiveOffset::startSAOCtuRows(TComPic* pPic, Bool* sliceEnabled, const Double *lambdas, const Double saoEncodingRate, const Double saoEncodingRateChroma)
+#endif
+{
+  memcpy(m_lambda, lambdas, sizeof(m_lambda));
+
+  //slice on/off, which only depends on the previous pictures
+#if OPTIONAL_RESET_SAO_ENCODING_AFTER_IRAP
+  decidePicParams(sliceEnabled, pPic, saoEncodingRate, saoEncodingRateChroma, bResetStateAfterIRAP);
+#else
+  decidePicParams(sliceEnabled, pPic->getSlice(0)->getDepth(), saoEncodingRate, saoEncodingRateChroma);
+#endif
+
+  xStartBlkParamDecision(sliceEnabled);
+}
+
+/** Statistics of the non-deblocked samples of a CTU row. They read the bottom line of the row above and the top line of
+ * the row below, so they have to be gathered before the vertical edges of the row above are deblocked.
+ */
+Void TEncSampleAdaptiveOffset::getPreDBFRowStatistics(TComPic* pPic, UInt ctuRow)
+{
+  for(Int ctuRsAddr = ctuRow*m_numCTUInWidth; ctuRsAddr < (ctuRow+1)*m_numCTUInWidth; ctuRsAddr++)
+  {
+    getCtuStats(m_preDBFstatData, pPic->getPicYuvOrg(), pPic->getPicYuvRec(), pPic, ctuRsAddr, true, 0);
+  }
+}
+
+/** Statistics and block decisions of a CTU row whose samples are final, and offsets of the row above.
+ * The deblocked statistics of a row do not read the bottom lines that the deblocking of the next row modifies, but the
+ * offsets of a row read the top line of the next row, hence the lag. Like in SAOProcess, the deblocked samples are read
+ * from a copy, as the offsets are written to the reconstruction.
+ */
+Void TEncSampleAdaptiveOffset::processDeblockedCtuRow(TComPic* pPic, Bool* sliceEnabled, UInt ctuRow, const Bool isPreDBFSamplesUsed)
+{
+  xCopyCtuRow(pPic->getPicYuvRec(), m_tempPicYuv, ctuRow);
+
+  for(Int ctuRsAddr = ctuRow*m_numCTUInWidth; ctuRsAddr < (ctuRow+1)*m_numCTUInWidth; ctuRsAddr++)
+  {
+    getCtuStats(m_statData, pPic->getPicYuvOrg(), m_tempPicYuv, pPic, ctuRsAddr, false, 0);
+    if(isPreDBFSamplesUsed)
+    {
+      addPreDBFStatistics(m_statData, ctuRsAddr);
+    }
+    xDecideCtuBlkParams(pPic, sliceEnabled, m_statData, m_reconParams, pPic->getPicSym()->getSAOBlkParam(), ctuRsAddr);
+  }
+
+  if(ctuRow > 0)
+  {
+    xOffsetCtuRow(pPic, ctuRow - 1);
+  }
+}
+
+Void TEncSampleAdaptiveOffset::finishSAOCtuRows(TComPic* pPic, Bool* sliceEnabled, const Bool bTestSAODisableAtPictureLevel, const Double saoEncodingRate, const Double saoEncodingRateChroma)
+{
+  xOffsetCtuRow(pPic, m_numCTUInHeight - 1);
+  xFinishBlkParamDecision(pPic, sliceEnabled, m_reconParams, pPic->getPicSym()->getSAOBlkParam(), bTestSAODisableAtPictureLevel, saoEncodingRate, saoEncodingRateChroma);
+}
+
+Void TEncSampleAdaptiveOffset::xCopyCtuRow(TComPicYuv* srcYuv, TComPicYuv* dstYuv, UInt ctuRow)
+{
+  const Int numberOfComponents = getNumberValidComponents(m_chromaFormatIDC);
+  for(Int compIdx = 0; compIdx < numberOfComponents; compIdx++)
+  {
+    const ComponentID component = ComponentID(compIdx);
+    const UInt componentScaleY  = getComponentScaleY(component, m_chromaFormatIDC);
+    const Int  startY           = (ctuRow*m_maxCUHeight) >> componentScaleY;
+    const Int  endY             = std::min((ctuRow+1)*m_maxCUHeight, (UInt)m_picHeight) >> componentScaleY;
+    const Int  width            = srcYuv->getWidth(component);
+    const Int  srcStride        = srcYuv->getStride(component);
+    const Int  dstStride        = dstYuv->getStride(component);
+    const Pel* src              = srcYuv->getAddr(component) + startY*srcStride;
+    Pel*       dst              = dstYuv->getAddr(component) + startY*dstStride;
+
+    for(Int y = startY; y < endY; y++)
+    {
+      ::memcpy(dst, src, sizeof(Pel)*width);
+      src += srcStride;
+      dst += dstStride;
+    }
+  }
 }
 
-Void TEncSampleAdaptiveOffset::getPreDBFStatistics(TComPic* pPic)
+Void TEncSampleAdaptiveOffset::xOffsetCtuRow(TComPic* pPic, UInt ctuRow)
 {
-  getStatistics(m_preDBFstatData, pPic->getPicYuvOrg(), pPic->getPicYuvRec(), pPic, true);
+  if(m_allBlksDisabled)
+  {
+    return;
+  }
+  for(Int ctuRsAddr = ctuRow*m_numCTUInWidth; ctuRsAddr < (ctuRow+1)*m_numCTUInWidth; ctuRsAddr++)
+  {
+    offsetCTU(ctuRsAddr, m_tempPicYuv, pPic->getPicYuvRec(), m_reconParams[ctuRsAddr], pPic);
+  }
+}
+
+Void TEncSampleAdaptiveOffset::getPreDBFStatistics(TComPic* pPic, TComThreadPool* pcThreadPool)
+{
+  getStatistics(m_preDBFstatData, pPic->getPicYuvOrg(), pPic->getPicYuvRec(), pPic, pcThreadPool, true);
 }
 
 Void TEncSampleAdaptiveOffset::addPreDBFStatistics(SAOStatData*** blkStats)
 {
   for(Int n=0; n< m_numCTUsPic; n++)
   {
-    for(Int compIdx=0; compIdx < MAX_NUM_COMPONENT; compIdx++)
+    addPreDBFStatistics(blkStats, n);
+  }
+}
+
+Void TEncSampleAdaptiveOffset::addPreDBFStatistics(SAOStatData*** blkStats, Int ctuRsAddr)
+{
+  for(Int compIdx=0; compIdx < MAX_NUM_COMPONENT; compIdx++)
+  {
+    for(Int typeIdc=0; typeIdc < NUM_SAO_NEW_TYPES; typeIdc++)
+    {
+      blkStats[ctuRsAddr][compIdx][typeIdc] += m_preDBFstatData[ctuRsAddr][compIdx][typeIdc];
+    }
+  }
+}
+
+/** Collect the statistics of all the CTUs of a picture, one task per CTU row.
+ * The statistics of a CTU only depend on its own samples and those around it, none of which are modified here.
+ */
+Void TEncSampleAdaptiveOffset::getStatistics(SAOStatData*** blkStats, TComPicYuv* orgYuv, TComPicYuv* srcYuv, TComPic* pPic, TComThreadPool* pcThreadPool, Bool isCalculatePreDeblockSamples)
+{
+  allocateLineBuffers(pcThreadPool != NULL ? std::max(pcThreadPool->getNumThreads(), 1) : 1);
+
+  TComTaskGroup rows(pcThreadPool);
+  for(Int ctuRow = 0; ctuRow < m_numCTUInHeight; ctuRow++)
+  {
+    rows.addTask([this, blkStats, orgYuv, srcYuv, pPic, isCalculatePreDeblockSamples, ctuRow](Int threadIdx)
     {
-      for(Int typeIdc=0; typeIdc < NUM_SAO_NEW_TYPES; typeIdc++)
+      for(Int ctuRsAddr = ctuRow*m_numCTUInWidth; ctuRsAddr < (ctuRow+1)*m_numCTUInWidth; ctuRsAddr++)
       {
-        blkStats[n][compIdx][typeIdc] += m_preDBFstatData[n][compIdx][typeIdc];
+        getCtuStats(blkStats, orgYuv, srcYuv, pPic, ctuRsAddr, isCalculatePreDeblockSamples, threadIdx);
       }
-    }
+    });
   }
+  rows.wait();
 }
 
-Void TEncSampleAdaptiveOffset::getStatistics(SAOStatData*** blkStats, TComPicYuv* orgYuv, TComPicYuv* srcYuv, TComPic* pPic, Bool isCalculatePreDeblockSamples)
+Void TEncSampleAdaptiveOffset::getCtuStats(SAOStatData*** blkStats, TComPicYuv* orgYuv, TComPicYuv* srcYuv, TComPic* pPic, Int ctuRsAddr, Bool isCalculatePreDeblockSamples, Int lineBufIdx)
 {
   Bool isLeftAvail,isRightAvail,isAboveAvail,isBelowAvail,isAboveLeftAvail,isAboveRightAvail,isBelowLeftAvail,isBelowRightAvail;
 
   const Int numberOfComponents = getNumberValidComponents(m_chromaFormatIDC);
 
-  for(Int ctuRsAddr= 0; ctuRsAddr < m_numCTUsPic; ctuRsAddr++)
   {
     Int yPos   = (ctuRsAddr / m_numCTUInWidth)*m_maxCUHeight;
     Int xPos   = (ctuRsAddr % m_numCTUInWidth)*m_maxCUWidth;
@@ -335,6 +464,7 @@ Void TEncSampleAdaptiveOffset::getStatistics(SAOStatData*** blkStats, TComPicYuv
                 , srcBlk, orgBlk, srcStride, orgStride, (width  >> componentScaleX), (height >> componentScaleY)
                 , isLeftAvail,  isRightAvail, isAboveAvail, isBelowAvail, isAboveLeftAvail, isAboveRightAvail
                 , isCalculatePreDeblockSamples
+                , lineBufIdx
                 );
 
     }
@@ -797,88 +927,114 @@ Void TEncSampleAdaptiveOffset::deriveModeMergeRDO(const BitDepths &bitDepths, In
 
 Void TEncSampleAdaptiveOffset::decideBlkParams(TComPic* pic, Bool* sliceEnabled, SAOStatData*** blkStats, TComPicYuv* srcYuv, TComPicYuv* resYuv,
                                                SAOBlkParam* reconParams, SAOBlkParam* codedParams, const Bool bTestSAODisableAtPictureLevel,
-                                               const Double saoEncodingRate, const Double saoEncodingRateChroma)
+                                               const Double saoEncodingRate, const Double saoEncodingRateChroma, TComThreadPool* pcThreadPool)
+{
+  xStartBlkParamDecision(sliceEnabled);
+
+  for(Int ctuRsAddr=0; ctuRsAddr< m_numCTUsPic; ctuRsAddr++)
+  {
+    xDecideCtuBlkParams(pic, sliceEnabled, blkStats, reconParams, codedParams, ctuRsAddr);
+  } //ctuRsAddr
+
+  //apply reconstructed offsets, once all the CTUs are decided
+  if (!m_allBlksDisabled)
+  {
+    offsetCTUs(pic, srcYuv, resYuv, reconParams, pcThreadPool);
+  }
+
+  xFinishBlkParamDecision(pic, sliceEnabled, reconParams, codedParams, bTestSAODisableAtPictureLevel, saoEncodingRate, saoEncodingRateChroma);
+}
+
+Void TEncSampleAdaptiveOffset::xStartBlkParamDecision(Bool* sliceEnabled)
 {
-  Bool allBlksDisabled = true;
+  m_allBlksDisabled = true;
   const Int numberOfComponents = getNumberValidComponents(m_chromaFormatIDC);
   for(Int compId = COMPONENT_Y; compId < numberOfComponents; compId++)
   {
     if (sliceEnabled[compId])
     {
-      allBlksDisabled = false;
+      m_allBlksDisabled = false;
     }
   }
 
   m_pcRDGoOnSbacCoder->load(m_pppcRDSbacCoder[ SAO_CABACSTATE_PIC_INIT ]);
 
+  m_totalCost = 0;
+}
+
+/** Decision of the parameters of a CTU. The CTUs have to be decided in raster-scan order, as the merge candidates and the
+ * CABAC state depend on the CTUs before.
+ */
+Void TEncSampleAdaptiveOffset::xDecideCtuBlkParams(TComPic* pic, Bool* sliceEnabled, SAOStatData*** blkStats, SAOBlkParam* reconParams, SAOBlkParam* codedParams, Int ctuRsAddr)
+{
+  if(m_allBlksDisabled)
+  {
+    codedParams[ctuRsAddr].reset();
+    reconParams[ctuRsAddr].reset();
+    return;
+  }
+
   SAOBlkParam modeParam;
   Double minCost, modeCost;
 
+  m_pcRDGoOnSbacCoder->store(m_pppcRDSbacCoder[ SAO_CABACSTATE_BLK_CUR ]);
 
-  Double totalCost = 0; // Used if bTestSAODisableAtPictureLevel==true
+  //get merge list
+  SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES] = { NULL };
+  getMergeList(pic, ctuRsAddr, reconParams, mergeList);
 
-  for(Int ctuRsAddr=0; ctuRsAddr< m_numCTUsPic; ctuRsAddr++)
+  minCost = MAX_DOUBLE;
+  for(Int mode=0; mode < NUM_SAO_MODES; mode++)
   {
-    if(allBlksDisabled)
-    {
-      codedParams[ctuRsAddr].reset();
-      continue;
-    }
-
-    m_pcRDGoOnSbacCoder->store(m_pppcRDSbacCoder[ SAO_CABACSTATE_BLK_CUR ]);
-
-    //get merge list
-    SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES] = { NULL };
-    getMergeList(pic, ctuRsAddr, reconParams, mergeList);
-
-    minCost = MAX_DOUBLE;
-    for(Int mode=0; mode < NUM_SAO_MODES; mode++)
+    switch(mode)
     {
-      switch(mode)
+    case SAO_MODE_OFF:
       {
-      case SAO_MODE_OFF:
-        {
-          continue; //not necessary, since all-off case will be tested in SAO_MODE_NEW case.
-        }
-        break;
-      case SAO_MODE_NEW:
-        {
-          deriveModeNewRDO(pic->getPicSym()->getSPS().getBitDepths(), ctuRsAddr, mergeList, sliceEnabled, blkStats, modeParam, modeCost, m_pppcRDSbacCoder, SAO_CABACSTATE_BLK_CUR);
-
-        }
-        break;
-      case SAO_MODE_MERGE:
-        {
-          deriveModeMergeRDO(pic->getPicSym()->getSPS().getBitDepths(), ctuRsAddr, mergeList, sliceEnabled, blkStats , modeParam, modeCost, m_pppcRDSbacCoder, SAO_CABACSTATE_BLK_CUR);
-        }
-        break;
-      default:
-        {
-          printf("Not a supported SAO mode\n");
-          assert(0);
-          exit(-1);
-        }
+        continue; //not necessary, since all-off case will be tested in SAO_MODE_NEW case.
       }
+      break;
+    case SAO_MODE_NEW:
+      {
+        deriveModeNewRDO(pic->getPicSym()->getSPS().getBitDepths(), ctuRsAddr, mergeList, sliceEnabled, blkStats, modeParam, modeCost, m_pppcRDSbacCoder, SAO_CABACSTATE_BLK_CUR);
 
-      if(modeCost < minCost)
+      }
+      break;
+    case SAO_MODE_MERGE:
+      {
+        deriveModeMergeRDO(pic->getPicSym()->getSPS().getBitDepths(), ctuRsAddr, mergeList, sliceEnabled, blkStats , modeParam, modeCost, m_pppcRDSbacCoder, SAO_CABACSTATE_BLK_CUR);
+      }
+      break;
+    default:
       {
-        minCost = modeCost;
-        codedParams[ctuRsAddr] = modeParam;
-        m_pcRDGoOnSbacCoder->store(m_pppcRDSbacCoder[ SAO_CABACSTATE_BLK_NEXT ]);
+        printf("Not a supported SAO mode\n");
+        assert(0);
+        exit(-1);
       }
-    } //mode
+    }
 
-    totalCost += minCost;
+    if(modeCost < minCost)
+    {
+      minCost = modeCost;
+      codedParams[ctuRsAddr] = modeParam;
+      m_pcRDGoOnSbacCoder->store(m_pppcRDSbacCoder[ SAO_CABACSTATE_BLK_NEXT ]);
+    }
+  } //mode
 
-    m_pcRDGoOnSbacCoder->load(m_pppcRDSbacCoder[ SAO_CABACSTATE_BLK_NEXT ]);
+  m_totalCost += minCost;
 
-    //apply reconstructed offsets
-    reconParams[ctuRsAddr] = codedParams[ctuRsAddr];
-    reconstructBlkSAOParam(reconParams[ctuRsAddr], mergeList);
-    offsetCTU(ctuRsAddr, srcYuv, resYuv, reconParams[ctuRsAddr], pic);
-  } //ctuRsAddr
+  m_pcRDGoOnSbacCoder->load(m_pppcRDSbacCoder[ SAO_CABACSTATE_BLK_NEXT ]);
+
+  //reconstruct the offsets
+  reconParams[ctuRsAddr] = codedParams[ctuRsAddr];
+  reconstructBlkSAOParam(reconParams[ctuRsAddr], mergeList);
+}
+
+Void TEncSampleAdaptiveOffset::xFinishBlkParamDecision(TComPic* pic, Bool* sliceEnabled, SAOBlkParam* reconParams, SAOBlkParam* codedParams, const Bool bTestSAODisableAtPictureLevel,
+                                                       const Double saoEncodingRate, const Double saoEncodingRateChroma)
+{
+  const Int numberOfComponents = getNumberValidComponents(m_chromaFormatIDC);
 
-  if (!allBlksDisabled && (totalCost >= 0) && bTestSAODisableAtPictureLevel) //SAO has not beneficial in this case - disable it
+  if (!m_allBlksDisabled && (m_totalCost >= 0) && bTestSAODisableAtPictureLevel) //SAO has not beneficial in this case - disable it
   {
     for(Int ctuRsAddr = 0; ctuRsAddr < m_numCTUsPic; ctuRsAddr++)
     {
@@ -928,26 +1084,12 @@ Void TEncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int
                         , Pel* srcBlk, Pel* orgBlk, Int srcStride, Int orgStride, Int width, Int height
                         , Bool isLeftAvail,  Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail
                         , Bool isCalculatePreDeblockSamples
+                        , Int lineBufIdx
                         )
 {
-  if(m_lineBufWidth != m_maxCUWidth)
-  {
-    m_lineBufWidth = m_maxCUWidth;
-
-    if (m_signLineBuf1)
-    {
-      delete[] m_signLineBuf1;
-      m_signLineBuf1 = NULL;
-    }
-    m_signLineBuf1 = new SChar[m_lineBufWidth+1];
-
-    if (m_signLineBuf2)
-    {
-      delete[] m_signLineBuf2;
-      m_signLineBuf2 = NULL;
-    }
-    m_signLineBuf2 = new SChar[m_lineBufWidth+1];
-  }
+  // the buffers of the calling thread, see allocateLineBuffers
+  SChar* signLineBuf1 = m_signLineBuf1 + lineBufIdx * (m_lineBufWidth + 1);
+  SChar* signLineBuf2 = m_signLineBuf2 + lineBufIdx * (m_lineBufWidth + 1);
 
   Int x,y, startX, startY, endX, endY, edgeType, firstLineStartX, firstLineEndX;
   SChar signLeft, signRight, signDown;
@@ -1023,7 +1165,7 @@ Void TEncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int
       {
         diff +=2;
         count+=2;
-        SChar *signUpLine = m_signLineBuf1;
+        SChar *signUpLine = signLineBuf1;
 
         startX = (!isCalculatePreDeblockSamples) ? 0
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : width)
@@ -1094,8 +1236,8 @@ Void TEncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int
         count+=2;
         SChar *signUpLine, *signDownLine, *signTmpLine;
 
-        signUpLine  = m_signLineBuf1;
-        signDownLine= m_signLineBuf2;
+        signUpLine  = signLineBuf1;
+        signDownLine= signLineBuf2;
 
         startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
@@ -1179,7 +1321,7 @@ Void TEncSampleAdaptiveOffset::getBlkStats(const ComponentID compIdx, const Int
       {
         diff +=2;
         count+=2;
-        SChar *signUpLine = m_signLineBuf1+1;
+        SChar *signUpLine = signLineBuf1+1;
 
         startX = (!isCalculatePreDeblockSamples) ? (isLeftAvail  ? 0 : 1)
                                                  : (isRightAvail ? (width - skipLinesR[typeIdx]) : (width - 1))
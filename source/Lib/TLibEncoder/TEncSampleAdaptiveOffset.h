@@ -103,21 +103,39 @@ public:
   Void destroyEncData();
   Void initRDOCabacCoder(TEncSbac* pcRDGoOnSbacCoder, TComSlice* pcSlice) ;
 #if OPTIONAL_RESET_SAO_ENCODING_AFTER_IRAP
-  Void SAOProcess(TComPic* pPic, Bool* sliceEnabled, const Double *lambdas, const Bool bTestSAODisableAtPictureLevel, const Double saoEncodingRate, const Double saoEncodingRateChroma, const Bool isPreDBFSamplesUsed, const Bool bResetStateAfterIRAP);
+  Void SAOProcess(TComPic* pPic, Bool* sliceEnabled, const Double *lambdas, const Bool bTestSAODisableAtPictureLevel, const Double saoEncodingRate, const Double saoEncodingRateChroma, const Bool isPreDBFSamplesUsed, const Bool bResetStateAfterIRAP, TComThreadPool* pcThreadPool = NULL);
 #else
-  Void SAOProcess(TComPic* pPic, Bool* sliceEnabled, const Double *lambdas, const Bool bTestSAODisableAtPictureLevel, const Double saoEncodingRate, const Double saoEncodingRateChroma, Bool isPreDBFSamplesUsed);
+  Void SAOProcess(TComPic* pPic, Bool* sliceEnabled, const Double *lambdas, const Bool bTestSAODisableAtPictureLevel, const Double saoEncodingRate, const Double saoEncodingRateChroma, Bool isPreDBFSamplesUsed, TComThreadPool* pcThreadPool = NULL);
 #endif
 public: //methods
-  Void getPreDBFStatistics(TComPic* pPic);
+  Void getPreDBFStatistics(TComPic* pPic, TComThreadPool* pcThreadPool = NULL);
+
+  // SAO of a picture whose CTU rows are filtered one after the other, as they are compressed: startSAOCtuRows, then, for each
+  // CTU row in order, getPreDBFRowStatistics (if used) before the row is deblocked and processDeblockedCtuRow once its
+  // deblocking is complete, and finally finishSAOCtuRows. The result is the same as the one of SAOProcess.
+#if OPTIONAL_RESET_SAO_ENCODING_AFTER_IRAP
+  Void startSAOCtuRows(TComPic* pPic, Bool* sliceEnabled, const Double *lambdas, const Double saoEncodingRate, const Double saoEncodingRateChroma, const Bool bResetStateAfterIRAP);
+#else
+  Void startSAOCtuRows(TComPic* pPic, Bool* sliceEnabled, const Double *lambdas, const Double saoEncodingRate, const Double saoEncodingRateChroma);
+#endif
+  Void getPreDBFRowStatistics(TComPic* pPic, UInt ctuRow);
+  Void processDeblockedCtuRow(TComPic* pPic, Bool* sliceEnabled, UInt ctuRow, const Bool isPreDBFSamplesUsed);
+  Void finishSAOCtuRows(TComPic* pPic, Bool* sliceEnabled, const Bool bTestSAODisableAtPictureLevel, const Double saoEncodingRate, const Double saoEncodingRateChroma);
 private: //methods
-  Void getStatistics(SAOStatData*** blkStats, TComPicYuv* orgYuv, TComPicYuv* srcYuv,TComPic* pPic, Bool isCalculatePreDeblockSamples = false);
+  Void getStatistics(SAOStatData*** blkStats, TComPicYuv* orgYuv, TComPicYuv* srcYuv,TComPic* pPic, TComThreadPool* pcThreadPool, Bool isCalculatePreDeblockSamples = false);
 #if OPTIONAL_RESET_SAO_ENCODING_AFTER_IRAP
   Void decidePicParams(Bool* sliceEnabled, const TComPic* pic, const Double saoEncodingRate, const Double saoEncodingRateChroma, const Bool bResetStateAfterIRAP);
 #else
   Void decidePicParams(Bool* sliceEnabled, Int picTempLayer, const Double saoEncodingRate, const Double saoEncodingRateChroma);
 #endif
-  Void decideBlkParams(TComPic* pic, Bool* sliceEnabled, SAOStatData*** blkStats, TComPicYuv* srcYuv, TComPicYuv* resYuv, SAOBlkParam* reconParams, SAOBlkParam* codedParams, const Bool bTestSAODisableAtPictureLevel, const Double saoEncodingRate, const Double saoEncodingRateChroma);
-  Void getBlkStats(const ComponentID compIdx, const Int channelBitDepth, SAOStatData* statsDataTypes, Pel* srcBlk, Pel* orgBlk, Int srcStride, Int orgStride, Int width, Int height, Bool isLeftAvail,  Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail, Bool isCalculatePreDeblockSamples);
+  Void decideBlkParams(TComPic* pic, Bool* sliceEnabled, SAOStatData*** blkStats, TComPicYuv* srcYuv, TComPicYuv* resYuv, SAOBlkParam* reconParams, SAOBlkParam* codedParams, const Bool bTestSAODisableAtPictureLevel, const Double saoEncodingRate, const Double saoEncodingRateChroma, TComThreadPool* pcThreadPool);
+  Void xStartBlkParamDecision(Bool* sliceEnabled);
+  Void xDecideCtuBlkParams(TComPic* pic, Bool* sliceEnabled, SAOStatData*** blkStats, SAOBlkParam* reconParams, SAOBlkParam* codedParams, Int ctuRsAddr);
+  Void xFinishBlkParamDecision(TComPic* pic, Bool* sliceEnabled, SAOBlkParam* reconParams, SAOBlkParam* codedParams, const Bool bTestSAODisableAtPictureLevel, const Double saoEncodingRate, const Double saoEncodingRateChroma);
+  Void xCopyCtuRow(TComPicYuv* srcYuv, TComPicYuv* dstYuv, UInt ctuRow);
+  Void xOffsetCtuRow(TComPic* pPic, UInt ctuRow);
+  Void getCtuStats(SAOStatData*** blkStats, TComPicYuv* orgYuv, TComPicYuv* srcYuv, TComPic* pPic, Int ctuRsAddr, Bool isCalculatePreDeblockSamples, Int lineBufIdx);
+  Void getBlkStats(const ComponentID compIdx, const Int channelBitDepth, SAOStatData* statsDataTypes, Pel* srcBlk, Pel* orgBlk, Int srcStride, Int orgStride, Int width, Int height, Bool isLeftAvail,  Bool isRightAvail, Bool isAboveAvail, Bool isBelowAvail, Bool isAboveLeftAvail, Bool isAboveRightAvail, Bool isCalculatePreDeblockSamples, Int lineBufIdx);
   Void deriveModeNewRDO(const BitDepths &bitDepths, Int ctuRsAddr, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES], Bool* sliceEnabled, SAOStatData*** blkStats, SAOBlkParam& modeParam, Double& modeNormCost, TEncSbac** cabacCoderRDO, Int inCabacLabel);
   Void deriveModeMergeRDO(const BitDepths &bitDepths, Int ctuRsAddr, SAOBlkParam* mergeList[NUM_SAO_MERGE_TYPES], Bool* sliceEnabled, SAOStatData*** blkStats, SAOBlkParam& modeParam, Double& modeNormCost, TEncSbac** cabacCoderRDO, Int inCabacLabel);
   Int64 getDistortion(const Int channelBitDepth, Int typeIdc, Int typeAuxInfo, Int* offsetVal, SAOStatData& statData);
@@ -125,6 +143,7 @@ private: //methods
   inline Int64 estSaoDist(Int64 count, Int64 offset, Int64 diffSum, Int shift);
   inline Int estIterOffset(Int typeIdx, Double lambda, Int offsetInput, Int64 count, Int64 diffSum, Int shift, Int bitIncrease, Int64& bestDist, Double& bestCost, Int offsetTh );
   Void addPreDBFStatistics(SAOStatData*** blkStats);
+  Void addPreDBFStatistics(SAOStatData*** blkStats, Int ctuRsAddr);
 private: //members
   //for RDO
   TEncSbac**             m_pppcRDSbacCoder;
@@ -136,6 +155,11 @@ private: //members
 #endif
   Double                 m_lambda[MAX_NUM_COMPONENT];
 
+  //block decision of the current picture
+  SAOBlkParam*           m_reconParams; //[ctu] reconstructed parameters, merges resolved
+  Bool                   m_allBlksDisabled;
+  Double                 m_totalCost;   //used if bTestSAODisableAtPictureLevel==true
+
   //statistics
   SAOStatData***         m_statData; //[ctu][comp][classes]
   SAOStatData***         m_preDBFstatData;
@@ -58,6 +58,9 @@ TEncSbac::TEncSbac()
 // new structure here
 : m_pcBitIf                            ( NULL )
 , m_pcBinIf                            ( NULL )
+#if FAST_BIT_EST
+, m_pcBinCounter                       ( NULL )
+#endif
 , m_numContextModels                   ( 0 )
 , m_cCUSplitFlagSCModel                ( 1,             1,                      NUM_SPLIT_FLAG_CTX                   , m_contextModels + m_numContextModels, m_numContextModels)
 , m_cCUSkipFlagSCModel                 ( 1,             1,                      NUM_SKIP_FLAG_CTX                    , m_contextModels + m_numContextModels, m_numContextModels)
@@ -252,7 +255,7 @@ Void TEncSbac::codeTilesWPPEntryPoint( TComSlice* /*pSlice*/ )
 
 Void TEncSbac::codeTerminatingBit( UInt uilsLast )
 {
-  m_pcBinIf->encodeBinTrm( uilsLast );
+  xEncodeBinTrm( uilsLast );
 }
 
 Void TEncSbac::codeSliceFinish()
@@ -262,7 +265,7 @@ Void TEncSbac::codeSliceFinish()
 
 Void TEncSbac::xWriteUnarySymbol( UInt uiSymbol, ContextModel* pcSCModel, Int iOffset )
 {
-  m_pcBinIf->encodeBin( uiSymbol ? 1 : 0, pcSCModel[0] );
+  xEncodeBin( uiSymbol ? 1 : 0, pcSCModel[0] );
 
   if( 0 == uiSymbol)
   {
@@ -271,7 +274,7 @@ Void TEncSbac::xWriteUnarySymbol( UInt uiSymbol, ContextModel* pcSCModel, Int iO
 
   while( uiSymbol-- )
   {
-    m_pcBinIf->encodeBin( uiSymbol ? 1 : 0, pcSCModel[ iOffset ] );
+    xEncodeBin( uiSymbol ? 1 : 0, pcSCModel[ iOffset ] );
   }
 
   return;
@@ -284,7 +287,7 @@ Void TEncSbac::xWriteUnaryMaxSymbol( UInt uiSymbol, ContextModel* pcSCModel, Int
     return;
   }
 
-  m_pcBinIf->encodeBin( uiSymbol ? 1 : 0, pcSCModel[ 0 ] );
+  xEncodeBin( uiSymbol ? 1 : 0, pcSCModel[ 0 ] );
 
   if ( uiSymbol == 0 )
   {
@@ -295,11 +298,11 @@ Void TEncSbac::xWriteUnaryMaxSymbol( UInt uiSymbol, ContextModel* pcSCModel, Int
 
   while( --uiSymbol )
   {
-    m_pcBinIf->encodeBin( 1, pcSCModel[ iOffset ] );
+    xEncodeBin( 1, pcSCModel[ iOffset ] );
   }
   if( bCodeLast )
   {
-    m_pcBinIf->encodeBin( 0, pcSCModel[ iOffset ] );
+    xEncodeBin( 0, pcSCModel[ iOffset ] );
   }
 
   return;
@@ -324,17 +327,21 @@ Void TEncSbac::xWriteEpExGolomb( UInt uiSymbol, UInt uiCount )
   numBins += uiCount;
 
   assert( numBins <= 32 );
-  m_pcBinIf->encodeBinsEP( bins, numBins );
+  xEncodeBinsEP( bins, numBins );
 }
 
 
-/** Coding of coeff_abs_level_minus3
- * \param symbol                  value of coeff_abs_level_minus3
- * \param rParam                  reference to Rice parameter
+/** Bins of the Golomb-Rice/Exp-Golomb code of coeff_abs_level_remaining
+ * \param symbol                  value of coeff_abs_level_remaining
+ * \param rParam                  Rice parameter
  * \param useLimitedPrefixLength
- * \param maxLog2TrDynamicRange 
+ * \param maxLog2TrDynamicRange
+ * \param rPrefix                 returns the prefix bins
+ * \param rPrefixLength           returns the number of prefix bins
+ * \param rSuffix                 returns the separator, suffix and rParam bins
+ * \param rSuffixLength           returns the number of separator, suffix and rParam bins
  */
-Void TEncSbac::xWriteCoefRemainExGolomb ( UInt symbol, UInt &rParam, const Bool useLimitedPrefixLength, const Int maxLog2TrDynamicRange )
+Void TEncSbac::xGetCoefRemainExGolombCode ( UInt symbol, UInt rParam, const Bool useLimitedPrefixLength, const Int maxLog2TrDynamicRange, UInt &rPrefix, UInt &rPrefixLength, UInt &rSuffix, UInt &rSuffixLength ) const
 {
   Int codeNumber  = (Int)symbol;
   UInt length;
@@ -342,8 +349,10 @@ Void TEncSbac::xWriteCoefRemainExGolomb ( UInt symbol, UInt &rParam, const Bool
   if (codeNumber < (COEF_REMAIN_BIN_REDUCTION << rParam))
   {
     length = codeNumber>>rParam;
-    m_pcBinIf->encodeBinsEP( (1<<(length+1))-2 , length+1);
-    m_pcBinIf->encodeBinsEP((codeNumber%(1<<rParam)),rParam);
+    rPrefix       = (1<<(length+1))-2;
+    rPrefixLength = length+1;
+    rSuffix       = codeNumber%(1<<rParam);
+    rSuffixLength = rParam;
   }
   else if (useLimitedPrefixLength)
   {
@@ -371,11 +380,12 @@ Void TEncSbac::xWriteCoefRemainExGolomb ( UInt symbol, UInt &rParam, const Bool
     const UInt suffix = codeValue - ((1 << prefixLength) - 1);
 
     const UInt totalPrefixLength = prefixLength + COEF_REMAIN_BIN_REDUCTION;
-    const UInt prefix            = (1 << totalPrefixLength) - 1;
     const UInt rParamBitMask     = (1 << rParam) - 1;
 
-    m_pcBinIf->encodeBinsEP(  prefix,                                        totalPrefixLength      ); //prefix
-    m_pcBinIf->encodeBinsEP(((suffix << rParam) | (symbol & rParamBitMask)), (suffixLength + rParam)); //separator, suffix, and rParam bits
+    rPrefix       = (1 << totalPrefixLength) - 1;                  //prefix
+    rPrefixLength = totalPrefixLength;
+    rSuffix       = (suffix << rParam) | (symbol & rParamBitMask); //separator, suffix, and rParam bits
+    rSuffixLength = suffixLength + rParam;
   }
   else
   {
@@ -387,11 +397,45 @@ Void TEncSbac::xWriteCoefRemainExGolomb ( UInt symbol, UInt &rParam, const Bool
       codeNumber -=  (1<<(length++));
     }
 
-    m_pcBinIf->encodeBinsEP((1<<(COEF_REMAIN_BIN_REDUCTION+length+1-rParam))-2,COEF_REMAIN_BIN_REDUCTION+length+1-rParam);
-    m_pcBinIf->encodeBinsEP(codeNumber,length);
+    rPrefix       = (1<<(COEF_REMAIN_BIN_REDUCTION+length+1-rParam))-2;
+    rPrefixLength = COEF_REMAIN_BIN_REDUCTION+length+1-rParam;
+    rSuffix       = codeNumber;
+    rSuffixLength = length;
   }
 }
 
+/** Coding of coeff_abs_level_minus3
+ * \param symbol                  value of coeff_abs_level_minus3
+ * \param rParam                  reference to Rice parameter
+ * \param useLimitedPrefixLength
+ * \param maxLog2TrDynamicRange 
+ */
+Void TEncSbac::xWriteCoefRemainExGolomb ( UInt symbol, UInt &rParam, const Bool useLimitedPrefixLength, const Int maxLog2TrDynamicRange )
+{
+  UInt prefix, prefixLength, suffix, suffixLength;
+  xGetCoefRemainExGolombCode( symbol, rParam, useLimitedPrefixLength, maxLog2TrDynamicRange, prefix, prefixLength, suffix, suffixLength );
+
+  xEncodeBinsEP( prefix, prefixLength );
+  xEncodeBinsEP( suffix, suffixLength );
+}
+
+#if FAST_BIT_EST
+/** Number of bypass bins used by xWriteCoefRemainExGolomb to code coeff_abs_level_remaining
+ * \param symbol                  value of coeff_abs_level_remaining
+ * \param rParam                  Rice parameter
+ * \param useLimitedPrefixLength
+ * \param maxLog2TrDynamicRange
+ * \returns number of bins
+ */
+UInt TEncSbac::xGetCoefRemainExGolombNumBins ( UInt symbol, UInt rParam, const Bool useLimitedPrefixLength, const Int maxLog2TrDynamicRange ) const
+{
+  UInt prefix, prefixLength, suffix, suffixLength;
+  xGetCoefRemainExGolombCode( symbol, rParam, useLimitedPrefixLength, maxLog2TrDynamicRange, prefix, prefixLength, suffix, suffixLength );
+
+  return prefixLength + suffixLength;
+}
+#endif
+
 // SBAC RD
 Void  TEncSbac::load ( const TEncSbac* pSrc)
 {
@@ -441,7 +485,7 @@ Void TEncSbac::codePartSize( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiDepth )
   {
     if( uiDepth == log2DiffMaxMinCodingBlockSize )
     {
-      m_pcBinIf->encodeBin( eSize == SIZE_2Nx2N? 1 : 0, m_cCUPartSizeSCModel.get( 0, 0, 0 ) );
+      xEncodeBin( eSize == SIZE_2Nx2N? 1 : 0, m_cCUPartSizeSCModel.get( 0, 0, 0 ) );
     }
     return;
   }
@@ -450,25 +494,25 @@ Void TEncSbac::codePartSize( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiDepth )
   {
     case SIZE_2Nx2N:
     {
-      m_pcBinIf->encodeBin( 1, m_cCUPartSizeSCModel.get( 0, 0, 0) );
+      xEncodeBin( 1, m_cCUPartSizeSCModel.get( 0, 0, 0) );
       break;
     }
     case SIZE_2NxN:
     case SIZE_2NxnU:
     case SIZE_2NxnD:
     {
-      m_pcBinIf->encodeBin( 0, m_cCUPartSizeSCModel.get( 0, 0, 0) );
-      m_pcBinIf->encodeBin( 1, m_cCUPartSizeSCModel.get( 0, 0, 1) );
+      xEncodeBin( 0, m_cCUPartSizeSCModel.get( 0, 0, 0) );
+      xEncodeBin( 1, m_cCUPartSizeSCModel.get( 0, 0, 1) );
       if ( pcCU->getSlice()->getSPS()->getUseAMP() && uiDepth < log2DiffMaxMinCodingBlockSize )
       {
         if (eSize == SIZE_2NxN)
         {
-          m_pcBinIf->encodeBin(1, m_cCUPartSizeSCModel.get( 0, 0, 3 ));
+          xEncodeBin(1, m_cCUPartSizeSCModel.get( 0, 0, 3 ));
         }
         else
         {
-          m_pcBinIf->encodeBin(0, m_cCUPartSizeSCModel.get( 0, 0, 3 ));
-          m_pcBinIf->encodeBinEP((eSize == SIZE_2NxnU? 0: 1));
+          xEncodeBin(0, m_cCUPartSizeSCModel.get( 0, 0, 3 ));
+          xEncodeBinEP((eSize == SIZE_2NxnU? 0: 1));
         }
       }
       break;
@@ -477,24 +521,24 @@ Void TEncSbac::codePartSize( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiDepth )
     case SIZE_nLx2N:
     case SIZE_nRx2N:
     {
-      m_pcBinIf->encodeBin( 0, m_cCUPartSizeSCModel.get( 0, 0, 0) );
-      m_pcBinIf->encodeBin( 0, m_cCUPartSizeSCModel.get( 0, 0, 1) );
+      xEncodeBin( 0, m_cCUPartSizeSCModel.get( 0, 0, 0) );
+      xEncodeBin( 0, m_cCUPartSizeSCModel.get( 0, 0, 1) );
 
       if( uiDepth == log2DiffMaxMinCodingBlockSize && !( pcCU->getWidth(uiAbsPartIdx) == 8 && pcCU->getHeight(uiAbsPartIdx) == 8 ) )
       {
-        m_pcBinIf->encodeBin( 1, m_cCUPartSizeSCModel.get( 0, 0, 2) );
+        xEncodeBin( 1, m_cCUPartSizeSCModel.get( 0, 0, 2) );
       }
 
       if ( pcCU->getSlice()->getSPS()->getUseAMP() && uiDepth < log2DiffMaxMinCodingBlockSize )
       {
         if (eSize == SIZE_Nx2N)
         {
-          m_pcBinIf->encodeBin(1, m_cCUPartSizeSCModel.get( 0, 0, 3 ));
+          xEncodeBin(1, m_cCUPartSizeSCModel.get( 0, 0, 3 ));
         }
         else
         {
-          m_pcBinIf->encodeBin(0, m_cCUPartSizeSCModel.get( 0, 0, 3 ));
-          m_pcBinIf->encodeBinEP((eSize == SIZE_nLx2N? 0: 1));
+          xEncodeBin(0, m_cCUPartSizeSCModel.get( 0, 0, 3 ));
+          xEncodeBinEP((eSize == SIZE_nLx2N? 0: 1));
         }
       }
       break;
@@ -503,9 +547,9 @@ Void TEncSbac::codePartSize( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiDepth )
     {
       if( uiDepth == log2DiffMaxMinCodingBlockSize && !( pcCU->getWidth(uiAbsPartIdx) == 8 && pcCU->getHeight(uiAbsPartIdx) == 8 ) )
       {
-        m_pcBinIf->encodeBin( 0, m_cCUPartSizeSCModel.get( 0, 0, 0) );
-        m_pcBinIf->encodeBin( 0, m_cCUPartSizeSCModel.get( 0, 0, 1) );
-        m_pcBinIf->encodeBin( 0, m_cCUPartSizeSCModel.get( 0, 0, 2) );
+        xEncodeBin( 0, m_cCUPartSizeSCModel.get( 0, 0, 0) );
+        xEncodeBin( 0, m_cCUPartSizeSCModel.get( 0, 0, 1) );
+        xEncodeBin( 0, m_cCUPartSizeSCModel.get( 0, 0, 2) );
       }
       break;
     }
@@ -526,13 +570,13 @@ Void TEncSbac::codePartSize( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiDepth )
 Void TEncSbac::codePredMode( TComDataCU* pcCU, UInt uiAbsPartIdx )
 {
   // get context function is here
-  m_pcBinIf->encodeBin( pcCU->isIntra( uiAbsPartIdx ) ? 1 : 0, m_cCUPredModeSCModel.get( 0, 0, 0 ) );
+  xEncodeBin( pcCU->isIntra( uiAbsPartIdx ) ? 1 : 0, m_cCUPredModeSCModel.get( 0, 0, 0 ) );
 }
 
 Void TEncSbac::codeCUTransquantBypassFlag( TComDataCU* pcCU, UInt uiAbsPartIdx )
 {
   UInt uiSymbol = pcCU->getCUTransquantBypass(uiAbsPartIdx);
-  m_pcBinIf->encodeBin( uiSymbol, m_CUTransquantBypassFlagSCModel.get( 0, 0, 0 ) );
+  xEncodeBin( uiSymbol, m_CUTransquantBypassFlagSCModel.get( 0, 0, 0 ) );
 }
 
 /** code skip flag
@@ -545,7 +589,7 @@ Void TEncSbac::codeSkipFlag( TComDataCU* pcCU, UInt uiAbsPartIdx )
   // get context function is here
   UInt uiSymbol = pcCU->isSkipped( uiAbsPartIdx ) ? 1 : 0;
   UInt uiCtxSkip = pcCU->getCtxSkipFlag( uiAbsPartIdx ) ;
-  m_pcBinIf->encodeBin( uiSymbol, m_cCUSkipFlagSCModel.get( 0, 0, uiCtxSkip ) );
+  xEncodeBin( uiSymbol, m_cCUSkipFlagSCModel.get( 0, 0, uiCtxSkip ) );
   DTRACE_CABAC_VL( g_nSymbolCounter++ );
   DTRACE_CABAC_T( "\tSkipFlag" );
   DTRACE_CABAC_T( "\tuiCtxSkip: ");
@@ -563,7 +607,7 @@ Void TEncSbac::codeSkipFlag( TComDataCU* pcCU, UInt uiAbsPartIdx )
 Void TEncSbac::codeMergeFlag( TComDataCU* pcCU, UInt uiAbsPartIdx )
 {
   const UInt uiSymbol = pcCU->getMergeFlag( uiAbsPartIdx ) ? 1 : 0;
-  m_pcBinIf->encodeBin( uiSymbol, *m_cCUMergeFlagExtSCModel.get( 0 ) );
+  xEncodeBin( uiSymbol, *m_cCUMergeFlagExtSCModel.get( 0 ) );
 
   DTRACE_CABAC_VL( g_nSymbolCounter++ );
   DTRACE_CABAC_T( "\tMergeFlag: " );
@@ -591,11 +635,11 @@ Void TEncSbac::codeMergeIndex( TComDataCU* pcCU, UInt uiAbsPartIdx )
       const UInt uiSymbol = ui == uiUnaryIdx ? 0 : 1;
       if ( ui==0 )
       {
-        m_pcBinIf->encodeBin( uiSymbol, m_cCUMergeIdxExtSCModel.get( 0, 0, 0 ) );
+        xEncodeBin( uiSymbol, m_cCUMergeIdxExtSCModel.get( 0, 0, 0 ) );
       }
       else
       {
-        m_pcBinIf->encodeBinEP( uiSymbol );
+        xEncodeBinEP( uiSymbol );
       }
       if( uiSymbol == 0 )
       {
@@ -621,7 +665,7 @@ Void TEncSbac::codeSplitFlag   ( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiDep
   UInt uiCurrSplitFlag = ( pcCU->getDepth( uiAbsPartIdx ) > uiDepth ) ? 1 : 0;
 
   assert( uiCtx < 3 );
-  m_pcBinIf->encodeBin( uiCurrSplitFlag, m_cCUSplitFlagSCModel.get( 0, 0, uiCtx ) );
+  xEncodeBin( uiCurrSplitFlag, m_cCUSplitFlagSCModel.get( 0, 0, uiCtx ) );
   DTRACE_CABAC_VL( g_nSymbolCounter++ )
   DTRACE_CABAC_T( "\tSplitFlag\n" )
   return;
@@ -629,7 +673,7 @@ Void TEncSbac::codeSplitFlag   ( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiDep
 
 Void TEncSbac::codeTransformSubdivFlag( UInt uiSymbol, UInt uiCtx )
 {
-  m_pcBinIf->encodeBin( uiSymbol, m_cCUTransSubdivFlagSCModel.get( 0, 0, uiCtx ) );
+  xEncodeBin( uiSymbol, m_cCUTransSubdivFlagSCModel.get( 0, 0, uiCtx ) );
   DTRACE_CABAC_VL( g_nSymbolCounter++ )
   DTRACE_CABAC_T( "\tparseTransformSubdivFlag()" )
   DTRACE_CABAC_T( "\tsymbol=" )
@@ -659,16 +703,16 @@ Void TEncSbac::codeIntraDirLumaAng( TComDataCU* pcCU, UInt absPartIdx, Bool isMu
         predIdx[j] = i;
       }
     }
-    m_pcBinIf->encodeBin((predIdx[j] != -1)? 1 : 0, m_cCUIntraPredSCModel.get( 0, 0, 0 ) );
+    xEncodeBin((predIdx[j] != -1)? 1 : 0, m_cCUIntraPredSCModel.get( 0, 0, 0 ) );
   }
   for (j=0;j<partNum;j++)
   {
     if(predIdx[j] != -1)
     {
-      m_pcBinIf->encodeBinEP( predIdx[j] ? 1 : 0 );
+      xEncodeBinEP( predIdx[j] ? 1 : 0 );
       if (predIdx[j])
       {
-        m_pcBinIf->encodeBinEP( predIdx[j]-1 );
+        xEncodeBinEP( predIdx[j]-1 );
       }
     }
     else
@@ -689,7 +733,7 @@ Void TEncSbac::codeIntraDirLumaAng( TComDataCU* pcCU, UInt absPartIdx, Bool isMu
       {
         dir[j] = dir[j] > preds[j][i] ? dir[j] - 1 : dir[j];
       }
-      m_pcBinIf->encodeBinsEP( dir[j], 5 );
+      xEncodeBinsEP( dir[j], 5 );
     }
   }
   return;
@@ -701,11 +745,11 @@ Void TEncSbac::codeIntraDirChroma( TComDataCU* pcCU, UInt uiAbsPartIdx )
 
   if( uiIntraDirChroma == DM_CHROMA_IDX )
   {
-    m_pcBinIf->encodeBin( 0, m_cCUChromaPredSCModel.get( 0, 0, 0 ) );
+    xEncodeBin( 0, m_cCUChromaPredSCModel.get( 0, 0, 0 ) );
   }
   else
   {
-    m_pcBinIf->encodeBin( 1, m_cCUChromaPredSCModel.get( 0, 0, 0 ) );
+    xEncodeBin( 1, m_cCUChromaPredSCModel.get( 0, 0, 0 ) );
 
     UInt uiAllowedChromaDir[ NUM_CHROMA_MODE ];
     pcCU->getAllowedChromaDir( uiAbsPartIdx, uiAllowedChromaDir );
@@ -719,7 +763,7 @@ Void TEncSbac::codeIntraDirChroma( TComDataCU* pcCU, UInt uiAbsPartIdx )
       }
     }
 
-    m_pcBinIf->encodeBinsEP( uiIntraDirChroma, 2 );
+    xEncodeBinsEP( uiIntraDirChroma, 2 );
   }
 
   return;
@@ -734,12 +778,12 @@ Void TEncSbac::codeInterDir( TComDataCU* pcCU, UInt uiAbsPartIdx )
 
   if (pcCU->getPartitionSize(uiAbsPartIdx) == SIZE_2Nx2N || pcCU->getHeight(uiAbsPartIdx) != 8 )
   {
-    m_pcBinIf->encodeBin( uiInterDir == 2 ? 1 : 0, *( pCtx + uiCtx ) );
+    xEncodeBin( uiInterDir == 2 ? 1 : 0, *( pCtx + uiCtx ) );
   }
 
   if (uiInterDir < 2)
   {
-    m_pcBinIf->encodeBin( uiInterDir, *( pCtx + 4 ) );
+    xEncodeBin( uiInterDir, *( pCtx + 4 ) );
   }
 
   return;
@@ -749,7 +793,7 @@ Void TEncSbac::codeRefFrmIdx( TComDataCU* pcCU, UInt uiAbsPartIdx, RefPicList eR
 {
   Int iRefFrame = pcCU->getCUMvField( eRefList )->getRefIdx( uiAbsPartIdx );
   ContextModel *pCtx = m_cCURefPicSCModel.get( 0 );
-  m_pcBinIf->encodeBin( ( iRefFrame == 0 ? 0 : 1 ), *pCtx );
+  xEncodeBin( ( iRefFrame == 0 ? 0 : 1 ), *pCtx );
 
   if( iRefFrame > 0 )
   {
@@ -761,11 +805,11 @@ Void TEncSbac::codeRefFrmIdx( TComDataCU* pcCU, UInt uiAbsPartIdx, RefPicList eR
       const UInt uiSymbol = ui == iRefFrame ? 0 : 1;
       if( ui == 0 )
       {
-        m_pcBinIf->encodeBin( uiSymbol, *pCtx );
+        xEncodeBin( uiSymbol, *pCtx );
       }
       else
       {
-        m_pcBinIf->encodeBinEP( uiSymbol );
+        xEncodeBinEP( uiSymbol );
       }
       if( uiSymbol == 0 )
       {
@@ -788,8 +832,8 @@ Void TEncSbac::codeMvd( TComDataCU* pcCU, UInt uiAbsPartIdx, RefPicList eRefList
   const Int iVer = pcCUMvField->getMvd( uiAbsPartIdx ).getVer();
   ContextModel* pCtx = m_cCUMvdSCModel.get( 0 );
 
-  m_pcBinIf->encodeBin( iHor != 0 ? 1 : 0, *pCtx );
-  m_pcBinIf->encodeBin( iVer != 0 ? 1 : 0, *pCtx );
+  xEncodeBin( iHor != 0 ? 1 : 0, *pCtx );
+  xEncodeBin( iVer != 0 ? 1 : 0, *pCtx );
 
   const Bool bHorAbsGr0 = iHor != 0;
   const Bool bVerAbsGr0 = iVer != 0;
@@ -799,12 +843,12 @@ Void TEncSbac::codeMvd( TComDataCU* pcCU, UInt uiAbsPartIdx, RefPicList eRefList
 
   if( bHorAbsGr0 )
   {
-    m_pcBinIf->encodeBin( uiHorAbs > 1 ? 1 : 0, *pCtx );
+    xEncodeBin( uiHorAbs > 1 ? 1 : 0, *pCtx );
   }
 
   if( bVerAbsGr0 )
   {
-    m_pcBinIf->encodeBin( uiVerAbs > 1 ? 1 : 0, *pCtx );
+    xEncodeBin( uiVerAbs > 1 ? 1 : 0, *pCtx );
   }
 
   if( bHorAbsGr0 )
@@ -814,7 +858,7 @@ Void TEncSbac::codeMvd( TComDataCU* pcCU, UInt uiAbsPartIdx, RefPicList eRefList
       xWriteEpExGolomb( uiHorAbs-2, 1 );
     }
 
-    m_pcBinIf->encodeBinEP( 0 > iHor ? 1 : 0 );
+    xEncodeBinEP( 0 > iHor ? 1 : 0 );
   }
 
   if( bVerAbsGr0 )
@@ -824,7 +868,7 @@ Void TEncSbac::codeMvd( TComDataCU* pcCU, UInt uiAbsPartIdx, RefPicList eRefList
       xWriteEpExGolomb( uiVerAbs-2, 1 );
     }
 
-    m_pcBinIf->encodeBinEP( 0 > iVer ? 1 : 0 );
+    xEncodeBinEP( 0 > iVer ? 1 : 0 );
   }
 
   return;
@@ -852,7 +896,7 @@ Void TEncSbac::codeCrossComponentPrediction( TComTU &rTu, ComponentID compID )
 
     Int alpha = pcCU->getCrossComponentPredictionAlpha( uiAbsPartIdx, compID );
     ContextModel *pCtx = m_cCrossComponentPredictionSCModel.get(0, 0) + ((compID == COMPONENT_Cr) ? (NUM_CROSS_COMPONENT_PREDICTION_CTX >> 1) : 0);
-    m_pcBinIf->encodeBin(((alpha != 0) ? 1 : 0), pCtx[0]);
+    xEncodeBin(((alpha != 0) ? 1 : 0), pCtx[0]);
 
     if (alpha != 0)
     {
@@ -861,14 +905,14 @@ Void TEncSbac::codeCrossComponentPrediction( TComTU &rTu, ComponentID compID )
 
       if (abs(alpha)>1)
       {
-        m_pcBinIf->encodeBin(1, pCtx[1]);
+        xEncodeBin(1, pCtx[1]);
         xWriteUnaryMaxSymbol( log2AbsAlphaMinus1Table[abs(alpha) - 1] - 1, (pCtx + 2), 1, 2 );
       }
       else
       {
-        m_pcBinIf->encodeBin(0, pCtx[1]);
+        xEncodeBin(0, pCtx[1]);
       }
-      m_pcBinIf->encodeBin( ((alpha < 0) ? 1 : 0), pCtx[4] );
+      xEncodeBin( ((alpha < 0) ? 1 : 0), pCtx[4] );
     }
     DTRACE_CABAC_T( "\tAlpha=" )
     DTRACE_CABAC_V( pcCU->getCrossComponentPredictionAlpha( uiAbsPartIdx, compID ) )
@@ -894,7 +938,7 @@ Void TEncSbac::codeDeltaQP( TComDataCU* pcCU, UInt uiAbsPartIdx )
   if ( uiAbsDQp > 0)
   {
     UInt uiSign = (iDQp > 0 ? 0 : 1);
-    m_pcBinIf->encodeBinEP(uiSign);
+    xEncodeBinEP(uiSign);
   }
 
   return;
@@ -909,7 +953,7 @@ Void TEncSbac::codeChromaQpAdjustment( TComDataCU* cu, UInt absPartIdx )
   Int chromaQpOffsetListLen = cu->getSlice()->getPPS()->getPpsRangeExtension().getChromaQpOffsetListLen();
   /* internal_idc == 0 => flag = 0
    * internal_idc > 1 => code idc value (if table size warrents) */
-  m_pcBinIf->encodeBin( internalIdc > 0, m_ChromaQpAdjFlagSCModel.get( 0, 0, 0 ) );
+  xEncodeBin( internalIdc > 0, m_ChromaQpAdjFlagSCModel.get( 0, 0, 0 ) );
 
   if (internalIdc > 0 && chromaQpOffsetListLen > 1)
   {
@@ -956,7 +1000,7 @@ Void TEncSbac::codeQtCbf( TComTU &rTu, const ComponentID compID, const Bool lowe
       const UInt subTUAbsPartIdx = absPartIdx + (subTU * partIdxesPerSubTU);
       const UInt uiCbf           = pcCU->getCbf(subTUAbsPartIdx, compID, subTUDepth);
 
-      m_pcBinIf->encodeBin(uiCbf, m_cCUQtCbfSCModel.get(0, contextSet, uiCtx));
+      xEncodeBin(uiCbf, m_cCUQtCbfSCModel.get(0, contextSet, uiCtx));
 
       DTRACE_CABAC_VL( g_nSymbolCounter++ )
       DTRACE_CABAC_T( "\tparseQtCbf()" )
@@ -976,7 +1020,7 @@ Void TEncSbac::codeQtCbf( TComTU &rTu, const ComponentID compID, const Bool lowe
   else
   {
     const UInt uiCbf = pcCU->getCbf( absPartIdx, compID, lowestTUDepth );
-    m_pcBinIf->encodeBin( uiCbf , m_cCUQtCbfSCModel.get( 0, contextSet, uiCtx ) );
+    xEncodeBin( uiCbf , m_cCUQtCbfSCModel.get( 0, contextSet, uiCtx ) );
 
 
     DTRACE_CABAC_VL( g_nSymbolCounter++ )
@@ -1010,7 +1054,7 @@ Void TEncSbac::codeTransformSkipFlags (TComTU &rTu, ComponentID component )
   }
 
   UInt useTransformSkip = pcCU->getTransformSkip( uiAbsPartIdx,component);
-  m_pcBinIf->encodeBin( useTransformSkip, m_cTransformSkipSCModel.get( 0, toChannelType(component), 0 ) );
+  xEncodeBin( useTransformSkip, m_cTransformSkipSCModel.get( 0, toChannelType(component), 0 ) );
 
   DTRACE_CABAC_VL( g_nSymbolCounter++ )
   DTRACE_CABAC_T("\tparseTransformSkip()");
@@ -1037,7 +1081,7 @@ Void TEncSbac::codeIPCMInfo( TComDataCU* pcCU, UInt uiAbsPartIdx )
 
   Bool writePCMSampleFlag = pcCU->getIPCMFlag(uiAbsPartIdx);
 
-  m_pcBinIf->encodeBinTrm (uiIPCM);
+  xEncodeBinTrm (uiIPCM);
 
   if (writePCMSampleFlag)
   {
@@ -1072,7 +1116,7 @@ Void TEncSbac::codeQtRootCbf( TComDataCU* pcCU, UInt uiAbsPartIdx )
 {
   UInt uiCbf = pcCU->getQtRootCbf( uiAbsPartIdx );
   UInt uiCtx = 0;
-  m_pcBinIf->encodeBin( uiCbf , m_cCUQtRootCbfSCModel.get( 0, 0, uiCtx ) );
+  xEncodeBin( uiCbf , m_cCUQtRootCbfSCModel.get( 0, 0, uiCtx ) );
   DTRACE_CABAC_VL( g_nSymbolCounter++ )
   DTRACE_CABAC_T( "\tparseQtRootCbf()" )
   DTRACE_CABAC_T( "\tsymbol=" )
@@ -1091,7 +1135,7 @@ Void TEncSbac::codeQtCbfZero( TComTU & rTu, const ChannelType chType )
   UInt uiCbf = 0;
   UInt uiCtx = rTu.getCU()->getCtxQtCbf( rTu, chType );
 
-  m_pcBinIf->encodeBin( uiCbf , m_cCUQtCbfSCModel.get( 0, chType, uiCtx ) );
+  xEncodeBin( uiCbf , m_cCUQtCbfSCModel.get( 0, chType, uiCtx ) );
 }
 
 Void TEncSbac::codeQtRootCbfZero( )
@@ -1100,7 +1144,7 @@ Void TEncSbac::codeQtRootCbfZero( )
   // and will never be called when writing the bistream. do not need to write log
   UInt uiCbf = 0;
   UInt uiCtx = 0;
-  m_pcBinIf->encodeBin( uiCbf , m_cCUQtRootCbfSCModel.get( 0, 0, uiCtx ) );
+  xEncodeBin( uiCbf , m_cCUQtRootCbfSCModel.get( 0, 0, uiCtx ) );
 }
 
 /** Encode (X,Y) position of the last significant coefficient
@@ -1137,22 +1181,22 @@ Void TEncSbac::codeLastSignificantXY( UInt uiPosX, UInt uiPosY, Int width, Int h
 
   for( uiCtxLast = 0; uiCtxLast < uiGroupIdxX; uiCtxLast++ )
   {
-    m_pcBinIf->encodeBin( 1, *( pCtxX + blkSizeOffsetX + (uiCtxLast >>shiftX) ) );
+    xEncodeBin( 1, *( pCtxX + blkSizeOffsetX + (uiCtxLast >>shiftX) ) );
   }
   if( uiGroupIdxX < g_uiGroupIdx[ width - 1 ])
   {
-    m_pcBinIf->encodeBin( 0, *( pCtxX + blkSizeOffsetX + (uiCtxLast >>shiftX) ) );
+    xEncodeBin( 0, *( pCtxX + blkSizeOffsetX + (uiCtxLast >>shiftX) ) );
   }
 
   // posY
 
   for( uiCtxLast = 0; uiCtxLast < uiGroupIdxY; uiCtxLast++ )
   {
-    m_pcBinIf->encodeBin( 1, *( pCtxY + blkSizeOffsetY + (uiCtxLast >>shiftY) ) );
+    xEncodeBin( 1, *( pCtxY + blkSizeOffsetY + (uiCtxLast >>shiftY) ) );
   }
   if( uiGroupIdxY < g_uiGroupIdx[ height - 1 ])
   {
-    m_pcBinIf->encodeBin( 0, *( pCtxY + blkSizeOffsetY + (uiCtxLast >>shiftY) ) );
+    xEncodeBin( 0, *( pCtxY + blkSizeOffsetY + (uiCtxLast >>shiftY) ) );
   }
 
   // EP-coded part
@@ -1163,7 +1207,7 @@ Void TEncSbac::codeLastSignificantXY( UInt uiPosX, UInt uiPosY, Int width, Int h
     uiPosX       = uiPosX - g_uiMinInGroup[ uiGroupIdxX ];
     for (Int i = uiCount - 1 ; i >= 0; i-- )
     {
-      m_pcBinIf->encodeBinEP( ( uiPosX >> i ) & 1 );
+      xEncodeBinEP( ( uiPosX >> i ) & 1 );
     }
   }
   if ( uiGroupIdxY > 3 )
@@ -1172,7 +1216,7 @@ Void TEncSbac::codeLastSignificantXY( UInt uiPosX, UInt uiPosY, Int width, Int h
     uiPosY       = uiPosY - g_uiMinInGroup[ uiGroupIdxY ];
     for ( Int i = uiCount - 1 ; i >= 0; i-- )
     {
-      m_pcBinIf->encodeBinEP( ( uiPosY >> i ) & 1 );
+      xEncodeBinEP( ( uiPosY >> i ) & 1 );
     }
   }
 }
@@ -1387,7 +1431,7 @@ Void TEncSbac::codeCoeffNxN( TComTU &rTu, TCoeff* pcCoef, const ComponentID comp
     {
       UInt uiSigCoeffGroup   = (uiSigCoeffGroupFlag[ iCGBlkPos ] != 0);
       UInt uiCtxSig  = TComTrQuant::getSigCoeffGroupCtxInc( uiSigCoeffGroupFlag, iCGPosX, iCGPosY, codingParameters.widthInGroups, codingParameters.heightInGroups );
-      m_pcBinIf->encodeBin( uiSigCoeffGroup, baseCoeffGroupCtx[ uiCtxSig ] );
+      xEncodeBin( uiSigCoeffGroup, baseCoeffGroupCtx[ uiCtxSig ] );
     }
 
     // encode significant_coeff_flag
@@ -1403,7 +1447,7 @@ Void TEncSbac::codeCoeffNxN( TComTU &rTu, TCoeff* pcCoef, const ComponentID comp
         if( iScanPosSig > iSubPos || iSubSet == 0 || numNonZero )
         {
           uiCtxSig  = TComTrQuant::getSigCtxInc( patternSigCtx, codingParameters, iScanPosSig, uiLog2BlockWidth, uiLog2BlockHeight, chType );
-          m_pcBinIf->encodeBin( uiSig, baseCtx[ uiCtxSig ] );
+          xEncodeBin( uiSig, baseCtx[ uiCtxSig ] );
         }
         if( uiSig )
         {
@@ -1437,7 +1481,7 @@ Void TEncSbac::codeCoeffNxN( TComTU &rTu, TCoeff* pcCoef, const ComponentID comp
       for( Int idx = 0; idx < numC1Flag; idx++ )
       {
         UInt uiSymbol = absCoeff[ idx ] > 1;
-        m_pcBinIf->encodeBin( uiSymbol, baseCtxMod[c1] );
+        xEncodeBin( uiSymbol, baseCtxMod[c1] );
         if( uiSymbol )
         {
           c1 = 0;
@@ -1463,7 +1507,7 @@ Void TEncSbac::codeCoeffNxN( TComTU &rTu, TCoeff* pcCoef, const ComponentID comp
         if ( firstC2FlagIdx != -1)
         {
           UInt symbol = absCoeff[ firstC2FlagIdx ] > 2;
-          m_pcBinIf->encodeBin( symbol, baseCtxMod[0] );
+          xEncodeBin( symbol, baseCtxMod[0] );
           if (symbol != 0)
           {
             escapeDataPresentInGroup = true;
@@ -1478,13 +1522,40 @@ Void TEncSbac::codeCoeffNxN( TComTU &rTu, TCoeff* pcCoef, const ComponentID comp
         m_pcBinIf->align();
       }
 
+#if FAST_BIT_EST
+      // when estimating, the bypass-coded sign and escape bins of the group are accounted for in a single step
+      UInt numBypassBins = 0;
+#endif
+
       if( beValid && signHidden )
       {
-        m_pcBinIf->encodeBinsEP( (coeffSigns >> 1), numNonZero-1 );
+#if FAST_BIT_EST
+        if (m_pcBinCounter)
+        {
+          numBypassBins += numNonZero-1;
+        }
+        else
+        {
+          xEncodeBinsEP( (coeffSigns >> 1), numNonZero-1 );
+        }
+#else
+        xEncodeBinsEP( (coeffSigns >> 1), numNonZero-1 );
+#endif
       }
       else
       {
-        m_pcBinIf->encodeBinsEP( coeffSigns, numNonZero );
+#if FAST_BIT_EST
+        if (m_pcBinCounter)
+        {
+          numBypassBins += numNonZero;
+        }
+        else
+        {
+          xEncodeBinsEP( coeffSigns, numNonZero );
+        }
+#else
+        xEncodeBinsEP( coeffSigns, numNonZero );
+#endif
       }
 
       Int iFirstCoeff2 = 1;
@@ -1498,7 +1569,18 @@ Void TEncSbac::codeCoeffNxN( TComTU &rTu, TCoeff* pcCoef, const ComponentID comp
           {
             const UInt escapeCodeValue = absCoeff[idx] - baseLevel;
 
+#if FAST_BIT_EST
+            if (m_pcBinCounter)
+            {
+              numBypassBins += xGetCoefRemainExGolombNumBins( escapeCodeValue, uiGoRiceParam, extendedPrecision, maxLog2TrDynamicRange );
+            }
+            else
+            {
+              xWriteCoefRemainExGolomb( escapeCodeValue, uiGoRiceParam, extendedPrecision, maxLog2TrDynamicRange );
+            }
+#else
             xWriteCoefRemainExGolomb( escapeCodeValue, uiGoRiceParam, extendedPrecision, maxLog2TrDynamicRange );
+#endif
 
             if (absCoeff[idx] > (3 << uiGoRiceParam))
             {
@@ -1528,6 +1610,13 @@ Void TEncSbac::codeCoeffNxN( TComTU &rTu, TCoeff* pcCoef, const ComponentID comp
           }
         }
       }
+
+#if FAST_BIT_EST
+      if (m_pcBinCounter)
+      {
+        m_pcBinCounter->encodeNumBinsEP( numBypassBins );
+      }
+#endif
     }
   }
 #if ENVIRONMENT_VARIABLE_DEBUG_AND_TEST
@@ -1542,7 +1631,7 @@ Void TEncSbac::codeCoeffNxN( TComTU &rTu, TCoeff* pcCoef, const ComponentID comp
  */
 Void TEncSbac::codeSAOSign( UInt code )
 {
-  m_pcBinIf->encodeBinEP( code );
+  xEncodeBinEP( code );
 }
 
 Void TEncSbac::codeSaoMaxUvlc    ( UInt code, UInt maxSymbol )
@@ -1557,18 +1646,18 @@ Void TEncSbac::codeSaoMaxUvlc    ( UInt code, UInt maxSymbol )
 
   if ( code == 0 )
   {
-    m_pcBinIf->encodeBinEP( 0 );
+    xEncodeBinEP( 0 );
   }
   else
   {
-    m_pcBinIf->encodeBinEP( 1 );
+    xEncodeBinEP( 1 );
     for ( i=0; i<code-1; i++ )
     {
-      m_pcBinIf->encodeBinEP( 1 );
+      xEncodeBinEP( 1 );
     }
     if( bCodeLast )
     {
-      m_pcBinIf->encodeBinEP( 0 );
+      xEncodeBinEP( 0 );
     }
   }
 }
@@ -1577,14 +1666,14 @@ Void TEncSbac::codeSaoMaxUvlc    ( UInt code, UInt maxSymbol )
  */
 Void TEncSbac::codeSaoUflc       ( UInt uiLength, UInt uiCode )
 {
-  m_pcBinIf->encodeBinsEP ( uiCode, uiLength );
+  xEncodeBinsEP ( uiCode, uiLength );
 }
 
 /** Code SAO merge flags
  */
 Void TEncSbac::codeSaoMerge       ( UInt uiCode )
 {
-  m_pcBinIf->encodeBin(((uiCode == 0) ? 0 : 1),  m_cSaoMergeSCModel.get( 0, 0, 0 ));
+  xEncodeBin(((uiCode == 0) ? 0 : 1),  m_cSaoMergeSCModel.get( 0, 0, 0 ));
 }
 
 /** Code SAO type index
@@ -1593,12 +1682,12 @@ Void TEncSbac::codeSaoTypeIdx       ( UInt uiCode)
 {
   if (uiCode == 0)
   {
-    m_pcBinIf->encodeBin( 0, m_cSaoTypeIdxSCModel.get( 0, 0, 0 ) );
+    xEncodeBin( 0, m_cSaoTypeIdxSCModel.get( 0, 0, 0 ) );
   }
   else
   {
-    m_pcBinIf->encodeBin( 1, m_cSaoTypeIdxSCModel.get( 0, 0, 0 ) );
-    m_pcBinIf->encodeBinEP( uiCode == 1 ? 0 : 1 );
+    xEncodeBin( 1, m_cSaoTypeIdxSCModel.get( 0, 0, 0 ) );
+    xEncodeBinEP( uiCode == 1 ? 0 : 1 );
   }
 }
 
@@ -1994,18 +2083,18 @@ Void TEncSbac::codeExplicitRdpcmMode( TComTU &rTu, const ComponentID compID )
 
   if( explicitRdpcmMode == RDPCM_OFF )
   {
-    m_pcBinIf->encodeBin (0, m_explicitRdpcmFlagSCModel.get (0, toChannelType(compID), 0));
+    xEncodeBin (0, m_explicitRdpcmFlagSCModel.get (0, toChannelType(compID), 0));
   }
   else if( explicitRdpcmMode == RDPCM_HOR || explicitRdpcmMode == RDPCM_VER )
   {
-    m_pcBinIf->encodeBin (1, m_explicitRdpcmFlagSCModel.get (0, toChannelType(compID), 0));
+    xEncodeBin (1, m_explicitRdpcmFlagSCModel.get (0, toChannelType(compID), 0));
     if(explicitRdpcmMode == RDPCM_HOR)
     {
-      m_pcBinIf->encodeBin ( 0, m_explicitRdpcmDirSCModel.get(0, toChannelType(compID), 0));
+      xEncodeBin ( 0, m_explicitRdpcmDirSCModel.get(0, toChannelType(compID), 0));
     }
     else
     {
-      m_pcBinIf->encodeBin ( 1, m_explicitRdpcmDirSCModel.get(0, toChannelType(compID), 0));
+      xEncodeBin ( 1, m_explicitRdpcmDirSCModel.get(0, toChannelType(compID), 0));
     }
   }
   else
@@ -69,8 +69,13 @@ public:
   TEncSbac();
   virtual ~TEncSbac();
 
+#if FAST_BIT_EST
+  Void  init                   ( TEncBinIf* p )  { m_pcBinIf = p; m_pcBinCounter = p->getTEncBinCABACCounter(); }
+  Void  uninit                 ()                { m_pcBinIf = 0; m_pcBinCounter = 0; }
+#else
   Void  init                   ( TEncBinIf* p )  { m_pcBinIf = p; }
   Void  uninit                 ()                { m_pcBinIf = 0; }
+#endif
 
   //  Virtual list
   Void  resetEntropy           (const TComSlice *pSlice);
@@ -110,7 +115,24 @@ private:
   Void  xWriteUnarySymbol    ( UInt uiSymbol, ContextModel* pcSCModel, Int iOffset );
   Void  xWriteUnaryMaxSymbol ( UInt uiSymbol, ContextModel* pcSCModel, Int iOffset, UInt uiMaxSymbol );
   Void  xWriteEpExGolomb     ( UInt uiSymbol, UInt uiCount );
+  Void  xGetCoefRemainExGolombCode ( UInt symbol, UInt rParam, const Bool useLimitedPrefixLength, const Int maxLog2TrDynamicRange, UInt &rPrefix, UInt &rPrefixLength, UInt &rSuffix, UInt &rSuffixLength ) const;
   Void  xWriteCoefRemainExGolomb ( UInt symbol, UInt &rParam, const Bool useLimitedPrefixLength, const Int maxLog2TrDynamicRange );
+#if FAST_BIT_EST
+  UInt  xGetCoefRemainExGolombNumBins ( UInt symbol, UInt rParam, const Bool useLimitedPrefixLength, const Int maxLog2TrDynamicRange ) const;
+#endif
+
+  // bin coding; when only estimating rates, the counter is called directly instead of through TEncBinIf
+#if FAST_BIT_EST
+  Void  xEncodeBin           ( UInt binValue, ContextModel& rcCtxModel ) { if (m_pcBinCounter) { m_pcBinCounter->TEncBinCABACCounter::encodeBin( binValue, rcCtxModel ); } else { m_pcBinIf->encodeBin( binValue, rcCtxModel ); } }
+  Void  xEncodeBinEP         ( UInt binValue )                           { if (m_pcBinCounter) { m_pcBinCounter->TEncBinCABACCounter::encodeBinEP( binValue );           } else { m_pcBinIf->encodeBinEP( binValue );           } }
+  Void  xEncodeBinsEP        ( UInt binValues, Int numBins )             { if (m_pcBinCounter) { m_pcBinCounter->TEncBinCABACCounter::encodeBinsEP( binValues, numBins ); } else { m_pcBinIf->encodeBinsEP( binValues, numBins ); } }
+  Void  xEncodeBinTrm        ( UInt binValue )                           { if (m_pcBinCounter) { m_pcBinCounter->TEncBinCABACCounter::encodeBinTrm( binValue );          } else { m_pcBinIf->encodeBinTrm( binValue );          } }
+#else
+  Void  xEncodeBin           ( UInt binValue, ContextModel& rcCtxModel ) { m_pcBinIf->encodeBin( binValue, rcCtxModel ); }
+  Void  xEncodeBinEP         ( UInt binValue )                           { m_pcBinIf->encodeBinEP( binValue );           }
+  Void  xEncodeBinsEP        ( UInt binValues, Int numBins )             { m_pcBinIf->encodeBinsEP( binValues, numBins ); }
+  Void  xEncodeBinTrm        ( UInt binValue )                           { m_pcBinIf->encodeBinTrm( binValue );          }
+#endif
 
   Void  xCopyFrom            ( const TEncSbac* pSrc );
   Void  xCopyContextsFrom    ( const TEncSbac* pSrc );
@@ -118,6 +140,9 @@ private:
 protected:
   TComBitIf*    m_pcBitIf;
   TEncBinIf*    m_pcBinIf;
+#if FAST_BIT_EST
+  TEncBinCABACCounter* m_pcBinCounter;  ///< m_pcBinIf when it only estimates rates, otherwise NULL
+#endif
 
   //--Adaptive loop filter
 
@@ -2920,7 +2920,11 @@ Void TEncSearch::IPCMSearch( TComDataCU* pcCU, TComYuv* pcOrgYuv, TComYuv* pcPre
   pcCU->getTotalCost()       = dCost;
   pcCU->getTotalDistortion() = uiDistortion;
 
+#if ADAPTIVE_QP_SELECTION
+  pcCU->copyToPic(uiDepth, m_pcEncCfg->getUseAdaptQpSelect());
+#else
   pcCU->copyToPic(uiDepth);
+#endif
 }
 
 
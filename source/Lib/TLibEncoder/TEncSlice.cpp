@@ -47,7 +47,11 @@
 // ====================================================================================================================
 
 TEncSlice::TEncSlice()
- : m_encCABACTableIdx(I_SLICE)
+ : m_pcThreadPool(NULL)
+ , m_pcCtuWorkers(NULL)
+ , m_pcEntropyCodingSyncContextStates(NULL)
+ , m_numEntropyCodingSyncContextStates(0)
+ , m_encCABACTableIdx(I_SLICE)
 {
 }
 
@@ -74,6 +78,10 @@ Void TEncSlice::destroy()
   m_vdRdPicLambda.clear();
   m_vdRdPicQp.clear();
   m_viRdPicQp.clear();
+
+  delete [] m_pcEntropyCodingSyncContextStates;
+  m_pcEntropyCodingSyncContextStates  = NULL;
+  m_numEntropyCodingSyncContextStates = 0;
 }
 
 Void TEncSlice::init( TEncTop* pcEncTop )
@@ -99,6 +107,9 @@ Void TEncSlice::init( TEncTop* pcEncTop )
   m_vdRdPicQp.resize(    m_pcCfg->getDeltaQpRD() * 2 + 1 );
   m_viRdPicQp.resize(    m_pcCfg->getDeltaQpRD() * 2 + 1 );
   m_pcRateCtrl        = pcEncTop->getRateCtrl();
+
+  m_pcThreadPool      = pcEncTop->getThreadPool();
+  m_pcCtuWorkers      = pcEncTop->getCtuWorkers();
 }
 
 
@@ -503,6 +514,13 @@ Void TEncSlice::setSearchRange( TComSlice* pcSlice )
       iRefPOC = pcSlice->getRefPic(e, iRefIdx)->getPOC();
       Int newSearchRange = Clip3(m_pcCfg->getMinSearchWindow(), iMaxSR, (iMaxSR*ADAPT_SR_SCALE*abs(iCurrPOC - iRefPOC)+iOffset)/iGOPSize);
       m_pcPredSearch->setAdaptiveSearchRange(iDir, iRefIdx, newSearchRange);
+      if ( m_pcCtuWorkers != NULL )
+      {
+        for ( Int threadIdx = 0; threadIdx < m_pcThreadPool->getNumThreads(); threadIdx++ )
+        {
+          m_pcCtuWorkers[threadIdx].getPredSearch()->setAdaptiveSearchRange(iDir, iRefIdx, newSearchRange);
+        }
+      }
     }
   }
 }
@@ -638,10 +656,12 @@ Void TEncSlice::calCostSliceI(TComPic* pcPic) // TODO: this only analyses the fi
 
 /** \param pcPic   picture class
  */
-Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice, const Bool bFastDeltaQP )
+Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice, const Bool bFastDeltaQP, const Bool bConcurrent )
 {
   // if bCompressEntireSlice is true, then the entire slice (not slice segment) is compressed,
   //   effectively disabling the slice-segment-mode.
+  // if bConcurrent is true (only allowed when canCompressConcurrently), the compression may still be running when this function
+  //   returns, and finishCompressSlice has to be called before the picture is used.
 
   UInt   startCtuTsAddr;
   UInt   boundingCtuTsAddr;
@@ -730,6 +750,22 @@ Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice,
     }
   }
 
+  if ( xCanCompressSliceInParallel( pcSlice, bCompressEntireSlice, bConcurrent ) )
+  {
+    if ( bConcurrent )
+    {
+      m_concurrentCompressions.emplace_back();
+      xStartCompressSliceParallel( m_concurrentCompressions.back(), pcPic, startCtuTsAddr, boundingCtuTsAddr, bFastDeltaQP, true );
+    }
+    else
+    {
+      ParallelCompression job;
+      xStartCompressSliceParallel( job, pcPic, startCtuTsAddr, boundingCtuTsAddr, bFastDeltaQP, false );
+      xFinishCompressSliceParallel( job );
+    }
+    return;
+  }
+
   // for every CTU in the slice segment (may terminate sooner if there is a byte limit on the slice-segment)
 
   for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ++ctuTsAddr )
@@ -925,6 +961,328 @@ Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice,
   //}
 }
 
+/** Whether the CTUs of a slice segment can be compressed by the worker threads.
+ * Rate control, adaptive QP selection and byte-limited slices carry results from one CTU into the next, so they stay sequential.
+ * A slice segment without tiles or wavefronts is only handed to the worker threads when it is compressed concurrently with other pictures.
+ */
+Bool TEncSlice::xCanCompressSliceInParallel( const TComSlice* pcSlice, const Bool bCompressEntireSlice, const Bool bConcurrent ) const
+{
+  const Bool bMultipleTiles = pcSlice->getPPS()->getNumTileColumnsMinus1() > 0 || pcSlice->getPPS()->getNumTileRowsMinus1() > 0;
+  if ( m_pcCtuWorkers == NULL || !( m_pcCfg->getEntropyCodingSyncEnabledFlag() || bMultipleTiles || bConcurrent ) || m_pcCfg->getUseRateCtrl() )
+  {
+    return false;
+  }
+#if ADAPTIVE_QP_SELECTION
+  if ( m_pcCfg->getUseAdaptQpSelect() )
+  {
+    return false;
+  }
+#endif
+  if ( pcSlice->getSliceMode() == FIXED_NUMBER_OF_BYTES || ( !bCompressEntireSlice && pcSlice->getSliceSegmentMode() == FIXED_NUMBER_OF_BYTES ) )
+  {
+    return false;
+  }
+  return true;
+}
+
+/** Whether a picture can be compressed while the encoder carries on with other pictures.
+ * The picture has to consist of a single slice, and its compression must not depend on state shared between pictures
+ * (rate control, adaptive QP selection and the multiple-QP optimisation of precompressSlice). This does not depend on the
+ * number of threads: without worker threads, the compression simply completes before compressSlice returns.
+ */
+Bool TEncSlice::canCompressConcurrently() const
+{
+  if ( m_pcCfg->getSliceMode() != NO_SLICES || m_pcCfg->getSliceSegmentMode() != NO_SLICES || m_pcCfg->getUseRateCtrl() || m_pcCfg->getDeltaQpRD() > 0 )
+  {
+    return false;
+  }
+#if ADAPTIVE_QP_SELECTION
+  if ( m_pcCfg->getUseAdaptQpSelect() )
+  {
+    return false;
+  }
+#endif
+  return true;
+}
+
+/** Start the multi-threaded version of the CTU loop of compressSlice.
+ * The slice segment is split into runs of CTUs that can be compressed independently: one run per tile, further split into one run
+ * per CTU row of the tile when wavefronts are enabled. Each run is compressed by a worker thread with its own CU encoder, search,
+ * RD cost and CABAC estimation state. Tiles do not depend on each other; within a tile, a CTU is only started once the run above has
+ * finished the CTU above-right of it. Each run starts from the same contexts as in the sequential loop, so the result is identical.
+ * \param job                state of the compression, which must stay in place until xFinishCompressSliceParallel has returned
+ * \param pcPic              picture class
+ * \param startCtuTsAddr     first CTU of the slice segment
+ * \param boundingCtuTsAddr  CTU following the slice segment
+ * \param bFastDeltaQP       fast delta-QP decision used by the CU encoders
+ * \param bConcurrent        the picture is compressed while the encoder carries on: nothing may be shared with the next slice
+ */
+Void TEncSlice::xStartCompressSliceParallel( ParallelCompression& job, TComPic* pcPic, const UInt startCtuTsAddr, const UInt boundingCtuTsAddr, const Bool bFastDeltaQP, const Bool bConcurrent )
+{
+  TComPicSym* const pcPicSym         = pcPic->getPicSym();
+  const UInt        frameWidthInCtus = pcPicSym->getFrameWidthInCtus();
+  const Bool        bWavefronts      = m_pcCfg->getEntropyCodingSyncEnabledFlag();
+
+  job.pcPic        = pcPic;
+  job.sliceIdx     = getSliceIdx();
+  job.rdCost       = *m_pcRdCost;
+  job.bFastDeltaQP = bFastDeltaQP;
+#if RDOQ_CHROMA_LAMBDA
+  for ( UInt comp = 0; comp < MAX_NUM_COMPONENT; comp++ )
+  {
+    job.trQuantLambdas[comp] = m_pcTrQuant->getLambdas()[comp];
+  }
+#else
+  job.trQuantLambdas[0] = m_pcTrQuant->getLambda();
+#endif
+
+  // one WPP context storage per CTU row and tile column. Those of the sequential slice segments are kept across calls,
+  // as a dependent slice segment may continue a row.
+  const UInt numSyncStates = pcPicSym->getFrameHeightInCtus() * (pcPicSym->getNumTileColumnsMinus1()+1);
+  if ( bConcurrent )
+  {
+    job.pcOwnedSyncStates = bWavefronts ? new TEncSbac[numSyncStates] : NULL;
+    job.pcSyncStates      = job.pcOwnedSyncStates;
+    job.pcStartState      = NULL;
+    job.pcEndState        = NULL;
+  }
+  else
+  {
+    if ( m_numEntropyCodingSyncContextStates != numSyncStates )
+    {
+      delete [] m_pcEntropyCodingSyncContextStates;
+      m_pcEntropyCodingSyncContextStates  = new TEncSbac[numSyncStates];
+      m_numEntropyCodingSyncContextStates = numSyncStates;
+    }
+    job.pcSyncStates = m_pcEntropyCodingSyncContextStates;
+    job.pcStartState = m_pppcRDSbacCoder[0][CI_CURR_BEST];
+    job.pcEndState   = pcPic->getSlice(job.sliceIdx)->getPPS()->getDependentSliceSegmentsEnabledFlag() ? &m_lastSliceSegmentEndContextState : NULL;
+  }
+
+  // the CTUs of other slice segments count as compressed
+  job.ctuRowProgress.init( pcPicSym->getFrameHeightInCtus(), Int(frameWidthInCtus) );
+
+  // tiles, and CTU rows of a tile, are contiguous in tile-scan order.
+  // The CTUs are also initialised here, as the availability checks of a tile read the slice of the CTUs in neighbouring tiles.
+  for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ++ctuTsAddr )
+  {
+    const UInt ctuRsAddr            = pcPicSym->getCtuTsToRsAddrMap(ctuTsAddr);
+    const UInt firstCtuRsAddrOfTile = pcPicSym->getTComTile(pcPicSym->getTileIdxMap(ctuRsAddr))->getFirstCtuRsAddr();
+    const UInt tileXPosInCtus       = firstCtuRsAddrOfTile % frameWidthInCtus;
+    if ( ctuTsAddr == startCtuTsAddr || ctuRsAddr == firstCtuRsAddrOfTile || ( bWavefronts && ctuRsAddr % frameWidthInCtus == tileXPosInCtus ) )
+    {
+      // without a start state, every run has to begin with a context reset
+      assert( job.pcStartState != NULL || ctuRsAddr == firstCtuRsAddrOfTile || bWavefronts );
+      job.segmentStartCtuTsAddr.push_back(ctuTsAddr);
+    }
+    pcPic->getCtu( ctuRsAddr )->initCtu( pcPic, ctuRsAddr );
+    job.ctuRowProgress.add( ctuRsAddr / frameWidthInCtus, -1 );
+  }
+  job.segmentStartCtuTsAddr.push_back(boundingCtuTsAddr);
+
+  // the progress of a run is the frame column following its last compressed CTU
+  const UInt numSegments = UInt(job.segmentStartCtuTsAddr.size()) - 1;
+  job.segmentProgress.init( numSegments );
+  job.segmentDone.init( numSegments );
+  for ( UInt segmentIdx = 0; segmentIdx < numSegments; segmentIdx++ )
+  {
+    job.segmentProgress.set( segmentIdx, pcPicSym->getCtuTsToRsAddrMap(job.segmentStartCtuTsAddr[segmentIdx]) % frameWidthInCtus );
+  }
+
+  job.ctuWrittenBits.resize( boundingCtuTsAddr - startCtuTsAddr );
+  for ( UInt segmentIdx = 0; segmentIdx < numSegments; segmentIdx++ )
+  {
+    ParallelCompression* pcJob = &job;
+    m_pcThreadPool->addTask( [this, pcJob, segmentIdx]( Int threadIdx )
+    {
+      xCompressCtuSegment( &m_pcCtuWorkers[threadIdx], *pcJob, segmentIdx );
+      pcJob->segmentDone.set( segmentIdx, 1 );
+    } );
+  }
+}
+
+/** Wait for the end of a compression started by xStartCompressSliceParallel, and accumulate the bits, costs and distortions of its CTUs.
+ * \param job  state of the compression
+ */
+Void TEncSlice::xFinishCompressSliceParallel( ParallelCompression& job )
+{
+  const UInt numSegments = UInt(job.segmentStartCtuTsAddr.size()) - 1;
+  for ( UInt segmentIdx = 0; segmentIdx < numSegments; segmentIdx++ )
+  {
+    job.segmentDone.waitFor( segmentIdx, 1 );
+  }
+
+  // accumulate in tile-scan order, exactly as the sequential loop does
+  TComSlice*  const pcSlice           = job.pcPic->getSlice(job.sliceIdx);
+  TComPicSym* const pcPicSym          = job.pcPic->getPicSym();
+  const UInt        startCtuTsAddr    = job.segmentStartCtuTsAddr.front();
+  const UInt        boundingCtuTsAddr = job.segmentStartCtuTsAddr.back();
+  for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ++ctuTsAddr )
+  {
+    TComDataCU* pCtu                = job.pcPic->getCtu( pcPicSym->getCtuTsToRsAddrMap(ctuTsAddr) );
+    const Int   numberOfWrittenBits = job.ctuWrittenBits[ctuTsAddr - startCtuTsAddr];
+
+    pcSlice->setSliceBits( (UInt)(pcSlice->getSliceBits() + numberOfWrittenBits) );
+    pcSlice->setSliceSegmentBits(pcSlice->getSliceSegmentBits()+numberOfWrittenBits);
+
+    m_uiPicTotalBits += pCtu->getTotalBits();
+    m_dPicRdCost     += pCtu->getTotalCost();
+    m_uiPicDist      += pCtu->getTotalDistortion();
+  }
+}
+
+/** Wait for the end of the compression of a picture started by compressSlice with bConcurrent set.
+ * \param pcPic  picture class
+ */
+Void TEncSlice::finishCompressSlice( TComPic* pcPic )
+{
+  for ( std::list<ParallelCompression>::iterator it = m_concurrentCompressions.begin(); it != m_concurrentCompressions.end(); it++ )
+  {
+    if ( it->pcPic == pcPic )
+    {
+      xFinishCompressSliceParallel( *it );
+      m_concurrentCompressions.erase( it );
+      return;
+    }
+  }
+  // otherwise, the picture was compressed before compressSlice returned
+}
+
+/** Wait until the first CTU rows of a picture started by compressSlice with bConcurrent set are compressed, so that they can be
+ * filtered while the compression of the following rows carries on.
+ * \param pcPic       picture class
+ * \param numCtuRows  number of CTU rows, from the top of the picture
+ */
+Void TEncSlice::waitForCompressedCtuRows( TComPic* pcPic, UInt numCtuRows )
+{
+  for ( std::list<ParallelCompression>::iterator it = m_concurrentCompressions.begin(); it != m_concurrentCompressions.end(); it++ )
+  {
+    if ( it->pcPic == pcPic )
+    {
+      const Int frameWidthInCtus = Int(pcPic->getFrameWidthInCtus());
+      for ( UInt ctuRow = 0; ctuRow < numCtuRows; ctuRow++ )
+      {
+        it->ctuRowProgress.waitFor( ctuRow, frameWidthInCtus );
+      }
+      return;
+    }
+  }
+}
+
+/** Compress one run of CTUs on a worker thread.
+ * \param pcWorker    tools of the worker thread
+ * \param job         state of the compression of the slice segment
+ * \param segmentIdx  run to compress
+ */
+Void TEncSlice::xCompressCtuSegment( TEncCtuWorker* pcWorker, ParallelCompression& job, const UInt segmentIdx )
+{
+  TComPic*    const pcPic            = job.pcPic;
+  TComSlice*  const pcSlice          = pcPic->getSlice(job.sliceIdx);
+  TComPicSym* const pcPicSym         = pcPic->getPicSym();
+  const UInt        frameWidthInCtus = pcPicSym->getFrameWidthInCtus();
+  const UInt        numTileColumns   = pcPicSym->getNumTileColumnsMinus1()+1;
+  const Bool        bWavefronts      = m_pcCfg->getEntropyCodingSyncEnabledFlag();
+
+  TEncCu*           pcCuEncoder      = pcWorker->getCuEncoder();
+  TEncEntropy*      pcEntropyCoder   = pcWorker->getEntropyCoder();
+  TEncSbac*         pcCurrBestCoder  = pcWorker->getRDSbacCoder()[0][CI_CURR_BEST];
+  TEncSbac*         pcRDGoOnCoder    = pcWorker->getRDGoOnSbacCoder();
+  TEncBinCABAC*     pRDSbacCoder     = (TEncBinCABAC *) pcCurrBestCoder->getEncBinIf();
+  TComBitCounter    tempBitCounter;
+
+  pcWorker->initSlice( &job.rdCost, job.trQuantLambdas, job.bFastDeltaQP );
+
+  // start from the state the sequential loop starts the slice segment with
+  if ( job.pcStartState != NULL )
+  {
+    pcCurrBestCoder->load( job.pcStartState );
+  }
+  pRDSbacCoder->setBinCountingEnableFlag( false );
+  pRDSbacCoder->setBinsCoded( 0 );
+
+  const UInt startCtuTsAddr    = job.segmentStartCtuTsAddr[segmentIdx];
+  const UInt boundingCtuTsAddr = job.segmentStartCtuTsAddr[segmentIdx+1];
+  for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ++ctuTsAddr )
+  {
+    const UInt ctuRsAddr = pcPicSym->getCtuTsToRsAddrMap(ctuTsAddr);
+    TComDataCU* pCtu = pcPic->getCtu( ctuRsAddr );
+
+    const UInt      tileIdx              = pcPicSym->getTileIdxMap(ctuRsAddr);
+    const TComTile *pCurrentTile         = pcPicSym->getTComTile(tileIdx);
+    const UInt      firstCtuRsAddrOfTile = pCurrentTile->getFirstCtuRsAddr();
+    const UInt      tileXPosInCtus       = firstCtuRsAddrOfTile % frameWidthInCtus;
+    const UInt      tileEndXPosInCtus    = tileXPosInCtus + pCurrentTile->getTileWidthInCtus();
+    const UInt      ctuXPosInCtus        = ctuRsAddr % frameWidthInCtus;
+    const UInt      syncStateIdx         = (ctuRsAddr / frameWidthInCtus) * numTileColumns + tileIdx % numTileColumns;
+
+    // wait for the CTU above-right, if the run above is in the same tile
+    if ( segmentIdx > 0 && pcPicSym->getTileIdxMap( pcPicSym->getCtuTsToRsAddrMap(startCtuTsAddr - 1) ) == tileIdx )
+    {
+      job.segmentProgress.waitFor( segmentIdx-1, min(ctuXPosInCtus+2, tileEndXPosInCtus) );
+    }
+
+    // update CABAC state
+    if (ctuRsAddr == firstCtuRsAddrOfTile)
+    {
+      pcCurrBestCoder->resetEntropy(pcSlice);
+    }
+    else if ( ctuXPosInCtus == tileXPosInCtus && bWavefronts )
+    {
+      // reset and then update contexts to the state at the end of the top-right CTU (if within current slice and tile).
+      pcCurrBestCoder->resetEntropy(pcSlice);
+      TComDataCU *pCtuUp = pCtu->getCtuAbove();
+      if ( pCtuUp && ((ctuRsAddr%frameWidthInCtus+1) < frameWidthInCtus)  )
+      {
+        TComDataCU *pCtuTR = pcPic->getCtu( ctuRsAddr - frameWidthInCtus + 1 );
+        if ( pCtu->CUIsFromSameSliceAndTile(pCtuTR) )
+        {
+          pcCurrBestCoder->loadContexts( &job.pcSyncStates[syncStateIdx - numTileColumns] );
+        }
+      }
+    }
+
+    pcEntropyCoder->setEntropyCoder ( pcRDGoOnCoder );
+    pcEntropyCoder->setBitstream( &tempBitCounter );
+    tempBitCounter.resetBits();
+    pcRDGoOnCoder->load( pcCurrBestCoder );
+    ((TEncBinCABAC*)pcRDGoOnCoder->getEncBinIf())->setBinCountingEnableFlag(true);
+
+    // run CTU trial encoder
+    pcCuEncoder->compressCtu( pCtu );
+
+    // true encode, to bring the contexts up to date and count the bits of the CTU
+    pcEntropyCoder->setEntropyCoder ( pcCurrBestCoder );
+    pcEntropyCoder->setBitstream( &tempBitCounter );
+    pRDSbacCoder->setBinCountingEnableFlag( true );
+    pcCurrBestCoder->resetBits();
+    pRDSbacCoder->setBinsCoded( 0 );
+
+    pcCuEncoder->encodeCtu( pCtu );
+
+    pRDSbacCoder->setBinCountingEnableFlag( false );
+
+    job.ctuWrittenBits[ctuTsAddr - job.segmentStartCtuTsAddr[0]] = pcEntropyCoder->getNumberOfWrittenBits();
+
+    // Store probabilities of second CTU in line into buffer
+    if ( ctuXPosInCtus == tileXPosInCtus+1 && bWavefronts )
+    {
+      job.pcSyncStates[syncStateIdx].loadContexts( pcCurrBestCoder );
+    }
+
+    job.segmentProgress.set( segmentIdx, ctuXPosInCtus+1 );
+    job.ctuRowProgress.add( ctuRsAddr / frameWidthInCtus, 1 );
+  }
+
+  // store context state at the end of this slice-segment, in case the next slice is a dependent slice and continues using the CABAC contexts.
+  if ( boundingCtuTsAddr == job.segmentStartCtuTsAddr.back() && job.pcEndState != NULL )
+  {
+    job.pcEndState->loadContexts( pcCurrBestCoder );
+  }
+
+  pcCurrBestCoder->setBitstream(NULL);
+  pcRDGoOnCoder->setBitstream(NULL);
+}
+
 Void TEncSlice::encodeSlice   ( TComPic* pcPic, TComOutputBitstream* pcSubstreams, UInt &numBinsCoded )
 {
   TComSlice *const pcSlice           = pcPic->getSlice(getSliceIdx());
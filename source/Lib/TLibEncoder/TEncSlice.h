@@ -46,6 +46,8 @@
 #include "TEncCu.h"
 #include "WeightPredAnalysis.h"
 #include "TEncRateCtrl.h"
+#include "TEncCtuWorker.h"
+#include "TLibCommon/TComThreadPool.h"
 
 //! \ingroup TLibEncoder
 //! \{
@@ -61,6 +63,36 @@ class TEncGOP;
 class TEncSlice
   : public WeightPredAnalysis
 {
+  /// compression of the CTUs of one slice segment by the worker threads
+  class ParallelCompression
+  {
+  public:
+    ParallelCompression()
+    : pcPic(NULL)
+    , sliceIdx(0)
+    , bFastDeltaQP(false)
+    , pcStartState(NULL)
+    , pcEndState(NULL)
+    , pcSyncStates(NULL)
+    , pcOwnedSyncStates(NULL) {};
+    ~ParallelCompression() { delete [] pcOwnedSyncStates; };
+
+    TComPic*          pcPic;
+    UInt              sliceIdx;
+    std::vector<UInt> segmentStartCtuTsAddr;            ///< first CTU of each run, followed by the bounding CTU of the slice segment
+    TComRowProgress   segmentProgress;                  ///< frame column following the last compressed CTU of each run
+    TComRowProgress   segmentDone;                      ///< set to 1 when the task of a run has returned
+    TComRowProgress   ctuRowProgress;                   ///< number of compressed CTUs of each CTU row of the frame, counting those of other slice segments
+    std::vector<Int>  ctuWrittenBits;                   ///< number of bits of each CTU of the slice segment
+    TComRdCost        rdCost;                           ///< slice-level RD cost settings
+    Double            trQuantLambdas[MAX_NUM_COMPONENT];
+    Bool              bFastDeltaQP;
+    const TEncSbac*   pcStartState;                     ///< contexts the slice segment starts with (NULL: every run starts at a context reset)
+    TEncSbac*         pcEndState;                       ///< receives the contexts at the end of the slice segment (may be NULL)
+    TEncSbac*         pcSyncStates;                     ///< WPP context storage for each CTU row of each tile column
+    TEncSbac*         pcOwnedSyncStates;                ///< storage owned by this compression, when it runs concurrently with other pictures
+  };
+
 private:
   // encoder configuration
   TEncCfg*                m_pcCfg;                              ///< encoder configuration class
@@ -97,11 +129,21 @@ private:
   UInt                    m_uiSliceIdx;
   TEncSbac                m_lastSliceSegmentEndContextState;    ///< context storage for state at the end of the previous slice-segment (used for dependent slices only).
   TEncSbac                m_entropyCodingSyncContextState;      ///< context storate for state of contexts at the wavefront/WPP/entropy-coding-sync second CTU of tile-row
+  TComThreadPool*         m_pcThreadPool;                       ///< worker threads for wavefront- and tile-parallel compression
+  TEncCtuWorker*          m_pcCtuWorkers;                       ///< CTU analysis tools of each worker thread (NULL when single-threaded)
+  TEncSbac*               m_pcEntropyCodingSyncContextStates;   ///< WPP context storage for each CTU row of each tile column (multi-threaded compression only)
+  UInt                    m_numEntropyCodingSyncContextStates;
+  std::list<ParallelCompression> m_concurrentCompressions;  ///< pictures being compressed while the encoder carries on with other pictures
   SliceType               m_encCABACTableIdx;
 
   Void     setUpLambda(TComSlice* slice, const Double dLambda, Int iQP);
   Void     calculateBoundingCtuTsAddrForSlice(UInt &startCtuTSAddrSlice, UInt &boundingCtuTSAddrSlice, Bool &haveReachedTileBoundary, TComPic* pcPic, const Int sliceMode, const Int sliceArgument);
 
+  Bool     xCanCompressSliceInParallel ( const TComSlice* pcSlice, const Bool bCompressEntireSlice, const Bool bConcurrent ) const;
+  Void     xStartCompressSliceParallel ( ParallelCompression& job, TComPic* pcPic, const UInt startCtuTsAddr, const UInt boundingCtuTsAddr, const Bool bFastDeltaQP, const Bool bConcurrent );
+  Void     xFinishCompressSliceParallel( ParallelCompression& job );
+  Void     xCompressCtuSegment         ( TEncCtuWorker* pcWorker, ParallelCompression& job, const UInt segmentIdx );
+
 public:
   TEncSlice();
   virtual ~TEncSlice();
@@ -116,7 +158,10 @@ public:
   Void    resetQP             ( TComPic* pic, Int sliceQP, Double lambda );
   // compress and encode slice
   Void    precompressSlice    ( TComPic* pcPic                                     );      ///< precompress slice for multi-loop slice-level QP opt.
-  Void    compressSlice       ( TComPic* pcPic, const Bool bCompressEntireSlice, const Bool bFastDeltaQP );      ///< analysis stage of slice
+  Void    compressSlice       ( TComPic* pcPic, const Bool bCompressEntireSlice, const Bool bFastDeltaQP, const Bool bConcurrent = false );  ///< analysis stage of slice
+  Bool    canCompressConcurrently () const;                                            ///< whether pictures can be compressed while other pictures are being encoded
+  Void    finishCompressSlice ( TComPic* pcPic );                                       ///< wait for the end of a concurrent compressSlice
+  Void    waitForCompressedCtuRows( TComPic* pcPic, UInt numCtuRows );                  ///< wait until the first CTU rows of a concurrent compressSlice are compressed
   Void    calCostSliceI       ( TComPic* pcPic );
   Void    encodeSlice         ( TComPic* pcPic, TComOutputBitstream* pcSubstreams, UInt &numBinsCoded );
 
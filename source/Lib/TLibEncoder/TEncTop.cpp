@@ -57,6 +57,7 @@ TEncTop::TEncTop()
   m_uiNumAllPicCoded  =  0;
   m_pppcRDSbacCoder   =  NULL;
   m_pppcBinCoderCABAC =  NULL;
+  m_pcCtuWorkers      =  NULL;
   m_cRDGoOnSbacCoder.init( &m_cRDGoOnBinCoderCABAC );
 #if ENC_DEC_TRACE
   if (g_hTrace == NULL)
@@ -140,6 +141,16 @@ Void TEncTop::create ()
       m_pppcRDSbacCoder   [iDepth][iCIIdx]->init( m_pppcBinCoderCABAC [iDepth][iCIIdx] );
     }
   }
+
+  if ( m_numThreads > 1 )
+  {
+    m_pcCtuWorkers = new TEncCtuWorker[m_numThreads];
+    for ( Int threadIdx = 0; threadIdx < m_numThreads; threadIdx++ )
+    {
+      m_pcCtuWorkers[threadIdx].create( m_maxTotalCUDepth, m_maxCUWidth, m_maxCUHeight, m_chromaFormatIDC );
+    }
+    m_cThreadPool.create( m_numThreads );
+  }
 }
 
 Void TEncTop::destroy ()
@@ -153,6 +164,9 @@ Void TEncTop::destroy ()
   m_cLoopFilter.        destroy();
   m_cRateCtrl.          destroy();
   m_cSearch.            destroy();
+  m_cThreadPool.        destroy();
+  delete [] m_pcCtuWorkers;
+  m_pcCtuWorkers = NULL;
   Int iDepth;
   for ( iDepth = 0; iDepth < m_maxTotalCUDepth+1; iDepth++ )
   {
@@ -225,6 +239,14 @@ Void TEncTop::init(Bool isFieldCoding)
   m_iMaxRefPicNum = 0;
 
   xInitScalingLists();
+
+  if ( m_pcCtuWorkers != NULL )
+  {
+    for ( Int threadIdx = 0; threadIdx < m_numThreads; threadIdx++ )
+    {
+      m_pcCtuWorkers[threadIdx].init( this, m_cSPS );
+    }
+  }
 }
 
 Void TEncTop::xInitScalingLists()
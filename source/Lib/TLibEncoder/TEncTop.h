@@ -44,6 +44,7 @@
 #include "TLibCommon/TComTrQuant.h"
 #include "TLibCommon/TComLoopFilter.h"
 #include "TLibCommon/AccessUnit.h"
+#include "TLibCommon/TComThreadPool.h"
 
 #include "TLibVideoIO/TVideoIOYuv.h"
 
@@ -57,6 +58,7 @@
 #include "TEncSampleAdaptiveOffset.h"
 #include "TEncPreanalyzer.h"
 #include "TEncRateCtrl.h"
+#include "TEncCtuWorker.h"
 //! \ingroup TLibEncoder
 //! \{
 
@@ -111,6 +113,10 @@ private:
 
   TEncRateCtrl            m_cRateCtrl;                    ///< Rate control class
 
+  // multi-threaded CTU compression
+  TComThreadPool          m_cThreadPool;                  ///< worker threads, only started when more than one thread is requested
+  TEncCtuWorker*          m_pcCtuWorkers;                 ///< CTU analysis tools for each worker thread
+
 protected:
   Void  xGetNewPicBuffer  ( TComPic*& rpcPic );           ///< get picture buffer which will be processed
   Void  xInitVPS          ();                             ///< initialize VPS from encoder options
@@ -153,6 +159,8 @@ public:
   TEncSbac***             getRDSbacCoder        () { return  m_pppcRDSbacCoder;       }
   TEncSbac*               getRDGoOnSbacCoder    () { return  &m_cRDGoOnSbacCoder;     }
   TEncRateCtrl*           getRateCtrl           () { return &m_cRateCtrl;             }
+  TComThreadPool*         getThreadPool         () { return &m_cThreadPool;           }
+  TEncCtuWorker*          getCtuWorkers         () { return m_pcCtuWorkers;           }
   Void selectReferencePictureSet(TComSlice* slice, Int POCCurr, Int GOPid );
   Int getReferencePictureSetIdxForSOP(Int POCCurr, Int GOPid );
   // -------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,212 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2016, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TVideoIOStdio.cpp
+    \brief    binary video streams on the standard input and output
+*/
+
+#include <stdio.h>
+#include <fcntl.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "TVideoIOStdio.h"
+
+// ====================================================================================================================
+// Local classes and functions
+// ====================================================================================================================
+
+/// stream buffer writing to a C file, which does its own buffering
+class TVideoIOStdioFileBuf : public std::streambuf
+{
+private:
+  FILE* m_pFile;
+
+protected:
+  virtual int_type overflow( int_type c )
+  {
+    if ( c != traits_type::eof() && fputc( c, m_pFile ) == EOF )
+    {
+      return traits_type::eof();
+    }
+    return traits_type::not_eof( c );
+  }
+
+  virtual std::streamsize xsputn( const char* s, std::streamsize n )
+  {
+    return std::streamsize( fwrite( s, 1, size_t( n ), m_pFile ) );
+  }
+
+  virtual int sync()
+  {
+    return fflush( m_pFile ) == 0 ? 0 : -1;
+  }
+
+public:
+  TVideoIOStdioFileBuf( FILE* pFile ) : m_pFile( pFile ) {}
+};
+
+/// stream buffer reading from a C file in blocks, into which bytes that were read can be put back
+class TVideoIOStdioInputBuf : public std::streambuf
+{
+private:
+  static const size_t BLOCK_SIZE = 1 << 16;
+
+  FILE*             m_pFile;
+  std::vector<char> m_buf;
+
+protected:
+  virtual int_type underflow()
+  {
+    if ( gptr() == egptr() )
+    {
+      m_buf.resize( BLOCK_SIZE );
+      const size_t numRead = fread( &m_buf[0], 1, m_buf.size(), m_pFile );
+      setg( &m_buf[0], &m_buf[0], &m_buf[0] + numRead );
+      if ( numRead == 0 )
+      {
+        return traits_type::eof();
+      }
+    }
+    return traits_type::to_int_type( *gptr() );
+  }
+
+  virtual std::streamsize xsgetn( char* s, std::streamsize n )
+  {
+    // bytes already buffered, then whole blocks straight from the file
+    const std::streamsize numBuffered = std::min<std::streamsize>( n, egptr() - gptr() );
+    memcpy( s, gptr(), size_t( numBuffered ) );
+    gbump( Int( numBuffered ) );
+    std::streamsize numRead = numBuffered;
+    while ( numRead < n )
+    {
+      if ( n - numRead >= std::streamsize( BLOCK_SIZE ) )
+      {
+        const size_t numDirect = fread( s + numRead, 1, size_t( n - numRead ), m_pFile );
+        if ( numDirect == 0 )
+        {
+          break;
+        }
+        numRead += std::streamsize( numDirect );
+      }
+      else
+      {
+        if ( traits_type::eq_int_type( underflow(), traits_type::eof() ) )
+        {
+          break;
+        }
+        const std::streamsize numCopied = std::min<std::streamsize>( n - numRead, egptr() - gptr() );
+        memcpy( s + numRead, gptr(), size_t( numCopied ) );
+        gbump( Int( numCopied ) );
+        numRead += numCopied;
+      }
+    }
+    return numRead;
+  }
+
+public:
+  TVideoIOStdioInputBuf( FILE* pFile ) : m_pFile( pFile ) {}
+
+  Void unread( const std::string &bytes )
+  {
+    std::vector<char> buf( bytes.begin(), bytes.end() );
+    buf.insert( buf.end(), gptr(), egptr() );
+    m_buf.swap( buf );
+    if ( m_buf.empty() )
+    {
+      setg( NULL, NULL, NULL );
+      return;
+    }
+    setg( &m_buf[0], &m_buf[0], &m_buf[0] + m_buf.size() );
+  }
+};
+
+/**
+ * Keep the standard output for data in a new C file, and point stdout at stderr.
+ * Whatever was printed and not yet flushed is written to stderr when stdout is next flushed.
+ */
+static FILE* openStdoutForData()
+{
+#if defined(_WIN32)
+  const Int dataFd = _dup( _fileno( stdout ) );
+  _dup2( _fileno( stderr ), _fileno( stdout ) );
+  _setmode( dataFd, _O_BINARY );
+  return _fdopen( dataFd, "wb" );
+#else
+  const Int dataFd = dup( fileno( stdout ) );
+  dup2( fileno( stderr ), fileno( stdout ) );
+  return fdopen( dataFd, "wb" );
+#endif
+}
+
+// ====================================================================================================================
+// Public member functions
+// ====================================================================================================================
+
+/** Get the stream buffer of the standard input.
+ * It reads stdin itself rather than through std::cin, so that bytes can be put back in front of it.
+ */
+static TVideoIOStdioInputBuf& getInputBuf()
+{
+#if defined(_WIN32)
+  static const Int s_prevMode = _setmode( _fileno( stdin ), _O_BINARY );
+  (Void)s_prevMode;
+#endif
+  static TVideoIOStdioInputBuf s_inputBuf( stdin );
+  return s_inputBuf;
+}
+
+std::istream& TVideoIOStdio::getInput()
+{
+  static std::istream s_stream( &getInputBuf() );
+  return s_stream;
+}
+
+Void TVideoIOStdio::unreadInput( const std::string &bytes )
+{
+  getInput().clear();
+  getInputBuf().unread( bytes );
+}
+
+std::ostream& TVideoIOStdio::getOutput()
+{
+  static TVideoIOStdioFileBuf s_fileBuf( openStdoutForData() );
+  static std::ostream         s_stream( &s_fileBuf );
+  return s_stream;
+}
@@ -0,0 +1,70 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2016, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TVideoIOStdio.h
+    \brief    binary video streams on the standard input and output (header)
+*/
+
+#ifndef __TVIDEOIOSTDIO__
+#define __TVIDEOIOSTDIO__
+
+#include <iostream>
+#include <string>
+#include "TLibCommon/CommonDef.h"
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// access to the standard input and output for binary video data, selected with the file name "-"
+class TVideoIOStdio
+{
+public:
+  /// true if fileName selects the standard input or output
+  static Bool          isStdio   ( const std::string &fileName ) { return fileName == "-"; }
+
+  /// standard input, in binary mode
+  static std::istream& getInput  ();
+
+  /// put bytes that were read from the standard input back in front of it, so that they are read again
+  static Void          unreadInput( const std::string &bytes );
+
+  /** standard output, in binary mode.
+   * The first call moves the messages printed to stdout over to stderr, including those printed before and not yet
+   * flushed, so that the output only carries data. stdout is fully buffered when it is not a terminal, so the
+   * redirection takes effect for all messages as long as it is made before the first screenful of output.
+   */
+  static std::ostream& getOutput ();
+};
+
+#endif // __TVIDEOIOSTDIO__
@@ -42,9 +42,22 @@
 #include <fstream>
 #include <iostream>
 #include <memory.h>
+#include <limits>
+#include <functional>
+#include <sstream>
+#include <cctype>
 
 #include "TLibCommon/TComRom.h"
 #include "TVideoIOYuv.h"
+#include "TVideoIOStdio.h"
+
+#if !defined(_WIN32)
+#define TVIDEOIOYUV_MMAP 1 ///< read input files through a memory map
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#define TVIDEOIOYUV_MMAP 0
+#endif
 
 using namespace std;
 
@@ -97,6 +110,154 @@ static Void scalePlane(Pel* img, const UInt stride, const UInt width, const UInt
 static Void
 copyPlane(const TComPicYuv &src, const ComponentID srcPlane, TComPicYuv &dest, const ComponentID destPlane);
 
+static ComponentID
+colourSpaceSourceComponent(const ChromaFormat format, const UInt numValidComp, const InputColourSpaceConversion conversion, const Bool bIsForwards, const ComponentID destPlane);
+
+static const TChar  Y4M_STREAM_TAG[]   = "YUV4MPEG2";
+static const TChar  Y4M_FRAME_TAG[]    = "FRAME";
+static const size_t Y4M_STREAM_TAG_LEN = sizeof(Y4M_STREAM_TAG) - 1;
+static const size_t Y4M_FRAME_TAG_LEN  = sizeof(Y4M_FRAME_TAG) - 1;
+
+/// true if the file name has the extension .y4m, which selects the Y4M format for an output file
+static Bool hasY4MExtension(const std::string &fileName)
+{
+  if (fileName.size() < 4)
+  {
+    return false;
+  }
+  std::string extension = fileName.substr(fileName.size() - 4);
+  for (UInt i = 0; i < extension.size(); i++)
+  {
+    extension[i] = TChar(tolower(extension[i]));
+  }
+  return extension == ".y4m";
+}
+
+/**
+ * Read the first line of a stream if it starts with the Y4M signature.
+ * bytes receives all bytes that were read, so that they can be put back if the stream is not a Y4M stream.
+ */
+static Bool readY4MHeaderLine(istream &is, std::string &bytes)
+{
+  bytes.assign(Y4M_STREAM_TAG_LEN, '\0');
+  is.read(&bytes[0], streamsize(Y4M_STREAM_TAG_LEN));
+  bytes.resize(size_t(is.gcount()));
+  if (bytes != Y4M_STREAM_TAG)
+  {
+    return false;
+  }
+
+  std::string params;
+  std::getline(is, params);
+  bytes += params;
+  if (!is.eof())
+  {
+    bytes += '\n';
+  }
+  return true;
+}
+
+/// parse the colour space parameter of a Y4M header, e.g. 420jpeg, 422p10 or mono
+static Bool parseY4MColourSpace(const std::string &value, ChromaFormat &chromaFormat, Int &bitDepth)
+{
+  std::string depth;
+  if (value.compare(0, 4, "mono") == 0)
+  {
+    chromaFormat = CHROMA_400;
+    depth        = value.substr(4);
+  }
+  else
+  {
+    const std::string format = value.substr(0, 3);
+    if      (format == "420") { chromaFormat = CHROMA_420; }
+    else if (format == "422") { chromaFormat = CHROMA_422; }
+    else if (format == "444") { chromaFormat = CHROMA_444; }
+    else
+    {
+      return false;
+    }
+
+    depth = value.substr(3);
+    if (depth == "jpeg" || depth == "mpeg2" || depth == "paldv")
+    {
+      depth.clear(); // 8-bit 4:2:0 with different chroma siting
+    }
+    else if (!depth.empty())
+    {
+      if (depth[0] != 'p')
+      {
+        return false; // e.g. 444alpha
+      }
+      depth = depth.substr(1);
+    }
+  }
+
+  bitDepth = depth.empty() ? 8 : atoi(depth.c_str());
+  return bitDepth >= 8 && bitDepth <= 16;
+}
+
+/// colour space parameter of a Y4M header, as written by the common tools
+static std::string getY4MColourSpace(ChromaFormat chromaFormat, Int bitDepth)
+{
+  static const TChar* const formatNames[NUM_CHROMA_FORMAT] = { "mono", "420", "422", "444" };
+
+  std::ostringstream colourSpace;
+  colourSpace << formatNames[chromaFormat];
+  if (bitDepth > 8)
+  {
+    colourSpace << (chromaFormat == CHROMA_400 ? "" : "p") << bitDepth;
+  }
+  else if (chromaFormat == CHROMA_420)
+  {
+    colourSpace << "jpeg";
+  }
+  return colourSpace.str();
+}
+
+/**
+ * Parse the stream header of a Y4M file: "YUV4MPEG2" followed by space separated parameters, each a letter and a value.
+ * Aspect ratio and extension parameters are ignored.
+ */
+static Bool parseY4MHeader(const std::string &line, TVideoIOY4MHeader &header)
+{
+  header = TVideoIOY4MHeader();
+
+  std::istringstream params(line.substr(Y4M_STREAM_TAG_LEN));
+  std::string param;
+  while (params >> param)
+  {
+    const std::string value = param.substr(1);
+    switch (param[0])
+    {
+      case 'W':
+        header.width = atoi(value.c_str());
+        break;
+      case 'H':
+        header.height = atoi(value.c_str());
+        break;
+      case 'F':
+        if (sscanf(value.c_str(), "%d:%d", &header.frameRateNum, &header.frameRateDen) != 2 || header.frameRateNum <= 0 || header.frameRateDen <= 0)
+        {
+          return false;
+        }
+        break;
+      case 'I':
+        header.isInterlaced    = value == "t" || value == "b";
+        header.isTopFieldFirst = value == "t";
+        break;
+      case 'C':
+        if (!parseY4MColourSpace(value, header.chromaFormat, header.bitDepth))
+        {
+          return false;
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  return header.width > 0 && header.height > 0;
+}
+
 // ====================================================================================================================
 // Public member functions
 // ====================================================================================================================
@@ -111,6 +272,14 @@ copyPlane(const TComPicYuv &src, const ComponentID srcPlane, TComPicYuv &dest, c
  * (See scalePlane(), TVideoIOYuv::read() and TVideoIOYuv::write() for
  * further details).
  *
+ * The file name "-" selects the standard input or output, which is
+ * read or written sequentially.
+ *
+ * An input file in the Y4M format is recognised by its signature, and
+ * an output file by the extension .y4m. The frame headers of a Y4M
+ * input are skipped; the geometry and format given by the stream header
+ * are expected to match those of the pictures read.
+ *
  * \param pchFile          file name string
  * \param bWriteMode       file open mode: true=write, false=read
  * \param fileBitDepth     bit-depth array of input/output file data.
@@ -119,7 +288,75 @@ copyPlane(const TComPicYuv &src, const ComponentID srcPlane, TComPicYuv &dest, c
  */
 Void TVideoIOYuv::open( const std::string &fileName, Bool bWriteMode, const Int fileBitDepth[MAX_NUM_CHANNEL_TYPE], const Int MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE], const Int internalBitDepth[MAX_NUM_CHANNEL_TYPE] )
 {
-  //NOTE: files cannot have bit depth greater than 16
+  xSetBitDepths( bWriteMode, fileBitDepth, MSBExtendedBitDepth, internalBitDepth );
+
+  m_isY4M              = bWriteMode && hasY4MExtension( fileName );
+  m_isY4MHeaderPending = m_isY4M;
+
+  if ( TVideoIOStdio::isStdio( fileName ) )
+  {
+    if ( bWriteMode )
+    {
+      m_pcOutput = &TVideoIOStdio::getOutput();
+    }
+    else
+    {
+      m_pcInput = &TVideoIOStdio::getInput();
+    }
+  }
+  else if ( bWriteMode )
+  {
+    m_cHandle.open( fileName.c_str(), ios::binary | ios::out );
+
+    if( m_cHandle.fail() )
+    {
+      printf("\nfailed to write reconstructed YUV file\n");
+      exit(0);
+    }
+  }
+  else if ( !xMapFile( fileName ) )
+  {
+    m_cHandle.open( fileName.c_str(), ios::binary | ios::in );
+
+    if( m_cHandle.fail() )
+    {
+      printf("\nfailed to open Input YUV file\n");
+      exit(0);
+    }
+  }
+
+  if ( !bWriteMode )
+  {
+    xReadY4MStreamHeader();
+  }
+
+  return;
+}
+
+/**
+ * Open a stream of raw frames for reading. The stream is owned by the
+ * caller and is read sequentially; it is not closed by close().
+ *
+ * \param input            stream of the frames, without Y4M headers
+ * \param fileBitDepth     bit-depth array of the frame data
+ * \param MSBExtendedBitDepth
+ * \param internalBitDepth bit-depth array to scale image data to when reading
+ */
+Void TVideoIOYuv::open( istream& input, const Int fileBitDepth[MAX_NUM_CHANNEL_TYPE], const Int MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE], const Int internalBitDepth[MAX_NUM_CHANNEL_TYPE] )
+{
+  xSetBitDepths( false, fileBitDepth, MSBExtendedBitDepth, internalBitDepth );
+
+  m_isY4M              = false;
+  m_isY4MHeaderPending = false;
+  m_pcInput            = &input;
+}
+
+/**
+ * Set the bit depths of the file data and the bit-depth shift applied when reading or writing.
+ * Files cannot have a bit depth greater than 16.
+ */
+Void TVideoIOYuv::xSetBitDepths( Bool bWriteMode, const Int fileBitDepth[MAX_NUM_CHANNEL_TYPE], const Int MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE], const Int internalBitDepth[MAX_NUM_CHANNEL_TYPE] )
+{
   for(UInt ch=0; ch<MAX_NUM_CHANNEL_TYPE; ch++)
   {
     m_fileBitdepth       [ch] = std::min<UInt>(fileBitDepth[ch], 16);
@@ -139,50 +376,270 @@ Void TVideoIOYuv::open( const std::string &fileName, Bool bWriteMode, const Int
       }
     }
   }
+}
 
-  if ( bWriteMode )
+Void TVideoIOYuv::close()
+{
+  if (m_mappedFile != NULL)
   {
-    m_cHandle.open( fileName.c_str(), ios::binary | ios::out );
+    xUnmapFile();
+  }
+  else if (m_pcOutput != &m_cHandle)
+  {
+    m_pcOutput->flush();
+  }
+  else if (m_pcInput == &m_cHandle)
+  {
+    m_cHandle.close();
+  }
+  m_pcInput            = &m_cHandle;
+  m_pcOutput           = &m_cHandle;
+  m_isY4M              = false;
+  m_isY4MHeaderPending = false;
+}
 
-    if( m_cHandle.fail() )
+Bool TVideoIOYuv::isEof()
+{
+  return m_mappedFile != NULL ? m_mappedFileEof : m_pcInput->eof();
+}
+
+Bool TVideoIOYuv::isFail()
+{
+  return m_mappedFile != NULL ? m_mappedFileEof : m_pcInput->fail();
+}
+
+/**
+ * Map a regular input file into memory, so that frames are converted directly from the pages of the file.
+ * Pipes, empty files and platforms without mmap are read through m_cHandle instead.
+ */
+Bool TVideoIOYuv::xMapFile( const std::string &fileName )
+{
+#if TVIDEOIOYUV_MMAP
+  const Int fd = ::open( fileName.c_str(), O_RDONLY );
+  if (fd < 0)
+  {
+    return false;
+  }
+
+  struct stat fileStat;
+  const Bool isMappable = fstat( fd, &fileStat ) == 0 && S_ISREG( fileStat.st_mode ) && fileStat.st_size > 0
+                          && UInt64( fileStat.st_size ) <= UInt64( std::numeric_limits<size_t>::max() );
+  Void* data = isMappable ? mmap( NULL, size_t( fileStat.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 ) : MAP_FAILED;
+  ::close( fd ); // the mapping keeps the file open
+  if (data == MAP_FAILED)
+  {
+    return false;
+  }
+
+  madvise( data, size_t( fileStat.st_size ), MADV_SEQUENTIAL );
+
+  m_mappedFile     = static_cast<const UChar*>( data );
+  m_mappedFileSize = UInt64( fileStat.st_size );
+  m_mappedFilePos  = 0;
+  m_mappedFileEof  = false;
+  return true;
+#else
+  return false;
+#endif
+}
+
+Void TVideoIOYuv::xUnmapFile()
+{
+#if TVIDEOIOYUV_MMAP
+  if (m_mappedFile != NULL)
+  {
+    munmap( const_cast<UChar*>( m_mappedFile ), size_t( m_mappedFileSize ) );
+  }
+#endif
+  m_mappedFile     = NULL;
+  m_mappedFileSize = 0;
+  m_mappedFilePos  = 0;
+  m_mappedFileEof  = false;
+}
+
+/**
+ * Get the next numBytes bytes of the input file: a pointer into the map of the file, or into m_lineBuf after a stream read.
+ * Returns NULL, and sets the end-of-file state, if the file ends before numBytes bytes.
+ */
+const UChar* TVideoIOYuv::xReadFileBytes( UInt64 numBytes )
+{
+  if (m_mappedFile != NULL)
+  {
+    if (m_mappedFilePos > m_mappedFileSize || numBytes > m_mappedFileSize - m_mappedFilePos)
     {
-      printf("\nfailed to write reconstructed YUV file\n");
-      exit(0);
+      m_mappedFilePos = m_mappedFileSize;
+      m_mappedFileEof = true;
+      return NULL;
     }
+    const UChar* bytes = m_mappedFile + m_mappedFilePos;
+    m_mappedFilePos += numBytes;
+    return bytes;
+  }
+
+  m_lineBuf.resize( size_t( std::max<UInt64>( numBytes, 1 ) ) );
+  m_pcInput->read( reinterpret_cast<TChar*>( &m_lineBuf[0] ), streamsize( numBytes ) );
+  if (m_pcInput->eof() || m_pcInput->fail())
+  {
+    return NULL;
+  }
+  return &m_lineBuf[0];
+}
+
+/**
+ * Release the pages of the mapped file between consumedStart and consumedEnd, which have been converted, and ask for the
+ * pages up to nextEnd to be read in ahead of the next frame.
+ */
+Void TVideoIOYuv::xAdviseMappedFile( UInt64 consumedStart, UInt64 consumedEnd, UInt64 nextEnd )
+{
+#if TVIDEOIOYUV_MMAP
+  const UInt64 pageSize  = UInt64( sysconf( _SC_PAGESIZE ) );
+  const UInt64 pageStart = consumedStart - consumedStart % pageSize;
+  const UInt64 pageEnd   = consumedEnd - consumedEnd % pageSize;
+  UChar* const base      = const_cast<UChar*>( m_mappedFile );
+
+  if (pageEnd > pageStart)
+  {
+    madvise( base + pageStart, size_t( pageEnd - pageStart ), MADV_DONTNEED );
+  }
+  nextEnd = std::min( nextEnd, m_mappedFileSize );
+  if (nextEnd > pageEnd)
+  {
+    madvise( base + pageEnd, size_t( nextEnd - pageEnd ), MADV_WILLNEED );
+  }
+#endif
+}
+
+Bool TVideoIOYuv::readY4MHeader( const std::string &fileName, TVideoIOY4MHeader &header )
+{
+  std::string bytes;
+  Bool isY4M = false;
+  if ( TVideoIOStdio::isStdio( fileName ) )
+  {
+    isY4M = readY4MHeaderLine( TVideoIOStdio::getInput(), bytes );
+    TVideoIOStdio::unreadInput( bytes );
   }
   else
   {
-    m_cHandle.open( fileName.c_str(), ios::binary | ios::in );
+    ifstream file( fileName.c_str(), ios::binary | ios::in );
+    isY4M = !!file && readY4MHeaderLine( file, bytes );
+  }
 
-    if( m_cHandle.fail() )
+  if ( isY4M && !parseY4MHeader( bytes, header ) )
+  {
+    std::cerr << "\nERROR: Unsupported Y4M header in " << fileName << ": " << bytes << std::endl;
+    exit(EXIT_FAILURE);
+  }
+  return isY4M;
+}
+
+/**
+ * Check the input for the Y4M signature and parse the stream header that follows it.
+ * An input without the signature is left at its start.
+ */
+Void TVideoIOYuv::xReadY4MStreamHeader()
+{
+  std::string bytes;
+  if (m_mappedFile != NULL)
+  {
+    const Bool hasTag = m_mappedFileSize >= Y4M_STREAM_TAG_LEN && memcmp( m_mappedFile, Y4M_STREAM_TAG, Y4M_STREAM_TAG_LEN ) == 0;
+    const UChar* lineEnd = hasTag ? static_cast<const UChar*>( memchr( m_mappedFile, '\n', size_t( m_mappedFileSize ) ) ) : NULL;
+    if (!hasTag)
     {
-      printf("\nfailed to open Input YUV file\n");
-      exit(0);
+      return;
+    }
+    m_mappedFilePos = lineEnd != NULL ? UInt64( lineEnd - m_mappedFile ) + 1 : m_mappedFileSize;
+    bytes.assign( reinterpret_cast<const TChar*>( m_mappedFile ), size_t( m_mappedFilePos ) );
+  }
+  else if (!readY4MHeaderLine( *m_pcInput, bytes ))
+  {
+    m_pcInput->clear();
+    if (m_pcInput == &m_cHandle)
+    {
+      m_cHandle.seekg( 0, ios::beg );
+    }
+    else
+    {
+      TVideoIOStdio::unreadInput( bytes );
     }
+    return;
   }
 
-  return;
+  if (!parseY4MHeader( bytes, m_y4mHeader ))
+  {
+    std::cerr << "\nERROR: Unsupported Y4M header: " << bytes << std::endl;
+    exit(EXIT_FAILURE);
+  }
+  m_isY4M = true;
 }
 
-Void TVideoIOYuv::close()
+/**
+ * Skip the header in front of the next frame of a Y4M input: "FRAME", optional parameters and a line end.
+ * Returns false, and sets the end-of-file state, at the end of the input or if the header is missing.
+ */
+Bool TVideoIOYuv::xReadY4MFrameHeader()
 {
-  m_cHandle.close();
-}
+  Bool isFrameHeader = false;
+  if (m_mappedFile != NULL)
+  {
+    const UChar* tag     = xReadFileBytes( Y4M_FRAME_TAG_LEN );
+    const UChar* lineEnd = tag != NULL ? static_cast<const UChar*>( memchr( tag, '\n', size_t( m_mappedFileSize - ( tag - m_mappedFile ) ) ) ) : NULL;
+    isFrameHeader = lineEnd != NULL && memcmp( tag, Y4M_FRAME_TAG, Y4M_FRAME_TAG_LEN ) == 0;
+    if (isFrameHeader)
+    {
+      m_mappedFilePos = UInt64( lineEnd - m_mappedFile ) + 1;
+    }
+    else if (tag != NULL)
+    {
+      m_mappedFileEof = true;
+    }
+  }
+  else
+  {
+    TChar tag[Y4M_FRAME_TAG_LEN];
+    m_pcInput->read( tag, streamsize( Y4M_FRAME_TAG_LEN ) );
+    isFrameHeader = !!*m_pcInput && memcmp( tag, Y4M_FRAME_TAG, Y4M_FRAME_TAG_LEN ) == 0;
+    if (isFrameHeader)
+    {
+      m_pcInput->ignore( std::numeric_limits<streamsize>::max(), '\n' );
+    }
+    else if (!!*m_pcInput)
+    {
+      m_pcInput->setstate( ios::eofbit | ios::failbit );
+    }
+  }
 
-Bool TVideoIOYuv::isEof()
-{
-  return m_cHandle.eof();
+  return isFrameHeader;
 }
 
-Bool TVideoIOYuv::isFail()
+/**
+ * Write the header in front of the next frame of a Y4M output, and before the first frame the stream header, which
+ * describes the frames with the given luma size, chroma format and interlacing ('p', 't' or 'b').
+ */
+Bool TVideoIOYuv::xWriteY4MFrameHeader( UInt width444, UInt height444, ChromaFormat format, TChar interlacing )
 {
-  return m_cHandle.fail();
+  if (m_isY4MHeaderPending)
+  {
+    std::ostringstream header;
+    header << Y4M_STREAM_TAG << " W" << width444 << " H" << height444;
+    if (m_y4mHeader.frameRateNum > 0 && m_y4mHeader.frameRateDen > 0)
+    {
+      header << " F" << m_y4mHeader.frameRateNum << ":" << m_y4mHeader.frameRateDen;
+    }
+    header << " I" << interlacing << " C" << getY4MColourSpace( format, m_fileBitdepth[CHANNEL_TYPE_LUMA] ) << "\n";
+    m_pcOutput->write( header.str().c_str(), streamsize( header.str().size() ) );
+    m_isY4MHeaderPending = false;
+  }
+
+  m_pcOutput->write( Y4M_FRAME_TAG, streamsize( Y4M_FRAME_TAG_LEN ) );
+  m_pcOutput->put( '\n' );
+  return !m_pcOutput->fail();
 }
 
 /**
  * Skip numFrames in input.
  *
- * This function correctly handles cases where the input file is not
+ * A mapped input file is skipped by moving the read position. This
+ * function also correctly handles cases where the input file is not
  * seekable, by consuming bytes.
  */
 Void TVideoIOYuv::skipFrames(UInt numFrames, UInt width, UInt height, ChromaFormat format)
@@ -208,32 +665,142 @@ Void TVideoIOYuv::skipFrames(UInt numFrames, UInt width, UInt height, ChromaForm
   frameSize *= wordsize;
   //------------------
 
-  const streamoff offset = frameSize * numFrames;
+  if (m_isY4M)
+  {
+    // each frame follows its own header
+    for (UInt frame = 0; frame < numFrames && xReadY4MFrameHeader(); frame++)
+    {
+      xSkipFileBytes(UInt64(frameSize));
+    }
+    return;
+  }
+
+  xSkipFileBytes(UInt64(frameSize) * numFrames);
+}
+
+/// skip numBytes bytes of the input file
+Void TVideoIOYuv::xSkipFileBytes(UInt64 numBytes)
+{
+  const streamoff offset = streamoff(numBytes);
+
+  if (m_mappedFile != NULL)
+  {
+    m_mappedFilePos = std::min( m_mappedFilePos + numBytes, m_mappedFileSize );
+    return;
+  }
 
   /* attempt to seek */
-  if (!!m_cHandle.seekg(offset, ios::cur))
+  if (m_pcInput == &m_cHandle && !!m_cHandle.seekg(offset, ios::cur))
   {
     return; /* success */
   }
-  m_cHandle.clear();
+  m_pcInput->clear();
 
   /* fall back to consuming the input */
   TChar buf[512];
   const streamoff offset_mod_bufsize = offset % sizeof(buf);
   for (streamoff i = 0; i < offset - offset_mod_bufsize; i += sizeof(buf))
   {
-    m_cHandle.read(buf, sizeof(buf));
+    m_pcInput->read(buf, sizeof(buf));
   }
-  m_cHandle.read(buf, offset_mod_bufsize);
+  m_pcInput->read(buf, offset_mod_bufsize);
 }
 
 /**
- * Read width*height pixels from fd into dst, optionally
+ * Resample a row of samples to another horizontal chroma subsampling,
+ * by repeating or dropping samples.
+ *
+ * @param dst       destination row of width samples
+ * @param src       source row
+ * @param width     width of the destination row
+ * @param csx_src   horizontal scale of the component in src
+ * @param csx_dst   horizontal scale of the component in dst
+ */
+static Void resampleRow(Pel* dst, const Pel* src, UInt width, UInt csx_src, UInt csx_dst)
+{
+  if (csx_dst < csx_src)
+  {
+    // eg dst is 444, src is 422.
+    const UInt sx=csx_src-csx_dst;
+    for (UInt x = 0; x < width; x++)
+    {
+      dst[x] = src[x>>sx];
+    }
+  }
+  else
+  {
+    // eg dst is 422, src is 444.
+    const UInt sx=csx_dst-csx_src;
+    for (UInt x = 0; x < width; x++)
+    {
+      dst[x] = src[x<<sx];
+    }
+  }
+}
+
+/**
+ * Unpack a row of bytes or little-endian 16-bit words and convert the samples
+ * to the internal bit depth, as scalePlane() does.  The iterations are
+ * independent of each other, so that the compiler vectorises the loops.
+ *
+ * @param dst        destination row
+ * @param src        source bytes
+ * @param width      number of samples
+ * @param is16bit    true to read 16-bit words, false to read bytes
+ * @param shiftbits  if > 0, multiply by 2<sup>shiftbits</sup>;
+ *                   if < 0, divide and round by 2<sup>-shiftbits</sup> and clip.
+ * @param minval     minimum clipping value when dividing.
+ * @param maxval     maximum clipping value when dividing.
+ */
+static Void unpackRow(Pel* dst, const UChar* src, UInt width, Bool is16bit, Int shiftbits, Pel minval, Pel maxval)
+{
+  if (shiftbits < 0)
+  {
+    const Int shift    = -shiftbits;
+    const Int rounding = 1 << (shift-1);
+    if (!is16bit)
+    {
+      for (UInt x = 0; x < width; x++)
+      {
+        dst[x] = Clip3(minval, maxval, Pel((Pel(src[x]) + rounding) >> shift));
+      }
+    }
+    else
+    {
+      for (UInt x = 0; x < width; x++)
+      {
+        const Pel value = Pel(src[2*x] | (src[2*x+1]<<8));
+        dst[x] = Clip3(minval, maxval, Pel((value + rounding) >> shift));
+      }
+    }
+  }
+  else
+  {
+    if (!is16bit)
+    {
+      for (UInt x = 0; x < width; x++)
+      {
+        dst[x] = Pel(src[x] << shiftbits);
+      }
+    }
+    else
+    {
+      for (UInt x = 0; x < width; x++)
+      {
+        const Pel value = Pel(src[2*x] | (src[2*x+1]<<8));
+        dst[x] = Pel(value << shiftbits);
+      }
+    }
+  }
+}
+
+/**
+ * Read width*height pixels from the input file into dst, optionally
  * padding the left and right edges by edge-extension.  Input may be
  * either 8bit or 16bit little-endian lsb-aligned words.
  *
  * @param dst          destination image plane
- * @param fd           input file stream
+ * @param readBytes    returns the next given number of bytes of the input file, or NULL at its end
  * @param is16bit      true if input file carries > 8bit data, false otherwise.
  * @param stride444    distance between vertically adjacent pixels of dst.
  * @param width444     width of active area in dst.
@@ -244,10 +811,13 @@ Void TVideoIOYuv::skipFrames(UInt numFrames, UInt width, UInt height, ChromaForm
  * @param destFormat   chroma format of image
  * @param fileFormat   chroma format of file
  * @param fileBitDepth component bit depth in file
+ * @param shiftbits    conversion to the internal bit depth, see unpackRow()
+ * @param minval       minimum clipping value when dividing.
+ * @param maxval       maximum clipping value when dividing.
  * @return true for success, false in case of error
  */
 static Bool readPlane(Pel* dst,
-                      istream& fd,
+                      const std::function<const UChar*(UInt64)> &readBytes,
                       Bool is16bit,
                       UInt stride444,
                       UInt width444,
@@ -257,7 +827,8 @@ static Bool readPlane(Pel* dst,
                       const ComponentID compID,
                       const ChromaFormat destFormat,
                       const ChromaFormat fileFormat,
-                      const UInt fileBitDepth)
+                      const UInt fileBitDepth,
+                      const Int shiftbits, const Pel minval, const Pel maxval)
 {
   const UInt csx_file =getComponentScaleX(compID, fileFormat);
   const UInt csy_file =getComponentScaleY(compID, fileFormat);
@@ -274,8 +845,8 @@ static Bool readPlane(Pel* dst,
   const UInt full_height_dest = height_dest+pad_y_dest;
 
   const UInt stride_file      = (width444 * (is16bit ? 2 : 1)) >> csx_file;
-  std::vector<UChar> bufVec(stride_file);
-  UChar *buf=&(bufVec[0]);
+  const UInt width_file       = width444 >>csx_file;
+  const UChar *buf = NULL;
 
   if (compID!=COMPONENT_Y && (fileFormat==CHROMA_400 || destFormat==CHROMA_400))
   {
@@ -290,13 +861,13 @@ static Bool readPlane(Pel* dst,
           dst[x] = value;
         }
       }
+      scalePlane(dst - full_height_dest*stride_dest, stride_dest, full_width_dest, full_height_dest, shiftbits, minval, maxval);
     }
 
     if (fileFormat!=CHROMA_400)
     {
       const UInt height_file      = height444>>csy_file;
-      fd.seekg(height_file*stride_file, ios::cur);
-      if (fd.eof() || fd.fail() )
+      if (readBytes(UInt64(height_file)*stride_file) == NULL)
       {
         return false;
       }
@@ -306,13 +877,14 @@ static Bool readPlane(Pel* dst,
   {
     const UInt mask_y_file=(1<<csy_file)-1;
     const UInt mask_y_dest=(1<<csy_dest)-1;
+    std::vector<Pel> rowVec(csx_file != csx_dest ? width_file : 0);
     for(UInt y444=0; y444<height444; y444++)
     {
       if ((y444&mask_y_file)==0)
       {
         // read a new line
-        fd.read(reinterpret_cast<TChar*>(buf), stride_file);
-        if (fd.eof() || fd.fail() )
+        buf = readBytes(stride_file);
+        if (buf == NULL)
         {
           return false;
         }
@@ -321,43 +893,14 @@ static Bool readPlane(Pel* dst,
       if ((y444&mask_y_dest)==0)
       {
         // process current destination line
-        if (csx_file < csx_dest)
+        if (csx_file != csx_dest)
         {
-          // eg file is 444, dest is 422.
-          const UInt sx=csx_dest-csx_file;
-          if (!is16bit)
-          {
-            for (UInt x = 0; x < width_dest; x++)
-            {
-              dst[x] = buf[x<<sx];
-            }
-          }
-          else
-          {
-            for (UInt x = 0; x < width_dest; x++)
-            {
-              dst[x] = Pel(buf[(x<<sx)*2+0]) | (Pel(buf[(x<<sx)*2+1])<<8);
-            }
-          }
+          unpackRow(&(rowVec[0]), buf, width_file, is16bit, shiftbits, minval, maxval);
+          resampleRow(dst, &(rowVec[0]), width_dest, csx_file, csx_dest);
         }
         else
         {
-          // eg file is 422, dest is 444.
-          const UInt sx=csx_file-csx_dest;
-          if (!is16bit)
-          {
-            for (UInt x = 0; x < width_dest; x++)
-            {
-              dst[x] = buf[x>>sx];
-            }
-          }
-          else
-          {
-            for (UInt x = 0; x < width_dest; x++)
-            {
-              dst[x] = Pel(buf[(x>>sx)*2+0]) | (Pel(buf[(x>>sx)*2+1])<<8);
-            }
-          }
+          unpackRow(dst, buf, width_dest, is16bit, shiftbits, minval, maxval);
         }
 
         // process right hand side padding
@@ -383,6 +926,64 @@ static Bool readPlane(Pel* dst,
   return true;
 }
 
+/**
+ * Convert a row of samples to the file bit depth, as scalePlane() does, and
+ * pack them as bytes or as little-endian 16-bit words.  The iterations are
+ * independent of each other, so that the compiler vectorises the loops.
+ *
+ * @param dst        destination bytes
+ * @param src        source row
+ * @param width      number of samples
+ * @param is16bit    true to write 16-bit words, false to write bytes
+ * @param shiftbits  if > 0, multiply by 2<sup>shiftbits</sup>;
+ *                   if < 0, divide and round by 2<sup>-shiftbits</sup> and clip.
+ * @param minval     minimum clipping value when dividing.
+ * @param maxval     maximum clipping value when dividing.
+ */
+static Void packRow(UChar* dst, const Pel* src, UInt width, Bool is16bit, Int shiftbits, Pel minval, Pel maxval)
+{
+  if (shiftbits < 0)
+  {
+    const Int shift    = -shiftbits;
+    const Int rounding = 1 << (shift-1);
+    if (!is16bit)
+    {
+      for (UInt x = 0; x < width; x++)
+      {
+        dst[x] = UChar(Clip3(minval, maxval, Pel((src[x] + rounding) >> shift)));
+      }
+    }
+    else
+    {
+      for (UInt x = 0; x < width; x++)
+      {
+        const Pel value = Clip3(minval, maxval, Pel((src[x] + rounding) >> shift));
+        dst[2*x  ] = UChar(value);
+        dst[2*x+1] = UChar(value>>8);
+      }
+    }
+  }
+  else
+  {
+    if (!is16bit)
+    {
+      for (UInt x = 0; x < width; x++)
+      {
+        dst[x] = UChar(src[x] << shiftbits);
+      }
+    }
+    else
+    {
+      for (UInt x = 0; x < width; x++)
+      {
+        const Pel value = Pel(src[x] << shiftbits);
+        dst[2*x  ] = UChar(value);
+        dst[2*x+1] = UChar(value>>8);
+      }
+    }
+  }
+}
+
 /**
  * Write an image plane (width444*height444 pixels) from src into output stream fd.
  *
@@ -404,7 +1005,8 @@ static Bool writePlane(ostream& fd, Pel* src, Bool is16bit,
                        const ComponentID compID,
                        const ChromaFormat srcFormat,
                        const ChromaFormat fileFormat,
-                       const UInt fileBitDepth)
+                       const UInt fileBitDepth,
+                       const Int shiftbits, const Pel minval, const Pel maxval)
 {
   const UInt csx_file =getComponentScaleX(compID, fileFormat);
   const UInt csy_file =getComponentScaleY(compID, fileFormat);
@@ -458,51 +1060,19 @@ static Bool writePlane(ostream& fd, Pel* src, Bool is16bit,
   {
     const UInt mask_y_file=(1<<csy_file)-1;
     const UInt mask_y_src =(1<<csy_src )-1;
+    std::vector<Pel> rowVec(csx_file != csx_src ? width_file : 0);
     for(UInt y444=0; y444<height444; y444++)
     {
       if ((y444&mask_y_file)==0)
       {
         // write a new line
-        if (csx_file < csx_src)
-        {
-          // eg file is 444, source is 422.
-          const UInt sx=csx_src-csx_file;
-          if (!is16bit)
-          {
-            for (UInt x = 0; x < width_file; x++)
-            {
-              buf[x] = (UChar)(src[x>>sx]);
-            }
-          }
-          else
-          {
-            for (UInt x = 0; x < width_file; x++)
-            {
-              buf[2*x  ] = (src[x>>sx]>>0) & 0xff;
-              buf[2*x+1] = (src[x>>sx]>>8) & 0xff;
-            }
-          }
-        }
-        else
+        const Pel *row = src;
+        if (csx_file != csx_src)
         {
-          // eg file is 422, src is 444.
-          const UInt sx=csx_file-csx_src;
-          if (!is16bit)
-          {
-            for (UInt x = 0; x < width_file; x++)
-            {
-              buf[x] = (UChar)(src[x<<sx]);
-            }
-          }
-          else
-          {
-            for (UInt x = 0; x < width_file; x++)
-            {
-              buf[2*x  ] = (src[x<<sx]>>0) & 0xff;
-              buf[2*x+1] = (src[x<<sx]>>8) & 0xff;
-            }
-          }
+          resampleRow(&(rowVec[0]), src, width_file, csx_src, csx_file);
+          row = &(rowVec[0]);
         }
+        packRow(buf, row, width_file, is16bit, shiftbits, minval, maxval);
 
         fd.write(reinterpret_cast<const TChar*>(buf), stride_file);
         if (fd.eof() || fd.fail() )
@@ -527,7 +1097,8 @@ static Bool writeField(ostream& fd, Pel* top, Pel* bottom, Bool is16bit,
                        const ComponentID compID,
                        const ChromaFormat srcFormat,
                        const ChromaFormat fileFormat,
-                       const UInt fileBitDepth, const Bool isTff)
+                       const UInt fileBitDepth, const Bool isTff,
+                       const Int shiftbits, const Pel minval, const Pel maxval)
 {
   const UInt csx_file =getComponentScaleX(compID, fileFormat);
   const UInt csy_file =getComponentScaleY(compID, fileFormat);
@@ -586,6 +1157,7 @@ static Bool writeField(ostream& fd, Pel* top, Pel* bottom, Bool is16bit,
   {
     const UInt mask_y_file=(1<<csy_file)-1;
     const UInt mask_y_src =(1<<csy_src )-1;
+    std::vector<Pel> rowVec(csx_file != csx_src ? width_file : 0);
     for(UInt y444=0; y444<height444; y444++)
     {
       if ((y444&mask_y_file)==0)
@@ -596,46 +1168,13 @@ static Bool writeField(ostream& fd, Pel* top, Pel* bottom, Bool is16bit,
           Pel   *src         = (((field == 0) && isTff) || ((field == 1) && (!isTff))) ? top : bottom;
 
           // write a new line
-          if (csx_file < csx_src)
-          {
-            // eg file is 444, source is 422.
-            const UInt sx=csx_src-csx_file;
-            if (!is16bit)
-            {
-              for (UInt x = 0; x < width_file; x++)
-              {
-                fieldBuffer[x] = (UChar)(src[x>>sx]);
-              }
-            }
-            else
-            {
-              for (UInt x = 0; x < width_file; x++)
-              {
-                fieldBuffer[2*x  ] = (src[x>>sx]>>0) & 0xff;
-                fieldBuffer[2*x+1] = (src[x>>sx]>>8) & 0xff;
-              }
-            }
-          }
-          else
+          const Pel *row = src;
+          if (csx_file != csx_src)
           {
-            // eg file is 422, src is 444.
-            const UInt sx=csx_file-csx_src;
-            if (!is16bit)
-            {
-              for (UInt x = 0; x < width_file; x++)
-              {
-                fieldBuffer[x] = (UChar)(src[x<<sx]);
-              }
-            }
-            else
-            {
-              for (UInt x = 0; x < width_file; x++)
-              {
-                fieldBuffer[2*x  ] = (src[x<<sx]>>0) & 0xff;
-                fieldBuffer[2*x+1] = (src[x<<sx]>>8) & 0xff;
-              }
-            }
+            resampleRow(&(rowVec[0]), src, width_file, csx_src, csx_file);
+            row = &(rowVec[0]);
           }
+          packRow(fieldBuffer, row, width_file, is16bit, shiftbits, minval, maxval);
         }
 
         fd.write(reinterpret_cast<const TChar*>(buf), (stride_file * 2));
@@ -707,6 +1246,14 @@ Bool TVideoIOYuv::read ( TComPicYuv*  pPicYuvUser, TComPicYuv* pPicYuvTrueOrg, c
   const UInt width444       = width_full444 - pad_h444;
   const UInt height444      = height_full444 - pad_v444;
 
+  const std::function<const UChar*(UInt64)> readBytes = [this](UInt64 numBytes) { return xReadFileBytes(numBytes); };
+  const UInt64 frameStart   = m_mappedFilePos;
+
+  if (m_isY4M && !xReadY4MFrameHeader())
+  {
+    return false;
+  }
+
   for(UInt comp=0; comp<MAX_NUM_COMPONENT; comp++)
   {
     const ComponentID compID = ComponentID(comp);
@@ -718,17 +1265,18 @@ Bool TVideoIOYuv::read ( TComPicYuv*  pPicYuvUser, TComPicYuv* pPicYuvTrueOrg, c
     const Pel minval = b709Compliance? ((   1 << (desired_bitdepth - 8))   ) : 0;
     const Pel maxval = b709Compliance? ((0xff << (desired_bitdepth - 8)) -1) : (1 << desired_bitdepth) - 1;
 
-    if (! readPlane(pPicYuv->getAddr(compID), m_cHandle, is16bit, stride444, width444, height444, pad_h444, pad_v444, compID, pPicYuv->getChromaFormat(), format, m_fileBitdepth[chType]))
+    // the samples are scaled to the internal bit depth as they are unpacked
+    if (! readPlane(pPicYuv->getAddr(compID), readBytes, is16bit, stride444, width444, height444, pad_h444, pad_v444, compID, pPicYuv->getChromaFormat(), format, m_fileBitdepth[chType],
+                    m_bitdepthShift[chType], minval, maxval))
     {
       return false;
     }
+  }
 
-    if (compID < pPicYuv->getNumberValidComponents() )
-    {
-      const UInt csx=getComponentScaleX(compID, pPicYuv->getChromaFormat());
-      const UInt csy=getComponentScaleY(compID, pPicYuv->getChromaFormat());
-      scalePlane(pPicYuv->getAddr(compID), stride444>>csx, width_full444>>csx, height_full444>>csy, m_bitdepthShift[chType], minval, maxval);
-    }
+  if (m_mappedFile != NULL)
+  {
+    // the next frame is assumed to have the size of this one
+    xAdviseMappedFile(frameStart, m_mappedFilePos, 2*m_mappedFilePos - frameStart);
   }
 
   ColourSpaceConvert(*pPicYuvTrueOrg, *pPicYuvUser, ipcsc, true);
@@ -751,17 +1299,10 @@ Bool TVideoIOYuv::read ( TComPicYuv*  pPicYuvUser, TComPicYuv* pPicYuvTrueOrg, c
  */
 Bool TVideoIOYuv::write( TComPicYuv* pPicYuvUser, const InputColourSpaceConversion ipCSC, Int confLeft, Int confRight, Int confTop, Int confBottom, ChromaFormat format, const Bool bClipToRec709 )
 {
-  TComPicYuv cPicYuvCSCd;
-  if (ipCSC!=IPCOLOURSPACE_UNCHANGED)
-  {
-    cPicYuvCSCd.createWithoutCUInfo(pPicYuvUser->getWidth(COMPONENT_Y), pPicYuvUser->getHeight(COMPONENT_Y), pPicYuvUser->getChromaFormat() );
-    ColourSpaceConvert(*pPicYuvUser, cPicYuvCSCd, ipCSC, false);
-  }
-  TComPicYuv *pPicYuv=(ipCSC==IPCOLOURSPACE_UNCHANGED) ? pPicYuvUser : &cPicYuvCSCd;
+  TComPicYuv *dstPicYuv=pPicYuvUser;
 
   // compute actual YUV frame size excluding padding size
   Bool is16bit = false;
-  Bool nonZeroBitDepthShift=false;
 
   for(UInt ch=0; ch<MAX_NUM_CHANNEL_TYPE; ch++)
   {
@@ -769,39 +1310,12 @@ Bool TVideoIOYuv::write( TComPicYuv* pPicYuvUser, const InputColourSpaceConversi
     {
       is16bit=true;
     }
-    if (m_bitdepthShift[ch] != 0)
-    {
-      nonZeroBitDepthShift=true;
-    }
   }
 
-  TComPicYuv *dstPicYuv = NULL;
   Bool retval = true;
   if (format>=NUM_CHROMA_FORMAT)
   {
-    format=pPicYuv->getChromaFormat();
-  }
-
-  if (nonZeroBitDepthShift)
-  {
-    dstPicYuv = new TComPicYuv;
-    dstPicYuv->createWithoutCUInfo( pPicYuv->getWidth(COMPONENT_Y), pPicYuv->getHeight(COMPONENT_Y), pPicYuv->getChromaFormat() );
-
-    for(UInt comp=0; comp<dstPicYuv->getNumberValidComponents(); comp++)
-    {
-      const ComponentID compID=ComponentID(comp);
-      const ChannelType ch=toChannelType(compID);
-      const Bool b709Compliance = bClipToRec709 && (-m_bitdepthShift[ch] < 0 && m_MSBExtendedBitDepth[ch] >= 8);     /* ITU-R BT.709 compliant clipping for converting say 10b to 8b */
-      const Pel minval = b709Compliance? ((   1 << (m_MSBExtendedBitDepth[ch] - 8))   ) : 0;
-      const Pel maxval = b709Compliance? ((0xff << (m_MSBExtendedBitDepth[ch] - 8)) -1) : (1 << m_MSBExtendedBitDepth[ch]) - 1;
-
-      copyPlane(*pPicYuv, compID, *dstPicYuv, compID);
-      scalePlane(dstPicYuv->getAddr(compID), dstPicYuv->getStride(compID), dstPicYuv->getWidth(compID), dstPicYuv->getHeight(compID), -m_bitdepthShift[ch], minval, maxval);
-    }
-  }
-  else
-  {
-    dstPicYuv = pPicYuv;
+    format=dstPicYuv->getChromaFormat();
   }
 
   const Int  stride444 = dstPicYuv->getStride(COMPONENT_Y);
@@ -813,6 +1327,11 @@ Bool TVideoIOYuv::write( TComPicYuv* pPicYuvUser, const InputColourSpaceConversi
     printf ("\nWarning: writing %d x %d luma sample output picture!", width444, height444);
   }
 
+  if (m_isY4M)
+  {
+    retval = xWriteY4MFrameHeader(width444, height444, format, 'p');
+  }
+
   for(UInt comp=0; retval && comp<dstPicYuv->getNumberValidComponents(); comp++)
   {
     const ComponentID compID = ComponentID(comp);
@@ -820,40 +1339,29 @@ Bool TVideoIOYuv::write( TComPicYuv* pPicYuvUser, const InputColourSpaceConversi
     const UInt csx = dstPicYuv->getComponentScaleX(compID);
     const UInt csy = dstPicYuv->getComponentScaleY(compID);
     const Int planeOffset =  (confLeft>>csx) + (confTop>>csy) * dstPicYuv->getStride(compID);
-    if (! writePlane(m_cHandle, dstPicYuv->getAddr(compID) + planeOffset, is16bit, stride444, width444, height444, compID, dstPicYuv->getChromaFormat(), format, m_fileBitdepth[ch]))
+    // the colour space conversion only reorders the planes, so each one is written from the plane it is copied from
+    const ComponentID srcCompID = colourSpaceSourceComponent(dstPicYuv->getChromaFormat(), dstPicYuv->getNumberValidComponents(), ipCSC, false, compID);
+    const Bool b709Compliance = bClipToRec709 && (-m_bitdepthShift[ch] < 0 && m_MSBExtendedBitDepth[ch] >= 8);     /* ITU-R BT.709 compliant clipping for converting say 10b to 8b */
+    const Pel minval = b709Compliance? ((   1 << (m_MSBExtendedBitDepth[ch] - 8))   ) : 0;
+    const Pel maxval = b709Compliance? ((0xff << (m_MSBExtendedBitDepth[ch] - 8)) -1) : (1 << m_MSBExtendedBitDepth[ch]) - 1;
+
+    // the samples are scaled to the file bit depth as they are packed
+    if (! writePlane(*m_pcOutput, dstPicYuv->getAddr(srcCompID) + planeOffset, is16bit, stride444, width444, height444, compID, dstPicYuv->getChromaFormat(), format, m_fileBitdepth[ch],
+                     -m_bitdepthShift[ch], minval, maxval))
     {
       retval=false;
     }
   }
 
-  if (nonZeroBitDepthShift)
-  {
-    dstPicYuv->destroy();
-    delete dstPicYuv;
-  }
-
-  cPicYuvCSCd.destroy();
-
   return retval;
 }
 
 Bool TVideoIOYuv::write( TComPicYuv* pPicYuvUserTop, TComPicYuv* pPicYuvUserBottom, const InputColourSpaceConversion ipCSC, Int confLeft, Int confRight, Int confTop, Int confBottom, ChromaFormat format, const Bool isTff, const Bool bClipToRec709 )
 {
-
-  TComPicYuv cPicYuvTopCSCd;
-  TComPicYuv cPicYuvBottomCSCd;
-  if (ipCSC!=IPCOLOURSPACE_UNCHANGED)
-  {
-    cPicYuvTopCSCd   .createWithoutCUInfo(pPicYuvUserTop   ->getWidth(COMPONENT_Y), pPicYuvUserTop   ->getHeight(COMPONENT_Y), pPicYuvUserTop   ->getChromaFormat() );
-    cPicYuvBottomCSCd.createWithoutCUInfo(pPicYuvUserBottom->getWidth(COMPONENT_Y), pPicYuvUserBottom->getHeight(COMPONENT_Y), pPicYuvUserBottom->getChromaFormat() );
-    ColourSpaceConvert(*pPicYuvUserTop,    cPicYuvTopCSCd,    ipCSC, false);
-    ColourSpaceConvert(*pPicYuvUserBottom, cPicYuvBottomCSCd, ipCSC, false);
-  }
-  TComPicYuv *pPicYuvTop    = (ipCSC==IPCOLOURSPACE_UNCHANGED) ? pPicYuvUserTop    : &cPicYuvTopCSCd;
-  TComPicYuv *pPicYuvBottom = (ipCSC==IPCOLOURSPACE_UNCHANGED) ? pPicYuvUserBottom : &cPicYuvBottomCSCd;
+  TComPicYuv *dstPicYuvTop    = pPicYuvUserTop;
+  TComPicYuv *dstPicYuvBottom = pPicYuvUserBottom;
 
   Bool is16bit = false;
-  Bool nonZeroBitDepthShift=false;
 
   for(UInt ch=0; ch<MAX_NUM_CHANNEL_TYPE; ch++)
   {
@@ -861,47 +1369,11 @@ Bool TVideoIOYuv::write( TComPicYuv* pPicYuvUserTop, TComPicYuv* pPicYuvUserBott
     {
       is16bit=true;
     }
-    if (m_bitdepthShift[ch] != 0)
-    {
-      nonZeroBitDepthShift=true;
-    }
   }
 
-  TComPicYuv *dstPicYuvTop    = NULL;
-  TComPicYuv *dstPicYuvBottom = NULL;
-
-  for (UInt field = 0; field < 2; field++)
+  if (format>=NUM_CHROMA_FORMAT)
   {
-    TComPicYuv *pPicYuv = (field == 0) ? pPicYuvTop : pPicYuvBottom;
-
-    if (format>=NUM_CHROMA_FORMAT)
-    {
-      format=pPicYuv->getChromaFormat();
-    }
-
-    TComPicYuv* &dstPicYuv = (field == 0) ? dstPicYuvTop : dstPicYuvBottom;
-
-    if (nonZeroBitDepthShift)
-    {
-      dstPicYuv = new TComPicYuv;
-      dstPicYuv->createWithoutCUInfo( pPicYuv->getWidth(COMPONENT_Y), pPicYuv->getHeight(COMPONENT_Y), pPicYuv->getChromaFormat() );
-
-      for(UInt comp=0; comp<dstPicYuv->getNumberValidComponents(); comp++)
-      {
-        const ComponentID compID=ComponentID(comp);
-        const ChannelType ch=toChannelType(compID);
-        const Bool b709Compliance=bClipToRec709 && (-m_bitdepthShift[ch] < 0 && m_MSBExtendedBitDepth[ch] >= 8);     /* ITU-R BT.709 compliant clipping for converting say 10b to 8b */
-        const Pel minval = b709Compliance? ((   1 << (m_MSBExtendedBitDepth[ch] - 8))   ) : 0;
-        const Pel maxval = b709Compliance? ((0xff << (m_MSBExtendedBitDepth[ch] - 8)) -1) : (1 << m_MSBExtendedBitDepth[ch]) - 1;
-
-        copyPlane(*pPicYuv, compID, *dstPicYuv, compID);
-        scalePlane(dstPicYuv->getAddr(compID), dstPicYuv->getStride(compID), dstPicYuv->getWidth(compID), dstPicYuv->getHeight(compID), -m_bitdepthShift[ch], minval, maxval);
-      }
-    }
-    else
-    {
-      dstPicYuv = pPicYuv;
-    }
+    format=dstPicYuvTop->getChromaFormat();
   }
 
   Bool retval = true;
@@ -909,6 +1381,12 @@ Bool TVideoIOYuv::write( TComPicYuv* pPicYuvUserTop, TComPicYuv* pPicYuvUserBott
   assert(dstPicYuvTop->getNumberValidComponents() == dstPicYuvBottom->getNumberValidComponents());
   assert(dstPicYuvTop->getChromaFormat()          == dstPicYuvBottom->getChromaFormat()         );
 
+  if (m_isY4M)
+  {
+    // the frame holds both fields
+    retval = xWriteY4MFrameHeader(dstPicYuvTop->getWidth(COMPONENT_Y) - (confLeft + confRight), 2 * (dstPicYuvTop->getHeight(COMPONENT_Y) - (confTop + confBottom)), format, isTff ? 't' : 'b');
+  }
+
   for(UInt comp=0; retval && comp<dstPicYuvTop->getNumberValidComponents(); comp++)
   {
     const ComponentID compID = ComponentID(comp);
@@ -931,29 +1409,24 @@ Bool TVideoIOYuv::write( TComPicYuv* pPicYuvUserTop, TComPicYuv* pPicYuvUserBott
     const UInt csx = dstPicYuvTop->getComponentScaleX(compID);
     const UInt csy = dstPicYuvTop->getComponentScaleY(compID);
     const Int planeOffset  = (confLeft>>csx) + ( confTop>>csy) * dstPicYuvTop->getStride(compID); //offset is for entire frame - round up for top field and down for bottom field
-
-    if (! writeField(m_cHandle,
-                     (dstPicYuvTop   ->getAddr(compID) + planeOffset),
-                     (dstPicYuvBottom->getAddr(compID) + planeOffset),
+    const ComponentID srcCompID = colourSpaceSourceComponent(dstPicYuvTop->getChromaFormat(), dstPicYuvTop->getNumberValidComponents(), ipCSC, false, compID);
+    const Bool b709Compliance=bClipToRec709 && (-m_bitdepthShift[ch] < 0 && m_MSBExtendedBitDepth[ch] >= 8);     /* ITU-R BT.709 compliant clipping for converting say 10b to 8b */
+    const Pel minval = b709Compliance? ((   1 << (m_MSBExtendedBitDepth[ch] - 8))   ) : 0;
+    const Pel maxval = b709Compliance? ((0xff << (m_MSBExtendedBitDepth[ch] - 8)) -1) : (1 << m_MSBExtendedBitDepth[ch]) - 1;
+
+    // the samples are scaled to the file bit depth as they are packed
+    if (! writeField(*m_pcOutput,
+                     (dstPicYuvTop   ->getAddr(srcCompID) + planeOffset),
+                     (dstPicYuvBottom->getAddr(srcCompID) + planeOffset),
                      is16bit,
                      dstPicYuvTop->getStride(COMPONENT_Y),
-                     width444, height444, compID, dstPicYuvTop->getChromaFormat(), format, m_fileBitdepth[ch], isTff))
+                     width444, height444, compID, dstPicYuvTop->getChromaFormat(), format, m_fileBitdepth[ch], isTff,
+                     -m_bitdepthShift[ch], minval, maxval))
     {
       retval=false;
     }
   }
 
-  if (nonZeroBitDepthShift)
-  {
-    dstPicYuvTop->destroy();
-    dstPicYuvBottom->destroy();
-    delete dstPicYuvTop;
-    delete dstPicYuvBottom;
-  }
-
-  cPicYuvTopCSCd.destroy();
-  cPicYuvBottomCSCd.destroy();
-
   return retval;
 }
 
@@ -974,12 +1447,20 @@ copyPlane(const TComPicYuv &src, const ComponentID srcPlane, TComPicYuv &dest, c
   }
 }
 
-// static member
-Void TVideoIOYuv::ColourSpaceConvert(const TComPicYuv &src, TComPicYuv &dest, const InputColourSpaceConversion conversion, Bool bIsForwards)
+/**
+ * Plane of the source picture that a colour space conversion copies to a plane
+ * of the destination picture.  All the conversions are reorderings of the planes.
+ *
+ * @param format       chroma format of the pictures
+ * @param numValidComp number of planes of the pictures
+ * @param conversion   colour space conversion
+ * @param bIsForwards  true for the conversion of input pictures, false for its inverse
+ * @param destPlane    plane of the destination picture
+ * @return plane of the source picture
+ */
+static ComponentID
+colourSpaceSourceComponent(const ChromaFormat format, const UInt numValidComp, const InputColourSpaceConversion conversion, const Bool bIsForwards, const ComponentID destPlane)
 {
-  const ChromaFormat  format=src.getChromaFormat();
-  const UInt          numValidComp=src.getNumberValidComponents();
-
   switch (conversion)
   {
     case IPCOLOURSPACE_YCbCrtoYYY:
@@ -989,50 +1470,35 @@ Void TVideoIOYuv::ColourSpaceConvert(const TComPicYuv &src, TComPicYuv &dest, co
         assert(format==CHROMA_444);
         exit(1);
       }
+      return bIsForwards ? COMPONENT_Y : destPlane;
 
-      {
-        for(UInt comp=0; comp<numValidComp; comp++)
-        {
-          copyPlane(src, ComponentID(bIsForwards?0:comp), dest, ComponentID(comp));
-        }
-      }
-      break;
     case IPCOLOURSPACE_YCbCrtoYCrCb:
-      {
-        for(UInt comp=0; comp<numValidComp; comp++)
-        {
-          copyPlane(src, ComponentID(comp), dest, ComponentID((numValidComp-comp)%numValidComp));
-        }
-      }
-      break;
+      return ComponentID((numValidComp-destPlane)%numValidComp);
 
     case IPCOLOURSPACE_RGBtoGBR:
+      if (format!=CHROMA_444)
       {
-        if (format!=CHROMA_444)
-        {
-          // only 444 is handled.
-          assert(format==CHROMA_444);
-          exit(1);
-        }
-
-        // channel re-mapping
-        for(UInt comp=0; comp<numValidComp; comp++)
-        {
-          const ComponentID compIDsrc=ComponentID((comp+1)%numValidComp);
-          const ComponentID compIDdst=ComponentID(comp);
-          copyPlane(src, bIsForwards?compIDsrc:compIDdst, dest, bIsForwards?compIDdst:compIDsrc);
-        }
+        // only 444 is handled.
+        assert(format==CHROMA_444);
+        exit(1);
       }
-      break;
+      // channel re-mapping
+      return ComponentID(bIsForwards ? (destPlane+1)%numValidComp : (destPlane+numValidComp-1)%numValidComp);
 
     case IPCOLOURSPACE_UNCHANGED:
     default:
-      {
-        for(UInt comp=0; comp<numValidComp; comp++)
-        {
-          copyPlane(src, ComponentID(comp), dest, ComponentID(comp));
-        }
-      }
-      break;
+      return destPlane;
+  }
+}
+
+// static member
+Void TVideoIOYuv::ColourSpaceConvert(const TComPicYuv &src, TComPicYuv &dest, const InputColourSpaceConversion conversion, Bool bIsForwards)
+{
+  const ChromaFormat  format=src.getChromaFormat();
+  const UInt          numValidComp=src.getNumberValidComponents();
+
+  for(UInt comp=0; comp<numValidComp; comp++)
+  {
+    copyPlane(src, colourSpaceSourceComponent(format, numValidComp, conversion, bIsForwards, ComponentID(comp)), dest, ComponentID(comp));
   }
 }
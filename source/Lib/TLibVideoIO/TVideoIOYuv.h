@@ -41,6 +41,7 @@
 #include <stdio.h>
 #include <fstream>
 #include <iostream>
+#include <vector>
 #include "TLibCommon/CommonDef.h"
 #include "TLibCommon/TComPicYuv.h"
 
@@ -50,22 +51,70 @@ using namespace std;
 // Class definition
 // ====================================================================================================================
 
-/// YUV file I/O class
+/// stream parameters carried in the header of a Y4M file
+struct TVideoIOY4MHeader
+{
+  Int          width;
+  Int          height;
+  Int          frameRateNum;                                ///< 0 if the frame rate is not given
+  Int          frameRateDen;
+  ChromaFormat chromaFormat;
+  Int          bitDepth;
+  Bool         isInterlaced;
+  Bool         isTopFieldFirst;
+
+  TVideoIOY4MHeader() : width(0), height(0), frameRateNum(0), frameRateDen(0), chromaFormat(CHROMA_420), bitDepth(8), isInterlaced(false), isTopFieldFirst(false) {}
+};
+
+/// YUV file I/O class, for raw files and Y4M files
 class TVideoIOYuv
 {
 private:
   fstream   m_cHandle;                                      ///< file handle
+  istream*  m_pcInput;                                      ///< stream frames are read from: m_cHandle, the standard input or a stream of the caller
+  ostream*  m_pcOutput;                                     ///< stream frames are written to: m_cHandle, or the standard output
   Int       m_fileBitdepth[MAX_NUM_CHANNEL_TYPE]; ///< bitdepth of input/output video file
   Int       m_MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE];  ///< bitdepth after addition of MSBs (with value 0)
   Int       m_bitdepthShift[MAX_NUM_CHANNEL_TYPE];  ///< number of bits to increase or decrease image by before/after write/read
 
+  const UChar*       m_mappedFile;                  ///< read-only memory map of the input file, or NULL when it is read through m_cHandle
+  UInt64             m_mappedFileSize;              ///< size of the mapped file in bytes
+  UInt64             m_mappedFilePos;               ///< offset in the mapped file of the next byte to read
+  Bool               m_mappedFileEof;               ///< a read went past the end of the mapped file
+  std::vector<UChar> m_lineBuf;                     ///< bytes read through m_cHandle
+
+  Bool               m_isY4M;                       ///< each frame of the file follows a Y4M frame header
+  Bool               m_isY4MHeaderPending;          ///< the Y4M stream header is written with the first frame
+  TVideoIOY4MHeader  m_y4mHeader;                   ///< header of a Y4M input, or frame rate of a Y4M output
+
+  Void         xSetBitDepths ( Bool bWriteMode, const Int fileBitDepth[MAX_NUM_CHANNEL_TYPE], const Int MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE], const Int internalBitDepth[MAX_NUM_CHANNEL_TYPE] );
+  Bool         xMapFile      ( const std::string &fileName ); ///< map an input file into memory, false if it cannot be mapped
+  Void         xUnmapFile    ();
+  const UChar* xReadFileBytes( UInt64 numBytes );   ///< next numBytes bytes of the input file, or NULL at the end of the file
+  Void         xAdviseMappedFile( UInt64 consumedStart, UInt64 consumedEnd, UInt64 nextEnd ); ///< release and prefetch pages of the map
+  Void         xSkipFileBytes( UInt64 numBytes );
+
+  Void         xReadY4MStreamHeader ();               ///< detect and parse the header of a Y4M input
+  Bool         xReadY4MFrameHeader  ();               ///< skip the frame header of a Y4M input, false at the end of the file
+  Bool         xWriteY4MFrameHeader ( UInt width444, UInt height444, ChromaFormat format, TChar interlacing );
+
 public:
-  TVideoIOYuv()           {}
-  virtual ~TVideoIOYuv()  {}
+  TVideoIOYuv() : m_pcInput(&m_cHandle), m_pcOutput(&m_cHandle), m_mappedFile(NULL), m_mappedFileSize(0), m_mappedFilePos(0), m_mappedFileEof(false), m_isY4M(false), m_isY4MHeaderPending(false) {}
+  virtual ~TVideoIOYuv()  { xUnmapFile(); }
 
+  /// the file name "-" selects the standard input or output
   Void  open  ( const std::string &fileName, Bool bWriteMode, const Int fileBitDepth[MAX_NUM_CHANNEL_TYPE], const Int MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE], const Int internalBitDepth[MAX_NUM_CHANNEL_TYPE] ); ///< open or create file
+  /// read raw frames from a stream owned by the caller, such as frames held in memory
+  Void  open  ( istream& input, const Int fileBitDepth[MAX_NUM_CHANNEL_TYPE], const Int MSBExtendedBitDepth[MAX_NUM_CHANNEL_TYPE], const Int internalBitDepth[MAX_NUM_CHANNEL_TYPE] );
   Void  close ();                                           ///< close file
 
+  /// parse the header of a Y4M input file, false if the file is not a Y4M file. The header is left to be read by open().
+  static Bool readY4MHeader( const std::string &fileName, TVideoIOY4MHeader &header );
+
+  Bool  isY4M () const                                      { return m_isY4M; }
+  const TVideoIOY4MHeader& getY4MHeader() const             { return m_y4mHeader; }
+  Void  setY4MFrameRate( Int num, Int den )                 { m_y4mHeader.frameRateNum = num; m_y4mHeader.frameRateDen = den; } ///< frame rate written in the header of a Y4M output
+
   Void skipFrames(UInt numFrames, UInt width, UInt height, ChromaFormat format);
 
   // if fileFormat<NUM_CHROMA_FORMAT, the format of the file is that format specified, else it is the format of the TComPicYuv.